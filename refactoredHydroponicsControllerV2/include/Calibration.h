@@ -0,0 +1,76 @@
+/*
+ * Calibration.h
+ *
+ * Pump calibration wizard and flow curves. The wizard runs a pump for a
+ * fixed time at each of CAL_POINT_COUNT duty levels, the user enters the
+ * volume collected after each run with the encoder, and the measured
+ * flows become the pump's flow-vs-duty curve in pumpCalibrations[].
+ * Doses then pick the fastest duty on the curve that still runs long
+ * enough to be accurate.
+ */
+
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include "Globals.h"
+
+#define CAL_RUN_MS 10000            // Run time per calibration point
+#define CAL_MIN_DOSE_RUN_MS 2000    // Shorter runs are dominated by spin-up and coast volume
+#define CAL_MAX_VOLUME 9999         // Tenths of mL the volume entry goes up to
+
+// Duty levels measured, ascending
+static const uint8_t CAL_DUTY_LEVELS[CAL_POINT_COUNT] = { 25, 50, 75, 100 };
+
+// ==================================================
+// WIZARD
+// ==================================================
+enum CalibrationState : uint8_t {
+  CAL_IDLE,
+  CAL_READY,       // Waiting for the user to place a cup and start the run
+  CAL_RUNNING,     // Pump running for CAL_RUN_MS
+  CAL_MEASURE,     // Waiting for the collected volume
+  CAL_REVIEW,      // All points measured, waiting for save or discard
+  CAL_FAILED       // No point produced any flow
+};
+
+struct CalibrationStatus {
+  CalibrationState state;
+  bool requestPending;     // A request has not been picked up by loop() yet
+  uint8_t pump;
+  uint8_t point;           // 0-based point being run or measured
+  uint8_t duty;            // PWM % of that point
+  unsigned long elapsedMs; // CAL_RUNNING: time run so far
+  uint16_t volume;         // CAL_MEASURE: entered volume, tenths of mL
+  PumpCalibration result;  // CAL_REVIEW: the curve that would be saved
+};
+
+// Requests from the menu (any task). loop() owns the pump and carries them
+// out in updatePumpCalibration(); the latest request wins.
+void requestPumpCalibration(uint8_t pumpNumber);
+void requestCalibrationStep();     // Run the next point / accept the volume
+void requestCalibrationSave();     // Store the reviewed curve
+void requestCalibrationCancel();   // Stop the pump and discard
+
+// CAL_MEASURE only: change the entered volume by delta tenths of mL
+void adjustCalibrationVolume(int delta);
+
+// Call from loop()
+void updatePumpCalibration(unsigned long currentTime);
+
+CalibrationStatus getCalibrationStatus();
+bool isPumpCalibrationActive();
+// Dosing holds this pump's queue while the wizard owns it
+bool isPumpCalibrating(uint8_t pumpNumber);
+
+// ==================================================
+// FLOW CURVES
+// ==================================================
+// Flow at a duty, interpolated between measured points; 0 below the curve
+float pumpFlowAtDuty(const PumpCalibration &cal, uint8_t duty);
+
+// Duty and flow to dose amountML (tenths) with: the highest measured duty
+// whose run is at least CAL_MIN_DOSE_RUN_MS, else the lowest. Falls back
+// to pwmSpeed / mlPerSecond without a curve. False if uncalibrated.
+bool choosePumpDuty(const PumpCalibration &cal, uint16_t amountML, uint8_t &duty, float &mlPerSecond);
+
+#endif // CALIBRATION_H
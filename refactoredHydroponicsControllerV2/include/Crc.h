@@ -0,0 +1,16 @@
+/*
+ * Crc.h
+ *
+ * Checksums for records kept in flash (dose journal, schedule store).
+ */
+
+#ifndef CRC_H
+#define CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-16/CCITT-FALSE
+uint16_t crc16(const uint8_t *data, size_t len);
+
+#endif // CRC_H
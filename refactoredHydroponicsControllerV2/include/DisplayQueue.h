@@ -0,0 +1,46 @@
+/*
+ * DisplayQueue.h
+ *
+ * Draw command ring for the display. DisplayTask is the only task that
+ * touches the canvas and the TFT; everything else (web handlers, MQTT,
+ * the dosing engine) posts a command here and returns without waiting
+ * for SPI.
+ */
+
+#ifndef DISPLAYQUEUE_H
+#define DISPLAYQUEUE_H
+
+#include "Globals.h"
+
+#define DRAW_QUEUE_SIZE        16   // Power of two
+#define DRAW_NOTIFY_TEXT_LEN   21   // Characters across the panel at size 1
+
+// ==================================================
+// DRAW COMMANDS
+// ==================================================
+enum DrawCommandType : uint8_t {
+  DRAW_CMD_REDRAW,      // Data behind the current screen changed
+  DRAW_CMD_NOTIFY       // Banner message over the current screen
+};
+
+struct DrawCommand {
+  DrawCommandType type;
+  uint16_t color;                         // NOTIFY: banner colour
+  uint16_t durationMs;                    // NOTIFY: time on screen
+  char text[DRAW_NOTIFY_TEXT_LEN + 1];    // NOTIFY: message
+};
+
+// ==================================================
+// PRODUCERS (any task, never block)
+// ==================================================
+// Return false when the ring is full; the command is dropped.
+bool postDrawCommand(const DrawCommand& cmd);
+bool displayNotify(const char* text, uint16_t color = YELLOW, uint16_t ms = 3000);
+bool requestDisplayRedraw();
+
+// ==================================================
+// CONSUMER (DisplayTask only)
+// ==================================================
+bool popDrawCommand(DrawCommand& cmd);
+
+#endif // DISPLAYQUEUE_H
@@ -9,6 +9,9 @@
 
 #include "Globals.h"
 #include "MenuRegistry.h"
+#include "FrameCanvas.h"
+#include "PagedList.h"
+#include "DisplayQueue.h"
 
 
 // ==================================================
@@ -32,6 +35,12 @@ void drawGenericMenu(const char* title, const char* const* items, int itemCount,
 void drawConfirmDialog(const char* title);
 void showSplash(const char* msg, uint16_t color = YELLOW, uint16_t ms = 900);
 
+// ==================================================
+// QUEUED COMMANDS (DisplayTask)
+// ==================================================
+void applyDrawCommand(const DrawCommand& cmd);
+void expireNotification(unsigned long currentTime);
+
 // ==================================================
 // SCHEDULE SCREENS
 // ==================================================
@@ -49,5 +58,11 @@ void drawOutletScheduleListScreen();
 // CALIBRATION SCREEN
 // ==================================================
 void drawCalibrateMenu(uint8_t pumpNum);
+void drawCalibrationRunScreen();
+
+// ==================================================
+// REPLACE SOLUTION SCREEN
+// ==================================================
+void drawReplaceStatusScreen();
 
 #endif // DISPLAYUI_H
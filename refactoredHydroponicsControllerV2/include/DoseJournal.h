@@ -0,0 +1,72 @@
+/*
+ * DoseJournal.h
+ *
+ * Append-only LittleFS journal of scheduled doses. Every scheduled dose is
+ * recorded when it is queued, started and finished, so after a reboot the
+ * controller knows which fires were already handed out, which dose was cut
+ * off mid-run, and which fires were missed while it was powered off.
+ *
+ * The guarantee is at-most-once per fire, not exactly-once:
+ * - A fire that was journaled is never handed out again.
+ * - A dose cut off mid-run is closed as INTERRUPTED and not finished. The
+ *   journal only knows when the pump started, not when power was lost, so
+ *   the volume already delivered is unknown and topping it up could
+ *   overdose.
+ * - Fires missed while powered off are caught up per schedule, and only
+ *   the latest of them (subject to config.doseCatchUp). Earlier misses of
+ *   the same schedule are logged and dropped, so an outage never stacks
+ *   several doses of one schedule back to back.
+ */
+
+#ifndef DOSE_JOURNAL_H
+#define DOSE_JOURNAL_H
+
+#include "Globals.h"
+#include "DosingEngine.h"
+
+// ==================================================
+// RECORDS
+// ==================================================
+enum DoseJournalType : uint8_t {
+  DOSE_JOURNAL_QUEUED = 1,       // On a pump queue (again on a volume change)
+  DOSE_JOURNAL_STARTED = 2,      // Pump switched on
+  DOSE_JOURNAL_DONE = 3,         // Pump switched off after the full run
+  DOSE_JOURNAL_SKIPPED = 4,      // Never run (late, pump not calibrated)
+  DOSE_JOURNAL_INTERRUPTED = 5,  // Reboot while the pump was running; not repeated
+  DOSE_JOURNAL_MERGED = 6,       // Volume added to another pending dose
+  DOSE_JOURNAL_WATERMARK = 7     // Fire history carried over by compaction
+};
+
+// A dose is identified by pump and fire time
+struct DoseJournalRecord {
+  uint8_t type;            // DoseJournalType
+  uint8_t pump;            // 1-4
+  uint8_t source;          // DoseSource
+  uint8_t scheduleIndex;
+  uint32_t dueUnix;        // Schedule fire time (local unix time)
+  uint32_t atUnix;         // RTC time the record was written
+  uint16_t amountML;       // Tenths of mL
+  uint16_t crc;            // CRC-16 of the bytes above
+};
+
+// ==================================================
+// JOURNAL
+// ==================================================
+// Replay the journal, close doses cut off by the reboot, apply the catch-up
+// policy (config.doseCatchUp) to the latest fire each schedule missed while
+// powered off and hand the fire history to DosingQueue. Call once from
+// setup() after the schedules are loaded and the RTC is running.
+void initDoseJournal();
+
+// Record a state change of a dose. Only scheduled doses are journaled;
+// call from loop() only.
+void journalDose(DoseJournalType type, const DoseRequest &dose);
+
+// ==================================================
+// CONFIG
+// ==================================================
+// "skip" / "late" / "window" <-> DOSE_CATCHUP_*
+const char* doseCatchUpName(uint8_t policy);
+uint8_t doseCatchUpFromName(const char* name);
+
+#endif // DOSE_JOURNAL_H
@@ -0,0 +1,66 @@
+/*
+ * DosingEngine.h
+ * 
+ * Dosing execution: one executor per peristaltic pump, each with its own
+ * queue of pending doses. Doses on different pumps run in parallel; doses
+ * on the same pump run back to back in the order they were queued.
+ */
+
+#ifndef DOSING_ENGINE_H
+#define DOSING_ENGINE_H
+
+#include "Globals.h"
+
+#define DOSING_PUMP_COUNT 4
+#define DOSE_QUEUE_LENGTH 8   // Pending doses per pump before coalescing
+
+// ==================================================
+// DOSE REQUESTS
+// ==================================================
+enum DoseSource : uint8_t {
+  DOSE_SOURCE_SCHEDULE,
+  DOSE_SOURCE_MANUAL,
+  DOSE_SOURCE_TOPUP,
+  DOSE_SOURCE_REPLACE
+};
+
+struct DoseRequest {
+  uint8_t pumpNumber;      // 1-4
+  uint16_t amountML;       // Tenths of mL, as in DosingSchedule
+  DoseSource source;
+  uint8_t scheduleIndex;   // dosingSchedules[] slot for DOSE_SOURCE_SCHEDULE
+  uint32_t dueUnix;        // Schedule fire time, 0 for other sources
+};
+
+// Queue a dose on its pump. A dose is never dropped: when the pump's queue
+// is full its volume is added to the last pending dose. Returns false only
+// for an invalid pump or amount. Safe to call from any task; scheduled
+// doses (journaled) are queued from loop() only.
+bool queueDose(const DoseRequest &request);
+
+// ==================================================
+// EXECUTION (call from loop)
+// ==================================================
+// Drop the pump's pending doses from source and stop its running dose if
+// it came from source (the volume already pumped is reported as usual).
+// Returns the number of doses cancelled.
+uint8_t cancelDoses(uint8_t pumpNumber, DoseSource source);
+// Move due schedules from DosingQueue onto the pump queues
+void checkDosingSchedules(unsigned long currentTime);
+// Finish doses whose pump the stop timer switched off (or stop them here if
+// the timer is missing or late) and start the next pending one on each
+// idle pump
+void updateDosingExecution(unsigned long currentTime);
+
+// ==================================================
+// STATUS
+// ==================================================
+bool isPumpDosing(uint8_t pumpNumber);
+bool isAnyPumpDosing();
+uint8_t pendingDoseCount(uint8_t pumpNumber);
+// Planned and actual run time of the last finished dose on a pump, in
+// microseconds. False if the pump has not finished a dose since boot. Any
+// task; reported in /api/data.
+bool lastDoseRunTime(uint8_t pumpNumber, int64_t &plannedUs, int64_t &actualUs);
+
+#endif // DOSING_ENGINE_H
@@ -0,0 +1,42 @@
+/*
+ * DosingQueue.h
+ * 
+ * Next-fire-time queue for the dosing schedules. Every enabled schedule's
+ * next fire time sits in a min-heap; between rebuilds the head is compared
+ * against millis() only, so the RTC is read once per resync instead of
+ * once per schedule per second.
+ */
+
+#ifndef DOSING_QUEUE_H
+#define DOSING_QUEUE_H
+
+#include "Globals.h"
+
+// ==================================================
+// QUEUE
+// ==================================================
+// Index of the schedule that is due now, or -1; dueUnix receives its fire
+// time. The schedule is taken off the head and re-queued at its following
+// fire time, so it is returned once per fire time. Cheap to call every
+// loop pass.
+int takeDueDosingSchedule(unsigned long currentTime, uint32_t *dueUnix = nullptr);
+
+// Schedules were edited or the clock was adjusted: rebuild on the next call.
+// Safe to call from any task.
+void invalidateDosingQueue();
+
+// Fires already handed out before a reboot (from the dose journal): the
+// pumps dosed at firedAt (bit 0 = pump 1). Fires up to firedAt are never
+// handed out again.
+void seedDosingQueueHistory(uint32_t firedAt, uint8_t pumps);
+
+// ==================================================
+// FIRE TIMES
+// ==================================================
+// First fire time of sched strictly after afterUnix (local unix time), or
+// 0 if it never fires. Interval schedules fire every intervalMinutes from
+// hour:minute (00:00 anchors them to midnight) until the end of each
+// enabled day, and start again from the anchor the next enabled day.
+uint32_t dosingScheduleNextFire(const DosingSchedule &sched, uint32_t afterUnix);
+
+#endif // DOSING_QUEUE_H
@@ -0,0 +1,98 @@
+/*
+ * FrameCanvas.h
+ *
+ * Off-screen 128x128 RGB565 canvas for the TFT. DisplayUI draws into it
+ * and flush() sends only the 16x16 tiles whose content changed since the
+ * last flush. Once DisplayTask has started it is the only task that may
+ * draw; others post DisplayQueue commands.
+ */
+
+#ifndef FRAMECANVAS_H
+#define FRAMECANVAS_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <TFT_ILI9163C.h>
+#include "GlyphAtlas.h"
+
+#define CANVAS_WIDTH   128
+#define CANVAS_HEIGHT  128
+#define CANVAS_TILE    16
+#define CANVAS_TILES_X (CANVAS_WIDTH / CANVAS_TILE)
+#define CANVAS_TILES_Y (CANVAS_HEIGHT / CANVAS_TILE)
+#define CANVAS_TILES   (CANVAS_TILES_X * CANVAS_TILES_Y)
+
+// ==================================================
+// RENDER INSTRUMENTATION
+// ==================================================
+struct RenderStats {
+  uint32_t frames;          // flush() calls that sent anything
+  uint16_t tilesChecked;    // Last flush: tiles drawn into and re-hashed
+  uint16_t tilesSent;       // Last flush: tiles pushed to the panel
+  uint32_t bytesSent;       // Last flush: pixel bytes queued to the panel
+  uint32_t flushMicros;     // Last flush: CPU time (DMA continues after)
+  uint32_t totalTilesSent;
+  uint32_t totalBytesSent;
+};
+
+// ==================================================
+// FRAME CANVAS
+// ==================================================
+// Pixels are kept in panel byte order (big endian) so they go to
+// pushRectAsync() untouched. Drawing marks the tiles it touches; flush()
+// re-hashes only those and sends the ones whose hash differs from the last
+// flush, so repainting identical content costs no SPI traffic. Runs of
+// changed tiles in a tile row are gathered into a DMA staging buffer (full
+// rows go straight from the canvas). Without a buffer all drawing falls
+// through to the panel unbuffered.
+class FrameCanvas : public Adafruit_GFX {
+public:
+  FrameCanvas();
+
+  bool begin(TFT_ILI9163C* panel);
+  bool isBuffered() const { return buffer != nullptr; }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void fillScreen(uint16_t color) override;
+
+  // Opaque text from the glyph atlas: the whole string box is written in one
+  // pass with bg baked in, no clear needed first. Returns the width drawn.
+  int16_t drawText(int16_t x, int16_t y, const char* text,
+                   uint16_t fg, uint16_t bg, uint8_t size = 1);
+
+  void flush();                 // Push changed tiles, returns while DMA runs
+  void invalidate();            // Resend everything (panel was drawn directly)
+
+  // Task allowed to flush; flushes from any other task are refused. Unset
+  // (NULL) until the renderer task claims the canvas.
+  void setOwner(TaskHandle_t task) { owner = task; }
+
+  const RenderStats& stats() const { return renderStats; }
+  void resetStats();
+
+private:
+  uint16_t* buffer;
+  uint16_t* staging[2];         // Internal DMA RAM, one tile row each
+  uint8_t stagingNext;
+  TFT_ILI9163C* panel;
+  TaskHandle_t owner;
+  uint64_t touchedTiles;        // Bit per tile, row major
+  uint64_t validTiles;          // tileHash[] matches what the panel shows
+  uint32_t tileHash[CANVAS_TILES];
+  bool flushPending;
+  RenderStats renderStats;
+
+  void markTouched(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+  void textRow(const char* text, uint8_t len, uint8_t row, uint8_t size,
+               uint16_t fg, uint16_t bg, uint16_t* out, int16_t skip, int16_t width);
+  uint32_t hashTile(uint8_t tx, uint8_t ty) const;
+  bool sendRun(uint8_t ty, uint8_t tx0, uint8_t tiles);
+  void waitForPanel();
+};
+
+extern FrameCanvas canvas;
+
+#endif // FRAMECANVAS_H
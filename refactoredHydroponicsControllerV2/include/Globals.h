@@ -18,6 +18,7 @@
 #include <TFT_ILI9163C.h>
 #include <Adafruit_NeoPixel.h>
 #include <Preferences.h>
+#include "MenuTable.h"
 
 // ==================================================
 // UTILITY MACROS
@@ -31,78 +32,11 @@
 // ==================================================
 // MENU SYSTEM ENUMERATIONS
 // ==================================================
+// Generated from MENU_TABLE (MenuTable.h), in table order
 enum MenuState {
-  MENU_MAIN,
-  
-  // Scheduling
-  MENU_SCHEDULING,
-  
-  // Dosing Schedule
-  MENU_DOSING_SCHEDULE,
-  MENU_DOSING_VIEW,
-  MENU_DOSING_ADD,
-  MENU_DOSING_ADD_SELECT_DAYS,
-  MENU_DOSING_ADD_SET_TIME,
-  MENU_DOSING_ADD_SET_AMOUNT,
-  MENU_DOSING_DELETE,
-  MENU_DOSING_DELETE_CONFIRM,
-  MENU_DOSING_DELETE_ALL,
-//  MENU_DOSING_ERROR_NO_DAYS,   // NEW: error screen when no days selected
-
-  // Outlet Schedule
-  MENU_OUTLET_SCHEDULE,
-  MENU_OUTLET_VIEW,
-  MENU_OUTLET_ADD,
-  MENU_OUTLET_ADD_SELECT_DAYS,   // NEW
-  MENU_OUTLET_ADD_VALUES,
-  MENU_OUTLET_ADD_CONFIRM,
-  MENU_OUTLET_DELETE,
-  MENU_OUTLET_DELETE_SELECT,
-  MENU_OUTLET_DELETE_CONFIRM,
-  MENU_OUTLET_DELETE_ALL,
-  MENU_OUTLET_DELETE_ALL_CONFIRM,
-  
-  // Manual Dosing
-  MENU_MANUAL_DOSING,
-  MENU_MANUAL_SELECT_PUMP,
-  MENU_MANUAL_SET_AMOUNT,
-  MENU_MANUAL_CONFIRM,
-  
-  // Pump Calibration
-  MENU_PUMP_CALIBRATION,
-  MENU_CALIBRATE_P1,
-  MENU_CALIBRATE_P1_START,
-  MENU_CALIBRATE_P1_CONFIRM,
-  MENU_CALIBRATE_P2,
-  MENU_CALIBRATE_P2_START,
-  MENU_CALIBRATE_P2_CONFIRM,
-  MENU_CALIBRATE_P3,
-  MENU_CALIBRATE_P3_START,
-  MENU_CALIBRATE_P3_CONFIRM,
-  MENU_CALIBRATE_P4,
-  MENU_CALIBRATE_P4_START,
-  MENU_CALIBRATE_P4_CONFIRM,
-  
-  // Top-up Solution
-  MENU_TOPUP_SOLUTION,
-  MENU_TOPUP_SET_AMOUNTS,
-  MENU_TOPUP_AMOUNTS_CONFIRM,
-  MENU_TOPUP_SET_PUMP_PIN,
-  MENU_TOPUP_PUMP_CONFIRM,
-  
-  // Replace Solution
-  MENU_REPLACE_SOLUTION,
-  MENU_REPLACE_SET_AMOUNTS,
-  MENU_REPLACE_SET_DRAIN,
-  MENU_REPLACE_SET_FILL,
-  MENU_REPLACE_SET_SCHEDULE,
-  MENU_REPLACE_CONFIRM,
-  
-  // WiFi & Reset
-  MENU_RESET_WIFI,
-  MENU_RESET_WIFI_CONFIRM,
-  MENU_FACTORY_RESET,
-  MENU_FACTORY_RESET_CONFIRM
+  MENU_TABLE(MENU_ROW_ID)
+  MENU_COUNT,
+  MENU_NONE = MENU_COUNT      // Item target: the menu's selectFn decides
 };
 
 enum MQTTState {
@@ -119,19 +53,16 @@ enum MQTTState {
 struct MenuNavigationState {
   MenuState currentMenu = MENU_MAIN;
   int selectedIndex = 0;
-  int lastDrawnIndex = -1;
   int scrollOffset = 0;
   bool inEditMode = false;
   int editValue = 0;
   unsigned long lastActivity = 0;
   bool needsRedraw = true;
-  bool needsFullRedraw = true;
   
   // Temporary workflow values
   uint8_t tempPumpNumber = 1;
   uint16_t tempAmount = 0;
   uint8_t tempRelay = 1;
-  bool isCalibrating = false;
   int tempIndex = -1;   // generic "selected schedule index" for delete flows
   
   // Dosing schedule wizard
@@ -172,17 +103,25 @@ struct OutletSchedule {
 
   // INTERVAL mode fields (NEW)
   bool isInterval;            // true = interval mode, false = fixed ON/OFF times
-  uint16_t intervalMinutes;   // total minutes between ON events (1..59 or 60..1440)
+  uint16_t intervalMinutes;   // total minutes between ON events (1..59 or 60..1440); on for the first half
 
   bool enabled;
 };
 
 
+#define CAL_POINT_COUNT 4   // PWM duty levels measured by the calibration wizard
+
 struct PumpCalibration {
   uint8_t pwmSpeed;
   uint16_t timeMs;
   float mlPerSecond;
   bool isCalibrated;
+
+  // Flow-vs-duty curve (Calibration.h), ascending duty. pointCount 0:
+  // single-speed calibration, pwmSpeed / mlPerSecond only.
+  uint8_t pointCount;
+  uint8_t pointDuty[CAL_POINT_COUNT];    // PWM %
+  float pointFlow[CAL_POINT_COUNT];      // mL/s measured at pointDuty
 };
 
 struct TopUpConfig {
@@ -206,6 +145,16 @@ struct ReplaceConfig {
   bool enabled;
 };
 
+// Replace cycle checkpoint, kept in NVS so a reboot resumes the cycle
+struct ReplaceProgress {
+  uint8_t stage;            // ReplaceStage
+  uint8_t faultStage;       // REPLACE_FAULT: stage that timed out
+  uint8_t dosePump;         // REPLACE_DOSE: pump being dosed, 0 before the first
+  bool doseQueued;          // REPLACE_DOSE: dosePump's dose was handed to the engine
+  uint32_t stageStartUnix;  // RTC time the stage was entered
+  uint32_t startedUnix;     // RTC time the cycle was started
+};
+
 struct Config {
   String apPassword;
   String mqttBroker;
@@ -221,6 +170,10 @@ struct Config {
   bool mqttUseTLS;
   String webUsername;
   String webPassword;
+
+  // Doses missed while powered off (DoseJournal)
+  uint8_t doseCatchUp;          // DOSE_CATCHUP_SKIP / _LATE / _WINDOW
+  uint16_t doseCatchUpMinutes;  // Window for DOSE_CATCHUP_WINDOW
   
   // WiFi credentials (added for SimpleWiFi module)
   char wifi_ssid[33];      // Max SSID length is 32 + null terminator
@@ -349,7 +302,9 @@ struct SensorData {
 
 // Files
 #define CONFIG_FILE "/config.json"
-#define LOG_FILE "/sensor_log.txt"
+#define LOG_FILE "/sensor_log.txt"          // CSV log of earlier firmware, imported once
+#define TELEMETRY_DIR "/telemetry"
+#define DOSE_JOURNAL_FILE "/dose_journal.bin"
 #define WEB_USERNAME "admin"
 #define WEB_PASSWORD "hydro2024"
 
@@ -375,6 +330,11 @@ struct SensorData {
 #define MAX_DOSING_SCHEDULES 24
 #define MAX_OUTLET_SCHEDULES 10
 
+// Dose journal: missed dose catch-up policies (config.doseCatchUp)
+#define DOSE_CATCHUP_SKIP   0   // Never run a dose late
+#define DOSE_CATCHUP_LATE   1   // Run the latest missed fire of each schedule
+#define DOSE_CATCHUP_WINDOW 2   // Same, if it is at most doseCatchUpMinutes late
+
 // Encoder
 #define PULSES_PER_DETENT 2
 #define ENCODER_DEBOUNCE_MS 5
@@ -386,8 +346,8 @@ struct SensorData {
 #define MQTT_PUBLISH_INTERVAL 5000
 #define DISPLAY_UPDATE_INTERVAL 50
 #define DAILY_SYNC_CHECK_INTERVAL 60000
-#define LOG_WRITE_INTERVAL 300000
 #define WEB_UPDATE_INTERVAL 1000
+#define OUTLET_CHECK_INTERVAL 1000
 #define FLOAT_CHECK_INTERVAL 500
 #define TOUCH_CHECK_INTERVAL 100
 #define ENCODER_CHECK_INTERVAL 10
@@ -438,35 +398,45 @@ extern unsigned long restartAt;
 extern const char* dayNames[];
 extern const char* dayNamesShort[];
 
-// Menu strings (PROGMEM)
+// Menu strings (PROGMEM), generated from the *_ITEMS lists in MenuTable.h
 extern const char* const mainMenuItems[];
-extern const int mainMenuCount;
 extern const char* const schedulingMenuItems[];
-extern const int schedulingMenuCount;
 extern const char* const dosingScheduleMenu[];
-extern const int dosingScheduleMenuCount;
 extern const char* const dosingConfirmMenu[];
-extern const int dosingConfirmMenuCount;
-// extern const char* const dosingErrorNoDaysMenu[];
-// extern const int dosingErrorNoDaysMenuCount;
 extern const char* const confirmYesNoMenu[];
-extern const int confirmYesNoMenuCount;
 extern const char* const manualDosingMenu[];
-extern const int manualDosingMenuCount;
 extern const char* const outletScheduleMenu[];
-extern const int outletScheduleMenuCount;
 extern const char* const pumpCalibrationMenu[];
-extern const int pumpCalibrationMenuCount;
 extern const char* const calibrateConfirmMenu[];
-extern const int calibrateConfirmMenuCount;
 extern const char* const calibrateSaveMenu[];
-extern const int calibrateSaveMenuCount;
 extern const char* const topupMenu[];
-extern const int topupMenuCount;
 extern const char* const replaceMenu[];
-extern const int replaceMenuCount;
 extern const char* const daySelectMenuItems[];
-extern const int daySelectMenuCount;
+
+// Item counts (compile-time, usable in static_assert)
+constexpr int mainMenuCount             = 0 MAIN_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int schedulingMenuCount       = 0 SCHEDULING_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int dosingScheduleMenuCount   = 0 DOSING_SCHEDULE_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int dosingConfirmMenuCount    = 0 DOSING_CONFIRM_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int confirmYesNoMenuCount     = 0 CONFIRM_YES_NO_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int manualDosingMenuCount     = 0 MANUAL_DOSING_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int outletScheduleMenuCount   = 0 OUTLET_SCHEDULE_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int pumpCalibrationMenuCount  = 0 PUMP_CALIBRATION_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int calibrateConfirmMenuCount = 0 CALIBRATE_CONFIRM_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int calibrateSaveMenuCount    = 0 CALIBRATE_SAVE_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int topupMenuCount            = 0 TOPUP_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int replaceMenuCount          = 0 REPLACE_MENU_ITEMS(MENU_ITEM_COUNT);
+constexpr int daySelectMenuCount        = 0 DAY_SELECT_MENU_ITEMS(MENU_ITEM_COUNT);
+
+// Per-item navigation targets for menus dispatched straight from the table
+extern const MenuState mainMenuTargets[];
+extern const MenuState schedulingMenuTargets[];
+extern const MenuState dosingScheduleMenuTargets[];
+extern const MenuState manualDosingMenuTargets[];
+extern const MenuState outletScheduleMenuTargets[];
+extern const MenuState pumpCalibrationMenuTargets[];
+extern const MenuState topupMenuTargets[];
+extern const MenuState replaceMenuTargets[];
 
 // Hardware objects
 // Note: WiFiManager objects moved to main.cpp to avoid library conflicts
@@ -484,6 +454,8 @@ extern Preferences preferences;
 extern TaskHandle_t DisplayTaskHandle;
 extern TaskHandle_t SensorTaskHandle;
 extern TaskHandle_t MQTTTaskHandle;
+extern TaskHandle_t TopUpTaskHandle;
+extern TaskHandle_t PersistTaskHandle;
 
 // State variables
 extern Config config;
@@ -533,7 +505,6 @@ extern unsigned long lastMqttPublish;
 extern unsigned long lastDisplayUpdate;
 extern unsigned long lastDailySyncCheck;
 extern unsigned long lastNTPSync;
-extern unsigned long lastLogWrite;
 extern unsigned long lastWebUpdate;
 extern unsigned long lastWifiReconnect;
 extern unsigned long lastStatusBarUpdate;
@@ -0,0 +1,28 @@
+/*
+ * GlyphAtlas.h
+ *
+ * Compile-time glyph atlas for the built-in 5x7 font, used by the canvas
+ * text blitter instead of Adafruit GFX's per-pixel drawChar().
+ */
+
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <Arduino.h>
+
+#define GLYPH_FIRST    0x20   // ' '
+#define GLYPH_LAST     0x7E   // '~'
+#define GLYPH_COUNT    (GLYPH_LAST - GLYPH_FIRST + 1)
+#define GLYPH_WIDTH    5      // Inked columns
+#define GLYPH_ADVANCE  6      // Cell width including the spacing column
+#define GLYPH_HEIGHT   8
+
+extern const uint8_t GLYPH_ATLAS[GLYPH_COUNT][GLYPH_HEIGHT];
+
+// Row bitmap for a character, unknown characters render as '?'
+inline uint8_t glyphRow(char c, uint8_t row) {
+  if (c < GLYPH_FIRST || c > GLYPH_LAST) c = '?';
+  return pgm_read_byte(&GLYPH_ATLAS[c - GLYPH_FIRST][row]);
+}
+
+#endif // GLYPHATLAS_H
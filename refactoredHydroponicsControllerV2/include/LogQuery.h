@@ -0,0 +1,122 @@
+/*
+ * LogQuery.h
+ *
+ * Range queries over the telemetry series for /api/logs. A query picks a
+ * time window, optionally one channel, and a step; the stream seeks to
+ * the window through the ring's per-segment index and produces the
+ * response a chunk at a time, so RAM use does not depend on the size of
+ * the window or of the log.
+ *
+ * step 0 (or under a minute) returns raw records. Otherwise the coarsest
+ * rollup series whose bucket fits in step is read, and its buckets are
+ * merged into windows of step rounded down to a whole number of buckets.
+ * Rollups skipped as unchanged are not filled in (see Telemetry.h).
+ */
+
+#ifndef LOG_QUERY_H
+#define LOG_QUERY_H
+
+#include "Globals.h"
+#include "SensorLog.h"
+
+#define LOG_EXPORT_MAGIC   0x58474C48UL   // "HLGX"
+#define LOG_EXPORT_VERSION 1
+
+enum LogQueryFormat : uint8_t {
+  LOG_FORMAT_CSV,
+  LOG_FORMAT_JSON,
+  LOG_FORMAT_BIN     // LogExportHeader, then SensorLogRecord or SensorRollupRecord
+};
+
+struct LogQuery {
+  uint32_t from;           // Local unix time, inclusive
+  uint32_t to;             // Local unix time, inclusive
+  uint8_t channel;         // SensorLogChannel, 0 for all
+  uint32_t step;           // Seconds, 0 for raw records
+  LogQueryFormat format;
+};
+
+// Start of a format=bin response
+struct LogExportHeader {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t recordSize;     // sizeof(SensorLogRecord) or sizeof(SensorRollupRecord)
+  uint32_t step;           // Effective step, 0 for raw records
+  uint32_t from;
+  uint32_t to;
+};
+
+// ==================================================
+// PARAMETERS
+// ==================================================
+// "csv", "json" or "bin"
+bool logQueryFormatFromName(const char *name, LogQueryFormat &format);
+const char* logQueryContentType(LogQueryFormat format);
+
+// Decimal digits only, up to 2^32 - 1
+bool logQueryParseNumber(const char *text, uint32_t &value);
+
+// Unix seconds, or "YYYY-MM-DD" with an optional " HH:MM:SS" / "THH:MM:SS"
+bool logQueryParseTime(const char *text, uint32_t &unixTime);
+
+// ==================================================
+// STREAM
+// ==================================================
+// Any task; reads never block loop()'s appends. Records appended while
+// the stream runs are included if they fall in the window.
+class LogQueryStream {
+public:
+  explicit LogQueryStream(const LogQuery &query);
+
+  // False if the series holds no records at all
+  bool hasRecords() const { return lastSeq != 0; }
+  SensorLogSeries series() const { return source; }
+  uint32_t step() const { return windowSeconds; }
+
+  // Copy up to maxLen bytes of the response into buffer; 0 once it is done
+  size_t read(uint8_t *buffer, size_t maxLen);
+
+private:
+  struct Window {
+    float min;
+    float max;
+    float sum;
+    uint32_t count;
+  };
+
+  LogQuery query;
+  SensorLogSeries source;
+  uint32_t windowSeconds;
+  RingLogReader reader;
+  uint32_t nextSeq;
+  uint32_t lastSeq;
+
+  uint8_t stage;
+  bool wroteRecord;
+  uint8_t out[SENSOR_LOG_LINE_MAX + 2];   // Room for a JSON separator
+  size_t outLen;
+  size_t outPos;
+
+  // Rollup buckets merged into the current window
+  Window windows[SENSOR_CH_COUNT];
+  uint32_t windowStart;
+  uint8_t flushChannel;          // Next channel to emit while closing a window
+  SensorRollupRecord pending;    // Bucket that closed the window
+  bool hasPending;
+  bool windowOpen;
+  bool ended;                    // Passed the end of the window
+
+  bool seqLeft();
+  bool nextRecord();
+  bool nextRaw();
+  bool nextRollup();
+  bool flushWindow();
+  void addBucket(const SensorRollupRecord &rec);
+  void emitRaw(const SensorLogRecord &rec);
+  void emitRollup(SensorRollupRecord &rec);
+  void emitText(const char *text);
+  void emitHeader();
+  void emitFooter();
+};
+
+#endif // LOG_QUERY_H
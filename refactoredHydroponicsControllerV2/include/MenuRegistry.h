@@ -13,16 +13,17 @@ struct MenuDef {
   const char* title;                 // Title string for generic menus
   const char* const* items;          // PROGMEM item array (nullptr for custom screens)
   int itemCount;                     // number of items (0 for custom screens)
+  const MenuState* targets;          // per-item destination (nullptr => selectFn)
   bool useScrolling;                 // enable scrollOffset logic
 
   MenuDrawFn   drawFn;               // nullptr => use generic draw
   MenuNavFn    navFn;                // nullptr => use default nav
-  MenuSelectFn selectFn;             // nullptr => use legacy select fallback
+  MenuSelectFn selectFn;             // nullptr => targets[], else backMenu
 
-  MenuState backMenu;                // where BACK goes (we'll wire later)
+  MenuState backMenu;                // parent screen
 };
 
-// MENUS[] indexed by MenuState enum order
-extern const MenuDef MENUS[];
+// MENUS[] indexed by MenuState, generated from MENU_TABLE (MenuTable.h)
+extern const MenuDef MENUS[MENU_COUNT];
 
 #endif
@@ -0,0 +1,275 @@
+/*
+ * MenuTable.h
+ *
+ * Single description of the menu tree. MENU_TABLE expands into the
+ * MenuState enum (Globals.h) and the MENUS[] registry (MenuRegistry.cpp),
+ * so the two can no longer drift apart. The *_ITEMS lists expand into the
+ * item strings, their counts and the per-item navigation targets.
+ *
+ * Adding a screen is one row in MENU_TABLE; its draw/nav/select functions
+ * must be declared in MenuRegistry.cpp.
+ */
+
+#ifndef MENU_TABLE_H
+#define MENU_TABLE_H
+
+// ==================================================
+// ITEM LISTS
+// ==================================================
+// X(label, target): target is the screen a press on the item opens, or
+// MENU_NONE where the menu's own selectFn decides.
+
+#define MAIN_MENU_ITEMS(X) \
+  X("Scheduling",        MENU_SCHEDULING) \
+  X("Manual Dosing",     MENU_MANUAL_DOSING) \
+  X("Pump Calibration",  MENU_PUMP_CALIBRATION) \
+  X("Top-up Solution",   MENU_TOPUP_SOLUTION) \
+  X("Replace Solution",  MENU_REPLACE_SOLUTION) \
+  X("Reset WiFi",        MENU_RESET_WIFI_CONFIRM) \
+  X("Factory Reset",     MENU_FACTORY_RESET_CONFIRM)
+
+#define SCHEDULING_MENU_ITEMS(X) \
+  X("Dosing Schedule",   MENU_DOSING_SCHEDULE) \
+  X("Outlet Schedule",   MENU_OUTLET_SCHEDULE) \
+  X("Back",              MENU_MAIN)
+
+#define DOSING_SCHEDULE_MENU_ITEMS(X) \
+  X("View Schedules",    MENU_DOSING_VIEW) \
+  X("Add Schedule",      MENU_DOSING_ADD) \
+  X("Delete Schedule",   MENU_DOSING_DELETE) \
+  X("Delete All",        MENU_DOSING_DELETE_ALL) \
+  X("Back",              MENU_SCHEDULING)
+
+#define DOSING_CONFIRM_MENU_ITEMS(X) \
+  X("Save to EEPROM",    MENU_NONE) \
+  X("Cancel",            MENU_NONE)
+
+#define CONFIRM_YES_NO_MENU_ITEMS(X) \
+  X("Yes",               MENU_NONE) \
+  X("No",                MENU_NONE)
+
+#define MANUAL_DOSING_MENU_ITEMS(X) \
+  X("Select Pump",       MENU_MANUAL_SELECT_PUMP) \
+  X("Set Amount (mL)",   MENU_MANUAL_SET_AMOUNT) \
+  X("Start Dosing",      MENU_NONE) \
+  X("Cancel",            MENU_MAIN)
+
+#define OUTLET_SCHEDULE_MENU_ITEMS(X) \
+  X("View Schedules",    MENU_OUTLET_VIEW) \
+  X("Add Schedule",      MENU_OUTLET_ADD) \
+  X("Delete Schedule",   MENU_OUTLET_DELETE_SELECT) \
+  X("Delete All",        MENU_OUTLET_DELETE_ALL) \
+  X("Back",              MENU_SCHEDULING)
+
+#define PUMP_CALIBRATION_MENU_ITEMS(X) \
+  X("Calibrate Pump 1",  MENU_CALIBRATE_P1) \
+  X("Calibrate Pump 2",  MENU_CALIBRATE_P2) \
+  X("Calibrate Pump 3",  MENU_CALIBRATE_P3) \
+  X("Calibrate Pump 4",  MENU_CALIBRATE_P4) \
+  X("Back",              MENU_MAIN)
+
+#define CALIBRATE_CONFIRM_MENU_ITEMS(X) \
+  X("Start Calibration", MENU_NONE) \
+  X("Cancel",            MENU_PUMP_CALIBRATION)
+
+#define CALIBRATE_SAVE_MENU_ITEMS(X) \
+  X("Save to EEPROM",    MENU_NONE) \
+  X("Cancel",            MENU_NONE)
+
+#define TOPUP_MENU_ITEMS(X) \
+  X("Set Pump Amounts",  MENU_TOPUP_SET_AMOUNTS) \
+  X("Set Fill Relay",    MENU_TOPUP_SET_PUMP_PIN) \
+  X("Auto Top-up",       MENU_NONE) \
+  X("Back",              MENU_MAIN)
+
+#define REPLACE_MENU_ITEMS(X) \
+  X("Set Pump Amounts",  MENU_REPLACE_SET_AMOUNTS) \
+  X("Set Drain Relay",   MENU_REPLACE_SET_DRAIN) \
+  X("Set Fill Relay",    MENU_REPLACE_SET_FILL) \
+  X("Set Schedule",      MENU_REPLACE_SET_SCHEDULE) \
+  X("Auto Replace",      MENU_NONE) \
+  X("Replace Now",       MENU_REPLACE_CONFIRM) \
+  X("Replace Status",    MENU_REPLACE_STATUS) \
+  X("Back",              MENU_MAIN)
+
+#define DAY_SELECT_MENU_ITEMS(X) \
+  X("Sunday",            MENU_NONE) \
+  X("Monday",            MENU_NONE) \
+  X("Tuesday",           MENU_NONE) \
+  X("Wednesday",         MENU_NONE) \
+  X("Thursday",          MENU_NONE) \
+  X("Friday",            MENU_NONE) \
+  X("Saturday",          MENU_NONE) \
+  X("All Days",          MENU_NONE) \
+  X("Weekdays",          MENU_NONE) \
+  X("Weekends",          MENU_NONE) \
+  X("Done",              MENU_NONE)
+
+#define MENU_ITEM_LABEL(label, target)  label,
+#define MENU_ITEM_TARGET(label, target) target,
+#define MENU_ITEM_COUNT(label, target)  + 1
+
+// ==================================================
+// MENU TABLE
+// ==================================================
+// X(id, title, items, itemCount, targets, useScrolling,
+//   drawFn, navFn, selectFn, backMenu)
+//
+// items/targets: nullptr for custom screens. targets: press on item i opens
+// targets[i] (used when selectFn is nullptr). drawFn nullptr: generic list
+// if there are items, otherwise the "screen pending" placeholder. navFn
+// nullptr: default list navigation. selectFn and targets both nullptr: a
+// press goes to backMenu.
+
+// Screen declared but not built yet: placeholder draw, press goes back
+#define MENU_STUB(X, id, title, back) \
+  X(id, title, nullptr, 0, nullptr, false, nullptr, nullptr, nullptr, back)
+
+#define MENU_TABLE(X) \
+  X(MENU_MAIN, "MAIN MENU", \
+    mainMenuItems, mainMenuCount, mainMenuTargets, true, \
+    drawMainMenu, nullptr, nullptr, MENU_MAIN) \
+  \
+  /* Scheduling */ \
+  X(MENU_SCHEDULING, "SCHEDULING", \
+    schedulingMenuItems, schedulingMenuCount, schedulingMenuTargets, true, \
+    nullptr, nullptr, nullptr, MENU_MAIN) \
+  \
+  /* Dosing Schedule */ \
+  X(MENU_DOSING_SCHEDULE, "DOSING SCHEDULE", \
+    dosingScheduleMenu, dosingScheduleMenuCount, dosingScheduleMenuTargets, true, \
+    nullptr, nullptr, selectDosingScheduleMenu, MENU_SCHEDULING) \
+  X(MENU_DOSING_VIEW, "DOSING VIEW", nullptr, 0, nullptr, false, \
+    drawDosingScheduleListScreen, handleDosingViewMenu, selectDosingViewMenu, \
+    MENU_DOSING_SCHEDULE) \
+  X(MENU_DOSING_ADD, "DOSING ADD", nullptr, 0, nullptr, false, \
+    drawScheduleEditorScreen, handleDosingAddMenu, selectDosingAddMenu, \
+    MENU_DOSING_SCHEDULE) \
+  X(MENU_DOSING_ADD_SELECT_DAYS, "SELECT DAYS", nullptr, 0, nullptr, false, \
+    drawDaySelectionScreen, handleDaySelectionMenu, selectDosingAddSelectDaysMenu, \
+    MENU_DOSING_ADD) \
+  X(MENU_DOSING_ADD_SET_TIME, "SET TIME", nullptr, 0, nullptr, false, \
+    drawTimeSelectionScreen, nullptr, selectDosingAddSetTimeMenu, \
+    MENU_DOSING_ADD) \
+  X(MENU_DOSING_ADD_SET_AMOUNT, "SET AMOUNT", nullptr, 0, nullptr, false, \
+    drawAmountSelectionScreen, nullptr, selectDosingAddSetAmountMenu, \
+    MENU_DOSING_ADD) \
+  X(MENU_DOSING_DELETE, "DOSING DELETE", nullptr, 0, nullptr, false, \
+    drawDosingDeleteListScreen, handleDosingDeleteMenu, selectDosingDeleteMenu, \
+    MENU_DOSING_SCHEDULE) \
+  X(MENU_DOSING_DELETE_CONFIRM, "DELETE CONFIRM", nullptr, 0, nullptr, false, \
+    drawDosingDeleteConfirm, handleConfirmMenu, selectDosingDeleteConfirmMenu, \
+    MENU_DOSING_DELETE) \
+  X(MENU_DOSING_DELETE_ALL, "DELETE ALL DOSING", nullptr, 0, nullptr, false, \
+    drawDosingDeleteAllConfirm, handleConfirmMenu, selectDosingDeleteAllMenu, \
+    MENU_DOSING_SCHEDULE) \
+  \
+  /* Outlet Schedule */ \
+  X(MENU_OUTLET_SCHEDULE, "OUTLET SCHEDULE", \
+    outletScheduleMenu, outletScheduleMenuCount, outletScheduleMenuTargets, true, \
+    nullptr, nullptr, nullptr, MENU_SCHEDULING) \
+  X(MENU_OUTLET_VIEW, "OUTLET VIEW", nullptr, 0, nullptr, false, \
+    drawOutletScheduleListScreen, handleOutletViewMenu, selectOutletViewMenu, \
+    MENU_OUTLET_SCHEDULE) \
+  X(MENU_OUTLET_ADD, "OUTLET ADD", nullptr, 0, nullptr, false, \
+    drawOutletEditorScreen, handleOutletAddMenu, selectOutletAddMenu, \
+    MENU_OUTLET_SCHEDULE) \
+  X(MENU_OUTLET_ADD_SELECT_DAYS, "SELECT DAYS", nullptr, 0, nullptr, false, \
+    drawDaySelectionScreen, handleDaySelectionMenu, selectOutletAddSelectDaysMenu, \
+    MENU_OUTLET_ADD) \
+  MENU_STUB(X, MENU_OUTLET_ADD_VALUES, "OUTLET VALUES", MENU_OUTLET_ADD) \
+  MENU_STUB(X, MENU_OUTLET_ADD_CONFIRM, "OUTLET ADD CONFIRM", MENU_OUTLET_ADD) \
+  X(MENU_OUTLET_DELETE, "OUTLET DELETE", nullptr, 0, nullptr, false, \
+    drawOutletScheduleListScreen, nullptr, nullptr, MENU_OUTLET_SCHEDULE) \
+  X(MENU_OUTLET_DELETE_SELECT, "OUTLET DELETE SELECT", nullptr, 0, nullptr, false, \
+    drawOutletScheduleListScreen, handleOutletDeleteMenu, selectOutletDeleteSelectMenu, \
+    MENU_OUTLET_SCHEDULE) \
+  X(MENU_OUTLET_DELETE_CONFIRM, "DELETE OUTLET CONFIRM", nullptr, 0, nullptr, false, \
+    drawOutletDeleteConfirm, handleConfirmMenu, selectOutletDeleteConfirmMenu, \
+    MENU_OUTLET_SCHEDULE) \
+  X(MENU_OUTLET_DELETE_ALL, "DELETE ALL OUTLET", \
+    confirmYesNoMenu, confirmYesNoMenuCount, nullptr, false, \
+    nullptr, nullptr, selectOutletDeleteAllMenu, MENU_OUTLET_SCHEDULE) \
+  X(MENU_OUTLET_DELETE_ALL_CONFIRM, "OUTLET DEL ALL CONF", nullptr, 0, nullptr, false, \
+    drawOutletDeleteAllConfirm, handleConfirmMenu, selectOutletDeleteAllConfirmMenu, \
+    MENU_OUTLET_SCHEDULE) \
+  \
+  /* Manual Dosing */ \
+  X(MENU_MANUAL_DOSING, "MANUAL DOSING", \
+    manualDosingMenu, manualDosingMenuCount, manualDosingMenuTargets, true, \
+    nullptr, nullptr, nullptr, MENU_MAIN) \
+  MENU_STUB(X, MENU_MANUAL_SELECT_PUMP, "MANUAL SELECT PUMP", MENU_MANUAL_DOSING) \
+  MENU_STUB(X, MENU_MANUAL_SET_AMOUNT, "MANUAL SET AMOUNT", MENU_MANUAL_SELECT_PUMP) \
+  MENU_STUB(X, MENU_MANUAL_CONFIRM, "MANUAL CONFIRM", MENU_MANUAL_DOSING) \
+  \
+  /* Pump Calibration */ \
+  X(MENU_PUMP_CALIBRATION, "PUMP CALIBRATION", \
+    pumpCalibrationMenu, pumpCalibrationMenuCount, pumpCalibrationMenuTargets, true, \
+    nullptr, nullptr, selectPumpCalibrationMenu, MENU_MAIN) \
+  X(MENU_CALIBRATE_P1, "CAL P1", nullptr, 0, nullptr, false, \
+    drawCalibrateP1, handleCalibrateMenu, selectCalibrateMenu, MENU_PUMP_CALIBRATION) \
+  X(MENU_CALIBRATE_P1_START, "CAL P1 RUN", nullptr, 0, nullptr, false, \
+    drawCalibrationRunScreen, handleCalibrationRunMenu, selectCalibrationRunMenu, \
+    MENU_CALIBRATE_P1) \
+  X(MENU_CALIBRATE_P1_CONFIRM, "SAVE CALIBRATION P1", \
+    calibrateSaveMenu, calibrateSaveMenuCount, nullptr, false, \
+    nullptr, nullptr, selectCalibrationSaveMenu, MENU_CALIBRATE_P1) \
+  X(MENU_CALIBRATE_P2, "CAL P2", nullptr, 0, nullptr, false, \
+    drawCalibrateP2, handleCalibrateMenu, selectCalibrateMenu, MENU_PUMP_CALIBRATION) \
+  X(MENU_CALIBRATE_P2_START, "CAL P2 RUN", nullptr, 0, nullptr, false, \
+    drawCalibrationRunScreen, handleCalibrationRunMenu, selectCalibrationRunMenu, \
+    MENU_CALIBRATE_P2) \
+  X(MENU_CALIBRATE_P2_CONFIRM, "SAVE CALIBRATION P2", \
+    calibrateSaveMenu, calibrateSaveMenuCount, nullptr, false, \
+    nullptr, nullptr, selectCalibrationSaveMenu, MENU_CALIBRATE_P2) \
+  X(MENU_CALIBRATE_P3, "CAL P3", nullptr, 0, nullptr, false, \
+    drawCalibrateP3, handleCalibrateMenu, selectCalibrateMenu, MENU_PUMP_CALIBRATION) \
+  X(MENU_CALIBRATE_P3_START, "CAL P3 RUN", nullptr, 0, nullptr, false, \
+    drawCalibrationRunScreen, handleCalibrationRunMenu, selectCalibrationRunMenu, \
+    MENU_CALIBRATE_P3) \
+  X(MENU_CALIBRATE_P3_CONFIRM, "SAVE CALIBRATION P3", \
+    calibrateSaveMenu, calibrateSaveMenuCount, nullptr, false, \
+    nullptr, nullptr, selectCalibrationSaveMenu, MENU_CALIBRATE_P3) \
+  X(MENU_CALIBRATE_P4, "CAL P4", nullptr, 0, nullptr, false, \
+    drawCalibrateP4, handleCalibrateMenu, selectCalibrateMenu, MENU_PUMP_CALIBRATION) \
+  X(MENU_CALIBRATE_P4_START, "CAL P4 RUN", nullptr, 0, nullptr, false, \
+    drawCalibrationRunScreen, handleCalibrationRunMenu, selectCalibrationRunMenu, \
+    MENU_CALIBRATE_P4) \
+  X(MENU_CALIBRATE_P4_CONFIRM, "SAVE CALIBRATION P4", \
+    calibrateSaveMenu, calibrateSaveMenuCount, nullptr, false, \
+    nullptr, nullptr, selectCalibrationSaveMenu, MENU_CALIBRATE_P4) \
+  \
+  /* Top-up Solution */ \
+  X(MENU_TOPUP_SOLUTION, "TOP-UP SOLUTION", \
+    topupMenu, topupMenuCount, topupMenuTargets, true, \
+    nullptr, nullptr, selectTopUpMenu, MENU_MAIN) \
+  MENU_STUB(X, MENU_TOPUP_SET_AMOUNTS, "TOPUP AMOUNTS", MENU_TOPUP_SOLUTION) \
+  MENU_STUB(X, MENU_TOPUP_AMOUNTS_CONFIRM, "TOPUP CONFIRM", MENU_TOPUP_SET_AMOUNTS) \
+  MENU_STUB(X, MENU_TOPUP_SET_PUMP_PIN, "TOPUP PUMP PIN", MENU_TOPUP_SOLUTION) \
+  MENU_STUB(X, MENU_TOPUP_PUMP_CONFIRM, "TOPUP PIN CONFIRM", MENU_TOPUP_SET_PUMP_PIN) \
+  \
+  /* Replace Solution */ \
+  X(MENU_REPLACE_SOLUTION, "REPLACE SOLUTION", \
+    replaceMenu, replaceMenuCount, replaceMenuTargets, true, \
+    nullptr, nullptr, selectReplaceMenu, MENU_MAIN) \
+  MENU_STUB(X, MENU_REPLACE_SET_AMOUNTS, "REPLACE AMOUNTS", MENU_REPLACE_SOLUTION) \
+  MENU_STUB(X, MENU_REPLACE_SET_DRAIN, "REPLACE DRAIN", MENU_REPLACE_SOLUTION) \
+  MENU_STUB(X, MENU_REPLACE_SET_FILL, "REPLACE FILL", MENU_REPLACE_SOLUTION) \
+  MENU_STUB(X, MENU_REPLACE_SET_SCHEDULE, "REPLACE SCHEDULE", MENU_REPLACE_SOLUTION) \
+  X(MENU_REPLACE_CONFIRM, "REPLACE CONFIRM", nullptr, 0, nullptr, false, \
+    drawReplaceConfirm, handleConfirmMenu, selectReplaceConfirmMenu, MENU_REPLACE_SOLUTION) \
+  X(MENU_REPLACE_STATUS, "REPLACE STATUS", nullptr, 0, nullptr, false, \
+    drawReplaceStatusScreen, handleReplaceStatusMenu, selectReplaceStatusMenu, \
+    MENU_REPLACE_SOLUTION) \
+  \
+  /* WiFi & Reset */ \
+  MENU_STUB(X, MENU_RESET_WIFI, "RESET WIFI", MENU_MAIN) \
+  X(MENU_RESET_WIFI_CONFIRM, "RESET WIFI CONFIRM", nullptr, 0, nullptr, false, \
+    drawResetWifiConfirm, handleConfirmMenu, selectResetWifiConfirmMenu, MENU_MAIN) \
+  MENU_STUB(X, MENU_FACTORY_RESET, "FACTORY RESET", MENU_MAIN) \
+  X(MENU_FACTORY_RESET_CONFIRM, "FACTORY RESET CONF", nullptr, 0, nullptr, false, \
+    drawFactoryResetConfirm, handleConfirmMenu, selectFactoryResetConfirmMenu, MENU_MAIN)
+
+#define MENU_ROW_ID(id, ...)  id,
+
+#endif // MENU_TABLE_H
@@ -0,0 +1,39 @@
+/*
+ * OutletScheduler.h
+ * 
+ * Drives the relays from the outlet schedules. The relay state is derived
+ * from the current time on every evaluation (level based), so it is right
+ * after a reboot, a clock jump or a schedule edit without waiting for the
+ * next ON/OFF edge.
+ */
+
+#ifndef OUTLET_SCHEDULER_H
+#define OUTLET_SCHEDULER_H
+
+#include "Globals.h"
+
+// ==================================================
+// SCHEDULER
+// ==================================================
+// Call every loop pass; evaluates at most once per OUTLET_CHECK_INTERVAL.
+void updateOutletSchedules(unsigned long currentTime);
+
+// Schedules were added, deleted or edited: re-apply on the next pass.
+// Safe to call from any task.
+void invalidateOutletSchedules();
+
+// ==================================================
+// EVALUATION
+// ==================================================
+// Whether the schedule wants its relay on at secondOfDay (0..86399) on
+// dayOfWeek (0=Sun). Time windows with OFF before ON run past midnight and
+// belong to the day they started.
+//
+// Interval schedules have no on-duration of their own: the relay is on for
+// the first half of every intervalMinutes period and off for the second
+// (a 2h interval is 1h on, 1h off), with periods counted from midnight of
+// an enabled day. The outlet editor shows this split in place of the
+// Time ON/OFF rows.
+bool outletScheduleWantsOn(const OutletSchedule &sched, uint32_t secondOfDay, uint8_t dayOfWeek);
+
+#endif // OUTLET_SCHEDULER_H
@@ -0,0 +1,42 @@
+/*
+ * PagedList.h
+ *
+ * Paged list widget for the schedule lists. The visible rows always hold
+ * a whole page, so moving the selection within a page changes only the
+ * two rows whose highlight moves, and the tile diff sends just those.
+ * Crossing to the next page repaints the list once per page of moves.
+ */
+
+#ifndef PAGEDLIST_H
+#define PAGEDLIST_H
+
+#include "Globals.h"
+#include "FrameCanvas.h"
+
+// Draws one list row into the canvas at y (row background already cleared)
+typedef void (*ListRowFn)(int index, int16_t y, bool selected);
+
+// ==================================================
+// PAGED LIST
+// ==================================================
+// Rows stay in fixed slots rather than shifting by one: a shifted window
+// changes every row, and the tile diff would resend the whole list on each
+// move. The controller's vertical scroll registers cannot help here: the
+// UI runs in rotation 1, where MADCTL swaps rows and columns and those
+// registers move the picture sideways.
+class PagedList {
+public:
+  PagedList(int16_t top, int16_t rowHeight, uint8_t visibleRows);
+
+  // Show the page holding `selected` and draw its rows
+  void draw(int itemCount, int selected, ListRowFn drawRow);
+  int firstVisible() const { return first; }
+
+private:
+  int16_t top;
+  int16_t rowHeight;
+  uint8_t visibleRows;
+  int first;
+};
+
+#endif // PAGEDLIST_H
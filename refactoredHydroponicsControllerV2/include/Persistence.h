@@ -0,0 +1,51 @@
+/*
+ * Persistence.h
+ *
+ * Write-behind NVS saves. Menu handlers mark a section dirty and return at
+ * once; PersistTask writes it after PERSIST_DEBOUNCE_MS without further
+ * edits (or PERSIST_MAX_DELAY_MS after the first one), so a burst of edits
+ * costs one flash write per section.
+ */
+
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include "Globals.h"
+
+#define PERSIST_DEBOUNCE_MS      750
+#define PERSIST_MAX_DELAY_MS     5000    // Continuous editing still saves this often
+#define PERSIST_FLUSH_TIMEOUT_MS 3000    // Longest flushPersistence() waits
+
+// ==================================================
+// SECTIONS
+// ==================================================
+#define PERSIST_SCHEDULES  (1UL << 0)   // Dosing and outlet schedules
+#define PERSIST_PUMP_CAL   (1UL << 1)   // pumpCalibrations
+#define PERSIST_TOPUP      (1UL << 2)   // topUpConfig
+#define PERSIST_REPLACE    (1UL << 3)   // replaceConfig
+#define PERSIST_SECTION_COUNT 4
+
+// Runs on PersistTask once per section after its write; keep it short
+typedef void (*PersistCallback)(uint32_t section, bool ok);
+
+// ==================================================
+// REQUESTS (any task)
+// ==================================================
+// The RAM copy is the truth from here on: the schedulers are told about
+// schedule changes straight away, not when they reach flash. A later
+// request's callback replaces an earlier one for the same section.
+void persistSections(uint32_t sections, PersistCallback done = NULL);
+// One schedule changed: only its scheduler is told, but the save is still
+// the whole PERSIST_SCHEDULES blob
+void persistDosingSchedule(int index, PersistCallback done = NULL);
+void persistOutletSchedule(int index, PersistCallback done = NULL);
+
+// Write everything pending now and wait for it, e.g. before a restart.
+// Returns false on a write error or timeout.
+bool flushPersistence();
+
+// PersistTask only: write what is due, then return how long the task may
+// sleep
+TickType_t updatePersistence(unsigned long currentTime);
+
+#endif // PERSISTENCE_H
@@ -0,0 +1,67 @@
+/*
+ * ReplaceSolution.h
+ *
+ * Reservoir replacement cycle: drain until EMPTY, fill until FULL, dose
+ * replaceConfig.pump1ML..pump4ML one pump at a time, then let the new
+ * solution settle. Runs weekly at replaceConfig.scheduleDay/scheduleHour
+ * when enabled, or on request. Every stage has a time limit, and the stage
+ * is checkpointed to NVS so a reboot picks the cycle up where it stopped.
+ */
+
+#ifndef REPLACE_SOLUTION_H
+#define REPLACE_SOLUTION_H
+
+#include "Globals.h"
+
+// Stage limits in seconds. Timed with millis(); a reboot carries the time
+// already spent over from the RTC checkpoint.
+#define REPLACE_DRAIN_TIMEOUT_S 1800   // Drain relay open, waiting for EMPTY
+#define REPLACE_FILL_TIMEOUT_S 1800    // Fill relay open, waiting for FULL
+#define REPLACE_DOSE_TIMEOUT_S 600     // Per pump, including time queued
+#define REPLACE_SETTLE_S 900           // Mixing time before the cycle ends
+
+#define REPLACE_CHECK_INTERVAL 1000    // ms between stage checks in loop()
+#define REPLACE_BOOT_SETTLE_MS 3000    // Let the float switches debounce before resuming
+
+// ==================================================
+// CYCLE
+// ==================================================
+enum ReplaceStage : uint8_t {
+  REPLACE_IDLE,
+  REPLACE_DRAIN,
+  REPLACE_FILL,
+  REPLACE_DOSE,
+  REPLACE_SETTLE,
+  REPLACE_FAULT     // A stage timed out; relays off until the next manual start
+};
+
+struct ReplaceStatus {
+  ReplaceStage stage;
+  ReplaceStage faultStage;  // REPLACE_FAULT: stage that timed out
+  bool requestPending;      // A request has not been picked up by loop() yet
+  uint8_t dosePump;         // REPLACE_DOSE: pump being dosed
+  uint32_t elapsedS;        // Time in the current stage
+  uint32_t limitS;          // Stage limit, 0 for IDLE / FAULT
+};
+
+// Load the checkpoint; an interrupted cycle resumes from loop() once the
+// float switches have settled. Call from setup() after the RTC is running.
+void initReplaceSolution();
+
+// Requests from the menu or web (any task), carried out by loop()
+void requestReplaceStart();
+void requestReplaceAbort();
+
+// Call from loop(): schedule check, requests and stage transitions
+void updateReplaceSolution(unsigned long currentTime);
+
+ReplaceStatus getReplaceStatus();
+const char* replaceStageName(ReplaceStage stage);
+String getReplaceJSON();
+
+// A cycle is between its start and the end of settling; top-up holds off
+bool isReplaceActive();
+// The cycle drives this relay; outlet schedules leave it alone
+bool replaceOwnsRelay(uint8_t relay);
+
+#endif // REPLACE_SOLUTION_H
@@ -0,0 +1,103 @@
+/*
+ * RingLog.h
+ *
+ * Fixed-size ring of fixed-size records on LittleFS. The ring is split
+ * into segment files of one flash block each. Records are written to a
+ * segment in order from its start (entering a segment truncates it), so
+ * every write is an append: LittleFS copies the rest of a file on a
+ * mid-file write, which would make a single-file ring cost a whole-file
+ * rewrite per record. Records carry a sequence number and a CRC; the
+ * write position is recovered at boot from the highest valid sequence
+ * number, and torn or overwritten records simply fail to read.
+ */
+
+#ifndef RING_LOG_H
+#define RING_LOG_H
+
+#include "Globals.h"
+#include <LittleFS.h>
+
+#define RING_LOG_SEGMENT_BYTES 4096    // One LittleFS block
+#define RING_LOG_RECORD_MAX    64
+#define RING_LOG_SEGMENTS_MAX  32      // Sparse index size: one timestamp per segment
+
+// Every record type starts with these fields and ends with a uint16_t CRC
+// of the bytes before it, with no padding after the CRC
+struct RingLogHead {
+  uint32_t seq;          // 1, 2, 3... in append order
+  uint32_t unixTime;     // Local unix time
+};
+
+// ==================================================
+// RING LOG
+// ==================================================
+class RingLog {
+public:
+  RingLog(const char *dir, uint16_t recordSize, uint16_t segments);
+
+  // Open or create the ring and find the write position. A ring written
+  // with another record size or segment count is started over.
+  bool begin();
+
+  // Set the record's seq and CRC and write it over the oldest record.
+  // One writer only (loop()).
+  bool append(void *record);
+
+  // Drop all records
+  void clear();
+
+  // Sequence numbers of the oldest and newest record that may still be
+  // in the ring; both 0 when it is empty. Once the ring has wrapped it
+  // holds between capacity() - records per segment and capacity()
+  // records. Any task.
+  void span(uint32_t &firstSeq, uint32_t &lastSeq) const;
+
+  // First sequence number worth reading for records at or after
+  // unixTime: the start of the newest segment that begins no later than
+  // it. Assumes records were appended in time order (a clock set back
+  // only makes the seek land early). 0 when the ring is empty. Any task.
+  uint32_t seek(uint32_t unixTime) const;
+
+  uint16_t recordSize() const { return recSize; }
+  uint32_t capacity() const { return (uint32_t)perSegment * segCount; }
+  bool ready() const { return isReady; }
+
+private:
+  friend class RingLogReader;
+
+  const char *dirPath;
+  uint16_t recSize;
+  uint16_t segCount;
+  uint16_t perSegment;
+  volatile uint32_t lastSeq;
+  bool isReady;
+  uint32_t firstTimes[RING_LOG_SEGMENTS_MAX];   // Time of each segment's first record, 0 if empty
+
+  void segmentPath(uint16_t segment, char *buf, size_t size) const;
+  File openForWrite(uint16_t segment, uint32_t offset);
+  bool checkMeta();
+  void writeMeta();
+  void removeSegments();
+  uint32_t scan();
+};
+
+// ==================================================
+// READER
+// ==================================================
+// Keeps the segment it last read open, so walking the ring in order
+// opens each segment once. Any task; readers do not block the writer.
+class RingLogReader {
+public:
+  explicit RingLogReader(const RingLog &log) : ring(log), openSegment(-1) {}
+
+  // False if the record has been overwritten, was never completely
+  // written or fails its CRC
+  bool read(uint32_t seq, void *record);
+
+private:
+  const RingLog &ring;
+  File file;
+  int32_t openSegment;
+};
+
+#endif // RING_LOG_H
@@ -0,0 +1,123 @@
+/*
+ * SensorLog.h
+ *
+ * Telemetry storage under TELEMETRY_DIR, four RingLogs:
+ *   raw     - every change of a channel at full resolution, plus an
+ *             hourly keyframe of all channels (SensorLogRecord)
+ *   minute, hour, day
+ *           - min / max / avg per channel and bucket (SensorRollupRecord)
+ * Telemetry.h fills them. CSV is only made when the log is exported.
+ */
+
+#ifndef SENSOR_LOG_H
+#define SENSOR_LOG_H
+
+#include "Globals.h"
+#include "RingLog.h"
+
+// Raw retention depends on how often the channels change, so no span is
+// guaranteed. Each sampled channel writes at most one record per
+// TELEMETRY_SAMPLE_MS, plus the hourly keyframes:
+//   - all 16 sampled channels changing every second: about 8.5 minutes
+//   - nothing changing (keyframes only, 384 a day): about 21 days
+// Older data survives only in the minute, hour and day rollups.
+#define SENSOR_LOG_RAW_SEGMENTS    32   // 8192 records
+#define SENSOR_LOG_MINUTE_SEGMENTS 28   // 4088 rollups
+#define SENSOR_LOG_HOUR_SEGMENTS   14   // 2044 rollups
+#define SENSOR_LOG_DAY_SEGMENTS    4    // 584 rollups
+#define SENSOR_LOG_LINE_MAX        128  // Longest CSV or JSON line, including the newline
+
+// ==================================================
+// CHANNELS
+// ==================================================
+enum SensorLogChannel : uint8_t {
+  SENSOR_CH_RTC_TEMP = 1,   // DS3231 temperature, °C
+  SENSOR_CH_FLOAT_FULL,     // Float switches, 0 / 1
+  SENSOR_CH_FLOAT_LOW,
+  SENSOR_CH_FLOAT_EMPTY,
+  SENSOR_CH_RELAY1,         // Relays, 0 / 1
+  SENSOR_CH_RELAY2,
+  SENSOR_CH_RELAY3,
+  SENSOR_CH_RELAY4,
+  SENSOR_CH_PUMP1,          // Dosing pump speed, %
+  SENSOR_CH_PUMP2,
+  SENSOR_CH_PUMP3,
+  SENSOR_CH_PUMP4,
+  SENSOR_CH_TOUCH1,         // Touch pads, 0 / 1
+  SENSOR_CH_TOUCH2,
+  SENSOR_CH_TOUCH3,
+  SENSOR_CH_TOUCH4,
+  SENSOR_CH_DOSE1,          // Finished doses, mL delivered (events, not samples)
+  SENSOR_CH_DOSE2,
+  SENSOR_CH_DOSE3,
+  SENSOR_CH_DOSE4
+};
+
+#define SENSOR_CH_SAMPLED SENSOR_CH_TOUCH4   // Channels 1..this are sampled
+#define SENSOR_CH_COUNT   SENSOR_CH_DOSE4
+
+const char* sensorLogChannelName(uint8_t channel);
+// 0 if the name is unknown
+uint8_t sensorLogChannelFromName(const char *name);
+
+// ==================================================
+// RECORDS
+// ==================================================
+enum SensorLogSeries : uint8_t {
+  SENSOR_SERIES_RAW,
+  SENSOR_SERIES_MINUTE,
+  SENSOR_SERIES_HOUR,
+  SENSOR_SERIES_DAY,
+  SENSOR_SERIES_COUNT
+};
+
+struct SensorLogRecord {
+  RingLogHead head;      // unixTime: when the sample was taken
+  float value;
+  uint8_t channel;       // SensorLogChannel
+  uint8_t reserved;
+  uint16_t crc;
+};
+
+struct SensorRollupRecord {
+  RingLogHead head;      // unixTime: start of the bucket
+  float min;
+  float max;
+  float avg;
+  uint32_t count;        // Samples (doses for the dose channels) in the bucket
+  uint8_t channel;
+  uint8_t reserved;
+  uint16_t crc;
+};
+
+// ==================================================
+// LOG
+// ==================================================
+// Open the rings, converting the CSV log of earlier firmware (LOG_FILE).
+// Call once from setup() after initLittleFS().
+bool initSensorLog();
+
+// loop() only
+bool sensorLogAppend(uint8_t channel, float value, uint32_t unixTime);
+bool sensorLogAppendRollup(SensorLogSeries series, SensorRollupRecord &rec);
+
+// Drop all records of every series (loop() only, see requestTelemetryClear)
+void clearSensorLog();
+
+RingLog& sensorLogRing(SensorLogSeries series);
+const char* sensorLogSeriesName(SensorLogSeries series);
+
+// Bucket length of a rollup series; 0 for raw
+uint32_t sensorLogBucketSeconds(SensorLogSeries series);
+
+// Finest rollup series that covers spanSeconds in at most maxPoints
+// buckets per channel (the day series if none does)
+SensorLogSeries sensorLogSeriesFor(uint32_t spanSeconds, uint32_t maxPoints);
+
+// CSV lines and JSON objects; return their length
+size_t sensorLogFormatCsv(const SensorLogRecord &rec, char *buf, size_t size);
+size_t sensorRollupFormatCsv(const SensorRollupRecord &rec, char *buf, size_t size);
+size_t sensorLogFormatJson(const SensorLogRecord &rec, char *buf, size_t size);
+size_t sensorRollupFormatJson(const SensorRollupRecord &rec, char *buf, size_t size);
+
+#endif // SENSOR_LOG_H
@@ -28,18 +28,20 @@ bool saveConfigToLittleFS();
 // ==================================================
 // PREFERENCES (EEPROM) STORAGE
 // ==================================================
+// The save functions write synchronously and return false on a write
+// error; menus go through Persistence.h instead.
+// Schedules are kept as one versioned, CRC-checked blob, so any edit
+// rewrites the whole blob; saves that would not change what is stored are
+// skipped.
 void loadSchedulesFromStorage();
-void saveSchedulesToStorage();
+bool saveSchedulesToStorage();
 void loadPumpCalibrationsFromStorage();
-void savePumpCalibrationsToStorage();
+bool savePumpCalibrationsToStorage();
 void loadTopUpConfigFromStorage();
-void saveTopUpConfigToStorage();
+bool saveTopUpConfigToStorage();
 void loadReplaceConfigFromStorage();
-void saveReplaceConfigToStorage();
-
-// ==================================================
-// LOGGING
-// ==================================================
-void logSensorData();
+bool saveReplaceConfigToStorage();
+bool loadReplaceProgressFromStorage(ReplaceProgress &progress);
+void saveReplaceProgressToStorage(const ReplaceProgress &progress);
 
 #endif // STORAGE_H
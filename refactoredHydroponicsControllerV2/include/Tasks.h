@@ -2,7 +2,10 @@
  * Tasks.h
  * 
  * FreeRTOS task definitions for dual-core operation.
- * DisplayTask runs on Core 1, SensorTask runs on Core 1.
+ * DisplayTask, SensorTask, TopUpTask and PersistTask run on Core 1.
+ * SensorTask is the only task that talks to the RTC (see TimeService.h).
+ * DisplayTask sleeps until a display event is posted to it, and is the only
+ * task that draws once started.
  */
 
 #ifndef TASKS_H
@@ -12,11 +15,27 @@
 #include "Hardware.h"
 #include "DisplayUI.h"
 
+// ==================================================
+// DISPLAY EVENTS
+// ==================================================
+// Bits in DisplayTask's notification value. Posting is cheap and coalescing:
+// several encoder steps before the task wakes are handled in one pass.
+#define DISPLAY_EVT_ENCODER  (1UL << 0)   // Encoder position changed (ISR)
+#define DISPLAY_EVT_BUTTON   (1UL << 1)   // Encoder button pressed
+#define DISPLAY_EVT_STATUS   (1UL << 2)   // WiFi / MQTT / NTP / dosing state changed
+#define DISPLAY_EVT_CLOCK    (1UL << 3)   // One-second clock tick
+#define DISPLAY_EVT_COMMAND  (1UL << 4)   // Draw command queued (DisplayQueue)
+
+void postDisplayEvent(uint32_t events);
+void IRAM_ATTR postDisplayEventFromISR(uint32_t events);
+
 // ==================================================
 // TASK FUNCTIONS
 // ==================================================
 void DisplayTask(void *parameter);
 void SensorTask(void *parameter);
+void TopUpTask(void *parameter);
+void PersistTask(void *parameter);
 
 // ==================================================
 // TASK INITIALIZATION
@@ -0,0 +1,34 @@
+/*
+ * Telemetry.h
+ *
+ * Recorder behind SensorLog.h. Once a second loop() samples the float
+ * switches, relays, pump speeds, touch pads and RTC temperature:
+ *   - a raw record is written only when a channel changes, plus a
+ *     keyframe of every channel at boot and each TELEMETRY_KEYFRAME_S
+ *   - min / max / avg are accumulated in RAM per channel and written to
+ *     the minute, hour and day series as their buckets close
+ * A rollup of a channel that held one value, the same value as its
+ * previous rollup in that series, is skipped: a missing bucket means
+ * "unchanged". It is written anyway every TELEMETRY_ROLLUP_KEYFRAME
+ * buckets. Buckets still open at a power cut are lost.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "Globals.h"
+
+#define TELEMETRY_SAMPLE_MS       1000
+#define TELEMETRY_KEYFRAME_S      3600   // Raw keyframe of all channels
+#define TELEMETRY_ROLLUP_KEYFRAME 60     // Buckets between unchanged rollups
+
+// loop() only. Records nothing while logging is off or the time is invalid.
+void updateTelemetry(unsigned long currentTime);
+
+// Any task; loop() drops every series on its next pass
+void requestTelemetryClear();
+
+// A finished dose (loop() only)
+void telemetryRecordDose(uint8_t pumpNumber, float ml);
+
+#endif // TELEMETRY_H
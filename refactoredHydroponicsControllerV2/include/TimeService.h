@@ -0,0 +1,45 @@
+/*
+ * TimeService.h
+ *
+ * Cached DS3231 time and temperature. SensorTask is the only task that
+ * talks to the RTC: it reads the time once a second and the temperature
+ * every TIME_TEMP_INTERVAL_MS, and publishes a snapshot that any task or
+ * core copies under a short spinlock, without I2C traffic. Between reads
+ * the time runs on from esp_timer, so readers also get sub-second
+ * resolution.
+ */
+
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include "Globals.h"
+
+#define TIME_REFRESH_INTERVAL_MS 1000
+#define TIME_TEMP_INTERVAL_MS 10000    // The DS3231 converts every 64 s anyway
+#define TIME_EDGE_WAIT_MS 1100         // Longest initTimeService() waits for a seconds tick
+
+// ==================================================
+// SERVICE
+// ==================================================
+// Call once from setup() after rtc.begin(), before anything reads the
+// time. Waits for the RTC's seconds to tick so the sub-second phase is
+// known.
+void initTimeService();
+
+// SensorTask only: re-read the RTC when due and apply a pending set
+void updateTimeService(unsigned long currentTime);
+
+// Set the RTC (NTP, web). timeNow() serves the new time at once; the chip
+// itself is written on SensorTask's next pass. Any task.
+void setRtcTime(const DateTime &time);
+
+// ==================================================
+// READERS (any task, never wait on I2C)
+// ==================================================
+// Current local time; invalid if the RTC was never read successfully
+DateTime timeNow();
+// Milliseconds since the unix epoch (local time), 0 when invalid
+uint64_t timeNowMs();
+float rtcTemperature();
+
+#endif // TIME_SERVICE_H
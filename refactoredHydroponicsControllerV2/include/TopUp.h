@@ -0,0 +1,57 @@
+/*
+ * TopUp.h
+ *
+ * Reservoir top-up from the float switches. When the LOW switch trips the
+ * fill relay (topUpConfig.fillPumpRelay) opens; when FULL trips it closes
+ * and the configured nutrient volumes (topUpConfig.pump1ML..pump4ML) are
+ * queued on the dosing pumps. TopUpTask sleeps until SensorTask reports a
+ * float switch edge, so an idle reservoir costs nothing. Top-up stands
+ * down while a replace cycle runs.
+ */
+
+#ifndef TOPUP_H
+#define TOPUP_H
+
+#include "Globals.h"
+
+#define TOPUP_MAX_FILL_MS 600000UL   // Failsafe: longest the fill relay may stay open
+
+// ==================================================
+// TOP-UP EVENTS
+// ==================================================
+// Bits in TopUpTask's notification value
+#define TOPUP_EVT_FLOAT   (1UL << 0)   // LOW or FULL changed (debounced)
+#define TOPUP_EVT_CONFIG  (1UL << 1)   // topUpConfig changed, replace cycle started or ended
+
+// Any task; dropped before the task exists
+void postTopUpEvent(uint32_t events);
+
+// ==================================================
+// STATE
+// ==================================================
+enum TopUpState : uint8_t {
+  TOPUP_IDLE,
+  TOPUP_FILLING,   // Fill relay open, waiting for FULL
+  TOPUP_FAULT      // Fill ran TOPUP_MAX_FILL_MS without reaching FULL; relay
+                   // stays off until FULL trips
+};
+
+struct TopUpStatus {
+  TopUpState state;
+  uint8_t relay;            // TOPUP_FILLING: relay being driven
+  unsigned long elapsedMs;  // TOPUP_FILLING: time filled so far
+  unsigned long lastFillMs; // Duration of the last completed fill
+  uint16_t cycles;          // Completed fills since boot
+};
+
+// TopUpTask only: act on the current float levels, then return how long
+// the task may sleep before the failsafe needs checking
+TickType_t updateTopUp(unsigned long currentTime);
+
+TopUpStatus getTopUpStatus();
+const char* topUpStateName(TopUpState state);
+
+// The engine drives this relay; outlet schedules leave it alone
+bool topUpOwnsRelay(uint8_t relay);
+
+#endif // TOPUP_H
@@ -0,0 +1,49 @@
+/*
+ * Adafruit_NeoPixel.h
+ *
+ * Host stand-in for the WS2812B driver: keeps the pixel buffer so the
+ * simulator can report the status LED colour.
+ */
+
+#ifndef SIM_ADAFRUIT_NEOPIXEL_H
+#define SIM_ADAFRUIT_NEOPIXEL_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define NEO_GRB    ((1 << 6) | (1 << 4) | (0 << 2) | (2))
+#define NEO_RGB    ((0 << 6) | (0 << 4) | (1 << 2) | (2))
+#define NEO_KHZ800 0x0000
+#define NEO_KHZ400 0x0100
+
+typedef uint16_t neoPixelType;
+
+class Adafruit_NeoPixel {
+public:
+  Adafruit_NeoPixel(uint16_t n, int16_t pin = 6, neoPixelType type = NEO_GRB + NEO_KHZ800)
+    : pixels(n, 0), pin(pin), brightness(255), shows(0) { (void)type; }
+
+  void begin() { pinMode(pin, OUTPUT); }
+  void show() { shows++; }
+  void clear() { std::fill(pixels.begin(), pixels.end(), 0); }
+  void setBrightness(uint8_t b) { brightness = b; }
+  uint8_t getBrightness() const { return brightness; }
+  uint16_t numPixels() const { return (uint16_t)pixels.size(); }
+
+  void setPixelColor(uint16_t n, uint32_t c) { if (n < pixels.size()) pixels[n] = c; }
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) { setPixelColor(n, Color(r, g, b)); }
+  uint32_t getPixelColor(uint16_t n) const { return n < pixels.size() ? pixels[n] : 0; }
+  uint32_t showCount() const { return shows; }
+
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+
+private:
+  std::vector<uint32_t> pixels;
+  int16_t pin;
+  uint8_t brightness;
+  uint32_t shows;
+};
+
+#endif // SIM_ADAFRUIT_NEOPIXEL_H
@@ -0,0 +1,174 @@
+/*
+ * Arduino.h
+ *
+ * Host stand-in for the ESP32 Arduino core: types, timing, GPIO, LEDC,
+ * interrupt masking, Serial and the ESP object. Pin levels live in a table
+ * that the simulator (Sim.h) drives; interrupts attached with
+ * attachInterrupt() fire when the simulator changes an input pin.
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// ==================================================
+// TYPES AND MACROS
+// ==================================================
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+#define PROGMEM
+#define IRAM_ATTR
+#define PSTR(s) (s)
+#define F(s) ((const __FlashStringHelper*)(s))
+#define pgm_read_byte(addr) (*(const unsigned char*)(addr))
+#define pgm_read_word(addr) (*(const unsigned short*)(addr))
+#define pgm_read_dword(addr) (*(const unsigned long*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define memcpy_P memcpy
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define PULLUP         0x04
+#define INPUT_PULLUP   0x05
+#define PULLDOWN       0x08
+#define INPUT_PULLDOWN 0x09
+
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+
+#define LED_BUILTIN 2
+
+using std::min;
+using std::max;
+using std::abs;
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bit(b) (1UL << (b))
+
+inline char* dtostrf(double val, signed char width, unsigned char prec, char* sout) {
+  sprintf(sout, "%*.*f", width, prec, val);
+  return sout;
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+long random(long howBig);
+long random(long howSmall, long howBig);
+void randomSeed(unsigned long seed);
+
+// ==================================================
+// TIMING
+// ==================================================
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// ==================================================
+// GPIO / LEDC / TOUCH
+// ==================================================
+#define SIM_PIN_COUNT 64
+#define digitalPinToInterrupt(p) (p)
+#define NOT_AN_INTERRUPT -1
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+uint16_t touchRead(uint8_t pin);
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+
+uint32_t ledcSetup(uint8_t channel, uint32_t freq, uint8_t resolutionBits);
+void ledcAttachPin(uint8_t pin, uint8_t channel);
+void ledcWrite(uint8_t channel, uint32_t duty);
+uint32_t ledcRead(uint8_t channel);
+
+// ==================================================
+// SERIAL
+// ==================================================
+#define SERIAL_8N1 0x800001c
+
+// UART0 is the console (stdout); the other UARTs have nothing attached
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int uart) : uartNum(uart) {}
+
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {
+    (void)baud; (void)config; (void)rxPin; (void)txPin;
+  }
+  void end() {}
+  operator bool() const { return true; }
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+  void flush() override;
+
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+
+private:
+  int uartNum;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+// ==================================================
+// ESP OBJECT
+// ==================================================
+class EspClass {
+public:
+  void restart();
+  uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+  uint32_t getFreeHeap();
+  uint32_t getHeapSize() { return 320 * 1024; }
+  uint32_t getFreePsram() { return 8 * 1024 * 1024; }
+  uint32_t getPsramSize() { return 8 * 1024 * 1024; }
+  uint32_t getCpuFreqMHz() { return 240; }
+  const char* getSdkVersion() { return "native-sim"; }
+};
+
+extern EspClass ESP;
+
+// ==================================================
+// TIME (NTP)
+// ==================================================
+#include <time.h>
+void configTime(long gmtOffsetSec, int daylightOffsetSec,
+                const char* server1, const char* server2 = nullptr,
+                const char* server3 = nullptr);
+bool getLocalTime(struct tm* info, uint32_t ms = 5000);
+
+#endif // SIM_ARDUINO_H
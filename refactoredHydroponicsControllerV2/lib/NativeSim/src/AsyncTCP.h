@@ -0,0 +1,13 @@
+/*
+ * AsyncTCP.h
+ *
+ * Host stand-in: the simulated web server never opens sockets, so there is
+ * nothing to declare beyond what ESPAsyncWebServer.h needs.
+ */
+
+#ifndef SIM_ASYNCTCP_H
+#define SIM_ASYNCTCP_H
+
+#include <Arduino.h>
+
+#endif // SIM_ASYNCTCP_H
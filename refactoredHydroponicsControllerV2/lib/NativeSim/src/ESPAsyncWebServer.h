@@ -0,0 +1,239 @@
+/*
+ * ESPAsyncWebServer.h
+ *
+ * Host stand-in for ESPAsyncWebServer. Routes are registered exactly as on
+ * the device; Sim::httpRequest() runs one request through them synchronously
+ * and prints the response, and Sim::wsConnect() attaches a client to the
+ * WebSocket handlers whose frames are printed.
+ */
+
+#ifndef SIM_ESPASYNCWEBSERVER_H
+#define SIM_ESPASYNCWEBSERVER_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+#include "Sim.h"
+
+#ifndef HTTP_ANY
+#define HTTP_ANY     0b01111111
+#define HTTP_GET     0b00000001
+#define HTTP_POST    0b00000010
+#define HTTP_PUT     0b00000100
+#define HTTP_PATCH   0b00001000
+#define HTTP_DELETE  0b00010000
+#define HTTP_OPTIONS 0b00100000
+#endif
+
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+
+// ==================================================
+// RESPONSE
+// ==================================================
+// Fills up to maxLen bytes at stream offset index; 0 ends the response
+typedef std::function<size_t(uint8_t* buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+
+class AsyncWebServerResponse {
+public:
+  AsyncWebServerResponse(int code, const String& contentType, AwsResponseFiller filler)
+    : code(code), contentType(contentType), filler(filler) {}
+
+  void addHeader(const String& name, const String& value) { (void)name; (void)value; }
+  void setCode(int status) { code = status; }
+
+private:
+  friend class AsyncWebServerRequest;
+  int code;
+  String contentType;
+  AwsResponseFiller filler;
+};
+
+// ==================================================
+// REQUEST
+// ==================================================
+class AsyncWebParameter {
+public:
+  AsyncWebParameter(const String& name, const String& value, bool form)
+    : paramName(name), paramValue(value), form(form) {}
+
+  const String& name() const { return paramName; }
+  const String& value() const { return paramValue; }
+  bool isPost() const { return form; }
+  bool isFile() const { return false; }
+
+private:
+  String paramName;
+  String paramValue;
+  bool form;
+};
+
+class AsyncWebServerRequest {
+public:
+  AsyncWebServerRequest(WebRequestMethodComposite method, const String& url)
+    : requestMethod(method), requestUrl(url), code(0) {}
+
+  WebRequestMethodComposite method() const { return requestMethod; }
+  const String& url() const { return requestUrl; }
+
+  size_t params() const { return paramList.size(); }
+  AsyncWebParameter* getParam(size_t index) { return index < paramList.size() ? &paramList[index] : nullptr; }
+  bool hasParam(const String& name, bool post = false, bool file = false) const;
+  AsyncWebParameter* getParam(const String& name, bool post = false, bool file = false);
+  bool hasArg(const char* name) const { return hasParam(name, false) || hasParam(name, true); }
+  String arg(const char* name);
+
+  bool authenticate(const char* username, const char* password) { (void)username; (void)password; return true; }
+  void requestAuthentication(const char* realm = nullptr) { (void)realm; send(401, "text/plain", "Unauthorized"); }
+
+  void send(int code, const String& contentType = String(), const String& content = String());
+  void send(FS& fs, const String& path, const String& contentType = String(), bool download = false);
+  AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller callback) {
+    return new AsyncWebServerResponse(200, contentType, callback);
+  }
+  void send(AsyncWebServerResponse* response);
+  void redirect(const char* url) { send(302, "text/plain", url); }
+
+  // Simulator side
+  void addParam(const String& name, const String& value, bool form) { paramList.emplace_back(name, value, form); }
+  int responseCode() const { return code; }
+  const String& responseType() const { return type; }
+  const std::string& responseBody() const { return body; }
+
+private:
+  WebRequestMethodComposite requestMethod;
+  String requestUrl;
+  std::vector<AsyncWebParameter> paramList;
+  int code;
+  String type;
+  std::string body;
+};
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, const String& filename, size_t index,
+                           uint8_t* data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest* request, uint8_t* data, size_t len,
+                           size_t index, size_t total)> ArBodyHandlerFunction;
+
+// ==================================================
+// HANDLERS
+// ==================================================
+class AsyncWebHandler {
+public:
+  virtual ~AsyncWebHandler() {}
+  virtual bool canHandle(AsyncWebServerRequest* request) { (void)request; return false; }
+  virtual void handleRequest(AsyncWebServerRequest* request) { (void)request; }
+  virtual void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+    (void)request; (void)data; (void)len; (void)index; (void)total;
+  }
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+public:
+  AsyncCallbackWebHandler(const String& uri, WebRequestMethodComposite method,
+                          ArRequestHandlerFunction onRequest, ArBodyHandlerFunction onBody)
+    : uri(uri), method(method), onRequest(onRequest), onBody(onBody) {}
+
+  bool canHandle(AsyncWebServerRequest* request) override {
+    return (request->method() & method) && request->url() == uri;
+  }
+  void handleRequest(AsyncWebServerRequest* request) override { if (onRequest) onRequest(request); }
+  void handleBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) override {
+    if (onBody) onBody(request, data, len, index, total);
+  }
+
+private:
+  String uri;
+  WebRequestMethodComposite method;
+  ArRequestHandlerFunction onRequest;
+  ArBodyHandlerFunction onBody;
+};
+
+// ==================================================
+// WEBSOCKET
+// ==================================================
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+
+class AsyncWebSocket;
+
+class AsyncWebSocketClient {
+public:
+  AsyncWebSocketClient(AsyncWebSocket* server, uint32_t id) : socket(server), clientId(id) {}
+
+  uint32_t id() const { return clientId; }
+  AsyncWebSocket* server() { return socket; }
+  void text(const String& message);
+  void text(const char* message) { text(String(message)); }
+
+private:
+  AsyncWebSocket* socket;
+  uint32_t clientId;
+};
+
+typedef std::function<void(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                           void* arg, uint8_t* data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler {
+public:
+  explicit AsyncWebSocket(const String& url) : socketUrl(url), nextId(1) {}
+
+  const char* url() const { return socketUrl.c_str(); }
+  void onEvent(AwsEventHandler handler) { eventHandler = handler; }
+  size_t count() const { return clients.size(); }
+  void textAll(const String& message);
+  void textAll(const char* message) { textAll(String(message)); }
+  void cleanupClients(uint16_t maxClients = 8) { while (clients.size() > maxClients) clients.pop_front(); }
+  void closeAll() { while (!clients.empty()) disconnectClient(); }
+
+  // Simulator side
+  void connectClient();
+  void disconnectClient();
+
+private:
+  String socketUrl;
+  uint32_t nextId;
+  std::list<AsyncWebSocketClient> clients;
+  AwsEventHandler eventHandler;
+};
+
+// ==================================================
+// SERVER
+// ==================================================
+class AsyncWebServer {
+public:
+  explicit AsyncWebServer(uint16_t port);
+  ~AsyncWebServer();
+
+  void begin() { running = true; }
+  void end() { running = false; }
+  void reset() { handlers.clear(); notFound = nullptr; }
+
+  AsyncCallbackWebHandler& on(const char* uri, WebRequestMethodComposite method,
+                              ArRequestHandlerFunction onRequest,
+                              ArUploadHandlerFunction onUpload = nullptr,
+                              ArBodyHandlerFunction onBody = nullptr);
+  AsyncCallbackWebHandler& on(const char* uri, ArRequestHandlerFunction onRequest) {
+    return on(uri, HTTP_ANY, onRequest);
+  }
+  void onNotFound(ArRequestHandlerFunction fn) { notFound = fn; }
+  AsyncWebHandler& addHandler(AsyncWebHandler* handler);
+
+  // Simulator side: run one request through the routes
+  void handle(AsyncWebServerRequest* request, const std::string& body);
+  bool isRunning() const { return running; }
+  const std::vector<AsyncWebHandler*>& handlerList() const { return handlers; }
+
+private:
+  uint16_t port;
+  bool running;
+  std::vector<AsyncWebHandler*> handlers;
+  std::vector<std::unique_ptr<AsyncCallbackWebHandler>> owned;
+  ArRequestHandlerFunction notFound;
+};
+
+#endif // SIM_ESPASYNCWEBSERVER_H
@@ -0,0 +1,35 @@
+/*
+ * LittleFS.h
+ *
+ * Host stand-in for the ESP32 LittleFS mount: <Sim::dataDir()>/fs is the
+ * partition. Size accounting follows LittleFS (4 KB blocks, default
+ * partition size) so the firmware's usage checks behave as on the device.
+ */
+
+#ifndef SIM_LITTLEFS_H
+#define SIM_LITTLEFS_H
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+  LittleFSFS() : FS("fs"), mounted(false) {}
+
+  bool begin(bool formatOnFail = false, const char* basePath = "/littlefs",
+             uint8_t maxOpenFiles = 10, const char* partitionLabel = "spiffs");
+  void end() { mounted = false; }
+  bool format();
+  size_t totalBytes();
+  size_t usedBytes();
+
+private:
+  bool mounted;
+};
+
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
+
+#endif // SIM_LITTLEFS_H
@@ -0,0 +1,79 @@
+/*
+ * Preferences.h
+ *
+ * Host stand-in for the ESP32 Preferences (NVS) library. Every namespace is
+ * one file under <Sim::dataDir()>/nvs/ and all Preferences objects share
+ * one in-memory copy, like the NVS partition. Writes go to disk at once.
+ * NVS limits that bite on the device are kept: 15 character namespace and
+ * key names, writes refused on a read-only handle.
+ */
+
+#ifndef SIM_PREFERENCES_H
+#define SIM_PREFERENCES_H
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+  Preferences() : open(false), readOnly(true) {}
+  ~Preferences() { end(); }
+
+  bool begin(const char* name, bool readOnly = false, const char* partitionLabel = NULL);
+  void end();
+
+  bool clear();
+  bool remove(const char* key);
+  bool isKey(const char* key);
+
+  size_t putChar(const char* key, int8_t value)        { return putRaw(key, &value, sizeof(value)); }
+  size_t putUChar(const char* key, uint8_t value)      { return putRaw(key, &value, sizeof(value)); }
+  size_t putShort(const char* key, int16_t value)      { return putRaw(key, &value, sizeof(value)); }
+  size_t putUShort(const char* key, uint16_t value)    { return putRaw(key, &value, sizeof(value)); }
+  size_t putInt(const char* key, int32_t value)        { return putRaw(key, &value, sizeof(value)); }
+  size_t putUInt(const char* key, uint32_t value)      { return putRaw(key, &value, sizeof(value)); }
+  size_t putLong(const char* key, int32_t value)       { return putRaw(key, &value, sizeof(value)); }
+  size_t putULong(const char* key, uint32_t value)     { return putRaw(key, &value, sizeof(value)); }
+  size_t putLong64(const char* key, int64_t value)     { return putRaw(key, &value, sizeof(value)); }
+  size_t putULong64(const char* key, uint64_t value)   { return putRaw(key, &value, sizeof(value)); }
+  size_t putFloat(const char* key, float value)        { return putRaw(key, &value, sizeof(value)); }
+  size_t putDouble(const char* key, double value)      { return putRaw(key, &value, sizeof(value)); }
+  size_t putBool(const char* key, bool value)          { uint8_t v = value; return putRaw(key, &v, 1); }
+  size_t putString(const char* key, const char* value);
+  size_t putString(const char* key, const String& value) { return putString(key, value.c_str()); }
+  size_t putBytes(const char* key, const void* value, size_t len) { return putRaw(key, value, len); }
+
+  int8_t getChar(const char* key, int8_t def = 0)            { return getValue(key, def); }
+  uint8_t getUChar(const char* key, uint8_t def = 0)         { return getValue(key, def); }
+  int16_t getShort(const char* key, int16_t def = 0)         { return getValue(key, def); }
+  uint16_t getUShort(const char* key, uint16_t def = 0)      { return getValue(key, def); }
+  int32_t getInt(const char* key, int32_t def = 0)           { return getValue(key, def); }
+  uint32_t getUInt(const char* key, uint32_t def = 0)        { return getValue(key, def); }
+  int32_t getLong(const char* key, int32_t def = 0)          { return getValue(key, def); }
+  uint32_t getULong(const char* key, uint32_t def = 0)       { return getValue(key, def); }
+  int64_t getLong64(const char* key, int64_t def = 0)        { return getValue(key, def); }
+  uint64_t getULong64(const char* key, uint64_t def = 0)     { return getValue(key, def); }
+  float getFloat(const char* key, float def = NAN)           { return getValue(key, def); }
+  double getDouble(const char* key, double def = NAN)        { return getValue(key, def); }
+  bool getBool(const char* key, bool def = false)            { return getValue<uint8_t>(key, def) != 0; }
+  size_t getString(const char* key, char* value, size_t maxLen);
+  String getString(const char* key, String def = String());
+  size_t getBytesLength(const char* key);
+  size_t getBytes(const char* key, void* buf, size_t maxLen);
+
+  size_t freeEntries();
+
+private:
+  char ns[16];
+  bool open;
+  bool readOnly;
+
+  size_t putRaw(const char* key, const void* value, size_t len);
+  bool getRaw(const char* key, void* out, size_t len);
+
+  template <typename T> T getValue(const char* key, T def) {
+    T value;
+    return getRaw(key, &value, sizeof(T)) ? value : def;
+  }
+};
+
+#endif // SIM_PREFERENCES_H
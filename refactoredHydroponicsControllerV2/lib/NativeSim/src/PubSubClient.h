@@ -0,0 +1,59 @@
+/*
+ * PubSubClient.h
+ *
+ * Host stand-in for the PubSubClient MQTT client. connect() succeeds while
+ * the simulated network is up. Published messages are counted (and printed
+ * with Sim::setMqttEcho); Sim::injectMqtt() queues an incoming message that
+ * the next loop() hands to the callback if the topic was subscribed.
+ */
+
+#ifndef SIM_PUBSUBCLIENT_H
+#define SIM_PUBSUBCLIENT_H
+
+#include <Arduino.h>
+#include <functional>
+#include <set>
+#include "WiFi.h"
+
+#define MQTT_CONNECTION_TIMEOUT -4
+#define MQTT_CONNECTION_LOST    -3
+#define MQTT_CONNECT_FAILED     -2
+#define MQTT_DISCONNECTED       -1
+#define MQTT_CONNECTED           0
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char*, uint8_t*, unsigned int)> callback
+
+class PubSubClient {
+public:
+  PubSubClient() : client(nullptr), isConnected(false), port(0) {}
+  explicit PubSubClient(Client& c) : client(&c), isConnected(false), port(0) {}
+
+  PubSubClient& setClient(Client& c) { client = &c; return *this; }
+  PubSubClient& setServer(const char* domain, uint16_t p) { broker = domain ? domain : ""; port = p; return *this; }
+  PubSubClient& setCallback(MQTT_CALLBACK_SIGNATURE) { this->callback = callback; return *this; }
+  bool setBufferSize(uint16_t size) { (void)size; return true; }
+  PubSubClient& setKeepAlive(uint16_t seconds) { (void)seconds; return *this; }
+  PubSubClient& setSocketTimeout(uint16_t seconds) { (void)seconds; return *this; }
+
+  bool connect(const char* id) { return connect(id, nullptr, nullptr); }
+  bool connect(const char* id, const char* user, const char* pass);
+  void disconnect() { isConnected = false; subscriptions.clear(); }
+  bool connected();
+  int state() { return connected() ? MQTT_CONNECTED : MQTT_DISCONNECTED; }
+  bool loop();
+
+  bool publish(const char* topic, const char* payload, bool retained = false);
+  bool publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained = false);
+  bool subscribe(const char* topic, uint8_t qos = 0);
+  bool unsubscribe(const char* topic);
+
+private:
+  Client* client;
+  bool isConnected;
+  std::string broker;
+  uint16_t port;
+  std::set<std::string> subscriptions;
+  MQTT_CALLBACK_SIGNATURE;
+};
+
+#endif // SIM_PUBSUBCLIENT_H
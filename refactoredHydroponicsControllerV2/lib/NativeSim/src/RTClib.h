@@ -0,0 +1,86 @@
+/*
+ * RTClib.h
+ *
+ * Host stand-in for Adafruit RTClib: DateTime, TimeSpan and an RTC_DS3231
+ * whose chip state lives in the simulator. The simulated DS3231 starts at
+ * the host's local wall-clock time and then runs on the host monotonic
+ * clock; Sim::setClock() jumps it like a battery swap or a bad NTP sync.
+ */
+
+#ifndef SIM_RTCLIB_H
+#define SIM_RTCLIB_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define SECONDS_PER_DAY 86400L
+#define SECONDS_FROM_1970_TO_2000 946684800
+
+class TimeSpan;
+
+class DateTime {
+public:
+  DateTime(uint32_t t = SECONDS_FROM_1970_TO_2000);
+  DateTime(uint16_t year, uint8_t month, uint8_t day,
+           uint8_t hour = 0, uint8_t min = 0, uint8_t sec = 0);
+  DateTime(const DateTime& copy) = default;
+  DateTime& operator=(const DateTime& copy) = default;
+
+  bool isValid() const;
+  uint16_t year() const { return 2000U + yOff; }
+  uint8_t month() const { return m; }
+  uint8_t day() const { return d; }
+  uint8_t hour() const { return hh; }
+  uint8_t twelveHour() const { return hh % 12 == 0 ? 12 : hh % 12; }
+  uint8_t isPM() const { return hh >= 12; }
+  uint8_t minute() const { return mm; }
+  uint8_t second() const { return ss; }
+  uint8_t dayOfTheWeek() const;   // 0 = Sunday
+
+  uint32_t secondstime() const { return unixtime() - SECONDS_FROM_1970_TO_2000; }
+  uint32_t unixtime() const;
+  String timestamp() const;       // YYYY-MM-DDThh:mm:ss
+
+  DateTime operator+(const TimeSpan& span) const;
+  DateTime operator-(const TimeSpan& span) const;
+  TimeSpan operator-(const DateTime& right) const;
+  bool operator<(const DateTime& right) const { return unixtime() < right.unixtime(); }
+  bool operator>(const DateTime& right) const { return right < *this; }
+  bool operator<=(const DateTime& right) const { return !(*this > right); }
+  bool operator>=(const DateTime& right) const { return !(*this < right); }
+  bool operator==(const DateTime& right) const { return unixtime() == right.unixtime(); }
+  bool operator!=(const DateTime& right) const { return !(*this == right); }
+
+protected:
+  uint8_t yOff, m, d, hh, mm, ss;
+};
+
+class TimeSpan {
+public:
+  TimeSpan(int32_t seconds = 0) : _seconds(seconds) {}
+  TimeSpan(int16_t days, int8_t hours, int8_t minutes, int8_t seconds)
+    : _seconds((int32_t)days * 86400L + (int32_t)hours * 3600 + (int32_t)minutes * 60 + seconds) {}
+
+  int16_t days() const { return _seconds / 86400L; }
+  int8_t hours() const { return _seconds / 3600 % 24; }
+  int8_t minutes() const { return _seconds / 60 % 60; }
+  int8_t seconds() const { return _seconds % 60; }
+  int32_t totalseconds() const { return _seconds; }
+
+  TimeSpan operator+(const TimeSpan& right) const { return TimeSpan(_seconds + right._seconds); }
+  TimeSpan operator-(const TimeSpan& right) const { return TimeSpan(_seconds - right._seconds); }
+
+protected:
+  int32_t _seconds;
+};
+
+class RTC_DS3231 {
+public:
+  bool begin(TwoWire* wireInstance = &Wire);
+  void adjust(const DateTime& dt);
+  bool lostPower(void);
+  DateTime now();
+  float getTemperature();
+};
+
+#endif // SIM_RTCLIB_H
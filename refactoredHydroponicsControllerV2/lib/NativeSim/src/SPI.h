@@ -0,0 +1,76 @@
+/*
+ * SPI.h
+ *
+ * Host stand-in for the Arduino SPI bus. The panel is simulated above the
+ * bus (TFT_ILI9163C.h), so transfers are discarded; the class exists for
+ * the firmware's SPI.begin() and for Adafruit_GFX/BusIO. It tracks whether
+ * the host is begun and counts the bytes written to a host that is not
+ * (see Sim::spiBytesLost()).
+ */
+
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum { LSBFIRST = 0, MSBFIRST = 1 } BitOrder;
+
+#define SPI_HAS_TRANSACTION
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x01
+#define SPI_MODE2 0x02
+#define SPI_MODE3 0x03
+
+class SPISettings {
+public:
+  SPISettings() : clock(1000000), bitOrder(MSBFIRST), dataMode(SPI_MODE0) {}
+  SPISettings(uint32_t clock, BitOrder bitOrder, uint8_t dataMode)
+    : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {}
+  SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+    : clock(clock), bitOrder((BitOrder)bitOrder), dataMode(dataMode) {}
+
+  uint32_t clock;
+  BitOrder bitOrder;
+  uint8_t dataMode;
+};
+
+class SPIClass {
+public:
+  SPIClass() : begun(false), lost(0) {}
+
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {
+    (void)sck; (void)miso; (void)mosi; (void)ss;
+    begun = true;
+  }
+  void end() { begun = false; }
+  void beginTransaction(SPISettings settings) { (void)settings; }
+  void endTransaction() {}
+  void setFrequency(uint32_t freq) { (void)freq; }
+  void setDataMode(uint8_t mode) { (void)mode; }
+  void setBitOrder(uint8_t order) { (void)order; }
+
+  uint8_t transfer(uint8_t data) { (void)data; send(1); return 0; }
+  uint16_t transfer16(uint16_t data) { (void)data; send(2); return 0; }
+  uint32_t transfer32(uint32_t data) { (void)data; send(4); return 0; }
+  void transfer(void* buffer, size_t size) { (void)buffer; send(size); }
+  void write(uint8_t data) { (void)data; send(1); }
+  void write16(uint16_t data) { (void)data; send(2); }
+  void write32(uint32_t data) { (void)data; send(4); }
+  void writeBytes(const uint8_t* data, uint32_t size) { (void)data; send(size); }
+  void writePixels(const void* data, uint32_t size) { (void)data; send(size); }
+
+  bool isBegun() const { return begun; }
+  uint32_t bytesLost() const { return lost; }
+
+private:
+  bool begun;
+  uint32_t lost;       // Written while the host was not begun
+
+  void send(size_t bytes) { if (!begun) lost += bytes; }
+};
+
+extern SPIClass SPI;
+
+#endif // SIM_SPI_H
@@ -0,0 +1,64 @@
+/*
+ * Sim.h
+ *
+ * Control surface of the host simulator: the script runner (SimMain.cpp)
+ * uses it to drive inputs and inspect outputs of the unmodified firmware.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+namespace Sim {
+
+// Root of the host-side NVS and LittleFS images (default "sim_data")
+const char* dataDir();
+void setDataDir(const char* path);
+
+// GPIO: drive an input level (fires attached interrupts on a matching edge)
+void setInput(uint8_t pin, int level);
+int pinLevel(uint8_t pin);
+uint32_t ledcDuty(uint8_t channel);
+
+// DS3231: set to a local unix time, or make begin() fail (chip missing)
+void setClock(uint32_t unixtime);
+void setRtcPresent(bool present);
+
+// Network link seen by WiFi/PubSubClient (up by default)
+void setNetwork(bool up);
+bool networkUp();
+
+// MQTT broker: queue a message for subscribers, echo publishes to stdout
+void injectMqtt(const char* topic, const char* payload);
+void setMqttEcho(bool on);
+uint32_t mqttPublished();
+
+// Web: run one request through the started servers ("a=1&b=2" params are
+// form fields for POST, query otherwise), print the response and return
+// its status code; attach a WebSocket client whose frames are printed
+int httpRequest(const char* method, const char* uri, const char* params, const char* body);
+void wsConnect(const char* url);
+
+// Rotary encoder on the given pins: steps > 0 turns towards
+// encoderPosition++, each step is edgesPerStep quadrature edges
+void turnEncoder(uint8_t clkPin, uint8_t dtPin, int steps,
+                 uint8_t edgesPerStep, uint32_t edgeMs);
+
+// SPI host: whether the Arduino driver has it begun, whether the IDF SPI
+// master driver holds the bus, and bytes written through the Arduino
+// driver while it was not begun (a dead bus on the board). Setup of the
+// IDF bus or device can be made to fail.
+bool spiBegun();
+bool spiBusHeld();
+uint32_t spiBytesLost();
+void setSpiMasterFailure(bool busInit, bool addDevice);
+
+// Save what the panel shows (rotation and scroll applied); a .png path
+// writes PNG, anything else binary PPM
+bool writeFrame(const char* path);
+uint32_t framePixelsPushed();
+
+}  // namespace Sim
+
+#endif // SIM_H
@@ -0,0 +1,265 @@
+/*
+ * SimCore.cpp
+ *
+ * Host implementation of the Arduino core: clock, pins, interrupts, LEDC,
+ * Serial, ESP and NTP time.
+ */
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+#include "Sim.h"
+#include "esp_timer.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+EspClass ESP;
+SPIClass SPI;
+TwoWire Wire;
+
+static const auto bootTime = std::chrono::steady_clock::now();
+static std::string simDataDir = "sim_data";
+
+// ==================================================
+// TIMING
+// ==================================================
+unsigned long millis() {
+  return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - bootTime).count();
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - bootTime).count();
+}
+
+int64_t esp_timer_get_time() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - bootTime).count();
+}
+
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+// loop() ends in yield(); sleeping here keeps the loop task from spinning
+// a host core at 100%
+void yield() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+  if (inMax == inMin) return outMin;
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+long random(long howBig) { return howBig > 0 ? rand() % howBig : 0; }
+long random(long howSmall, long howBig) {
+  return howBig > howSmall ? howSmall + random(howBig - howSmall) : howSmall;
+}
+void randomSeed(unsigned long seed) { srand((unsigned)seed); }
+
+// ==================================================
+// GPIO AND INTERRUPTS
+// ==================================================
+// Interrupt masking is one recursive lock: the simulator holds it while it
+// runs an ISR, so noInterrupts() sections exclude ISRs as on one core.
+static std::recursive_mutex interruptLock;
+
+struct SimPin {
+  uint8_t mode;
+  uint8_t level;
+  void (*isr)(void);
+  int isrMode;
+};
+
+static SimPin pins[SIM_PIN_COUNT];
+static uint32_t ledcDuties[16];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= SIM_PIN_COUNT) return;
+  pins[pin].mode = mode;
+  if (mode == INPUT_PULLUP) pins[pin].level = HIGH;
+  if (mode == INPUT_PULLDOWN) pins[pin].level = LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < SIM_PIN_COUNT) pins[pin].level = value ? HIGH : LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < SIM_PIN_COUNT ? pins[pin].level : LOW;
+}
+
+int analogRead(uint8_t pin) {
+  return digitalRead(pin) ? 4095 : 0;
+}
+
+// Untouched pads read high; the firmware treats a drop below its
+// threshold as a touch
+uint16_t touchRead(uint8_t pin) {
+  return digitalRead(pin) ? 10 : 100;
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(void), int mode) {
+  if (pin >= SIM_PIN_COUNT) return;
+  std::lock_guard<std::recursive_mutex> guard(interruptLock);
+  pins[pin].isr = isr;
+  pins[pin].isrMode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  attachInterrupt(pin, nullptr, 0);
+}
+
+void noInterrupts() { interruptLock.lock(); }
+void interrupts() { interruptLock.unlock(); }
+
+uint32_t ledcSetup(uint8_t channel, uint32_t freq, uint8_t resolutionBits) {
+  (void)channel; (void)resolutionBits;
+  return freq;
+}
+
+void ledcAttachPin(uint8_t pin, uint8_t channel) { (void)pin; (void)channel; }
+
+void ledcWrite(uint8_t channel, uint32_t duty) {
+  if (channel < 16) ledcDuties[channel] = duty;
+}
+
+uint32_t ledcRead(uint8_t channel) {
+  return channel < 16 ? ledcDuties[channel] : 0;
+}
+
+// ==================================================
+// SERIAL / ESP
+// ==================================================
+size_t HardwareSerial::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  if (uartNum != 0) return size;
+  return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush() { fflush(stdout); }
+
+void EspClass::restart() {
+  Serial.println("[SIM] ESP.restart()");
+  fflush(stdout);
+  _exit(0);   // Other tasks are still running; skip static destructors
+}
+
+uint32_t EspClass::getFreeHeap() { return 200 * 1024; }
+
+// ==================================================
+// NTP
+// ==================================================
+static long ntpOffsetSec = 0;
+static bool ntpConfigured = false;
+
+void configTime(long gmtOffsetSec, int daylightOffsetSec,
+                const char* server1, const char* server2, const char* server3) {
+  (void)server1; (void)server2; (void)server3;
+  ntpOffsetSec = gmtOffsetSec + daylightOffsetSec;
+  ntpConfigured = true;
+}
+
+// Host wall clock stands in for the NTP server
+bool getLocalTime(struct tm* info, uint32_t ms) {
+  (void)ms;
+  if (!ntpConfigured || !Sim::networkUp()) return false;
+  time_t now = time(nullptr) + ntpOffsetSec;
+  gmtime_r(&now, info);
+  return true;
+}
+
+// ==================================================
+// PRINT
+// ==================================================
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::print(const Printable& p) { return p.printTo(*this); }
+
+size_t Print::strlenSafe(const char* s) { return strlen(s); }
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0) return 0;
+  if ((size_t)len < sizeof(buf)) return write((const uint8_t*)buf, len);
+
+  std::string big(len + 1, '\0');
+  va_start(args, format);
+  vsnprintf(&big[0], big.size(), format, args);
+  va_end(args);
+  return write((const uint8_t*)big.data(), len);
+}
+
+// ==================================================
+// SIMULATOR CONTROL
+// ==================================================
+namespace Sim {
+
+static bool network = true;
+
+const char* dataDir() { return simDataDir.c_str(); }
+void setDataDir(const char* path) { simDataDir = path; }
+
+void setInput(uint8_t pin, int level) {
+  if (pin >= SIM_PIN_COUNT) return;
+  std::lock_guard<std::recursive_mutex> guard(interruptLock);
+  uint8_t old = pins[pin].level;
+  pins[pin].level = level ? HIGH : LOW;
+  if (!pins[pin].isr || old == pins[pin].level) return;
+
+  int mode = pins[pin].isrMode;
+  bool rising = pins[pin].level == HIGH;
+  if (mode == CHANGE || (mode == RISING && rising) || (mode == FALLING && !rising)) {
+    pins[pin].isr();
+  }
+}
+
+int pinLevel(uint8_t pin) { return digitalRead(pin); }
+uint32_t ledcDuty(uint8_t channel) { return ledcRead(channel); }
+
+void setNetwork(bool up) { network = up; }
+bool networkUp() { return network; }
+
+// Gray sequence of (DT << 1 | CLK); walking it forwards is what the
+// firmware's ISR counts as encoderPosition++
+void turnEncoder(uint8_t clkPin, uint8_t dtPin, int steps,
+                 uint8_t edgesPerStep, uint32_t edgeMs) {
+  static const uint8_t gray[4] = { 0b00, 0b01, 0b11, 0b10 };
+  static int phase = 0;
+
+  int dir = steps >= 0 ? 1 : -1;
+  for (int e = 0; e < abs(steps) * edgesPerStep; e++) {
+    phase = (phase + dir + 4) % 4;
+    uint8_t code = gray[phase];
+    // One pin changes per edge; setInput ignores the unchanged one
+    setInput(clkPin, code & 0x01);
+    setInput(dtPin, (code >> 1) & 0x01);
+    delay(edgeMs);
+  }
+}
+
+}  // namespace Sim
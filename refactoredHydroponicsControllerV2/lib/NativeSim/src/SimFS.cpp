@@ -0,0 +1,233 @@
+/*
+ * SimFS.cpp
+ *
+ * Host-directory filesystem behind FS/File and LittleFS.
+ */
+
+#include "LittleFS.h"
+#include "Sim.h"
+
+#include <dirent.h>
+#include <ftw.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+fs::LittleFSFS LittleFS;
+
+#define LFS_BLOCK_SIZE 4096
+#define LFS_PARTITION_SIZE 0x160000   // "spiffs" entry of the default partition table
+
+namespace fs {
+
+struct FileImpl {
+  FILE* fp = nullptr;
+  std::string path;                   // Path on the device filesystem
+  std::string host;
+  bool dir = false;
+  std::vector<std::string> entries;   // Directory listing for openNextFile()
+  size_t nextEntry = 0;
+  const FS* owner = nullptr;
+
+  ~FileImpl() { if (fp) fclose(fp); }
+};
+
+// ==================================================
+// FILE
+// ==================================================
+size_t File::write(uint8_t c) { return write(&c, 1); }
+
+size_t File::write(const uint8_t* buf, size_t size) {
+  if (!impl || !impl->fp) return 0;
+  return fwrite(buf, 1, size, impl->fp);
+}
+
+int File::available() {
+  if (!impl || !impl->fp) return 0;
+  return (int)(size() - position());
+}
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t* buf, size_t size) {
+  if (!impl || !impl->fp) return 0;
+  return fread(buf, 1, size, impl->fp);
+}
+
+int File::peek() {
+  if (!impl || !impl->fp) return -1;
+  int c = fgetc(impl->fp);
+  if (c != EOF) ungetc(c, impl->fp);
+  return c == EOF ? -1 : c;
+}
+
+void File::flush() {
+  if (impl && impl->fp) fflush(impl->fp);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!impl || !impl->fp) return false;
+  int whence = mode == SeekCur ? SEEK_CUR : mode == SeekEnd ? SEEK_END : SEEK_SET;
+  return fseek(impl->fp, (long)pos, whence) == 0;
+}
+
+size_t File::position() const {
+  if (!impl || !impl->fp) return 0;
+  long pos = ftell(impl->fp);
+  return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+  if (!impl) return 0;
+  if (impl->fp) fflush(impl->fp);
+  struct stat st;
+  return stat(impl->host.c_str(), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() {
+  impl.reset();
+}
+
+File::operator bool() const {
+  return impl && (impl->fp || impl->dir);
+}
+
+const char* File::path() const { return impl ? impl->path.c_str() : nullptr; }
+
+const char* File::name() const {
+  if (!impl) return nullptr;
+  size_t slash = impl->path.rfind('/');
+  return impl->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool File::isDirectory() const { return impl && impl->dir; }
+
+File File::openNextFile(const char* mode) {
+  if (!impl || !impl->dir || !impl->owner || impl->nextEntry >= impl->entries.size()) return File();
+  std::string base = impl->path == "/" ? "" : impl->path;
+  std::string child = base + "/" + impl->entries[impl->nextEntry++];
+  return const_cast<FS*>(impl->owner)->open(child.c_str(), mode);
+}
+
+void File::rewindDirectory() {
+  if (impl) impl->nextEntry = 0;
+}
+
+// ==================================================
+// FS
+// ==================================================
+std::string FS::hostPath(const char* path) const {
+  std::string p = path ? path : "/";
+  if (p.empty() || p[0] != '/') p = "/" + p;
+  return std::string(Sim::dataDir()) + "/" + root + p;
+}
+
+File FS::open(const char* path, const char* mode, bool create) {
+  (void)create;
+  std::shared_ptr<FileImpl> impl = std::make_shared<FileImpl>();
+  impl->path = path;
+  impl->host = hostPath(path);
+  impl->owner = this;
+
+  struct stat st;
+  if (stat(impl->host.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+    DIR* dir = opendir(impl->host.c_str());
+    if (!dir) return File();
+    while (struct dirent* entry = readdir(dir)) {
+      if (entry->d_name[0] == '.') continue;
+      impl->entries.push_back(entry->d_name);
+    }
+    closedir(dir);
+    impl->dir = true;
+    return File(impl);
+  }
+
+  std::string m = mode ? mode : "r";
+  if (m.find('b') == std::string::npos) m += "b";
+  impl->fp = fopen(impl->host.c_str(), m.c_str());
+  if (!impl->fp) return File();
+  return File(impl);
+}
+
+bool FS::exists(const char* path) {
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char* path) {
+  return unlink(hostPath(path).c_str()) == 0;
+}
+
+bool FS::rename(const char* from, const char* to) {
+  return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0;
+}
+
+bool FS::mkdir(const char* path) {
+  return ::mkdir(hostPath(path).c_str(), 0755) == 0 || exists(path);
+}
+
+bool FS::rmdir(const char* path) {
+  return ::rmdir(hostPath(path).c_str()) == 0;
+}
+
+// ==================================================
+// LITTLEFS
+// ==================================================
+static size_t blocksUsed(const std::string& dirPath) {
+  size_t blocks = 1;   // The directory's own metadata pair
+  DIR* dir = opendir(dirPath.c_str());
+  if (!dir) return 0;
+  while (struct dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') continue;
+    std::string child = dirPath + "/" + entry->d_name;
+    struct stat st;
+    if (stat(child.c_str(), &st) != 0) continue;
+    if (S_ISDIR(st.st_mode)) {
+      blocks += blocksUsed(child);
+    } else {
+      blocks += (st.st_size + LFS_BLOCK_SIZE - 1) / LFS_BLOCK_SIZE;
+    }
+  }
+  closedir(dir);
+  return blocks;
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath,
+                       uint8_t maxOpenFiles, const char* partitionLabel) {
+  (void)basePath; (void)maxOpenFiles; (void)partitionLabel;
+  std::string dir = std::string(Sim::dataDir());
+  ::mkdir(dir.c_str(), 0755);
+  std::string mount = hostPath("/");
+  struct stat st;
+  if (stat(mount.c_str(), &st) != 0) {
+    if (!formatOnFail) return false;
+    if (::mkdir(mount.c_str(), 0755) != 0) return false;
+  }
+  mounted = true;
+  return true;
+}
+
+static int removeEntry(const char* path, const struct stat* st, int flag, struct FTW* ftw) {
+  (void)st; (void)flag; (void)ftw;
+  return ::remove(path);
+}
+
+bool LittleFSFS::format() {
+  nftw(hostPath("/").c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+  return ::mkdir(hostPath("/").c_str(), 0755) == 0;
+}
+
+size_t LittleFSFS::totalBytes() {
+  return LFS_PARTITION_SIZE;
+}
+
+size_t LittleFSFS::usedBytes() {
+  if (!mounted) return 0;
+  return blocksUsed(hostPath("/")) * LFS_BLOCK_SIZE;
+}
+
+}  // namespace fs
@@ -0,0 +1,188 @@
+/*
+ * SimMain.cpp
+ *
+ * Entry point of the native build. Like the ESP32 core, the main thread is
+ * loopTask: it runs setup() and then loop() forever. A second thread reads
+ * the simulation script (file given as argv[1], or stdin) and drives the
+ * inputs one command per line:
+ *
+ *   turn N                  Encoder N detents (negative = other direction)
+ *   press                   Click the encoder button
+ *   wait MS                 Let the firmware run for MS milliseconds
+ *   snap PATH               Save the panel (.png or .ppm)
+ *   time YYYY-MM-DD HH:MM:SS  Set the DS3231
+ *   pin N 0|1               Drive an input pin (float switches, ...)
+ *   wifi 0|1                Bring the network link up or down
+ *   http METHOD URI [k=v&...] [BODY]
+ *   ws URL                  Attach a WebSocket client
+ *   mqtt TOPIC PAYLOAD      Deliver a message to subscribers
+ *   echo 0|1                Print MQTT publishes
+ *   stats                   Print timing and render counters
+ *   quit
+ *
+ * Lines starting with '#' are comments.
+ *
+ * Test builds (pio test -e native) bring their own main() and leave this
+ * file out.
+ */
+
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+#include <RTClib.h>
+#include "Sim.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+#ifndef SIM_ENCODER_CLK
+#define SIM_ENCODER_CLK 4
+#endif
+#ifndef SIM_ENCODER_DT
+#define SIM_ENCODER_DT 15
+#endif
+#ifndef SIM_ENCODER_SW
+#define SIM_ENCODER_SW 5
+#endif
+#ifndef SIM_EDGES_PER_STEP
+#define SIM_EDGES_PER_STEP 2
+#endif
+#ifndef SIM_ENCODER_EDGE_MS
+#define SIM_ENCODER_EDGE_MS 6
+#endif
+
+void setup();
+void loop();
+
+static std::atomic<bool> setupDone(false);
+static std::atomic<uint32_t> loopPasses(0);
+
+static void simSleep(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void printStats() {
+  printf("[sim] t=%lu ms loop passes=%u pixels pushed=%u mqtt published=%u\n",
+         (unsigned long)millis(), (unsigned)loopPasses.load(),
+         (unsigned)Sim::framePixelsPushed(), (unsigned)Sim::mqttPublished());
+}
+
+static void finish(int code) {
+  printStats();
+  fflush(stdout);
+  _exit(code);   // loopTask and the firmware tasks never return
+}
+
+static bool runCommand(const std::string& line) {
+  std::istringstream in(line);
+  std::string cmd;
+  in >> cmd;
+  if (cmd.empty() || cmd[0] == '#') return true;
+
+  if (cmd == "turn") {
+    int steps = 0;
+    in >> steps;
+    Sim::turnEncoder(SIM_ENCODER_CLK, SIM_ENCODER_DT, steps, SIM_EDGES_PER_STEP, SIM_ENCODER_EDGE_MS);
+  } else if (cmd == "press") {
+    Sim::setInput(SIM_ENCODER_SW, LOW);
+    simSleep(50);
+    Sim::setInput(SIM_ENCODER_SW, HIGH);
+    simSleep(250);   // Past the firmware's BUTTON_DEBOUNCE
+  } else if (cmd == "wait") {
+    uint32_t ms = 0;
+    in >> ms;
+    simSleep(ms);
+  } else if (cmd == "snap") {
+    std::string path;
+    in >> path;
+    if (!Sim::writeFrame(path.c_str())) printf("[sim] cannot write %s\n", path.c_str());
+  } else if (cmd == "time") {
+    int y, mo, d, h, mi, s;
+    std::string rest;
+    std::getline(in, rest);
+    if (sscanf(rest.c_str(), " %d-%d-%d %d:%d:%d", &y, &mo, &d, &h, &mi, &s) != 6) {
+      printf("[sim] bad time: %s\n", rest.c_str());
+      return true;
+    }
+    Sim::setClock(DateTime(y, mo, d, h, mi, s).unixtime());
+  } else if (cmd == "pin") {
+    int pin = -1, level = 0;
+    in >> pin >> level;
+    if (pin >= 0) Sim::setInput((uint8_t)pin, level ? HIGH : LOW);
+  } else if (cmd == "wifi") {
+    int up = 1;
+    in >> up;
+    Sim::setNetwork(up != 0);
+  } else if (cmd == "http") {
+    std::string method, uri, params, body;
+    in >> method >> uri >> params;
+    std::getline(in, body);
+    if (!body.empty() && body[0] == ' ') body.erase(0, 1);
+    if (params == "-") params.clear();
+    Sim::httpRequest(method.c_str(), uri.c_str(), params.c_str(), body.c_str());
+  } else if (cmd == "ws") {
+    std::string url = "/ws";
+    in >> url;
+    Sim::wsConnect(url.c_str());
+  } else if (cmd == "mqtt") {
+    std::string topic, payload;
+    in >> topic;
+    std::getline(in, payload);
+    if (!payload.empty() && payload[0] == ' ') payload.erase(0, 1);
+    Sim::injectMqtt(topic.c_str(), payload.c_str());
+  } else if (cmd == "echo") {
+    int on = 1;
+    in >> on;
+    Sim::setMqttEcho(on != 0);
+  } else if (cmd == "stats") {
+    printStats();
+  } else if (cmd == "quit") {
+    return false;
+  } else {
+    printf("[sim] unknown command: %s\n", line.c_str());
+  }
+  return true;
+}
+
+static void scriptTask(std::istream* script) {
+  while (!setupDone) simSleep(1);
+  std::string line;
+  while (std::getline(*script, line)) {
+    uint32_t start = millis();
+    if (!runCommand(line)) break;
+    uint32_t took = millis() - start;
+    if (took > 0) printf("[sim] %s (%u ms)\n", line.c_str(), (unsigned)took);
+  }
+  finish(0);
+}
+
+int main(int argc, char** argv) {
+  std::ifstream file;
+  std::istream* script = &std::cin;
+  if (argc > 1) {
+    file.open(argv[1]);
+    if (!file) {
+      fprintf(stderr, "cannot open script %s\n", argv[1]);
+      return 1;
+    }
+    script = &file;
+  }
+  if (argc > 2) Sim::setDataDir(argv[2]);
+
+  std::thread(scriptTask, script).detach();
+
+  setup();
+  setupDone = true;
+  for (;;) {
+    loop();
+    loopPasses++;
+  }
+}
+
+#endif // PIO_UNIT_TESTING
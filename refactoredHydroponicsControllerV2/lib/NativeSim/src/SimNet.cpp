@@ -0,0 +1,90 @@
+/*
+ * SimNet.cpp
+ *
+ * WiFi station and an in-process MQTT broker for PubSubClient.
+ */
+
+#include "PubSubClient.h"
+#include "Sim.h"
+
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+WiFiClass WiFi;
+
+static std::mutex brokerLock;
+static std::deque<std::pair<std::string, std::string>> brokerInbox;
+static bool brokerEcho = false;
+static uint32_t brokerPublished = 0;
+
+namespace Sim {
+
+void injectMqtt(const char* topic, const char* payload) {
+  std::lock_guard<std::mutex> guard(brokerLock);
+  brokerInbox.emplace_back(topic ? topic : "", payload ? payload : "");
+}
+
+void setMqttEcho(bool on) { brokerEcho = on; }
+uint32_t mqttPublished() { return brokerPublished; }
+
+}  // namespace Sim
+
+// ==================================================
+// PUBSUBCLIENT
+// ==================================================
+bool PubSubClient::connect(const char* id, const char* user, const char* pass) {
+  (void)id; (void)user; (void)pass;
+  isConnected = !broker.empty() && Sim::networkUp();
+  return isConnected;
+}
+
+bool PubSubClient::connected() {
+  if (isConnected && !Sim::networkUp()) {
+    isConnected = false;
+    subscriptions.clear();
+  }
+  return isConnected;
+}
+
+bool PubSubClient::loop() {
+  if (!connected()) return false;
+
+  std::vector<std::pair<std::string, std::string>> due;
+  {
+    std::lock_guard<std::mutex> guard(brokerLock);
+    due.assign(brokerInbox.begin(), brokerInbox.end());
+    brokerInbox.clear();
+  }
+  for (auto& message : due) {
+    if (!callback || subscriptions.count(message.first) == 0) continue;
+    callback(&message.first[0], (uint8_t*)&message.second[0], (unsigned int)message.second.size());
+  }
+  return true;
+}
+
+bool PubSubClient::publish(const char* topic, const char* payload, bool retained) {
+  return publish(topic, (const uint8_t*)payload, payload ? strlen(payload) : 0, retained);
+}
+
+bool PubSubClient::publish(const char* topic, const uint8_t* payload, unsigned int length, bool retained) {
+  if (!connected() || !topic) return false;
+  brokerPublished++;
+  if (brokerEcho) {
+    printf("[mqtt] %s%s %.*s\n", topic, retained ? " (retained)" : "", (int)length, (const char*)payload);
+  }
+  return true;
+}
+
+bool PubSubClient::subscribe(const char* topic, uint8_t qos) {
+  (void)qos;
+  if (!connected() || !topic) return false;
+  subscriptions.insert(topic);
+  return true;
+}
+
+bool PubSubClient::unsubscribe(const char* topic) {
+  if (!connected() || !topic) return false;
+  return subscriptions.erase(topic) != 0;
+}
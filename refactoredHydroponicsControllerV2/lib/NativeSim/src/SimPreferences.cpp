@@ -0,0 +1,184 @@
+/*
+ * SimPreferences.cpp
+ *
+ * File-backed NVS namespaces.
+ */
+
+#include "Preferences.h"
+#include "Sim.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+
+#define NVS_NAME_MAX 15
+#define NVS_ENTRY_LIMIT 504   // Roughly what the default 20 KB NVS partition holds
+
+typedef std::vector<uint8_t> NvsValue;
+typedef std::map<std::string, NvsValue> NvsNamespace;
+
+static std::mutex nvsLock;
+static std::map<std::string, NvsNamespace> nvs;
+static std::map<std::string, bool> nvsLoaded;
+
+static std::string nvsPath(const std::string& name) {
+  return std::string(Sim::dataDir()) + "/nvs/" + name + ".bin";
+}
+
+// File format: repeated [keyLen u8][key][valueLen u32 LE][value]
+static NvsNamespace& nvsLoad(const std::string& name) {
+  NvsNamespace& space = nvs[name];
+  if (nvsLoaded[name]) return space;
+  nvsLoaded[name] = true;
+
+  FILE* f = fopen(nvsPath(name).c_str(), "rb");
+  if (!f) return space;
+  uint8_t keyLen;
+  while (fread(&keyLen, 1, 1, f) == 1) {
+    std::string key(keyLen, '\0');
+    uint32_t len;
+    if (fread(&key[0], 1, keyLen, f) != keyLen || fread(&len, 4, 1, f) != 1) break;
+    NvsValue value(len);
+    if (len && fread(value.data(), 1, len, f) != len) break;
+    space[key] = value;
+  }
+  fclose(f);
+  return space;
+}
+
+static bool nvsCommit(const std::string& name) {
+  std::string dir = std::string(Sim::dataDir());
+  mkdir(dir.c_str(), 0755);
+  mkdir((dir + "/nvs").c_str(), 0755);
+
+  std::string tmp = nvsPath(name) + ".tmp";
+  FILE* f = fopen(tmp.c_str(), "wb");
+  if (!f) return false;
+  for (const auto& entry : nvs[name]) {
+    uint8_t keyLen = (uint8_t)entry.first.size();
+    uint32_t len = (uint32_t)entry.second.size();
+    fwrite(&keyLen, 1, 1, f);
+    fwrite(entry.first.data(), 1, keyLen, f);
+    fwrite(&len, 4, 1, f);
+    fwrite(entry.second.data(), 1, len, f);
+  }
+  fclose(f);
+  return rename(tmp.c_str(), nvsPath(name).c_str()) == 0;
+}
+
+static size_t nvsEntryCount() {
+  size_t count = 0;
+  for (const auto& space : nvs) {
+    for (const auto& entry : space.second) count += 1 + entry.second.size() / 32;
+  }
+  return count;
+}
+
+// ==================================================
+// PREFERENCES
+// ==================================================
+bool Preferences::begin(const char* name, bool ro, const char* partitionLabel) {
+  (void)partitionLabel;
+  if (open || !name || strlen(name) == 0 || strlen(name) > NVS_NAME_MAX) return false;
+  strcpy(ns, name);
+  readOnly = ro;
+
+  std::lock_guard<std::mutex> guard(nvsLock);
+  NvsNamespace& space = nvsLoad(ns);
+  // NVS cannot open a namespace read-only before anything was written to it
+  if (readOnly && space.empty()) return false;
+  open = true;
+  return true;
+}
+
+void Preferences::end() {
+  open = false;
+}
+
+bool Preferences::clear() {
+  if (!open || readOnly) return false;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  nvs[ns].clear();
+  return nvsCommit(ns);
+}
+
+bool Preferences::remove(const char* key) {
+  if (!open || readOnly || !key) return false;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  if (nvs[ns].erase(key) == 0) return false;
+  return nvsCommit(ns);
+}
+
+bool Preferences::isKey(const char* key) {
+  if (!open || !key) return false;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  return nvs[ns].count(key) != 0;
+}
+
+size_t Preferences::putRaw(const char* key, const void* value, size_t len) {
+  if (!open || readOnly || !key || strlen(key) == 0 || strlen(key) > NVS_NAME_MAX) return 0;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  NvsValue& slot = nvs[ns][key];
+  NvsValue old = slot;
+  slot.assign((const uint8_t*)value, (const uint8_t*)value + len);
+  if (nvsEntryCount() > NVS_ENTRY_LIMIT) {
+    slot = old;   // ESP_ERR_NVS_NOT_ENOUGH_SPACE
+    return 0;
+  }
+  return nvsCommit(ns) ? len : 0;
+}
+
+bool Preferences::getRaw(const char* key, void* out, size_t len) {
+  if (!open || !key) return false;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  auto it = nvs[ns].find(key);
+  if (it == nvs[ns].end() || it->second.size() != len) return false;
+  memcpy(out, it->second.data(), len);
+  return true;
+}
+
+size_t Preferences::putString(const char* key, const char* value) {
+  if (!value) return 0;
+  return putRaw(key, value, strlen(value) + 1) ? strlen(value) : 0;
+}
+
+size_t Preferences::getString(const char* key, char* value, size_t maxLen) {
+  if (!open || !key) return 0;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  auto it = nvs[ns].find(key);
+  if (it == nvs[ns].end() || it->second.size() > maxLen) return 0;
+  memcpy(value, it->second.data(), it->second.size());
+  return it->second.size();
+}
+
+String Preferences::getString(const char* key, String def) {
+  if (!open || !key) return def;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  auto it = nvs[ns].find(key);
+  if (it == nvs[ns].end() || it->second.empty()) return def;
+  return String((const char*)it->second.data());
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  if (!open || !key) return 0;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  auto it = nvs[ns].find(key);
+  return it == nvs[ns].end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buf, size_t maxLen) {
+  if (!open || !key || !buf) return 0;
+  std::lock_guard<std::mutex> guard(nvsLock);
+  auto it = nvs[ns].find(key);
+  if (it == nvs[ns].end() || it->second.size() > maxLen) return 0;
+  memcpy(buf, it->second.data(), it->second.size());
+  return it->second.size();
+}
+
+size_t Preferences::freeEntries() {
+  std::lock_guard<std::mutex> guard(nvsLock);
+  size_t used = nvsEntryCount();
+  return used < NVS_ENTRY_LIMIT ? NVS_ENTRY_LIMIT - used : 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * SimRTC.cpp
+ *
+ * DateTime arithmetic and the simulated DS3231.
+ */
+
+#include "RTClib.h"
+#include "Sim.h"
+
+#include <chrono>
+#include <mutex>
+
+// Days since 1970-01-01 for a civil date (proleptic Gregorian)
+static int32_t daysFromCivil(int32_t y, uint32_t m, uint32_t d) {
+  y -= m <= 2;
+  const int32_t era = (y >= 0 ? y : y - 399) / 400;
+  const uint32_t yoe = (uint32_t)(y - era * 400);
+  const uint32_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (int32_t)doe - 719468;
+}
+
+// ==================================================
+// DATETIME
+// ==================================================
+DateTime::DateTime(uint32_t t) {
+  int32_t days = (int32_t)(t / SECONDS_PER_DAY);
+  uint32_t rem = t % SECONDS_PER_DAY;
+  ss = rem % 60;
+  mm = rem / 60 % 60;
+  hh = rem / 3600;
+
+  days += 719468;
+  const int32_t era = days / 146097;
+  const uint32_t doe = (uint32_t)(days - era * 146097);
+  const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const uint32_t mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  int32_t y = (int32_t)yoe + era * 400 + (m <= 2);
+  yOff = (uint8_t)(y - 2000);
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day,
+                   uint8_t hour, uint8_t min, uint8_t sec) {
+  if (year >= 2000U) year -= 2000U;
+  yOff = year;
+  m = month;
+  d = day;
+  hh = hour;
+  mm = min;
+  ss = sec;
+}
+
+bool DateTime::isValid() const {
+  if (yOff >= 100) return false;
+  DateTime other(unixtime());
+  return yOff == other.yOff && m == other.m && d == other.d &&
+         hh == other.hh && mm == other.mm && ss == other.ss;
+}
+
+uint8_t DateTime::dayOfTheWeek() const {
+  int32_t days = daysFromCivil(year(), m, d);
+  return (uint8_t)((days + 4) % 7);   // 1970-01-01 was a Thursday
+}
+
+uint32_t DateTime::unixtime() const {
+  return (uint32_t)daysFromCivil(year(), m, d) * SECONDS_PER_DAY +
+         hh * 3600UL + mm * 60UL + ss;
+}
+
+String DateTime::timestamp() const {
+  char buf[20];
+  snprintf(buf, sizeof(buf), "%04u-%02u-%02uT%02u:%02u:%02u",
+           year(), m, d, hh, mm, ss);
+  return String(buf);
+}
+
+DateTime DateTime::operator+(const TimeSpan& span) const {
+  return DateTime(unixtime() + span.totalseconds());
+}
+
+DateTime DateTime::operator-(const TimeSpan& span) const {
+  return DateTime(unixtime() - span.totalseconds());
+}
+
+TimeSpan DateTime::operator-(const DateTime& right) const {
+  return TimeSpan((int32_t)(unixtime() - right.unixtime()));
+}
+
+// ==================================================
+// SIMULATED DS3231
+// ==================================================
+static std::mutex chipLock;
+static bool chipPresent = true;
+static bool chipSet = false;
+static uint32_t chipBase = 0;
+static std::chrono::steady_clock::time_point chipBaseAt;
+
+static uint32_t hostLocalTime() {
+  time_t t = time(nullptr);
+  struct tm local;
+  localtime_r(&t, &local);
+  return (uint32_t)(t + local.tm_gmtoff);
+}
+
+static uint32_t chipNow() {
+  std::lock_guard<std::mutex> guard(chipLock);
+  if (!chipSet) {
+    chipBase = hostLocalTime();
+    chipBaseAt = std::chrono::steady_clock::now();
+    chipSet = true;
+  }
+  auto elapsed = std::chrono::steady_clock::now() - chipBaseAt;
+  return chipBase + (uint32_t)std::chrono::duration_cast<std::chrono::seconds>(elapsed).count();
+}
+
+bool RTC_DS3231::begin(TwoWire* wireInstance) {
+  (void)wireInstance;
+  return chipPresent;
+}
+
+void RTC_DS3231::adjust(const DateTime& dt) {
+  Sim::setClock(dt.unixtime());
+}
+
+bool RTC_DS3231::lostPower(void) { return false; }
+
+DateTime RTC_DS3231::now() { return DateTime(chipNow()); }
+
+float RTC_DS3231::getTemperature() { return 24.25f; }
+
+namespace Sim {
+
+void setClock(uint32_t unixtime) {
+  std::lock_guard<std::mutex> guard(chipLock);
+  chipBase = unixtime;
+  chipBaseAt = std::chrono::steady_clock::now();
+  chipSet = true;
+}
+
+void setRtcPresent(bool present) { chipPresent = present; }
+
+}  // namespace Sim
@@ -0,0 +1,250 @@
+/*
+ * SimRTOS.cpp
+ *
+ * FreeRTOS tasks, notifications and software timers on std::thread.
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "Arduino.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct SimTask {
+  explicit SimTask(const char* taskName) : name(taskName) {}
+
+  const char* name;
+  std::mutex lock;
+  std::condition_variable cv;
+  uint32_t value = 0;
+  bool pending = false;
+};
+
+static SimTask mainTask("loopTask");
+static thread_local SimTask* currentTask = &mainTask;
+
+static std::chrono::steady_clock::duration ticksToDuration(TickType_t ticks) {
+  return std::chrono::milliseconds(ticks);
+}
+
+// ==================================================
+// TASKS
+// ==================================================
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name,
+                                   uint32_t stackDepth, void* param,
+                                   UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core) {
+  (void)stackDepth; (void)priority; (void)core;
+  SimTask* task = new SimTask(name);
+  if (handle) *handle = task;
+
+  std::thread([fn, param, task]() {
+    currentTask = task;
+    fn(param);
+  }).detach();
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackDepth,
+                       void* param, UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(fn, name, stackDepth, param, priority, handle, 0);
+}
+
+// Only self-deletion is supported: the thread parks forever
+void vTaskDelete(TaskHandle_t task) {
+  if (task == NULL || task == currentTask) {
+    for (;;) std::this_thread::sleep_for(std::chrono::hours(1));
+  }
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return currentTask; }
+TickType_t xTaskGetTickCount() { return (TickType_t)millis(); }
+
+void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(ticksToDuration(ticks));
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t period) {
+  *previousWake += period;
+  int32_t remaining = (int32_t)(*previousWake - xTaskGetTickCount());
+  if (remaining > 0) vTaskDelay((TickType_t)remaining);
+}
+
+// ==================================================
+// NOTIFICATIONS
+// ==================================================
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+  if (!task) return pdFAIL;
+  {
+    std::lock_guard<std::mutex> guard(task->lock);
+    switch (action) {
+      case eSetBits:                  task->value |= value; break;
+      case eIncrement:                task->value++; break;
+      case eSetValueWithOverwrite:    task->value = value; break;
+      case eSetValueWithoutOverwrite:
+        if (task->pending) return pdFAIL;
+        task->value = value;
+        break;
+      case eNoAction:                 break;
+    }
+    task->pending = true;
+  }
+  task->cv.notify_one();
+  return pdPASS;
+}
+
+BaseType_t xTaskNotifyFromISR(TaskHandle_t task, uint32_t value,
+                              eNotifyAction action, BaseType_t* higherPriorityWoken) {
+  if (higherPriorityWoken) *higherPriorityWoken = pdFALSE;
+  return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  return xTaskNotify(task, 0, eIncrement);
+}
+
+BaseType_t xTaskNotifyWait(uint32_t clearOnEntry, uint32_t clearOnExit,
+                           uint32_t* value, TickType_t ticks) {
+  SimTask* task = currentTask;
+  std::unique_lock<std::mutex> guard(task->lock);
+  if (!task->pending) task->value &= ~clearOnEntry;
+
+  auto ready = [task]() { return task->pending; };
+  if (ticks == portMAX_DELAY) {
+    task->cv.wait(guard, ready);
+  } else if (!task->cv.wait_for(guard, ticksToDuration(ticks), ready)) {
+    if (value) *value = task->value;
+    return pdFALSE;
+  }
+
+  if (value) *value = task->value;
+  task->value &= ~clearOnExit;
+  task->pending = false;
+  return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  SimTask* task = currentTask;
+  std::unique_lock<std::mutex> guard(task->lock);
+  auto ready = [task]() { return task->value != 0; };
+  if (ticks == portMAX_DELAY) {
+    task->cv.wait(guard, ready);
+  } else if (!task->cv.wait_for(guard, ticksToDuration(ticks), ready)) {
+    return 0;
+  }
+
+  uint32_t count = task->value;
+  task->value = clearOnExit ? 0 : count - 1;
+  task->pending = task->value != 0;
+  return count;
+}
+
+// ==================================================
+// SOFTWARE TIMERS
+// ==================================================
+struct SimTimer {
+  const char* name;
+  TickType_t period;
+  bool autoReload;
+  void* id;
+  TimerCallbackFunction_t callback;
+  bool active;
+  std::chrono::steady_clock::time_point due;
+};
+
+static std::mutex timerLock;
+static std::condition_variable timerCv;
+static std::list<SimTimer*> timers;
+static bool timerServiceStarted = false;
+
+static void timerService() {
+  std::unique_lock<std::mutex> guard(timerLock);
+  for (;;) {
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (SimTimer* t : timers) {
+      if (t->active && t->due < next) next = t->due;
+    }
+    if (next == std::chrono::steady_clock::time_point::max()) {
+      timerCv.wait(guard);
+      continue;
+    }
+    if (timerCv.wait_until(guard, next) != std::cv_status::timeout) continue;
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<SimTimer*> fired;
+    for (SimTimer* t : timers) {
+      if (!t->active || t->due > now) continue;
+      if (t->autoReload) {
+        t->due += ticksToDuration(t->period);
+      } else {
+        t->active = false;
+      }
+      fired.push_back(t);
+    }
+
+    // Callbacks may call back into the timer API
+    guard.unlock();
+    for (SimTimer* t : fired) t->callback(t);
+    guard.lock();
+  }
+}
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload,
+                           void* timerId, TimerCallbackFunction_t callback) {
+  if (period == 0 || !callback) return NULL;
+  SimTimer* t = new SimTimer{ name, period, autoReload != pdFALSE, timerId, callback,
+                              false, std::chrono::steady_clock::time_point() };
+  std::lock_guard<std::mutex> guard(timerLock);
+  timers.push_back(t);
+  if (!timerServiceStarted) {
+    timerServiceStarted = true;
+    std::thread(timerService).detach();
+  }
+  return t;
+}
+
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticksToWait) {
+  (void)ticksToWait;
+  if (!timer) return pdFAIL;
+  {
+    std::lock_guard<std::mutex> guard(timerLock);
+    timer->active = true;
+    timer->due = std::chrono::steady_clock::now() + ticksToDuration(timer->period);
+  }
+  timerCv.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticksToWait) {
+  return xTimerStart(timer, ticksToWait);
+}
+
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticksToWait) {
+  (void)ticksToWait;
+  if (!timer) return pdFAIL;
+  {
+    std::lock_guard<std::mutex> guard(timerLock);
+    timer->active = false;
+  }
+  timerCv.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticksToWait) {
+  if (!timer || period == 0) return pdFAIL;
+  {
+    std::lock_guard<std::mutex> guard(timerLock);
+    timer->period = period;
+  }
+  return xTimerStart(timer, ticksToWait);
+}
+
+void* pvTimerGetTimerID(TimerHandle_t timer) {
+  return timer ? timer->id : NULL;
+}
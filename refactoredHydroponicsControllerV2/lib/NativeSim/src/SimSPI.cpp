@@ -0,0 +1,112 @@
+/*
+ * SimSPI.cpp
+ *
+ * Host ESP-IDF SPI master and GPIO drivers for the ILI9163C DMA path, and
+ * the SPI host state seen through Sim.h.
+ */
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "Sim.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+
+#include <deque>
+
+struct spi_device_t {
+  spi_device_interface_config_t config;
+  std::deque<spi_transaction_t*> done;
+};
+
+static bool busHeld = false;
+static spi_device_t* device = nullptr;
+static bool failBusInit = false;
+static bool failAddDevice = false;
+
+// ==================================================
+// SIM CONTROL
+// ==================================================
+namespace Sim {
+
+void setSpiMasterFailure(bool busInit, bool addDevice) {
+  failBusInit = busInit;
+  failAddDevice = addDevice;
+}
+
+bool spiBegun() {
+  return SPI.isBegun();
+}
+
+bool spiBusHeld() {
+  return busHeld;
+}
+
+uint32_t spiBytesLost() {
+  return SPI.bytesLost();
+}
+
+}  // namespace Sim
+
+// ==================================================
+// SPI MASTER
+// ==================================================
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t* config, int dmaChan) {
+  (void)host; (void)config; (void)dmaChan;
+  if (busHeld) return ESP_ERR_INVALID_STATE;
+  if (failBusInit) return ESP_ERR_NO_MEM;
+  busHeld = true;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t host) {
+  (void)host;
+  if (!busHeld || device) return ESP_ERR_INVALID_STATE;
+  busHeld = false;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t* config,
+                             spi_device_handle_t* handle) {
+  (void)host;
+  if (!busHeld || device) return ESP_ERR_INVALID_STATE;
+  if (failAddDevice) return ESP_ERR_NOT_FOUND;
+  device = new spi_device_t();
+  device->config = *config;
+  *handle = device;
+  return ESP_OK;
+}
+
+// Transfers finish at once; the callbacks still run in order
+static void complete(spi_device_handle_t handle, spi_transaction_t* trans) {
+  if (handle->config.pre_cb) handle->config.pre_cb(trans);
+  if (handle->config.post_cb) handle->config.post_cb(trans);
+}
+
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t* trans, TickType_t wait) {
+  (void)wait;
+  if ((int)handle->done.size() >= handle->config.queue_size) return ESP_ERR_TIMEOUT;
+  complete(handle, trans);
+  handle->done.push_back(trans);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t** trans, TickType_t wait) {
+  (void)wait;
+  if (handle->done.empty()) return ESP_ERR_TIMEOUT;
+  *trans = handle->done.front();
+  handle->done.pop_front();
+  return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t handle, spi_transaction_t* trans) {
+  complete(handle, trans);
+  return ESP_OK;
+}
+
+// ==================================================
+// GPIO
+// ==================================================
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level) {
+  if (gpio >= 0) digitalWrite((uint8_t)gpio, level ? HIGH : LOW);
+  return ESP_OK;
+}
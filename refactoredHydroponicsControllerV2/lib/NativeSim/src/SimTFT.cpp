@@ -0,0 +1,246 @@
+/*
+ * SimTFT.cpp
+ *
+ * In-memory ILI9163C and frame capture to PPM/PNG.
+ */
+
+#include "TFT_ILI9163C.h"
+#include "Sim.h"
+
+#include <string>
+#include <vector>
+
+static TFT_ILI9163C* simPanel = nullptr;
+
+TFT_ILI9163C::TFT_ILI9163C(uint8_t cspin, uint8_t dcpin, uint8_t rstpin)
+  : Adafruit_GFX(_TFTWIDTH, _TFTHEIGHT),
+    winX0(0), winY0(0), winX1(_TFTWIDTH - 1), winY1(_TFTHEIGHT - 1), winX(0), winY(0),
+    scrollTop(0), scrollBottom(0), scrollStart(0),
+    async(false), inverted(false), displayOn(true),
+    doneCb(nullptr), doneArg(nullptr), pushed(0) {
+  (void)cspin; (void)dcpin; (void)rstpin;
+  memset(gram, 0, sizeof(gram));
+  simPanel = this;
+}
+
+void TFT_ILI9163C::begin(void) {
+  memset(gram, 0, sizeof(gram));
+  scrollTop = scrollBottom = scrollStart = 0;
+}
+
+bool TFT_ILI9163C::beginAsync(int8_t sck, int8_t mosi, uint32_t hz) {
+  (void)sck; (void)mosi; (void)hz;
+  async = true;
+  return true;
+}
+
+void TFT_ILI9163C::setRotation(uint8_t r) {
+  Adafruit_GFX::setRotation(r);
+}
+
+// ==================================================
+// GRAM ADDRESSING
+// ==================================================
+// Logical (rotated) coordinates to native GRAM. With scrolled set, a row
+// of the visible picture maps to the GRAM row the controller scans out
+// there, as the vertical scroll start address is applied on native rows.
+uint16_t TFT_ILI9163C::gramIndex(int16_t x, int16_t y, bool scrolled) const {
+  int16_t gx, gy;
+  switch (getRotation()) {
+    case 1:  gx = _TFTWIDTH - 1 - y;  gy = x;                    break;
+    case 2:  gx = _TFTWIDTH - 1 - x;  gy = _TFTHEIGHT - 1 - y;   break;
+    case 3:  gx = y;                  gy = _TFTHEIGHT - 1 - x;   break;
+    default: gx = x;                  gy = y;                    break;
+  }
+
+  int16_t area = _TFTHEIGHT - scrollTop - scrollBottom;
+  if (scrolled && area > 0 && gy >= scrollTop && gy < scrollTop + area) {
+    gy = scrollTop + ((gy - scrollTop) + (scrollStart - scrollTop) + area) % area;
+  }
+  return gy * _TFTWIDTH + gx;
+}
+
+void TFT_ILI9163C::writeGram(int16_t x, int16_t y, uint16_t color) {
+  if (x < 0 || y < 0 || x >= width() || y >= height()) return;
+  gram[gramIndex(x, y, false)] = color;
+  pushed = pushed + 1;
+}
+
+void TFT_ILI9163C::defineScrollArea(uint16_t tfa, uint16_t bfa) {
+  if (tfa + bfa > _TFTHEIGHT) return;
+  scrollTop = tfa;
+  scrollBottom = bfa;
+}
+
+void TFT_ILI9163C::scroll(uint16_t adrs) {
+  scrollStart = adrs;
+}
+
+// ==================================================
+// DRAWING
+// ==================================================
+void TFT_ILI9163C::setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+  winX0 = x0; winY0 = y0; winX1 = x1; winY1 = y1;
+  winX = x0; winY = y0;
+}
+
+void TFT_ILI9163C::pushColor(uint16_t color) {
+  writeGram(winX, winY, color);
+  if (++winX > winX1) {
+    winX = winX0;
+    if (++winY > winY1) winY = winY0;
+  }
+}
+
+void TFT_ILI9163C::pushColors(const uint16_t* colors, uint32_t len) {
+  while (len--) pushColor(*colors++);
+}
+
+void TFT_ILI9163C::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  writeGram(x, y, color);
+}
+
+void TFT_ILI9163C::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void TFT_ILI9163C::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void TFT_ILI9163C::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  for (int16_t j = y; j < y + h; j++) {
+    for (int16_t i = x; i < x + w; i++) writeGram(i, j, color);
+  }
+}
+
+void TFT_ILI9163C::fillScreen(uint16_t color) {
+  fillRect(0, 0, width(), height(), color);
+}
+
+void TFT_ILI9163C::writeScreen24(const uint32_t* bitmap, uint16_t size) {
+  setAddrWindow(0, 0, width() - 1, height() - 1);
+  for (uint16_t i = 0; i < size; i++) pushColor(Color24To565(bitmap[i]));
+}
+
+// Pixels arrive in panel byte order (big endian), like the DMA path
+bool TFT_ILI9163C::pushRectAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels) {
+  if (!pixels || w <= 0 || h <= 0) return false;
+  for (int16_t j = 0; j < h; j++) {
+    for (int16_t i = 0; i < w; i++) {
+      uint16_t p = pixels[j * w + i];
+      writeGram(x + i, y + j, (uint16_t)((p >> 8) | (p << 8)));
+    }
+  }
+  if (doneCb) doneCb(doneArg);
+  return true;
+}
+
+void TFT_ILI9163C::capture(uint16_t* out) const {
+  for (int16_t y = 0; y < height(); y++) {
+    for (int16_t x = 0; x < width(); x++) {
+      uint16_t c = displayOn ? gram[gramIndex(x, y, true)] : 0;
+      out[y * width() + x] = inverted ? (uint16_t)~c : c;
+    }
+  }
+}
+
+// ==================================================
+// FRAME FILES
+// ==================================================
+static uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+static void putBE32(std::vector<uint8_t>& out, uint32_t v) {
+  out.push_back(v >> 24); out.push_back(v >> 16); out.push_back(v >> 8); out.push_back(v);
+}
+
+static void pngChunk(FILE* f, const char* type, const std::vector<uint8_t>& data) {
+  std::vector<uint8_t> buf;
+  putBE32(buf, (uint32_t)data.size());
+  buf.insert(buf.end(), type, type + 4);
+  buf.insert(buf.end(), data.begin(), data.end());
+  uint32_t crc = crc32(&buf[4], buf.size() - 4);
+  putBE32(buf, crc);
+  fwrite(buf.data(), 1, buf.size(), f);
+}
+
+// Uncompressed PNG (stored deflate blocks): no zlib needed on the host
+static void writePNG(FILE* f, const std::vector<uint8_t>& rgb, int w, int h) {
+  static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+  fwrite(signature, 1, sizeof(signature), f);
+
+  std::vector<uint8_t> ihdr;
+  putBE32(ihdr, w);
+  putBE32(ihdr, h);
+  ihdr.push_back(8);   // Bit depth
+  ihdr.push_back(2);   // Truecolour
+  ihdr.push_back(0); ihdr.push_back(0); ihdr.push_back(0);
+  pngChunk(f, "IHDR", ihdr);
+
+  std::vector<uint8_t> raw;
+  for (int y = 0; y < h; y++) {
+    raw.push_back(0);  // Filter: none
+    raw.insert(raw.end(), &rgb[y * w * 3], &rgb[(y + 1) * w * 3]);
+  }
+
+  std::vector<uint8_t> z = { 0x78, 0x01 };
+  uint32_t a = 1, b = 0;
+  for (size_t pos = 0; pos < raw.size();) {
+    uint16_t len = (uint16_t)std::min<size_t>(65535, raw.size() - pos);
+    z.push_back(pos + len == raw.size() ? 1 : 0);
+    z.push_back(len & 0xFF); z.push_back(len >> 8);
+    z.push_back(~len & 0xFF); z.push_back((~len >> 8) & 0xFF);
+    for (uint16_t i = 0; i < len; i++) {
+      uint8_t c = raw[pos + i];
+      z.push_back(c);
+      a = (a + c) % 65521;
+      b = (b + a) % 65521;
+    }
+    pos += len;
+  }
+  putBE32(z, (b << 16) | a);
+  pngChunk(f, "IDAT", z);
+  pngChunk(f, "IEND", std::vector<uint8_t>());
+}
+
+namespace Sim {
+
+bool writeFrame(const char* path) {
+  if (!simPanel) return false;
+  int w = simPanel->width(), h = simPanel->height();
+  std::vector<uint16_t> frame(w * h);
+  simPanel->capture(frame.data());
+
+  std::vector<uint8_t> rgb(w * h * 3);
+  for (int i = 0; i < w * h; i++) {
+    uint16_t c = frame[i];
+    rgb[i * 3 + 0] = ((c >> 11) & 0x1F) * 255 / 31;
+    rgb[i * 3 + 1] = ((c >> 5) & 0x3F) * 255 / 63;
+    rgb[i * 3 + 2] = (c & 0x1F) * 255 / 31;
+  }
+
+  FILE* f = fopen(path, "wb");
+  if (!f) return false;
+  std::string p(path);
+  if (p.size() > 4 && p.compare(p.size() - 4, 4, ".png") == 0) {
+    writePNG(f, rgb, w, h);
+  } else {
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    fwrite(rgb.data(), 1, rgb.size(), f);
+  }
+  fclose(f);
+  return true;
+}
+
+uint32_t framePixelsPushed() {
+  return simPanel ? simPanel->pixelsPushed() : 0;
+}
+
+}  // namespace Sim
@@ -0,0 +1,123 @@
+/*
+ * SimTimer.cpp
+ *
+ * esp_timer one-shot and periodic timers on a dispatch thread.
+ */
+
+#include "esp_timer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct esp_timer {
+  esp_timer_cb_t callback;
+  void* arg;
+  const char* name;
+  bool active;
+  uint64_t periodUs;     // 0 for one-shot
+  std::chrono::steady_clock::time_point due;
+};
+
+// Never destroyed: the detached dispatch thread still waits on them while
+// static destructors run at exit
+static std::mutex& espTimerLock = *new std::mutex;
+static std::condition_variable& espTimerCv = *new std::condition_variable;
+static std::list<esp_timer*>& espTimers = *new std::list<esp_timer*>;
+static bool dispatcherStarted = false;
+
+static void timerDispatch() {
+  std::unique_lock<std::mutex> guard(espTimerLock);
+  for (;;) {
+    auto next = std::chrono::steady_clock::time_point::max();
+    for (esp_timer* t : espTimers) {
+      if (t->active && t->due < next) next = t->due;
+    }
+    if (next == std::chrono::steady_clock::time_point::max()) {
+      espTimerCv.wait(guard);
+      continue;
+    }
+    if (espTimerCv.wait_until(guard, next) != std::cv_status::timeout) continue;
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<esp_timer*> fired;
+    for (esp_timer* t : espTimers) {
+      if (!t->active || t->due > now) continue;
+      if (t->periodUs) {
+        t->due += std::chrono::microseconds(t->periodUs);
+      } else {
+        t->active = false;
+      }
+      fired.push_back(t);
+    }
+
+    // Callbacks may call back into the timer API
+    guard.unlock();
+    for (esp_timer* t : fired) t->callback(t->arg);
+    guard.lock();
+  }
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* outHandle) {
+  if (!args || !args->callback || !outHandle) return ESP_ERR_INVALID_ARG;
+  esp_timer* t = new esp_timer{ args->callback, args->arg, args->name, false, 0,
+                                std::chrono::steady_clock::time_point() };
+  std::lock_guard<std::mutex> guard(espTimerLock);
+  espTimers.push_back(t);
+  if (!dispatcherStarted) {
+    dispatcherStarted = true;
+    std::thread(timerDispatch).detach();
+  }
+  *outHandle = t;
+  return ESP_OK;
+}
+
+static esp_err_t startTimer(esp_timer_handle_t timer, uint64_t timeoutUs, uint64_t periodUs) {
+  if (!timer) return ESP_ERR_INVALID_ARG;
+  {
+    std::lock_guard<std::mutex> guard(espTimerLock);
+    if (timer->active) return ESP_ERR_INVALID_STATE;
+    timer->active = true;
+    timer->periodUs = periodUs;
+    timer->due = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs);
+  }
+  espTimerCv.notify_all();
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+  return startTimer(timer, timeoutUs, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+  if (periodUs == 0) return ESP_ERR_INVALID_ARG;
+  return startTimer(timer, periodUs, periodUs);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  if (!timer) return ESP_ERR_INVALID_ARG;
+  {
+    std::lock_guard<std::mutex> guard(espTimerLock);
+    if (!timer->active) return ESP_ERR_INVALID_STATE;
+    timer->active = false;
+  }
+  espTimerCv.notify_all();
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+  if (!timer) return ESP_ERR_INVALID_ARG;
+  std::lock_guard<std::mutex> guard(espTimerLock);
+  if (timer->active) return ESP_ERR_INVALID_STATE;
+  espTimers.remove(timer);
+  delete timer;
+  return ESP_OK;
+}
+
+bool esp_timer_is_active(esp_timer_handle_t timer) {
+  std::lock_guard<std::mutex> guard(espTimerLock);
+  return timer && timer->active;
+}
@@ -0,0 +1,223 @@
+/*
+ * SimWeb.cpp
+ *
+ * Synchronous request dispatch for the simulated ESPAsyncWebServer.
+ */
+
+#include "ESPAsyncWebServer.h"
+
+#include <algorithm>
+#include <string.h>
+
+// Servers are globals in the firmware, so the registry must exist before
+// their constructors run
+static std::vector<AsyncWebServer*>& serverList() {
+  static std::vector<AsyncWebServer*> servers;
+  return servers;
+}
+
+static std::vector<AsyncWebSocket*> sockets;
+
+// ==================================================
+// REQUEST
+// ==================================================
+bool AsyncWebServerRequest::hasParam(const String& name, bool post, bool file) const {
+  (void)file;
+  for (const auto& p : paramList) {
+    if (p.isPost() == post && p.name() == name) return true;
+  }
+  return false;
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(const String& name, bool post, bool file) {
+  (void)file;
+  for (auto& p : paramList) {
+    if (p.isPost() == post && p.name() == name) return &p;
+  }
+  return nullptr;
+}
+
+String AsyncWebServerRequest::arg(const char* name) {
+  AsyncWebParameter* p = getParam(name, false);
+  if (!p) p = getParam(name, true);
+  return p ? p->value() : String();
+}
+
+void AsyncWebServerRequest::send(int status, const String& contentType, const String& content) {
+  if (code) return;   // The first response wins, as on the device
+  code = status;
+  type = contentType;
+  body.assign(content.c_str(), content.length());
+}
+
+// Small chunks, so fillers are exercised across many calls as on the device
+#define SIM_CHUNK_SIZE 256
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response) {
+  if (code) {
+    delete response;
+    return;
+  }
+  code = response->code;
+  type = response->contentType;
+  body.clear();
+  uint8_t buf[SIM_CHUNK_SIZE];
+  size_t n;
+  while (response->filler && (n = response->filler(buf, sizeof(buf), body.size())) > 0) {
+    body.append((const char*)buf, n);
+  }
+  delete response;
+}
+
+void AsyncWebServerRequest::send(FS& fs, const String& path, const String& contentType, bool download) {
+  (void)download;
+  if (code) return;
+  File f = fs.open(path, FILE_READ);
+  if (!f) {
+    send(404, "text/plain", "Not found");
+    return;
+  }
+  code = 200;
+  type = contentType;
+  body.clear();
+  char buf[512];
+  size_t n;
+  while ((n = f.read((uint8_t*)buf, sizeof(buf))) > 0) body.append(buf, n);
+  f.close();
+}
+
+// ==================================================
+// WEBSOCKET
+// ==================================================
+void AsyncWebSocketClient::text(const String& message) {
+  printf("[ws %s #%u] %s\n", socket->url(), (unsigned)clientId, message.c_str());
+}
+
+void AsyncWebSocket::textAll(const String& message) {
+  for (auto& client : clients) client.text(message);
+}
+
+void AsyncWebSocket::connectClient() {
+  clients.emplace_back(this, nextId++);
+  if (eventHandler) eventHandler(this, &clients.back(), WS_EVT_CONNECT, nullptr, nullptr, 0);
+}
+
+void AsyncWebSocket::disconnectClient() {
+  if (clients.empty()) return;
+  if (eventHandler) eventHandler(this, &clients.front(), WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+  clients.pop_front();
+}
+
+// ==================================================
+// SERVER
+// ==================================================
+AsyncWebServer::AsyncWebServer(uint16_t port) : port(port), running(false) {
+  serverList().push_back(this);
+}
+
+AsyncWebServer::~AsyncWebServer() {
+  std::vector<AsyncWebServer*>& servers = serverList();
+  servers.erase(std::remove(servers.begin(), servers.end(), this), servers.end());
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* uri, WebRequestMethodComposite method,
+                                            ArRequestHandlerFunction onRequest,
+                                            ArUploadHandlerFunction onUpload,
+                                            ArBodyHandlerFunction onBody) {
+  (void)onUpload;
+  owned.emplace_back(new AsyncCallbackWebHandler(uri, method, onRequest, onBody));
+  handlers.push_back(owned.back().get());
+  return *owned.back();
+}
+
+AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler) {
+  handlers.push_back(handler);
+  AsyncWebSocket* socket = dynamic_cast<AsyncWebSocket*>(handler);
+  if (socket) sockets.push_back(socket);
+  return *handler;
+}
+
+void AsyncWebServer::handle(AsyncWebServerRequest* request, const std::string& body) {
+  for (AsyncWebHandler* handler : handlers) {
+    if (!handler->canHandle(request)) continue;
+    if (!body.empty()) {
+      std::string copy = body;   // Handlers may write past len like the real chunk buffer
+      handler->handleBody(request, (uint8_t*)&copy[0], copy.size(), 0, copy.size());
+    }
+    handler->handleRequest(request);
+    return;
+  }
+  if (notFound) {
+    notFound(request);
+  } else {
+    request->send(404);
+  }
+}
+
+// ==================================================
+// SIMULATOR
+// ==================================================
+static WebRequestMethodComposite methodFromName(const char* name) {
+  if (strcasecmp(name, "POST") == 0) return HTTP_POST;
+  if (strcasecmp(name, "PUT") == 0) return HTTP_PUT;
+  if (strcasecmp(name, "PATCH") == 0) return HTTP_PATCH;
+  if (strcasecmp(name, "DELETE") == 0) return HTTP_DELETE;
+  if (strcasecmp(name, "OPTIONS") == 0) return HTTP_OPTIONS;
+  return HTTP_GET;
+}
+
+namespace Sim {
+
+int httpRequest(const char* method, const char* uri, const char* params, const char* body) {
+  WebRequestMethodComposite m = methodFromName(method ? method : "GET");
+  std::string url = uri ? uri : "/";
+  std::string query;
+  size_t q = url.find('?');
+  if (q != std::string::npos) {
+    query = url.substr(q + 1);
+    url.resize(q);
+  }
+
+  AsyncWebServerRequest request(m, String(url.c_str()));
+  auto addPairs = [&request](const std::string& list, bool form) {
+    size_t start = 0;
+    while (start < list.size()) {
+      size_t end = list.find('&', start);
+      if (end == std::string::npos) end = list.size();
+      std::string pair = list.substr(start, end - start);
+      size_t eq = pair.find('=');
+      std::string key = pair.substr(0, eq);
+      std::string value = eq == std::string::npos ? "" : pair.substr(eq + 1);
+      if (!key.empty()) request.addParam(key.c_str(), value.c_str(), form);
+      start = end + 1;
+    }
+  };
+  addPairs(query, false);
+  if (params) addPairs(params, m != HTTP_GET);
+
+  AsyncWebServer* target = nullptr;
+  for (AsyncWebServer* server : serverList()) {
+    if (server->isRunning()) { target = server; break; }
+  }
+  if (!target) {
+    printf("[http] %s %s -> no server running\n", method, url.c_str());
+    return 0;
+  }
+  target->handle(&request, body ? body : "");
+
+  printf("[http] %s %s -> %d %s (%u bytes)\n", method, url.c_str(), request.responseCode(),
+         request.responseType().c_str(), (unsigned)request.responseBody().size());
+  if (!request.responseBody().empty()) {
+    fwrite(request.responseBody().data(), 1, request.responseBody().size(), stdout);
+    printf("\n");
+  }
+  return request.responseCode();
+}
+
+void wsConnect(const char* url) {
+  for (AsyncWebSocket* socket : sockets) {
+    if (!url || strcmp(socket->url(), url) == 0) socket->connectClient();
+  }
+}
+
+}  // namespace Sim
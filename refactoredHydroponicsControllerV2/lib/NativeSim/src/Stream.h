@@ -0,0 +1,44 @@
+/*
+ * Stream.h
+ *
+ * Host stand-in for the Arduino Stream base class.
+ */
+
+#ifndef SIM_STREAM_H
+#define SIM_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long ms) { timeoutMs = ms; }
+  unsigned long getTimeout() const { return timeoutMs; }
+
+  // Host streams never wait: a short read means end of data
+  virtual size_t readBytes(char* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length) {
+      int c = read();
+      if (c < 0) break;
+      buffer[n++] = (char)c;
+    }
+    return n;
+  }
+  size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+
+  String readString() {
+    String s;
+    int c;
+    while ((c = read()) >= 0) s += (char)c;
+    return s;
+  }
+
+protected:
+  unsigned long timeoutMs = 1000;
+};
+
+#endif // SIM_STREAM_H
@@ -0,0 +1,85 @@
+/*
+ * TFT_ILI9163C.h
+ *
+ * Host stand-in for the ILI9163C driver in lib/TFT_ILI9163C. Keeps the
+ * controller's GRAM in memory (RGB565, native orientation) and applies the
+ * rotation and vertical scroll registers when a frame is captured, so what
+ * Sim::writeFrame() saves is what the panel would show. Async transfers
+ * complete immediately.
+ */
+
+#ifndef _TFT_ILI9163CLIB_H_
+#define _TFT_ILI9163CLIB_H_
+
+#include "Arduino.h"
+#include "Print.h"
+#include <Adafruit_GFX.h>
+
+#define _TFTWIDTH  128
+#define _TFTHEIGHT 128
+
+#define BLACK 0x0000
+#define WHITE 0xFFFF
+
+class TFT_ILI9163C : public Adafruit_GFX {
+public:
+  TFT_ILI9163C(uint8_t cspin, uint8_t dcpin, uint8_t rstpin = 255);
+
+  void begin(void);
+  void setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);
+  void setCursor(int16_t x, int16_t y) { Adafruit_GFX::setCursor(x, y); }
+  void pushColor(uint16_t color);
+  void fillScreen(uint16_t color = 0x0000) override;
+  void clearScreen(uint16_t color = 0x0000) { fillScreen(color); }
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+  void setRotation(uint8_t r) override;
+  void invertDisplay(bool i) override { inverted = i; }
+
+  uint8_t errorCode(void) { return 0; }
+  void idleMode(bool onOff) { (void)onOff; }
+  void display(bool onOff) { displayOn = onOff; }
+  void sleepMode(bool mode) { displayOn = !mode; }
+  void defineScrollArea(uint16_t tfa, uint16_t bfa);
+  void scroll(uint16_t adrs);
+  void startPushData(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) { setAddrWindow(x0, y0, x1, y1); }
+  void pushData(uint16_t color) { pushColor(color); }
+  void endPushData() {}
+  void writeScreen24(const uint32_t* bitmap, uint16_t size = _TFTWIDTH * _TFTHEIGHT);
+  inline uint16_t Color565(uint8_t r, uint8_t g, uint8_t b) { return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3); }
+  inline uint16_t Color24To565(int32_t color_) { return ((((color_ >> 16) & 0xFF) / 8) << 11) | ((((color_ >> 8) & 0xFF) / 4) << 5) | (((color_) & 0xFF) / 8); }
+  void setBitrate(uint32_t n) { (void)n; }
+
+  void pushColors(const uint16_t* colors, uint32_t len);
+  void startWrite(void) override {}
+  void endWrite(void) override {}
+  bool beginAsync(int8_t sck, int8_t mosi, uint32_t hz = 8000000);
+  bool pushRectAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t* pixels);
+  bool waitAsync(uint32_t timeoutMs = 1000) { (void)timeoutMs; return true; }
+  bool asyncBusy(void) { return false; }
+  void onAsyncDone(void (*cb)(void* arg), void* arg) { doneCb = cb; doneArg = arg; }
+  bool isAsync(void) { return async; }
+
+  // ---- Simulator ----
+  // Visible picture, row major RGB565 in the current rotation
+  void capture(uint16_t* out) const;
+  uint32_t pixelsPushed() const { return pushed; }
+
+private:
+  uint16_t gram[_TFTWIDTH * _TFTHEIGHT];
+  int16_t winX0, winY0, winX1, winY1, winX, winY;
+  uint16_t scrollTop, scrollBottom, scrollStart;
+  bool async;
+  bool inverted;
+  bool displayOn;
+  void (*doneCb)(void* arg);
+  void* doneArg;
+  volatile uint32_t pushed;
+
+  void writeGram(int16_t x, int16_t y, uint16_t color);
+  uint16_t gramIndex(int16_t x, int16_t y, bool scrolled) const;
+};
+
+#endif // _TFT_ILI9163CLIB_H_
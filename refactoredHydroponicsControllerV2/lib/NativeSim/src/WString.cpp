@@ -0,0 +1,102 @@
+/*
+ * WString.cpp
+ *
+ * Host String implementation.
+ */
+
+#include "WString.h"
+#include <algorithm>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+
+static std::string formatUnsigned(unsigned long long value, unsigned char base) {
+  if (base < 2 || base > 16) base = 10;
+  char buf[72];
+  int i = sizeof(buf) - 1;
+  buf[i] = '\0';
+  do {
+    buf[--i] = "0123456789ABCDEF"[value % base];
+    value /= base;
+  } while (value && i > 0);
+  return std::string(&buf[i]);
+}
+
+static std::string formatSigned(long long value, unsigned char base) {
+  if (base == DEC && value < 0) return "-" + formatUnsigned(0ULL - (unsigned long long)value, base);
+  return formatUnsigned((unsigned long long)value, base);
+}
+
+String::String(unsigned char value, unsigned char base) : str(formatUnsigned(value, base)) {}
+String::String(int value, unsigned char base) : str(formatSigned(value, base)) {}
+String::String(unsigned int value, unsigned char base) : str(formatUnsigned(value, base)) {}
+String::String(long value, unsigned char base) : str(formatSigned(value, base)) {}
+String::String(unsigned long value, unsigned char base) : str(formatUnsigned(value, base)) {}
+String::String(long long value, unsigned char base) : str(formatSigned(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : str(formatUnsigned(value, base)) {}
+String::String(float value, unsigned char decimals) : String((double)value, decimals) {}
+
+String::String(double value, unsigned char decimals) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+  str = buf;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+  return strcasecmp(str.c_str(), s.str.c_str()) == 0;
+}
+
+bool String::endsWith(const String& s) const {
+  return str.size() >= s.str.size() &&
+         str.compare(str.size() - s.str.size(), s.str.size(), s.str) == 0;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  size_t pos = str.find(c, from);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& s, unsigned int from) const {
+  size_t pos = str.find(s.str, from);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t pos = str.rfind(c);
+  return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) std::swap(from, to);
+  if (from >= str.size()) return String();
+  return String(str.substr(from, std::min<size_t>(to, str.size()) - from));
+}
+
+void String::replace(const String& find, const String& with) {
+  if (find.str.empty()) return;
+  size_t pos = 0;
+  while ((pos = str.find(find.str, pos)) != std::string::npos) {
+    str.replace(pos, find.str.size(), with.str);
+    pos += with.str.size();
+  }
+}
+
+void String::trim() {
+  size_t start = 0;
+  while (start < str.size() && isspace((unsigned char)str[start])) start++;
+  size_t end = str.size();
+  while (end > start && isspace((unsigned char)str[end - 1])) end--;
+  str = str.substr(start, end - start);
+}
+
+void String::toUpperCase() {
+  for (char& c : str) c = (char)toupper((unsigned char)c);
+}
+
+void String::toLowerCase() {
+  for (char& c : str) c = (char)tolower((unsigned char)c);
+}
+
+long String::toInt() const { return atol(str.c_str()); }
+float String::toFloat() const { return (float)atof(str.c_str()); }
@@ -0,0 +1,104 @@
+/*
+ * WString.h
+ *
+ * Host stand-in for the Arduino String class, backed by std::string.
+ * Covers the members the firmware, ArduinoJson and Adafruit_GFX use.
+ */
+
+#ifndef SIM_WSTRING_H
+#define SIM_WSTRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+class __FlashStringHelper;
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class String {
+public:
+  String() {}
+  String(const char* s) { if (s) str = s; }
+  String(const __FlashStringHelper* s) : String((const char*)s) {}
+  explicit String(const std::string& s) : str(s) {}
+  String(char c) : str(1, c) {}
+  String(unsigned char value, unsigned char base = DEC);
+  String(int value, unsigned char base = DEC);
+  String(unsigned int value, unsigned char base = DEC);
+  String(long value, unsigned char base = DEC);
+  String(unsigned long value, unsigned char base = DEC);
+  String(long long value, unsigned char base = DEC);
+  String(unsigned long long value, unsigned char base = DEC);
+  String(float value, unsigned char decimals = 2);
+  String(double value, unsigned char decimals = 2);
+
+  const char* c_str() const { return str.c_str(); }
+  unsigned int length() const { return (unsigned int)str.length(); }
+  bool isEmpty() const { return str.empty(); }
+  bool reserve(unsigned int size) { str.reserve(size); return true; }
+
+  bool concat(const String& s) { str += s.str; return true; }
+  bool concat(const char* s) { if (s) str += s; return true; }
+  bool concat(const char* s, unsigned int n) { if (s) str.append(s, n); return true; }
+  bool concat(char c) { str += c; return true; }
+  template <typename T> bool concat(T value) { return concat(String(value)); }
+
+  template <typename T> String& operator+=(const T& value) { concat(value); return *this; }
+
+  bool equals(const String& s) const { return str == s.str; }
+  bool equals(const char* s) const { return s && str == s; }
+  bool equalsIgnoreCase(const String& s) const;
+  bool startsWith(const String& s) const { return str.compare(0, s.str.size(), s.str) == 0; }
+  bool endsWith(const String& s) const;
+
+  char charAt(unsigned int i) const { return i < str.size() ? str[i] : 0; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char& operator[](unsigned int i) { return str[i]; }
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String& s, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  String substring(unsigned int from) const { return substring(from, length()); }
+  String substring(unsigned int from, unsigned int to) const;
+
+  void replace(const String& find, const String& with);
+  void remove(unsigned int index) { if (index < str.size()) str.erase(index); }
+  void remove(unsigned int index, unsigned int count) { if (index < str.size()) str.erase(index, count); }
+  void trim();
+  void toUpperCase();
+  void toLowerCase();
+
+  long toInt() const;
+  float toFloat() const;
+  double toDouble() const { return toFloat(); }
+
+  bool operator==(const String& s) const { return equals(s); }
+  bool operator==(const char* s) const { return equals(s); }
+  bool operator!=(const String& s) const { return !equals(s); }
+  bool operator!=(const char* s) const { return !equals(s); }
+  bool operator<(const String& s) const { return str < s.str; }
+
+  const std::string& std() const { return str; }
+
+private:
+  std::string str;
+};
+
+// ArduinoJson adapts this type by name on some versions
+class StringSumHelper : public String {
+public:
+  using String::String;
+  StringSumHelper(const String& s) : String(s) {}
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r.concat(b); return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r.concat(b); return r; }
+inline String operator+(const String& a, char b) { String r(a); r.concat(b); return r; }
+template <typename T> String operator+(const String& a, T b) { String r(a); r.concat(String(b)); return r; }
+
+#endif // SIM_WSTRING_H
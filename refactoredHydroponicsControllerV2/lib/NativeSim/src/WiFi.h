@@ -0,0 +1,143 @@
+/*
+ * WiFi.h
+ *
+ * Host stand-in for the ESP32 WiFi stack. The station "associates" as soon
+ * as begin() is called while Sim::networkUp() is true and drops when the
+ * simulator takes the link down. Clients never open sockets.
+ */
+
+#ifndef SIM_WIFI_H
+#define SIM_WIFI_H
+
+#include <Arduino.h>
+#include "Sim.h"
+
+// ==================================================
+// IP ADDRESS
+// ==================================================
+class IPAddress : public Printable {
+public:
+  IPAddress() : addr(0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    : addr((uint32_t)a | ((uint32_t)b << 8) | ((uint32_t)c << 16) | ((uint32_t)d << 24)) {}
+  IPAddress(uint32_t address) : addr(address) {}
+
+  operator uint32_t() const { return addr; }
+  uint8_t operator[](int index) const { return (addr >> (index * 8)) & 0xFF; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(buf);
+  }
+  size_t printTo(Print& p) const override { return p.print(toString()); }
+
+private:
+  uint32_t addr;
+};
+
+// ==================================================
+// WIFI
+// ==================================================
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6
+} wl_status_t;
+
+typedef enum {
+  WIFI_MODE_NULL = 0,
+  WIFI_MODE_STA,
+  WIFI_MODE_AP,
+  WIFI_MODE_APSTA
+} wifi_mode_t;
+
+#define WIFI_OFF    WIFI_MODE_NULL
+#define WIFI_STA    WIFI_MODE_STA
+#define WIFI_AP     WIFI_MODE_AP
+#define WIFI_AP_STA WIFI_MODE_APSTA
+
+class WiFiClass {
+public:
+  WiFiClass() : wifiMode(WIFI_MODE_NULL), started(false), apUp(false) {}
+
+  bool mode(wifi_mode_t m) { wifiMode = m; return true; }
+  wifi_mode_t getMode() const { return wifiMode; }
+  bool persistent(bool on) { (void)on; return true; }
+  bool setAutoReconnect(bool on) { (void)on; return true; }
+  void setHostname(const char* name) { (void)name; }
+
+  wl_status_t begin() { started = true; return status(); }
+  wl_status_t begin(const char* ssid, const char* pass = nullptr) {
+    (void)pass;
+    if (ssid) ssidName = ssid;
+    return begin();
+  }
+  bool reconnect() { started = true; return status() == WL_CONNECTED; }
+  bool disconnect(bool wifiOff = false, bool eraseAp = false) {
+    (void)wifiOff;
+    if (eraseAp) ssidName = "";
+    started = false;
+    return true;
+  }
+  wl_status_t status() const {
+    bool sta = wifiMode == WIFI_MODE_STA || wifiMode == WIFI_MODE_APSTA;
+    if (!sta || !started) return WL_DISCONNECTED;
+    return Sim::networkUp() ? WL_CONNECTED : WL_CONNECTION_LOST;
+  }
+  bool isConnected() const { return status() == WL_CONNECTED; }
+
+  String SSID() const { return String(ssidName.c_str()); }
+  int8_t RSSI() const { return isConnected() ? -55 : 0; }
+  IPAddress localIP() const { return isConnected() ? IPAddress(192, 168, 1, 50) : IPAddress(); }
+  String macAddress() const { return String("A1:B2:C3:D4:E5:F6"); }
+
+  bool softAP(const char* ssid, const char* pass = nullptr) { (void)ssid; (void)pass; apUp = true; return true; }
+  bool softAPConfig(IPAddress ip, IPAddress gateway, IPAddress subnet) {
+    (void)gateway; (void)subnet;
+    apAddress = ip;
+    return true;
+  }
+  bool softAPdisconnect(bool wifiOff = false) { (void)wifiOff; apUp = false; return true; }
+  IPAddress softAPIP() const { return apUp ? apAddress : IPAddress(); }
+
+private:
+  wifi_mode_t wifiMode;
+  bool started;
+  bool apUp;
+  std::string ssidName = "SimNet";
+  IPAddress apAddress = IPAddress(192, 168, 4, 1);
+};
+
+extern WiFiClass WiFi;
+
+// ==================================================
+// CLIENT
+// ==================================================
+class Client : public Stream {
+public:
+  virtual int connect(const char* host, uint16_t port) = 0;
+  virtual void stop() = 0;
+  virtual uint8_t connected() = 0;
+};
+
+class WiFiClient : public Client {
+public:
+  int connect(const char* host, uint16_t port) override { (void)host; (void)port; return Sim::networkUp(); }
+  void stop() override {}
+  uint8_t connected() override { return Sim::networkUp(); }
+  void setTimeout(uint32_t seconds) { Stream::setTimeout(seconds * 1000); }
+
+  size_t write(uint8_t c) override { (void)c; return 1; }
+  size_t write(const uint8_t* buf, size_t size) override { (void)buf; return size; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  operator bool() { return connected(); }
+};
+
+#endif // SIM_WIFI_H
@@ -0,0 +1,20 @@
+/*
+ * WiFiClientSecure.h
+ *
+ * Host stand-in for the TLS client: same as WiFiClient, no handshake.
+ */
+
+#ifndef SIM_WIFICLIENTSECURE_H
+#define SIM_WIFICLIENTSECURE_H
+
+#include "WiFi.h"
+
+class WiFiClientSecure : public WiFiClient {
+public:
+  void setInsecure() {}
+  void setCACert(const char* rootCA) { (void)rootCA; }
+  void setCertificate(const char* clientCert) { (void)clientCert; }
+  void setPrivateKey(const char* privateKey) { (void)privateKey; }
+};
+
+#endif // SIM_WIFICLIENTSECURE_H
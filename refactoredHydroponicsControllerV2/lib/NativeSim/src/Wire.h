@@ -0,0 +1,39 @@
+/*
+ * Wire.h
+ *
+ * Host stand-in for the Arduino I2C bus. The DS3231 is simulated above the
+ * bus (RTClib.h); nothing acknowledges on the wire.
+ */
+
+#ifndef SIM_WIRE_H
+#define SIM_WIRE_H
+
+#include "Stream.h"
+
+class TwoWire : public Stream {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) {
+    (void)sda; (void)scl; (void)frequency;
+    return true;
+  }
+  bool end() { return true; }
+  bool setClock(uint32_t frequency) { (void)frequency; return true; }
+
+  void beginTransmission(int address) { (void)address; }
+  uint8_t endTransmission(bool sendStop = true) { (void)sendStop; return 2; }  // NACK on address
+  uint8_t requestFrom(int address, int quantity, int sendStop = 1) {
+    (void)address; (void)quantity; (void)sendStop;
+    return 0;
+  }
+
+  size_t write(uint8_t data) override { (void)data; return 1; }
+  size_t write(const uint8_t* data, size_t size) override { (void)data; return size; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+
+extern TwoWire Wire;
+
+#endif // SIM_WIRE_H
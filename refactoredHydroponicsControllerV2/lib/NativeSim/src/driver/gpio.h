@@ -0,0 +1,19 @@
+/*
+ * driver/gpio.h
+ *
+ * Host stand-in for the ESP-IDF GPIO driver, as far as TFT_ILI9163C uses it.
+ */
+
+#ifndef SIM_DRIVER_GPIO_H
+#define SIM_DRIVER_GPIO_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef int gpio_num_t;
+
+#define GPIO_NUM_NC ((gpio_num_t)-1)
+
+esp_err_t gpio_set_level(gpio_num_t gpio, uint32_t level);
+
+#endif // SIM_DRIVER_GPIO_H
@@ -0,0 +1,19 @@
+/*
+ * esp_task_wdt.h
+ *
+ * Host stand-in for the task watchdog: nothing to feed.
+ */
+
+#ifndef SIM_ESP_TASK_WDT_H
+#define SIM_ESP_TASK_WDT_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/task.h"
+
+inline esp_err_t esp_task_wdt_init(uint32_t timeoutSec, bool panic) { (void)timeoutSec; (void)panic; return ESP_OK; }
+inline esp_err_t esp_task_wdt_add(TaskHandle_t task) { (void)task; return ESP_OK; }
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t task) { (void)task; return ESP_OK; }
+inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
+
+#endif // SIM_ESP_TASK_WDT_H
@@ -0,0 +1,53 @@
+/*
+ * FreeRTOS.h
+ *
+ * Host stand-in for the FreeRTOS types and tick macros. One tick is one
+ * millisecond, as on the ESP32 Arduino build (CONFIG_FREERTOS_HZ=1000).
+ */
+
+#ifndef SIM_FREERTOS_H
+#define SIM_FREERTOS_H
+
+#include <atomic>
+#include <limits.h>
+#include <stdint.h>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS 1
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTICKS_TO_MS(t) ((uint32_t)(t))
+
+#define portYIELD_FROM_ISR(...) do {} while (0)
+
+// Critical sections are a spinlock shared by tasks and ISRs, as on the
+// dual-core ESP32
+typedef struct {
+  std::atomic_flag locked = ATOMIC_FLAG_INIT;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {}
+
+inline void vPortEnterCritical(portMUX_TYPE* mux) {
+  while (mux->locked.test_and_set(std::memory_order_acquire)) {}
+}
+
+inline void vPortExitCritical(portMUX_TYPE* mux) {
+  mux->locked.clear(std::memory_order_release);
+}
+
+#define portENTER_CRITICAL(mux)     vPortEnterCritical(mux)
+#define portEXIT_CRITICAL(mux)      vPortExitCritical(mux)
+#define portENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define portEXIT_CRITICAL_ISR(mux)  vPortExitCritical(mux)
+
+#endif // SIM_FREERTOS_H
@@ -0,0 +1,25 @@
+/*
+ * timers.h
+ *
+ * Host stand-in for FreeRTOS software timers. All timers share one service
+ * thread, like the FreeRTOS timer daemon task.
+ */
+
+#ifndef SIM_FREERTOS_TIMERS_H
+#define SIM_FREERTOS_TIMERS_H
+
+#include "FreeRTOS.h"
+
+struct SimTimer;
+typedef SimTimer* TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period, UBaseType_t autoReload,
+                           void* timerId, TimerCallbackFunction_t callback);
+BaseType_t xTimerStart(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerStop(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerReset(TimerHandle_t timer, TickType_t ticksToWait);
+BaseType_t xTimerChangePeriod(TimerHandle_t timer, TickType_t period, TickType_t ticksToWait);
+void* pvTimerGetTimerID(TimerHandle_t timer);
+
+#endif // SIM_FREERTOS_TIMERS_H
@@ -0,0 +1,13 @@
+/*
+ * pins_arduino.h
+ *
+ * Host stand-in for the ESP32 variant pin header. The pins the firmware
+ * uses come from Arduino.h.
+ */
+
+#ifndef SIM_PINS_ARDUINO_H
+#define SIM_PINS_ARDUINO_H
+
+#include "Arduino.h"
+
+#endif // SIM_PINS_ARDUINO_H
@@ -0,0 +1,13 @@
+/*
+ * wiring_private.h
+ *
+ * Host stand-in for the Arduino core's private wiring header, which the
+ * ILI9163C driver includes. Nothing in it is used on the host.
+ */
+
+#ifndef SIM_WIRING_PRIVATE_H
+#define SIM_WIRING_PRIVATE_H
+
+#include "Arduino.h"
+
+#endif // SIM_WIRING_PRIVATE_H
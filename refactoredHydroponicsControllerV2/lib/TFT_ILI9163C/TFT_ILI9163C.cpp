@@ -37,6 +37,12 @@
 		_cs   = cspin;
 		_rs   = dcpin;
 		_rst  = rstpin;
+		#if defined(ESP32)
+			_burstDepth = 0;
+			_async = false;
+			_asyncNext = 0;
+			_asyncInFlight = 0;
+		#endif
 	}
 #endif
 
@@ -237,6 +243,258 @@
 	{
 		//nop
 	}
+#elif defined(ESP32)
+/*
+	ESP32 backend. The generic path below pays a full SPI transaction (mutex,
+	bus reconfigure, CS toggle) for every single pixel. Here every primitive opens
+	one transaction with _beginBurst(), sends the address window and then streams
+	the whole pixel run with writeBytes. Bursts nest, so the single byte helpers
+	can still be used inside a primitive without reopening the bus.
+*/
+	#define _ESP32_BURST_PIXELS		64//pixels per writeBytes() chunk
+
+	void TFT_ILI9163C::_beginBurst(void)
+	{
+		if (_burstDepth++ == 0 && !_async) {
+			SPI.beginTransaction(ILI9163C_SPI);
+			digitalWrite(_cs,LOW);
+		}
+	}
+
+	void TFT_ILI9163C::_endBurst(void)
+	{
+		if (_burstDepth == 0) return;
+		if (--_burstDepth == 0 && !_async) {
+			digitalWrite(_cs,HIGH);
+			SPI.endTransaction();
+		}
+	}
+
+/*
+	Single exit to the wire. In async mode the SPI master driver owns the bus
+	and CS, so writes become polling transactions (after the DMA queue drained)
+	and the DC level travels in the transaction user field.
+*/
+	void TFT_ILI9163C::_spiWrite(const uint8_t *data, uint32_t len, bool dc)
+	{
+		if (_async) {
+			waitAsync();
+			spi_transaction_t t;
+			memset(&t, 0, sizeof(t));
+			t.length = len * 8;
+			t.user = (void*)(uintptr_t)(dc ? 1 : 0);
+			if (len <= 4) {
+				t.flags = SPI_TRANS_USE_TXDATA;
+				memcpy(t.tx_data, data, len);
+			} else {
+				t.tx_buffer = data;
+			}
+			spi_device_polling_transmit(_spiDev, &t);
+			return;
+		}
+		digitalWrite(_rs,dc);
+		SPI.writeBytes(data, len);
+	}
+
+	void TFT_ILI9163C::writecommand(uint8_t c)
+	{
+		_beginBurst();
+		_spiWrite(&c, 1, LOW);
+		_endBurst();
+	}
+
+	void TFT_ILI9163C::writedata(uint8_t c)
+	{
+		_beginBurst();
+		_spiWrite(&c, 1, HIGH);
+		_endBurst();
+	} 
+
+	void TFT_ILI9163C::writedata16(uint16_t d)
+	{
+		uint8_t buf[2] = { (uint8_t)(d >> 8), (uint8_t)d };
+		_beginBurst();
+		_spiWrite(buf, 2, HIGH);
+		_endBurst();
+	} 
+
+	void TFT_ILI9163C::_writeColorBurst(uint16_t color, uint32_t len)
+	{
+		uint8_t buf[_ESP32_BURST_PIXELS * 2];
+		uint32_t n = (len < _ESP32_BURST_PIXELS) ? len : _ESP32_BURST_PIXELS;
+		for (uint32_t i = 0;i < n;i++){
+			buf[i * 2]     = color >> 8;
+			buf[i * 2 + 1] = color;
+		}
+		while (len > 0) {
+			n = (len < _ESP32_BURST_PIXELS) ? len : _ESP32_BURST_PIXELS;
+			_spiWrite(buf, n * 2, HIGH);
+			len -= n;
+		}
+	}
+
+	void TFT_ILI9163C::pushColors(const uint16_t *colors, uint32_t len)
+	{
+		if (len == 0) return;
+		_beginBurst();
+		if (!_async) {
+			digitalWrite(_rs,HIGH);
+			SPI.writePixels(colors, len * 2);//writePixels swaps to MSB first
+		} else {
+			uint8_t buf[_ESP32_BURST_PIXELS * 2];
+			while (len > 0) {
+				uint32_t n = (len < _ESP32_BURST_PIXELS) ? len : _ESP32_BURST_PIXELS;
+				for (uint32_t i = 0;i < n;i++){
+					buf[i * 2]     = colors[i] >> 8;
+					buf[i * 2 + 1] = colors[i];
+				}
+				_spiWrite(buf, n * 2, HIGH);
+				colors += n;
+				len -= n;
+			}
+		}
+		_endBurst();
+	}
+
+/*
+	Async DMA mode. The Arduino SPI driver has no queued transfers, so the host
+	is released and handed to the IDF SPI master driver. One panel per host:
+	the DC pin and the completion callback live in file statics because the
+	driver callbacks run in ISR context with no object pointer.
+*/
+	#define _ASYNC_DC_HIGH		0x01
+	#define _ASYNC_LAST			0x02
+
+	static gpio_num_t 	_asyncDcPin = GPIO_NUM_NC;
+	static void 		(*_asyncCb)(void *) = NULL;
+	static void 		*_asyncArg = NULL;
+
+	static void IRAM_ATTR _asyncPreCb(spi_transaction_t *t)
+	{
+		gpio_set_level(_asyncDcPin, ((uintptr_t)t->user & _ASYNC_DC_HIGH) ? 1 : 0);
+	}
+
+	static void IRAM_ATTR _asyncPostCb(spi_transaction_t *t)
+	{
+		if (((uintptr_t)t->user & _ASYNC_LAST) && _asyncCb != NULL) _asyncCb(_asyncArg);
+	}
+
+	bool TFT_ILI9163C::beginAsync(int8_t sck, int8_t mosi, uint32_t hz)
+	{
+		if (_async) return true;
+		//the IDF driver needs the host to itself; every failure below hands it
+		//back to the Arduino driver so the blocking path keeps working
+		SPI.end();
+		spi_bus_config_t bus;
+		memset(&bus, 0, sizeof(bus));
+		bus.mosi_io_num = mosi;
+		bus.miso_io_num = -1;
+		bus.sclk_io_num = sck;
+		bus.quadwp_io_num = -1;
+		bus.quadhd_io_num = -1;
+		bus.max_transfer_sz = _ASYNC_CHUNK;
+		if (spi_bus_initialize(SPI2_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK) {
+			SPI.begin(sck, -1, mosi);
+			return false;
+		}
+		spi_device_interface_config_t dev;
+		memset(&dev, 0, sizeof(dev));
+		dev.clock_speed_hz = hz;
+		dev.mode = 0;
+		dev.spics_io_num = _cs;
+		dev.queue_size = _ASYNC_QUEUE;
+		dev.pre_cb = _asyncPreCb;
+		dev.post_cb = _asyncPostCb;
+		if (spi_bus_add_device(SPI2_HOST, &dev, &_spiDev) != ESP_OK) {
+			spi_bus_free(SPI2_HOST);
+			SPI.begin(sck, -1, mosi);
+			return false;
+		}
+		_asyncDcPin = (gpio_num_t)_rs;
+		_asyncNext = 0;
+		_asyncInFlight = 0;
+		_async = true;
+		return true;
+	}
+
+	bool TFT_ILI9163C::pushRectAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels)
+	{
+		if (pixels == NULL) return false;
+		if ((x < 0) || (y < 0) || (w < 1) || (h < 1) || boundaryCheck(x,y)) return false;
+		if (((x + w) - 1) >= _width)  return false;
+		if (((y + h) - 1) >= _height) return false;
+		if (!_async) {//no DMA host, same bytes as a plain blocking burst
+			_beginBurst();
+			_setAddrWindow(x,y,(x+w)-1,(y+h)-1);
+			_spiWrite((const uint8_t *)pixels, (uint32_t)w * h * 2, HIGH);
+			_endBurst();
+			return true;
+		}
+		if (!waitAsync()) return false;//previous block still owns the window
+		_setAddrWindow(x,y,(x+w)-1,(y+h)-1);
+		const uint8_t *src = (const uint8_t *)pixels;
+		uint32_t bytes = (uint32_t)w * h * 2;
+		while (bytes > 0) {
+			uint32_t n = (bytes < _ASYNC_CHUNK) ? bytes : _ASYNC_CHUNK;
+			if (_asyncInFlight >= _ASYNC_QUEUE) {//reclaim the oldest slot
+				spi_transaction_t *done;
+				if (spi_device_get_trans_result(_spiDev, &done, pdMS_TO_TICKS(1000)) != ESP_OK) return false;
+				_asyncInFlight--;
+			}
+			spi_transaction_t *t = &_asyncTrans[_asyncNext];
+			_asyncNext = (_asyncNext + 1) % _ASYNC_QUEUE;
+			memset(t, 0, sizeof(spi_transaction_t));
+			t->length = n * 8;
+			t->tx_buffer = src;
+			t->user = (void*)(uintptr_t)(_ASYNC_DC_HIGH | ((n == bytes) ? _ASYNC_LAST : 0));
+			if (spi_device_queue_trans(_spiDev, t, portMAX_DELAY) != ESP_OK) return false;
+			_asyncInFlight++;
+			src += n;
+			bytes -= n;
+		}
+		return true;
+	}
+
+	bool TFT_ILI9163C::waitAsync(uint32_t timeoutMs)
+	{
+		while (_asyncInFlight > 0) {
+			spi_transaction_t *done;
+			if (spi_device_get_trans_result(_spiDev, &done, pdMS_TO_TICKS(timeoutMs)) != ESP_OK) return false;
+			_asyncInFlight--;
+		}
+		return true;
+	}
+
+	bool TFT_ILI9163C::asyncBusy(void)
+	{
+		spi_transaction_t *done;
+		while (_asyncInFlight > 0 && spi_device_get_trans_result(_spiDev, &done, 0) == ESP_OK) {
+			_asyncInFlight--;
+		}
+		return _asyncInFlight > 0;
+	}
+
+	void TFT_ILI9163C::onAsyncDone(void (*cb)(void *arg), void *arg)
+	{
+		_asyncCb = NULL;//never leave the ISR with a half written pair
+		_asyncArg = arg;
+		_asyncCb = cb;
+	}
+
+	void TFT_ILI9163C::startWrite(void)
+	{
+		_beginBurst();
+	}
+
+	void TFT_ILI9163C::endWrite(void)
+	{
+		_endBurst();
+	}
+
+	void TFT_ILI9163C::setBitrate(uint32_t n)
+	{
+		ILI9163C_SPI = SPISettings(n, MSBFIRST, SPI_MODE0);
+	}
 #else
 
 	void TFT_ILI9163C::writecommand(uint8_t c)
@@ -379,6 +637,14 @@ void TFT_ILI9163C::begin(void)
 		bitSet(_initError,1);
 		return;
 	}
+#elif defined(ESP32)
+	pinMode(_rs, OUTPUT);
+	pinMode(_cs, OUTPUT);
+	SPI.begin();//no-op if the sketch already started the bus on custom pins
+	ILI9163C_SPI = SPISettings(8000000, MSBFIRST, SPI_MODE0);
+	digitalWrite(_cs, HIGH);//CS is driven per burst
+	_burstDepth = 0;
+	_async = false;
 #else//all the rest of possible boards
 	pinMode(_rs, OUTPUT);
 	pinMode(_cs, OUTPUT);
@@ -747,6 +1013,12 @@ void TFT_ILI9163C::clearScreen(uint16_t color) {
 		}
 		writecommand_last(CMD_NOP);
 		SPI.endTransaction();
+	#elif defined(ESP32)
+		(void)px;
+		_beginBurst();
+		_setAddrWindow(0x00,0x00,_GRAMWIDTH,_GRAMHEIGH);//go home
+		_writeColorBurst(color,_GRAMSIZE);
+		_endBurst();
 	#else
 		setAddr(0x00,0x00,_GRAMWIDTH,_GRAMHEIGH);//go home
 		for (px = 0;px < _GRAMSIZE; px++){
@@ -756,7 +1028,12 @@ void TFT_ILI9163C::clearScreen(uint16_t color) {
 }
 
 void TFT_ILI9163C::startPushData(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
-	setAddr(x0,y0,x1,y1);
+	#if defined(ESP32)
+		_beginBurst();//held until endPushData()
+		_setAddrWindow(x0,y0,x1,y1);
+	#else
+		setAddr(x0,y0,x1,y1);
+	#endif
 }
 
 void TFT_ILI9163C::pushData(uint16_t color) {
@@ -772,6 +1049,8 @@ void TFT_ILI9163C::endPushData() {
 	#if defined(__MK20DX128__) || defined(__MK20DX256__)
 		writecommand_last(CMD_NOP);
 		SPI.endTransaction();
+	#elif defined(ESP32)
+		_endBurst();
 	#endif
 }
 
@@ -798,12 +1077,18 @@ void TFT_ILI9163C::writeScreen24(const uint32_t *bitmap,uint16_t size) {
 		_setAddrWindow(0x00,0x00,_GRAMWIDTH,_GRAMHEIGH);//home
 		SPI.endTransaction();
 	#else
+		#if defined(ESP32)
+			_beginBurst();
+		#endif
 		writecommand(CMD_RAMWR);
 		for (px = 0;px < size; px++){
 			color = Color24To565(bitmap[px]);
 			writedata16(color);
 		}
 		homeAddress();
+		#if defined(ESP32)
+			_endBurst();
+		#endif
 	#endif
 }
 
@@ -815,7 +1100,9 @@ void TFT_ILI9163C::homeAddress() {
 
 void TFT_ILI9163C::setCursor(int16_t x, int16_t y) {
 	if (boundaryCheck(x,y)) return;
-	setAddrWindow(0x00,0x00,x,y);
+	#if !defined(ESP32)//text goes through drawPixel, which sets its own window
+		setAddrWindow(0x00,0x00,x,y);
+	#endif
 	cursor_x = x;
 	cursor_y = y;
 }
@@ -827,6 +1114,13 @@ void TFT_ILI9163C::setCursor(int16_t x, int16_t y) {
 void TFT_ILI9163C::drawPixel(int16_t x, int16_t y, uint16_t color) {
 	if (boundaryCheck(x,y)) return;
 	if ((x < 0) || (y < 0)) return;
+	#if defined(ESP32)
+		_beginBurst();
+		_setAddrWindow(x,y,x+1,y+1);
+		writedata16(color);
+		_endBurst();
+		return;
+	#endif
 	setAddr(x,y,x+1,y+1);
 	#if defined(__MK20DX128__) || defined(__MK20DX256__)
 		writedata16_last(color);
@@ -842,6 +1136,14 @@ void TFT_ILI9163C::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color
 	// Rudimentary clipping
 	if (boundaryCheck(x,y)) return;
 	if (((y + h) - 1) >= _height) h = _height-y;
+	#if defined(ESP32)
+		if (h < 1) return;
+		_beginBurst();
+		_setAddrWindow(x,y,x,(y+h)-1);
+		_writeColorBurst(color,h);
+		_endBurst();
+		return;
+	#endif
 	setAddr(x,y,x,(y+h)-1);
 	while (h-- > 0) {
 		#if defined(__MK20DX128__) || defined(__MK20DX256__)
@@ -868,6 +1170,14 @@ void TFT_ILI9163C::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color
 	// Rudimentary clipping
 	if (boundaryCheck(x,y)) return;
 	if (((x+w) - 1) >= _width)  w = _width-x;
+	#if defined(ESP32)
+		if (w < 1) return;
+		_beginBurst();
+		_setAddrWindow(x,y,(x+w)-1,y);
+		_writeColorBurst(color,w);
+		_endBurst();
+		return;
+	#endif
 	setAddr(x,y,(x+w)-1,y);
 	while (w-- > 0) {
 		#if defined(__MK20DX128__) || defined(__MK20DX256__)
@@ -894,6 +1204,14 @@ void TFT_ILI9163C::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t
 	if (boundaryCheck(x,y)) return;
 	if (((x + w) - 1) >= _width)  w = _width  - x;
 	if (((y + h) - 1) >= _height) h = _height - y;
+	#if defined(ESP32)
+		if ((w < 1) || (h < 1)) return;
+		_beginBurst();
+		_setAddrWindow(x,y,(x+w)-1,(y+h)-1);
+		_writeColorBurst(color,(uint32_t)w * h);
+		_endBurst();
+		return;
+	#endif
 	setAddr(x,y,(x+w)-1,(y+h)-1);
 	for (y = h;y > 0;y--) {
 		for (x = w;x > 1;x--) {
@@ -1029,6 +1347,10 @@ void TFT_ILI9163C::setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t
 		SPI.beginTransaction(ILI9163C_SPI);
 		_setAddrWindow(x0,y0,x1,y1);
 		SPI.endTransaction();
+	#elif defined(ESP32)
+		_beginBurst();
+		_setAddrWindow(x0,y0,x1,y1);
+		_endBurst();
 	#else
 		writecommand(CMD_CLMADRS); // Column
 		if (rotation == 0 || rotation > 1){
@@ -1071,6 +1393,26 @@ void TFT_ILI9163C::_setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_
 	}
 	writecommand_cont(CMD_RAMWR); //Into RAM
 }
+#elif defined(ESP32)
+void TFT_ILI9163C::_setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+	writecommand(CMD_CLMADRS); // Column
+	if (rotation == 0 || rotation > 1){
+		writedata16(x0);
+		writedata16(x1);
+	} else {
+		writedata16(x0 + __OFFSET);
+		writedata16(x1 + __OFFSET);
+	}
+	writecommand(CMD_PGEADRS); // Page
+	if (rotation == 0){
+		writedata16(y0 + __OFFSET);
+		writedata16(y1 + __OFFSET);
+	} else {
+		writedata16(y0);
+		writedata16(y1);
+	}
+	writecommand(CMD_RAMWR); //Into RAM
+}
 #endif
 
 void TFT_ILI9163C::setRotation(uint8_t m) {
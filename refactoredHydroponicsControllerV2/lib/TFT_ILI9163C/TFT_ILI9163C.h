@@ -82,6 +82,10 @@
 	0.8:	Compatiblke with IDE 1.0.6 (teensyduino 1.20) and IDE 1.6.x (teensyduino 1.21b)
 	0.9:    Many changes! Now works with more CPU's, alternative pins for Teensy and Teensy LC
 	Works (in standard SPI) with Teensy LC.
+	0.9e1:  ESP32 backend. One SPI transaction per primitive, pixel runs streamed
+	with writeBytes/writePixels instead of one transaction per pixel.
+	0.9e2:  ESP32 async mode, pixel blocks queued to the SPI master DMA with
+	completion callback (beginAsync, pushRectAsync, waitAsync).
 	+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 	BugList of the current version:
 	
@@ -114,6 +118,13 @@ Done!
 
 #include "_settings/TFT_ILI9163C_settings.h"
 
+#if defined(ESP32)
+	#include "driver/spi_master.h"
+	#include "driver/gpio.h"
+	#define _ASYNC_QUEUE	6//in flight DMA transactions
+	#define _ASYNC_CHUNK	8192//bytes per DMA transaction
+#endif
+
 #if !defined(_ADAFRUIT_GFX_VARIANT)
 	#ifdef __AVR__
 		#include <avr/pgmspace.h>
@@ -179,6 +190,21 @@ class TFT_ILI9163C : public Adafruit_GFX {
   //convert 24bit color into packet 16 bit one (credits for this are all mine)
 	inline uint16_t Color24To565(int32_t color_) { return ((((color_ >> 16) & 0xFF) / 8) << 11) | ((((color_ >> 8) & 0xFF) / 4) << 5) | (((color_) &  0xFF) / 8);}
 	void 		setBitrate(uint32_t n);	
+	#if defined(ESP32)
+	void		pushColors(const uint16_t *colors, uint32_t len);//stream into current window
+	void		startWrite(void);//Adafruit_GFX hooks, keep one transaction per glyph/shape
+	void		endWrite(void);
+	//async DMA mode: takes the SPI host over from the Arduino driver, call after begin()
+	//false if the IDF driver refused it; the Arduino driver then keeps the host
+	bool		beginAsync(int8_t sck, int8_t mosi, uint32_t hz = 8000000);
+	//queue a w*h block of big endian (panel order) pixels and return at once,
+	//the buffer must stay untouched until the transfer is done (blocking without beginAsync)
+	bool		pushRectAsync(int16_t x, int16_t y, int16_t w, int16_t h, const uint16_t *pixels);
+	bool		waitAsync(uint32_t timeoutMs = 1000);//true when the wire is idle
+	bool		asyncBusy(void);
+	void		onAsyncDone(void (*cb)(void *arg), void *arg);//called from ISR!
+	bool		isAsync(void) { return _async; }
+	#endif
  protected:
 	volatile uint8_t		_Mactrl_Data;//container for the memory access control data
 	uint8_t					_colorspaceData;
@@ -397,6 +423,19 @@ class TFT_ILI9163C : public Adafruit_GFX {
 			_setAddrWindow(x, y, x, y);
 			writedata16_cont(color);
 		}
+	#elif defined(ESP32)
+		uint8_t 			_cs,_rs,_rst;
+		uint8_t				_burstDepth;//nesting level of the open SPI transaction
+		void				_beginBurst(void);
+		void				_endBurst(void);
+		void				_setAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1);//caller holds burst
+		void				_writeColorBurst(uint16_t color, uint32_t len);//caller holds burst
+		void				_spiWrite(const uint8_t *data, uint32_t len, bool dc);
+		bool				_async;
+		spi_device_handle_t	_spiDev;
+		spi_transaction_t	_asyncTrans[_ASYNC_QUEUE];
+		uint8_t				_asyncNext;
+		volatile uint8_t	_asyncInFlight;
 	#else
 		uint8_t 			_cs,_rs,_rst;	
 	#endif
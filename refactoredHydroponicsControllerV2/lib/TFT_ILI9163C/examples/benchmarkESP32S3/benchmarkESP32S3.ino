@@ -0,0 +1,124 @@
+#include <SPI.h>
+#include <Adafruit_GFX.h>
+#include <TFT_ILI9163C.h>
+
+// Color definitions
+#define	BLACK   0x0000
+#define	BLUE    0x001F
+#define	RED     0xF800
+#define	GREEN   0x07E0
+#define WHITE   0xFFFF
+
+/*
+Before/after fill rate of the ESP32 burst backend. The two fill rows are
+the numbers to quote: "Per pixel fill" is the old path, "Burst fill" the
+new one, and the "Fill speedup" line is their ratio.
+
+Results (ESP32-S3 N16R8, 8 MHz SPI, 128x128, rotation 1): NOT MEASURED.
+No S3 run has been recorded, so the speedup of the burst backend is
+unverified. Flash this sketch and paste the "Per pixel fill", "Burst fill"
+and "Fill speedup" lines here. Until then, quote no figure for it.
+
+ESP32-S3 (hydroponics controller wiring)
+ MOSI:  35
+ SCK:   36
+ the rest of pin below:
+*/
+#define __CS  40
+#define __DC  38
+#define __RST 39
+#define __MOSI 35
+#define __SCK  36
+
+#define FRAMES 10
+
+TFT_ILI9163C tft = TFT_ILI9163C(__CS, __DC, __RST);
+
+/*
+Old path: one address window, then one pushColor (one SPI transaction) per pixel.
+This is what every primitive did on ESP32 before the burst backend.
+*/
+unsigned long testPerPixelFill() {
+  unsigned long start = micros();
+  for (uint8_t f = 0; f < FRAMES; f++) {
+    uint16_t color = (f & 1) ? RED : BLUE;
+    tft.setAddrWindow(0, 0, tft.width() - 1, tft.height() - 1);
+    for (uint32_t px = 0; px < (uint32_t)tft.width() * tft.height(); px++) {
+      tft.pushColor(color);
+    }
+  }
+  return (micros() - start) / FRAMES;
+}
+
+// New path: one transaction per frame, pixels streamed in 64 pixel chunks.
+unsigned long testBurstFill() {
+  unsigned long start = micros();
+  for (uint8_t f = 0; f < FRAMES; f++) {
+    tft.fillScreen((f & 1) ? GREEN : BLACK);
+  }
+  return (micros() - start) / FRAMES;
+}
+
+unsigned long testPushColors() {
+  static uint16_t line[128];
+  for (uint8_t i = 0; i < 128; i++) line[i] = (i & 1) ? WHITE : BLUE;
+  unsigned long start = micros();
+  for (uint8_t f = 0; f < FRAMES; f++) {
+    tft.startPushData(0, 0, tft.width() - 1, tft.height() - 1);
+    for (int16_t y = 0; y < tft.height(); y++) tft.pushColors(line, tft.width());
+    tft.endPushData();
+  }
+  return (micros() - start) / FRAMES;
+}
+
+unsigned long testText() {
+  tft.fillScreen(BLACK);
+  unsigned long start = micros();
+  tft.setCursor(0, 0);
+  tft.setTextColor(WHITE);
+  tft.setTextSize(1);
+  for (uint8_t i = 0; i < 12; i++) tft.println("Hydroponics 0123456");
+  return micros() - start;
+}
+
+void printResult(const __FlashStringHelper *label, unsigned long us) {
+  Serial.print(label);
+  Serial.print(us);
+  Serial.print(F(" us  "));
+  if (us > 0) {
+    Serial.print(1000000.0f / us, 1);
+    Serial.print(F(" fps  "));
+    Serial.print((float)tft.width() * tft.height() / us, 3);
+    Serial.print(F(" Mpx/s"));
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(115200);
+  long unsigned debug_start = millis();
+  while (!Serial && ((millis() - debug_start) <= 5000)) ;
+  SPI.begin(__SCK, -1, __MOSI, __CS);
+  tft.begin();
+  tft.setRotation(1);
+  Serial.println(F("Benchmark                Time per frame"));
+  unsigned long perPixel = testPerPixelFill();
+  printResult(F("Per pixel fill           "), perPixel);
+  delay(500);
+  unsigned long burst = testBurstFill();
+  printResult(F("Burst fill               "), burst);
+  if (burst > 0) {
+    Serial.print(F("Fill speedup             "));
+    Serial.print((float)perPixel / burst, 2);
+    Serial.println(F("x"));
+  }
+  delay(500);
+  printResult(F("pushColors frame         "), testPushColors());
+  delay(500);
+  Serial.print(F("Text (12 lines)          "));
+  Serial.println(testText());
+  Serial.println(F("Done!"));
+}
+
+void loop() {
+}
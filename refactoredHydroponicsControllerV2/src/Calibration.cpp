@@ -0,0 +1,296 @@
+/*
+ * Calibration.cpp
+ *
+ * Pump calibration wizard state machine (driven from loop()) and flow
+ * curve lookups used by the dosing engine.
+ */
+
+#include "Calibration.h"
+#include "DosingEngine.h"
+#include "DisplayQueue.h"
+#include "Hardware.h"
+#include "Persistence.h"
+#include "Tasks.h"
+#include <esp_timer.h>
+
+enum CalibrationRequest : uint8_t {
+  CAL_REQ_NONE,
+  CAL_REQ_START,
+  CAL_REQ_STEP,
+  CAL_REQ_SAVE,
+  CAL_REQ_CANCEL
+};
+
+// Posted by the menu, taken by loop()
+static volatile CalibrationRequest pendingRequest = CAL_REQ_NONE;
+static volatile uint8_t requestedPump = 0;
+
+// Wizard state, written by loop() (volume also by the menu) under calMux
+static CalibrationState calState = CAL_IDLE;
+static uint8_t calPump = 0;
+static uint8_t calPoint = 0;
+static unsigned long runStartMs = 0;
+static int64_t runStartUs = 0;
+static int64_t runMicros = 0;
+static uint16_t enteredVolume = 0;
+static float measuredFlow[CAL_POINT_COUNT];
+static PumpCalibration result;
+
+static portMUX_TYPE calMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================================================
+// FLOW CURVES
+// ==================================================
+float pumpFlowAtDuty(const PumpCalibration &cal, uint8_t duty) {
+  if (cal.pointCount == 0) {
+    // Single-speed calibration: assume flow proportional to duty
+    if (cal.pwmSpeed == 0 || cal.mlPerSecond <= 0) return 0;
+    return cal.mlPerSecond * duty / cal.pwmSpeed;
+  }
+
+  if (duty < cal.pointDuty[0]) return 0;
+  for (uint8_t i = 1; i < cal.pointCount; i++) {
+    if (duty > cal.pointDuty[i]) continue;
+    float span = cal.pointDuty[i] - cal.pointDuty[i - 1];
+    float t = (duty - cal.pointDuty[i - 1]) / span;
+    return cal.pointFlow[i - 1] + t * (cal.pointFlow[i] - cal.pointFlow[i - 1]);
+  }
+  return cal.pointFlow[cal.pointCount - 1];
+}
+
+bool choosePumpDuty(const PumpCalibration &cal, uint16_t amountML, uint8_t &duty, float &mlPerSecond) {
+  if (cal.pointCount == 0) {
+    duty = cal.pwmSpeed;
+    mlPerSecond = cal.mlPerSecond;
+    return mlPerSecond > 0;
+  }
+
+  float targetML = amountML / 10.0;
+  mlPerSecond = 0;
+  for (int i = cal.pointCount - 1; i >= 0; i--) {
+    if (cal.pointFlow[i] <= 0) continue;
+    duty = cal.pointDuty[i];
+    mlPerSecond = cal.pointFlow[i];
+    if (targetML / mlPerSecond * 1000.0f >= CAL_MIN_DOSE_RUN_MS) break;
+  }
+  return mlPerSecond > 0;
+}
+
+// ==================================================
+// REQUESTS
+// ==================================================
+static void postRequest(CalibrationRequest request) {
+  portENTER_CRITICAL(&calMux);
+  pendingRequest = request;
+  portEXIT_CRITICAL(&calMux);
+}
+
+static CalibrationRequest takeRequest() {
+  portENTER_CRITICAL(&calMux);
+  CalibrationRequest request = pendingRequest;
+  pendingRequest = CAL_REQ_NONE;
+  portEXIT_CRITICAL(&calMux);
+  return request;
+}
+
+void requestPumpCalibration(uint8_t pumpNumber) {
+  if (pumpNumber < 1 || pumpNumber > DOSING_PUMP_COUNT) return;
+  requestedPump = pumpNumber;
+  postRequest(CAL_REQ_START);
+}
+
+void requestCalibrationStep() {
+  postRequest(CAL_REQ_STEP);
+}
+
+void requestCalibrationSave() {
+  postRequest(CAL_REQ_SAVE);
+}
+
+void requestCalibrationCancel() {
+  postRequest(CAL_REQ_CANCEL);
+}
+
+void adjustCalibrationVolume(int delta) {
+  portENTER_CRITICAL(&calMux);
+  if (calState == CAL_MEASURE) {
+    int volume = (int)enteredVolume + delta;
+    if (volume < 0) volume = 0;
+    if (volume > CAL_MAX_VOLUME) volume = CAL_MAX_VOLUME;
+    enteredVolume = (uint16_t)volume;
+  }
+  portEXIT_CRITICAL(&calMux);
+}
+
+// ==================================================
+// WIZARD
+// ==================================================
+static void setState(CalibrationState state) {
+  portENTER_CRITICAL(&calMux);
+  calState = state;
+  portEXIT_CRITICAL(&calMux);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+}
+
+static void startRun(unsigned long currentTime) {
+  uint8_t duty = CAL_DUTY_LEVELS[calPoint];
+  setPumpSpeed(calPump, duty);
+  runStartUs = esp_timer_get_time();
+  runStartMs = currentTime;
+  setState(CAL_RUNNING);
+
+  Serial.print("[CAL] Pump ");
+  Serial.print(calPump);
+  Serial.print(" running at ");
+  Serial.print(duty);
+  Serial.println("%");
+}
+
+// The flow is taken over the measured run time, so a late stop from a
+// stalled loop() only collects more liquid
+static void stopRun() {
+  setPumpSpeed(calPump, 0);
+  runMicros = esp_timer_get_time() - runStartUs;
+
+  // Start the volume entry at what the current calibration predicts
+  float predicted = pumpFlowAtDuty(pumpCalibrations[calPump - 1], CAL_DUTY_LEVELS[calPoint]) * runMicros / 100000.0;
+  portENTER_CRITICAL(&calMux);
+  enteredVolume = (uint16_t)constrain((long)(predicted + 0.5f), 0L, (long)CAL_MAX_VOLUME);
+  calState = CAL_MEASURE;
+  portEXIT_CRITICAL(&calMux);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+}
+
+// Measured points in duty order, dropping any that do not raise the flow
+// (pump stalled, or a misread volume)
+static bool buildCurve() {
+  result = pumpCalibrations[calPump - 1];
+  result.pointCount = 0;
+  float lastFlow = 0;
+  for (uint8_t i = 0; i < CAL_POINT_COUNT; i++) {
+    if (measuredFlow[i] <= lastFlow) {
+      Serial.print("[CAL] Dropped point at ");
+      Serial.print(CAL_DUTY_LEVELS[i]);
+      Serial.println("%: flow does not increase");
+      continue;
+    }
+    result.pointDuty[result.pointCount] = CAL_DUTY_LEVELS[i];
+    result.pointFlow[result.pointCount] = measuredFlow[i];
+    result.pointCount++;
+    lastFlow = measuredFlow[i];
+  }
+  if (result.pointCount == 0) return false;
+
+  result.pwmSpeed = result.pointDuty[result.pointCount - 1];
+  result.mlPerSecond = result.pointFlow[result.pointCount - 1];
+  result.timeMs = CAL_RUN_MS;
+  result.isCalibrated = true;
+  return true;
+}
+
+static void acceptMeasurement() {
+  float seconds = runMicros / 1000000.0;
+  float volumeML = enteredVolume / 10.0;
+  measuredFlow[calPoint] = seconds > 0 ? volumeML / seconds : 0;
+
+  Serial.print("[CAL] Pump ");
+  Serial.print(calPump);
+  Serial.print(" at ");
+  Serial.print(CAL_DUTY_LEVELS[calPoint]);
+  Serial.print("%: ");
+  Serial.print(volumeML, 1);
+  Serial.print(" mL in ");
+  Serial.print(seconds, 3);
+  Serial.print(" s = ");
+  Serial.print(measuredFlow[calPoint], 3);
+  Serial.println(" mL/s");
+
+  calPoint++;
+  if (calPoint < CAL_POINT_COUNT) {
+    setState(CAL_READY);
+  } else if (buildCurve()) {
+    setState(CAL_REVIEW);
+  } else {
+    Serial.println("[CAL] No flow measured, calibration failed");
+    setState(CAL_FAILED);
+  }
+}
+
+void updatePumpCalibration(unsigned long currentTime) {
+  CalibrationRequest request = takeRequest();
+
+  switch (request) {
+    case CAL_REQ_START:
+      if (calState == CAL_RUNNING) break;
+      calPump = requestedPump;
+      calPoint = 0;
+      memset(measuredFlow, 0, sizeof(measuredFlow));
+      setState(CAL_READY);
+      break;
+
+    case CAL_REQ_STEP:
+      if (calState == CAL_READY) {
+        // Let a dose already running on this pump finish first
+        if (isPumpDosing(calPump)) {
+          postRequest(CAL_REQ_STEP);
+          break;
+        }
+        startRun(currentTime);
+      } else if (calState == CAL_MEASURE) {
+        acceptMeasurement();
+      }
+      break;
+
+    case CAL_REQ_SAVE:
+      if (calState != CAL_REVIEW) break;
+      pumpCalibrations[calPump - 1] = result;
+      persistSections(PERSIST_PUMP_CAL);
+      Serial.print("[CAL] Pump ");
+      Serial.print(calPump);
+      Serial.print(" calibrated with ");
+      Serial.print(result.pointCount);
+      Serial.println(" points");
+      setState(CAL_IDLE);
+      break;
+
+    case CAL_REQ_CANCEL:
+      if (calState == CAL_RUNNING) setPumpSpeed(calPump, 0);
+      if (calState != CAL_IDLE) Serial.println("[CAL] Calibration cancelled");
+      setState(CAL_IDLE);
+      break;
+
+    default:
+      break;
+  }
+
+  if (calState == CAL_RUNNING && (unsigned long)(currentTime - runStartMs) >= CAL_RUN_MS) {
+    stopRun();
+  }
+}
+
+// ==================================================
+// STATUS
+// ==================================================
+CalibrationStatus getCalibrationStatus() {
+  CalibrationStatus status;
+  portENTER_CRITICAL(&calMux);
+  status.state = calState;
+  status.pump = calPump;
+  status.point = calPoint;
+  status.volume = enteredVolume;
+  status.requestPending = pendingRequest != CAL_REQ_NONE;
+  portEXIT_CRITICAL(&calMux);
+
+  status.duty = CAL_DUTY_LEVELS[min<uint8_t>(status.point, CAL_POINT_COUNT - 1)];
+  status.elapsedMs = status.state == CAL_RUNNING ? (unsigned long)(millis() - runStartMs) : 0;
+  status.result = result;
+  return status;
+}
+
+bool isPumpCalibrationActive() {
+  return calState != CAL_IDLE;
+}
+
+bool isPumpCalibrating(uint8_t pumpNumber) {
+  return calState != CAL_IDLE && calPump == pumpNumber;
+}
@@ -0,0 +1,95 @@
+/*
+ * DisplayQueue.cpp
+ *
+ * Bounded multi-producer / single-consumer ring of draw commands. Each
+ * slot carries a sequence number: a producer claims a ticket with one
+ * compare-and-swap on the head, fills the slot, then publishes it by bumping
+ * the slot sequence, so no producer ever waits on a lock or on the renderer.
+ */
+
+#include "DisplayQueue.h"
+#include "Tasks.h"
+#include <atomic>
+
+struct DrawSlot {
+  std::atomic<uint32_t> seq;    // Stored relative to the slot index, see below
+  DrawCommand cmd;
+};
+
+// Slot i is free for ticket `pos` when its sequence equals pos, and holds a
+// published command for ticket `pos` when it equals pos + 1. Sequences are
+// stored minus the slot index so the zero-initialised ring starts out with
+// every slot free, without an init call that producers could race.
+static DrawSlot drawRing[DRAW_QUEUE_SIZE];
+static std::atomic<uint32_t> drawHead(0);   // Next ticket to claim (producers)
+static uint32_t drawTail = 0;               // Next ticket to read (DisplayTask)
+static std::atomic<uint32_t> drawDropped(0);
+
+static inline uint32_t slotSeq(uint32_t i) {
+  return drawRing[i].seq.load(std::memory_order_acquire) + i;
+}
+
+static inline void publishSeq(uint32_t i, uint32_t seq) {
+  drawRing[i].seq.store(seq - i, std::memory_order_release);
+}
+
+// ==================================================
+// PRODUCERS
+// ==================================================
+bool postDrawCommand(const DrawCommand& cmd) {
+  uint32_t pos = drawHead.load(std::memory_order_relaxed);
+  for (;;) {
+    uint32_t i = pos & (DRAW_QUEUE_SIZE - 1);
+    int32_t diff = (int32_t)(slotSeq(i) - pos);
+
+    if (diff == 0) {
+      if (drawHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        drawRing[i].cmd = cmd;
+        publishSeq(i, pos + 1);
+        postDisplayEvent(DISPLAY_EVT_COMMAND);
+        return true;
+      }
+      // pos was reloaded by the failed CAS, try again
+    } else if (diff < 0) {
+      // Renderer is DRAW_QUEUE_SIZE commands behind
+      if (drawDropped.fetch_add(1, std::memory_order_relaxed) == 0) {
+        Serial.println("[DISPLAY] Draw queue full, command dropped");
+      }
+      return false;
+    } else {
+      pos = drawHead.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool displayNotify(const char* text, uint16_t color, uint16_t ms) {
+  DrawCommand cmd;
+  cmd.type = DRAW_CMD_NOTIFY;
+  cmd.color = color;
+  cmd.durationMs = ms;
+  strncpy(cmd.text, text, DRAW_NOTIFY_TEXT_LEN);
+  cmd.text[DRAW_NOTIFY_TEXT_LEN] = '\0';
+  return postDrawCommand(cmd);
+}
+
+bool requestDisplayRedraw() {
+  DrawCommand cmd;
+  cmd.type = DRAW_CMD_REDRAW;
+  cmd.color = 0;
+  cmd.durationMs = 0;
+  cmd.text[0] = '\0';
+  return postDrawCommand(cmd);
+}
+
+// ==================================================
+// CONSUMER
+// ==================================================
+bool popDrawCommand(DrawCommand& cmd) {
+  uint32_t i = drawTail & (DRAW_QUEUE_SIZE - 1);
+  if (slotSeq(i) != drawTail + 1) return false;   // Empty, or producer still filling
+
+  cmd = drawRing[i].cmd;
+  publishSeq(i, drawTail + DRAW_QUEUE_SIZE);
+  drawTail++;
+  return true;
+}
@@ -5,27 +5,74 @@
  */
 
 #include "DisplayUI.h"
+#include "Calibration.h"
+#include "ReplaceSolution.h"
+#include "TimeService.h"
 
 #define DARKGREY 0x7BEF   // or any grey shade you like
 
 void showSplash(const char* msg, uint16_t color, uint16_t ms) {
   // Simple centered toast-style message
-  tft.fillRect(0, 52, 128, 24, BLACK);
-  tft.setTextSize(1);
-  tft.setTextColor(color);
+  canvas.fillRect(0, 52, 128, 24, BLACK);
+  canvas.setTextSize(1);
+  canvas.setTextColor(color);
   
   // crude centering: each char ~6px at size 1
   int len = strlen(msg);
   int x = max(0, (128 - len * 6) / 2);
-  tft.setCursor(x, 60);
-  tft.print(msg);
+  canvas.setCursor(x, 60);
+  canvas.print(msg);
+  canvas.flush();
 
   delay(ms);
 
   // force menu to redraw after toast
-  menuNav.needsFullRedraw = true;
   menuNav.needsRedraw = true;
-  menuNav.lastDrawnIndex = -1;
+}
+
+// ==================================================
+// QUEUED NOTIFICATIONS
+// ==================================================
+// A notification is a banner along the bottom row of whatever screen is up.
+// It is drawn as the last step of drawMenu(), so the canvas diff only sends
+// the banner tiles, and it clears on the first clock tick after it expires.
+
+#define NOTIFY_BANNER_Y  116
+#define NOTIFY_BANNER_H  12
+
+static char notifyText[DRAW_NOTIFY_TEXT_LEN + 1] = "";
+static uint16_t notifyColor = YELLOW;
+static unsigned long notifyUntil = 0;
+
+static void drawNotificationBanner() {
+  if (notifyText[0] == '\0') return;
+
+  canvas.fillRect(0, NOTIFY_BANNER_Y, 128, NOTIFY_BANNER_H, notifyColor);
+  int x = max(0, (128 - (int)strlen(notifyText) * GLYPH_ADVANCE) / 2);
+  canvas.drawText(x, NOTIFY_BANNER_Y + 2, notifyText, BLACK, notifyColor);
+}
+
+void applyDrawCommand(const DrawCommand& cmd) {
+  switch (cmd.type) {
+    case DRAW_CMD_NOTIFY:
+      strcpy(notifyText, cmd.text);
+      notifyColor = cmd.color;
+      notifyUntil = millis() + cmd.durationMs;
+      menuNav.needsRedraw = true;
+      break;
+
+    case DRAW_CMD_REDRAW:
+      menuNav.needsRedraw = true;
+      break;
+  }
+}
+
+void expireNotification(unsigned long currentTime) {
+  if (notifyText[0] == '\0') return;
+  if ((long)(currentTime - notifyUntil) < 0) return;
+
+  notifyText[0] = '\0';
+  menuNav.needsRedraw = true;
 }
 
 void drawCircleIndicator(int x, int y, bool connected) {
@@ -33,152 +80,100 @@ void drawCircleIndicator(int x, int y, bool connected) {
   uint16_t color = connected ? 0x07E0 : RED;
   // Draw filled circle - 7 pixels tall (same as text height)
   // Center point at x+3, y+3
-  tft.fillRect(x+1, y, 5, 7, color);      // Main vertical bar
-  tft.fillRect(x, y+1, 7, 5, color);      // Main horizontal bar
-  tft.drawPixel(x+1, y+1, color);         // Round top-left
-  tft.drawPixel(x+5, y+1, color);         // Round top-right
-  tft.drawPixel(x+1, y+5, color);         // Round bottom-left
-  tft.drawPixel(x+5, y+5, color);         // Round bottom-right
+  canvas.fillRect(x+1, y, 5, 7, color);      // Main vertical bar
+  canvas.fillRect(x, y+1, 7, 5, color);      // Main horizontal bar
+  canvas.drawPixel(x+1, y+1, color);         // Round top-left
+  canvas.drawPixel(x+5, y+1, color);         // Round top-right
+  canvas.drawPixel(x+1, y+5, color);         // Round bottom-left
+  canvas.drawPixel(x+5, y+5, color);         // Round bottom-right
 }
 
 // Draw status bar with date, time, and connection status
+// Text goes through the glyph blitter with the background baked in, so a
+// field is simply overwritten in place; every field has a fixed width.
 
-void drawStatusBar() {
-  // Month names
-  const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
-                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
-  const char* days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
-
-  // Get current time
-  DateTime now = rtc.now();
-
-  // ====== TOP LINE - Date, Day, Time (evenly distributed) ======
-  // Layout: "01/15"  "MON"  "14:30:45"
-  // Positions: 2px, 46px, 80px (user adjusted)
-
-  tft.setTextSize(1);
-  tft.setTextColor(GREEN);  // ALL GREEN
+static void drawStatusDate(const DateTime& now) {
+  static const char* const days[] = {"SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+  char buf[8];
 
   // Date: "01/15" at x=2
-  tft.setCursor(2, 2);
-  if (now.month() < 10) tft.print("0");
-  tft.print(now.month());
-  tft.print("/");
-  if (now.day() < 10) tft.print("0");
-  tft.print(now.day());
+  snprintf(buf, sizeof(buf), "%02d/%02d", now.month(), now.day());
+  canvas.drawText(2, 2, buf, GREEN, BLACK);
 
   // Day: "MON" at x=46 (user adjusted)
-  tft.setCursor(46, 2);
-  // Convert to uppercase
-  const char* dayName = days[now.dayOfTheWeek()];
-  for (int i = 0; dayName[i] != '\0'; i++) {
-    tft.print((char)toupper(dayName[i]));
-  }
+  canvas.drawText(46, 2, days[now.dayOfTheWeek()], GREEN, BLACK);
+}
+
+static void drawStatusTime(const DateTime& now) {
+  char buf[12];
 
   // Time: "14:30:45" at x=80 (user adjusted)
-  tft.setCursor(80, 2);
-  if (now.hour() < 10) tft.print("0");
-  tft.print(now.hour());
-  tft.print(":");
-  if (now.minute() < 10) tft.print("0");
-  tft.print(now.minute());
-  tft.print(":");
-  if (now.second() < 10) tft.print("0");
-  tft.print(now.second());
+  snprintf(buf, sizeof(buf), "%02d:%02d:%02d", now.hour(), now.minute(), now.second());
+  canvas.drawText(80, 2, buf, GREEN, BLACK);
+}
+
+static void drawStatusSync() {
+  char buf[8];
+
+  // Last RTC sync time at x=98
+  snprintf(buf, sizeof(buf), "%02d:%02d", lastSyncHour, lastSyncMinute);
+  canvas.drawText(98, 10, buf, GREEN, BLACK);
+}
+
+void drawStatusBar() {
+  // Get current time
+  DateTime now = timeNow();
+
+  // ====== TOP LINE - Date, Day, Time (evenly distributed) ======
+  // Layout: "01/15"  "MON"  "14:30:45"
+  // Positions: 2px, 46px, 80px (user adjusted)
+  drawStatusDate(now);
+  drawStatusTime(now);
 
   // ====== SECOND LINE - WiFi, MQTT, Test LED, RTC Sync ======
   // Layout: "WiFi ●  MQTT ● ●      14:25"
   // Positions: x=2, x=30, x=42, x=68, x=76, x=98
   // WiFi text(2) + circle(30) | MQTT text(42) + circle(68) | Test circle(76) | Sync(98)
 
-  tft.setTextColor(GREEN);  // ALL GREEN
-
   // WiFi status at x=2
-  tft.setCursor(2, 10);
-  tft.print("WiFi");
+  canvas.drawText(2, 10, "WiFi", GREEN, BLACK);
   drawCircleIndicator(30, 10, wifiConnected);  // Circle at x=30
 
   // MQTT status at x=42
-  tft.setCursor(42, 10);
-  tft.print("MQTT");
+  canvas.drawText(42, 10, "MQTT", GREEN, BLACK);
   drawCircleIndicator(68, 10, mqtt.connected());  // Circle at x=68
 
   // Test LED indicator at x=76 (no text, just circle beside MQTT)
   drawCircleIndicator(76, 10, testLedState);  // GREEN when ON, RED when OFF
 
-  // Last RTC sync time at x=98
-  tft.setCursor(98, 10);
-  if (lastSyncHour < 10) tft.print("0");
-  tft.print(lastSyncHour);
-  tft.print(":");
-  if (lastSyncMinute < 10) tft.print("0");
-  tft.print(lastSyncMinute);
+  drawStatusSync();
 
   // No horizontal line - just blank space separator
 }
 
-// Update status bar periodically (non-blocking, selective updates only)
+// Update status bar (non-blocking, selective updates only). Called by
+// DisplayTask on the one-second clock tick and on status events.
 
 void updateStatusBar() {
-  unsigned long currentTime = millis();
-
-  // Only update if on main menu and enough time has passed
+  // Only update if on main menu
   if (menuNav.currentMenu != MENU_MAIN) return;
-  if (currentTime - lastStatusBarUpdate < STATUS_BAR_UPDATE_INTERVAL) return;
 
-  lastStatusBarUpdate = currentTime;
-
-  // Month and day names
-  const char* months[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
-                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
-  const char* days[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+  lastStatusBarUpdate = millis();
 
   // Get current time
-  DateTime now = rtc.now();
-
-  tft.setTextSize(1);
-  tft.setTextColor(GREEN);  // ALL GREEN
+  DateTime now = timeNow();
 
   // ====== UPDATE ONLY CHANGED ELEMENTS ======
 
-  // Update date if day changed (x=2, y=2)
+  // Update date and day of week if day changed
   if (now.day() != lastDisplayedDay) {
-    tft.fillRect(2, 2, 36, 8, BLACK);  // Clear wider area to prevent artifacts
-    tft.setTextSize(1);  // Ensure correct text size
-    tft.setTextColor(GREEN);  // Ensure correct color
-    tft.setCursor(2, 2);  // Always set cursor explicitly
-    if (now.month() < 10) tft.print("0");
-    tft.print(now.month());
-    tft.print("/");
-    if (now.day() < 10) tft.print("0");
-    tft.print(now.day());
+    drawStatusDate(now);
     lastDisplayedDay = now.day();
-
-    // Also update day of week (x=46, y=2) - UPPERCASE - USER ADJUSTED
-    tft.fillRect(46, 2, 24, 8, BLACK);  // Clear wider area to prevent artifacts
-    tft.setCursor(46, 2);
-    const char* dayName = days[now.dayOfTheWeek()];
-    for (int i = 0; dayName[i] != '\0'; i++) {
-      tft.print((char)toupper(dayName[i]));
-    }
   }
 
-  // Update time - only seconds change frequently (x=80, y=2) - USER ADJUSTED
-  bool timeChanged = false;
+  // Update time - only seconds change frequently (x=80, y=2)
   if (now.hour() != lastDisplayedHour || now.minute() != lastDisplayedMinute || now.second() != lastDisplayedSecond) {
-    tft.fillRect(80, 2, 48, 8, BLACK);  // Clear to edge to prevent artifacts
-    tft.setTextSize(1);  // Ensure correct text size
-    tft.setTextColor(GREEN);  // Ensure correct color
-    tft.setCursor(80, 2);  // Always set cursor explicitly
-    if (now.hour() < 10) tft.print("0");
-    tft.print(now.hour());
-    tft.print(":");
-    if (now.minute() < 10) tft.print("0");
-    tft.print(now.minute());
-    tft.print(":");
-    if (now.second() < 10) tft.print("0");
-    tft.print(now.second());
-
+    drawStatusTime(now);
     lastDisplayedHour = now.hour();
     lastDisplayedMinute = now.minute();
     lastDisplayedSecond = now.second();
@@ -186,7 +181,7 @@ void updateStatusBar() {
 
   // Update WiFi circle if state changed (x=30, y=10)
   if (wifiConnected != lastWifiState) {
-    tft.fillRect(28, 10, 10, 8, BLACK);  // Clear wider area including circle
+    canvas.fillRect(28, 10, 10, 8, BLACK);  // Clear wider area including circle
     drawCircleIndicator(30, 10, wifiConnected);
     lastWifiState = wifiConnected;
   }
@@ -194,25 +189,16 @@ void updateStatusBar() {
   // Update MQTT circle if state changed (x=68, y=10) - moved closer to WiFi
   bool mqttState = mqtt.connected();
   if (mqttState != lastMqttState) {
-    tft.fillRect(66, 10, 10, 8, BLACK);  // Clear wider area including circle
+    canvas.fillRect(66, 10, 10, 8, BLACK);  // Clear wider area including circle
     drawCircleIndicator(68, 10, mqttState);
     lastMqttState = mqttState;
   }
 
   // Sync time rarely changes, so only update when it actually changes
-  // Check if we need to update sync time display
   static uint8_t displayedSyncHour = 255;
   static uint8_t displayedSyncMinute = 255;
   if (lastSyncHour != displayedSyncHour || lastSyncMinute != displayedSyncMinute) {
-    // Sync time changed, update display
-    tft.fillRect(98, 10, 30, 8, BLACK);  // Clear sync time area
-    tft.setCursor(98, 10);
-    tft.setTextColor(GREEN);
-    if (lastSyncHour < 10) tft.print("0");
-    tft.print(lastSyncHour);
-    tft.print(":");
-    if (lastSyncMinute < 10) tft.print("0");
-    tft.print(lastSyncMinute);
+    drawStatusSync();
     displayedSyncHour = lastSyncHour;
     displayedSyncMinute = lastSyncMinute;
   }
@@ -220,10 +206,12 @@ void updateStatusBar() {
   // Update test LED indicator if state changed (x=76, y=10) - beside MQTT
   static bool lastTestLedState = false;
   if (testLedState != lastTestLedState) {
-    tft.fillRect(74, 10, 10, 8, BLACK);  // Clear test LED circle area
+    canvas.fillRect(74, 10, 10, 8, BLACK);  // Clear test LED circle area
     drawCircleIndicator(76, 10, testLedState);
     lastTestLedState = testLedState;
   }
+
+  canvas.flush();
 }
 
 void drawGenericMenu(const char* title,
@@ -234,14 +222,8 @@ void drawGenericMenu(const char* title,
                      int textX,
                      int startY) 
 {
-  // Draw title only on full redraw
-  if (menuNav.lastDrawnIndex == -1) {
-    tft.setTextSize(1);
-    tft.setCursor(2, 2);
-    tft.setTextColor(YELLOW);
-    tft.print(title);
-    tft.drawFastHLine(0, 10, 128, YELLOW);
-  }
+  canvas.drawText(2, 2, title, YELLOW, BLACK);
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
 
   int visibleItems = useScrolling ? MENU_ITEMS_PER_PAGE : itemCount;
 
@@ -249,109 +231,34 @@ void drawGenericMenu(const char* title,
     int itemIndex = useScrolling ? (i + menuNav.scrollOffset) : i;
     int y = startY + (i * MENU_ITEM_HEIGHT);
 
-    bool isSelected  = (itemIndex == menuNav.selectedIndex);
-    bool wasSelected = (itemIndex == menuNav.lastDrawnIndex);
-
-    if (isSelected != wasSelected || menuNav.lastDrawnIndex == -1) {
-
-      // Clear row
-      tft.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLACK);
+    bool isSelected = (itemIndex == menuNav.selectedIndex);
 
-      // Arrow + color
-      if (isSelected) {
-        tft.setTextColor(WHITE);
-        tft.setCursor(cursorX, y);
-        tft.print(">");
-      } else {
-        tft.setTextColor(GREEN);
-      }
+    // Arrow + color
+    uint16_t color = isSelected ? WHITE : GREEN;
+    if (isSelected) {
+      canvas.drawText(cursorX, y, ">", color, BLACK);
+    }
 
-      // Read text from PROGMEM
-      char buffer[50];
-      strcpy_P(buffer, (char*)pgm_read_ptr(&items[itemIndex]));
+    // Read text from PROGMEM
+    char buffer[50];
+    strcpy_P(buffer, (char*)pgm_read_ptr(&items[itemIndex]));
 
-      // Print item text
-      tft.setCursor(textX, y);
-      tft.print(buffer);
-    }
+    // Print item text
+    canvas.drawText(textX, y, buffer, color, BLACK);
   }
 }
 
-// Legacy drawer (your existing switch-based behavior)
-static void drawMenuLegacy(MenuState menu) {
-  switch (menu) {
-    case MENU_MAIN:
-      drawMainMenu(); break;
-    case MENU_SCHEDULING:
-      drawGenericMenu("SCHEDULING", schedulingMenuItems, schedulingMenuCount, true, 2, 12, 15); break;
-    case MENU_DOSING_SCHEDULE:
-      drawGenericMenu("DOSING SCHEDULE", dosingScheduleMenu, dosingScheduleMenuCount, true, 2, 12, 15); break;
-    case MENU_DOSING_VIEW:
-      drawDosingScheduleListScreen(); break;
-    case MENU_DOSING_DELETE:
-      drawDosingDeleteListScreen(); break;
-    case MENU_DOSING_DELETE_CONFIRM:
-      drawConfirmDialog("   DELETE SCHEDULE?"); break;
-    case MENU_MANUAL_DOSING:
-      drawGenericMenu("MANUAL DOSING", manualDosingMenu, manualDosingMenuCount, true, 2, 12, 15); break;
-    case MENU_OUTLET_SCHEDULE:
-      drawGenericMenu("OUTLET SCHEDULE", outletScheduleMenu, outletScheduleMenuCount, true, 2, 12, 15); break;
-    case MENU_OUTLET_VIEW:
-      drawOutletScheduleListScreen(); break;  
-    case MENU_OUTLET_ADD:
-      drawOutletEditorScreen(); break;
-    case MENU_OUTLET_ADD_SELECT_DAYS:
-      drawDaySelectionScreen(); break;
-    case MENU_PUMP_CALIBRATION:
-      drawGenericMenu("PUMP CALIBRATION", pumpCalibrationMenu, pumpCalibrationMenuCount, true, 2, 12, 15); break;
-    case MENU_TOPUP_SOLUTION:
-      drawGenericMenu("TOP-UP SOLUTION", topupMenu, topupMenuCount, true, 2, 12, 15); break;
-    case MENU_REPLACE_SOLUTION:
-      drawGenericMenu("REPLACE SOLUTION", replaceMenu, replaceMenuCount, true, 2, 12, 15); break;
-    case MENU_DOSING_DELETE_ALL:
-      drawConfirmDialog("DELETE ALL DOSING"); break;
-    case MENU_OUTLET_DELETE_ALL:
-      drawConfirmDialog("DELETE ALL OUTLET"); break;
-    case MENU_DOSING_ADD:
-      drawScheduleEditorScreen(); break;
-    case MENU_DOSING_ADD_SELECT_DAYS:
-      drawDaySelectionScreen(); break;
-    case MENU_DOSING_ADD_SET_TIME:
-      drawTimeSelectionScreen(); break;
-    case MENU_DOSING_ADD_SET_AMOUNT:
-      drawAmountSelectionScreen(); break;
-    case MENU_RESET_WIFI_CONFIRM:
-      drawConfirmDialog("RESET WIFI"); break;
-    case MENU_FACTORY_RESET_CONFIRM:
-      drawConfirmDialog("FACTORY RESET"); break;
-    case MENU_CALIBRATE_P1:
-      drawCalibrateMenu(1); break;
-    case MENU_CALIBRATE_P2:
-      drawCalibrateMenu(2); break;
-    case MENU_CALIBRATE_P3:
-      drawCalibrateMenu(3); break;
-    case MENU_CALIBRATE_P4:
-      drawCalibrateMenu(4); break;
-    default:
-      tft.setCursor(2, 2);
-      tft.setTextColor(YELLOW);
-      tft.setTextSize(1);
-      tft.print("MENU ");
-      tft.print(menuNav.currentMenu);
-      tft.setCursor(2, 40);
-      tft.setTextColor(WHITE);
-      tft.print("Screen pending");
-      tft.setCursor(2, 60);
-      tft.setTextColor(CYAN);
-      tft.print("Press BACK");
-      break;
-  }
+// Screens declared in MENU_TABLE without a renderer yet (a press goes back)
+static void drawPendingScreen(const MenuDef& m) {
+  canvas.drawText(2, 2, m.title, YELLOW, BLACK);
+  canvas.drawText(2, 40, "Screen pending", WHITE, BLACK);
+  canvas.drawText(2, 60, "Press to go back", CYAN, BLACK);
 }
 
 void drawMenu() {
   if (!menuNav.needsRedraw) return;
 
-  auto drawViaRegistryOrLegacy = [](){
+  auto drawViaRegistry = [](){
     const MenuDef& m = MENUS[menuNav.currentMenu];
 
     // If registry knows how to draw, use it
@@ -365,1081 +272,615 @@ void drawMenu() {
       return;
     }
 
-    // Otherwise fallback to legacy switch
-    drawMenuLegacy(menuNav.currentMenu);
+    drawPendingScreen(m);
   };
 
-  // Full redraw
-  if (menuNav.needsFullRedraw) {
-    menuNav.needsFullRedraw = false;
-    menuNav.needsRedraw = false;
-    menuNav.lastDrawnIndex = -1;
-    tft.fillScreen(BLACK);
+  // Every redraw repaints the whole screen into the canvas, so screens
+  // draw unconditionally onto black. The canvas hashes each 16x16 tile and
+  // only sends the ones that differ from what the panel already shows.
+  menuNav.needsRedraw = false;
+  canvas.fillScreen(BLACK);
 
-    drawViaRegistryOrLegacy();
-    menuNav.lastDrawnIndex = menuNav.selectedIndex;
-    return;
-  }
-
-  // Partial redraw checks (keep your existing behavior)
-  bool needsPartialRedraw = false;
-  if (menuNav.currentMenu == MENU_DOSING_ADD_SELECT_DAYS || menuNav.currentMenu == MENU_OUTLET_ADD_SELECT_DAYS) {
-    static int lastDayIndex = -1;
-    if (lastDayIndex != menuNav.daySelectIndex) {
-      needsPartialRedraw = true;
-      lastDayIndex = menuNav.daySelectIndex;
-    }
-  } else {
-    if (menuNav.lastDrawnIndex != menuNav.selectedIndex || menuNav.needsRedraw) {
-      needsPartialRedraw = true;
-    }
-  }
-
-  if (needsPartialRedraw) {
-    menuNav.needsRedraw = false;
-    drawViaRegistryOrLegacy();
-    menuNav.lastDrawnIndex = menuNav.selectedIndex;
-  }
+  drawViaRegistry();
+  drawNotificationBanner();
+  canvas.flush();
 }
 
 void drawDaySelectionScreen() {
-  static int lastDayIndex = -1;
-  static uint8_t lastDaysBitmap = 0xFF;  // Initialize to impossible value
-
-  // Full redraw on first draw or if bitmap changed significantly
-  bool fullRedraw = (menuNav.lastDrawnIndex == -1) || (lastDaysBitmap != menuNav.tempDaysBitmap);
+  canvas.setTextSize(1);
 
-  if (fullRedraw) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-
-    // Header
-    tft.setTextColor(YELLOW);
-    tft.setCursor(2, 2);
-    tft.print("SELECT DAYS");
-    tft.drawFastHLine(0, 10, 128, YELLOW);
-
-    lastDayIndex = -1;  // Force redraw of all items
-    lastDaysBitmap = menuNav.tempDaysBitmap;
-  }
+  // Header
+  canvas.setTextColor(YELLOW);
+  canvas.setCursor(2, 2);
+  canvas.print("SELECT DAYS");
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
 
   int y = 15;
   int itemHeight = 11;
 
-  // Draw all 7 days - but only redraw changed items
   for (int i = 0; i < 7; i++) {
     bool selected = (i == menuNav.daySelectIndex);
-    bool wasSelected = (i == lastDayIndex);
     bool checked = isDayEnabled(menuNav.tempDaysBitmap, i);
+    int itemY = y + (i * itemHeight);
 
-    // Only redraw if selection changed or full redraw needed
-    if (fullRedraw || selected != wasSelected) {
-      int itemY = y + (i * itemHeight);
-
-      // Clear the line
-      tft.fillRect(0, itemY - 1, 128, itemHeight, BLACK);
-
-      // Highlight selected item
-      if (selected) {
-        tft.fillRect(0, itemY - 1, 128, itemHeight, BLUE);
-        tft.setTextColor(WHITE);
-      } else {
-        tft.setTextColor(GREEN);
-      }
-
-      tft.setCursor(4, itemY + 1);
-      // Checkbox
-      tft.print(checked ? "[X]" : "[ ]");
-      tft.print(" ");
-      tft.print(dayNames[i]);
+    // Highlight selected item
+    if (selected) {
+      canvas.fillRect(0, itemY - 1, 128, itemHeight, BLUE);
+      canvas.setTextColor(WHITE);
+    } else {
+      canvas.setTextColor(GREEN);
     }
+
+    canvas.setCursor(4, itemY + 1);
+    // Checkbox
+    canvas.print(checked ? "[X]" : "[ ]");
+    canvas.print(" ");
+    canvas.print(dayNames[i]);
   }
 
   // Done button (index 7)
   int doneY = y + (7 * itemHeight) + 4;
-  bool doneSelected = (menuNav.daySelectIndex == 7);
-  bool doneWasSelected = (lastDayIndex == 7);
+  if (menuNav.daySelectIndex == 7) {
+    canvas.fillRect(0, doneY - 1, 128, itemHeight, BLUE);
+    canvas.setTextColor(WHITE);
+  } else {
+    canvas.setTextColor(GREEN);
+  }
+  canvas.setCursor(4, doneY + 1);
+  canvas.print("> Done");
+}
+
+
+// ==================================================
+// SCHEDULE LISTS
+// ==================================================
+// Title in the top tile row, six 16px rows (two text lines each) paged
+// by PagedList, footer in the bottom tile row.
+#define LIST_TOP          16
+#define LIST_ROW_HEIGHT   16
+#define LIST_VISIBLE_ROWS 6
+
+static PagedList dosingViewList(LIST_TOP, LIST_ROW_HEIGHT, LIST_VISIBLE_ROWS);
+static PagedList dosingDeleteList(LIST_TOP, LIST_ROW_HEIGHT, LIST_VISIBLE_ROWS);
+static PagedList outletList(LIST_TOP, LIST_ROW_HEIGHT, LIST_VISIBLE_ROWS);
+
+static void drawListHeader(const char* title) {
+  canvas.drawText(2, 2, title, YELLOW, BLACK);
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
+}
+
+// Empty list message
+static void drawListEmpty() {
+  canvas.drawText(4, 50, "No schedules", CYAN, BLACK);
+  canvas.drawText(4, 62, "Press to Return", CYAN, BLACK);
+}
+
+// Second row line: enabled days in the row colour, disabled days red
+static void drawListDays(int16_t y, uint8_t daysOfWeek, uint16_t color, uint16_t bg) {
+  static const char* const dayAbbr[] = {"Su", "Mo", "Tu", "We", "Th", "Fr", "Sa"};
+  int16_t x = 0;
+  for (int d = 0; d < 7; d++) {
+    x += canvas.drawText(x, y, dayAbbr[d], isDayEnabled(daysOfWeek, d) ? color : RED, bg);
+    if (d < 6) x += canvas.drawText(x, y, " ", color, bg);
+  }
+}
+
+// "Return to Menu" as the last row of a delete list
+static void drawListReturnRow(int16_t y, bool selected) {
+  uint16_t bg = selected ? BLUE : BLACK;
+  if (selected) canvas.fillRect(0, y, 128, LIST_ROW_HEIGHT, bg);
+  canvas.drawText(0, y + 4, "Return to Menu", selected ? WHITE : YELLOW, bg);
+}
 
-  if (fullRedraw || doneSelected != doneWasSelected) {
-    // Clear the line
-    tft.fillRect(0, doneY - 1, 128, itemHeight, BLACK);
+static void drawDosingRow(int index, int16_t y, bool selected) {
+  if (index >= dosingScheduleCount) {
+    drawListReturnRow(y, selected);
+    return;
+  }
 
-    if (doneSelected) {
-      tft.fillRect(0, doneY - 1, 128, itemHeight, BLUE);
-      tft.setTextColor(WHITE);
+  const DosingSchedule& sched = dosingSchedules[index];
+  uint16_t bg = selected ? BLUE : BLACK;
+  uint16_t fg = selected ? WHITE : GREEN;
+  if (selected) canvas.fillRect(0, y, 128, LIST_ROW_HEIGHT, bg);
+
+  // LINE 1: "S1 P1 08:30 5.0mL" or interval "P1 90m@08:00 5.0mL"; at most
+  // 20 of the 21 columns (the interval row has no room for the index)
+  char line[28];
+  if (sched.isInterval) {
+    char every[8];
+    uint16_t mins = sched.intervalMinutes;
+    if (mins % 60 == 0) snprintf(every, sizeof(every), "%dh", mins / 60);
+    else snprintf(every, sizeof(every), "%dm", mins);
+    snprintf(line, sizeof(line), "P%d %s@%02d:%02d %.1fmL",
+             sched.pumpNumber, every, sched.hour, sched.minute, sched.amountML / 10.0);
+  } else {
+    snprintf(line, sizeof(line), "S%d P%d %02d:%02d %.1fmL",
+             (uint8_t)(index + 1), sched.pumpNumber, sched.hour, sched.minute, sched.amountML / 10.0);
+  }
+  canvas.drawText(0, y, line, fg, bg);
+
+  // LINE 2: Day abbreviations with color coding
+  drawListDays(y + 8, sched.daysOfWeek, fg, bg);
+}
+
+static void drawOutletRow(int index, int16_t y, bool selected) {
+  if (index >= outletScheduleCount) {
+    drawListReturnRow(y, selected);
+    return;
+  }
+
+  const OutletSchedule& sched = outletSchedules[index];
+  uint16_t bg = selected ? BLUE : BLACK;
+  uint16_t fg = selected ? WHITE : GREEN;
+  if (selected) canvas.fillRect(0, y, 128, LIST_ROW_HEIGHT, bg);
+
+  // LINE 1: either time span "S1 Rly3 08:00-09:30" or interval "S1 Rly3 Int 2h"
+  char line[28];
+  if (sched.isInterval) {
+    uint16_t mins = sched.intervalMinutes;
+    if (mins % 60 == 0) {
+      snprintf(line, sizeof(line), "S%d Rly%d Int %dh", (uint8_t)(index + 1), sched.relayNumber, mins / 60);
     } else {
-      tft.setTextColor(GREEN);
+      snprintf(line, sizeof(line), "S%d Rly%d Int %dm", (uint8_t)(index + 1), sched.relayNumber, mins);
     }
-    tft.setCursor(4, doneY + 1);
-    tft.print("> Done");
+  } else {
+    snprintf(line, sizeof(line), "S%d Rly%d %02d:%02d-%02d:%02d", (uint8_t)(index + 1), sched.relayNumber,
+             sched.hourOn, sched.minuteOn, sched.hourOff, sched.minuteOff);
   }
+  canvas.drawText(0, y, line, fg, bg);
 
-  lastDayIndex = menuNav.daySelectIndex;
+  // LINE 2: days
+  drawListDays(y + 8, sched.daysOfWeek, fg, bg);
 }
 
-
 void drawDosingScheduleListScreen() {
-  tft.fillScreen(BLACK);
-  tft.setTextSize(1);
+  drawListHeader("DOSING SCHEDULES");
 
-  const int SCHEDULES_PER_PAGE = 6;
-  const int LINE_HEIGHT = 9;  // Each text line is 9px (6px char + 1px spacing + 2px gap)
-  
   // Show message if no schedules
   if (dosingScheduleCount == 0) {
-    tft.setTextColor(CYAN);
-    tft.setCursor(4, 50);
-    tft.print("No schedules");
-    tft.setCursor(4, 62);
-    tft.print("Press to Return");
+    drawListEmpty();
     return;
   }
 
-  // Calculate which schedules to show on current page
-  int startIdx = menuNav.currentPage * SCHEDULES_PER_PAGE;
-  int endIdx = min(startIdx + SCHEDULES_PER_PAGE, dosingScheduleCount);
-  
-  int y = 0;  // Start at top of screen
-  
-  // Draw schedules (2 lines each)
-  for (int i = startIdx; i < endIdx; i++) {
-    DosingSchedule &sched = dosingSchedules[i];
-    
-    // LINE 1: "S1 Pump1 08:30 5.0mL"
-    tft.setCursor(0, y);
-    tft.setTextColor(GREEN);
-    tft.print("S");
-    tft.print(i + 1);  // Schedule number (1-indexed)
-    tft.print(" Pump");
-    tft.print(sched.pumpNumber);
-    tft.print(" ");
-    if (sched.hour < 10) tft.print("0");
-    tft.print(sched.hour);
-    tft.print(":");
-    if (sched.minute < 10) tft.print("0");
-    tft.print(sched.minute);
-    tft.print(" ");
-    tft.print(sched.amountML / 10.0, 1);
-    tft.print("mL");
-    
-    y += LINE_HEIGHT;
-    
-    // LINE 2: Day abbreviations with color coding
-    const char* dayAbbr[] = {"Su", "Mo", "Tu", "We", "Th", "Fr", "Sa"};
-    tft.setCursor(0, y);
-    
-    for (int d = 0; d < 7; d++) {
-      bool enabled = isDayEnabled(sched.daysOfWeek, d);
-      
-      // Set color based on enabled state (no brackets)
-      if (enabled) {
-        tft.setTextColor(GREEN);
-      } else {
-        tft.setTextColor(RED);
-      }
-      
-      tft.print(dayAbbr[d]);
-      
-      if (d < 6) tft.print(" ");  // Space between days
-    }
-    
-    y += LINE_HEIGHT + 2;  // Add 2px gap between schedules
-  }
-  
+  dosingViewList.draw(dosingScheduleCount, menuNav.selectedIndex, drawDosingRow);
+
   // "Press to Return" at y=119
-  tft.setCursor(0, 119);
-  tft.setTextColor(YELLOW);
-  tft.print("Press to Return");
+  canvas.drawText(0, 119, "Press to Return", YELLOW, BLACK);
 }
 
 
 void drawDosingDeleteListScreen() {
-  static int lastSelectedIndex = -1;
-  static int lastPage = -1;
-
-  // Check if we need full redraw
-  bool needsFullRedraw = (menuNav.needsFullRedraw || lastPage != menuNav.currentPage);
-  
-  // Full redraw if page changed or first draw
-  if (needsFullRedraw) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-    lastSelectedIndex = -1;
-    lastPage = menuNav.currentPage;
-    menuNav.needsFullRedraw = false;  // Clear flag immediately
-  }
+  drawListHeader("DELETE SCHEDULE");
 
   // Show message if no schedules
   if (dosingScheduleCount == 0) {
-    tft.setTextColor(CYAN);
-    tft.setCursor(4, 50);
-    tft.print("No schedules");
-    tft.setCursor(4, 62);
-    tft.print("Press to Return");
+    drawListEmpty();
     return;
   }
 
-  const int SCHEDULES_PER_PAGE = 6;
-  const int LINE_HEIGHT = 20;  // 2 lines per schedule (9px + 9px + 2px gap)
-  
-  // Calculate which schedules to show on current page
-  int startIdx = menuNav.currentPage * SCHEDULES_PER_PAGE;
-  int endIdx = min(startIdx + SCHEDULES_PER_PAGE, dosingScheduleCount);
-  
-  int y = 0;  // Start at top of screen
-  int itemsOnPage = 0;
-  
-  // Draw schedules (2 lines each, 20px total per schedule)
-  for (int i = startIdx; i < endIdx; i++) {
-    bool isSelected = (i == menuNav.selectedIndex);
-    bool wasSelected = (i == lastSelectedIndex);
-    
-    // Redraw if selection changed, full redraw, or first draw
-    if (isSelected != wasSelected || needsFullRedraw || lastSelectedIndex == -1) {
-      DosingSchedule &sched = dosingSchedules[i];
-      
-      // Clear 2-line area (20px total)
-      tft.fillRect(0, y, 128, LINE_HEIGHT, isSelected ? BLUE : BLACK);
-      
-      // Set text color
-      tft.setTextColor(isSelected ? WHITE : GREEN);
-      tft.setTextSize(1);
-      
-      // LINE 1: "S1 Pump1 08:30 5.0mL"
-      tft.setCursor(0, y);
-      tft.print("S");
-      tft.print(i + 1);
-      tft.print(" Pump");
-      tft.print(sched.pumpNumber);
-      tft.print(" ");
-      if (sched.hour < 10) tft.print("0");
-      tft.print(sched.hour);
-      tft.print(":");
-      if (sched.minute < 10) tft.print("0");
-      tft.print(sched.minute);
-      tft.print(" ");
-      tft.print(sched.amountML / 10.0, 1);
-      tft.print("mL");
-      
-      // LINE 2: Day abbreviations with color coding
-      const char* dayAbbr[] = {"Su", "Mo", "Tu", "We", "Th", "Fr", "Sa"};
-      tft.setCursor(0, y + 9);
-      
-      for (int d = 0; d < 7; d++) {
-        bool enabled = isDayEnabled(sched.daysOfWeek, d);
-        
-        // Set color based on enabled and selection state
-        if (isSelected) {
-          tft.setTextColor(enabled ? WHITE : RED);
-        } else {
-          tft.setTextColor(enabled ? GREEN : RED);
-        }
-        
-        tft.print(dayAbbr[d]);
-        if (d < 6) tft.print(" ");
-      }
-    }
-    
-    y += LINE_HEIGHT;  // Move to next schedule
-    itemsOnPage++;
+  // Schedules plus the "Return to Menu" row
+  dosingDeleteList.draw(dosingScheduleCount + 1, menuNav.selectedIndex, drawDosingRow);
+}
+
+
+// Row highlight and label colour for the editor screens
+static void beginEditorRow(int y, int lineHeight, bool selected) {
+  if (selected) {
+    canvas.fillRect(0, y, 128, lineHeight, BLUE);
+    canvas.setTextColor(WHITE);
+  } else {
+    canvas.setTextColor(GREEN);
   }
-  
-  // Draw "Return to Dosing Menu" option if on the page where last schedule is
-  int returnIndex = dosingScheduleCount;
-  int returnPage = returnIndex / SCHEDULES_PER_PAGE;
-  
-  if (menuNav.currentPage == returnPage && itemsOnPage < SCHEDULES_PER_PAGE) {
-    bool isSelected = (menuNav.selectedIndex == returnIndex);
-    bool wasSelected = (lastSelectedIndex == returnIndex);
-    
-    if (isSelected != wasSelected || needsFullRedraw || lastSelectedIndex == -1) {
-      // Clear line area
-      tft.fillRect(0, y, 128, 10, isSelected ? BLUE : BLACK);
-      
-      // Set text color
-      tft.setTextColor(isSelected ? WHITE : YELLOW);
-      tft.setTextSize(1);
-      tft.setCursor(0, y);
-      tft.print("Return to Menu");
+  canvas.setCursor(4, y + 2);
+}
+
+static void printTwoDigits(uint8_t value) {
+  if (value < 10) canvas.print("0");
+  canvas.print(value);
+}
+
+// Half of an outlet interval ("1h", "45m", "2m30s"): interval schedules are
+// on for the first half of each period and off for the second
+static void printHalfInterval(uint16_t intervalMinutes) {
+  uint32_t half = (uint32_t)intervalMinutes * 30;
+  if (half % 3600 == 0) {
+    canvas.print(half / 3600);
+    canvas.print("h");
+  } else {
+    if (half >= 60) {
+      canvas.print(half / 60);
+      canvas.print("m");
+    }
+    if (half % 60) {
+      canvas.print(half % 60);
+      canvas.print("s");
     }
   }
-  
-  lastSelectedIndex = menuNav.selectedIndex;
 }
 
-
 void drawScheduleEditorScreen() {
-  static int lastSelectedIndex = -1;
-  static uint8_t lastDaysBitmap = 0xFF;
-  static uint8_t lastPump = 0;
-  static uint8_t lastHour = 0;
-  static uint8_t lastMinute = 0;
-  static uint16_t lastAmount = 0;
-  static bool lastInEditMode = false;
-  static bool lastEditingHour = false;
-
-  bool fullRedraw = (menuNav.lastDrawnIndex == -1);
-
-  if (fullRedraw) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-
-    // Header
-    tft.setTextColor(YELLOW);
-    tft.setCursor(2, 2);
-    tft.print(" ADD DOSING SCHEDULE ");
-    tft.drawFastHLine(0, 10, 128, YELLOW);
-
-    lastSelectedIndex = -1;  // Force redraw all
-  }
+  canvas.setTextSize(1);
+
+  // Header
+  canvas.setTextColor(YELLOW);
+  canvas.setCursor(2, 2);
+  canvas.print(" ADD DOSING SCHEDULE ");
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
 
   int y = 15;
   int lineHeight = 14;
 
   // Line 0: Pump
-  if (fullRedraw || lastSelectedIndex == 0 || menuNav.selectedIndex == 0 || lastPump != tempDosingSchedule.pumpNumber) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    if (menuNav.selectedIndex == 0) {
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(WHITE);
-    } else {
-      tft.setTextColor(GREEN);
-    }
-    tft.setCursor(4, y + 2);
-    tft.print("Pump: ");
-
-    if (menuNav.selectedIndex == 0 && menuNav.inEditMode) {
-      tft.setTextColor(YELLOW);
-    }
-
-    tft.print(tempDosingSchedule.pumpNumber);
-
+  beginEditorRow(y, lineHeight, menuNav.selectedIndex == 0);
+  canvas.print("Pump: ");
+  if (menuNav.selectedIndex == 0 && menuNav.inEditMode) {
+    canvas.setTextColor(YELLOW);
   }
+  canvas.print(tempDosingSchedule.pumpNumber);
   y += lineHeight;
 
   // Line 1: Days (2 lines allocated)
-  if (fullRedraw || lastSelectedIndex == 1 || menuNav.selectedIndex == 1 || lastDaysBitmap != menuNav.tempDaysBitmap) {
-    tft.fillRect(0, y, 128, lineHeight * 2, BLACK);
-  // Line 1: Days
   bool daysEditing = (menuNav.selectedIndex == 1 && menuNav.inEditMode);
-
   if (!daysEditing && menuNav.selectedIndex == 1) {
-      // Normal selection highlight (not editing)
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(BLACK);
+    // Normal selection highlight (not editing)
+    canvas.fillRect(0, y, 128, lineHeight, BLUE);
+    canvas.setTextColor(BLACK);
   } else {
-      // Editing OR not selected → black background
-      tft.fillRect(0, y, 128, lineHeight, BLACK);
-      tft.setTextColor(WHITE);
+    canvas.setTextColor(WHITE);
   }
-    tft.setCursor(4, y + 2);
-    tft.print("Days:");
-
-    // // Print days on second line with word wrap
-    // Print days on second line
-    tft.setCursor(4, y + 2 + lineHeight);
-
-    if (menuNav.selectedIndex == 1 && menuNav.inEditMode) {
-      // Inline edit view: color-coded days + yellow cursor
-      const char* dayAbbr[7] = {"Su", "Mo", "Tu", "We", "Th", "Fr", "Sa"};
-
-      for (int d = 0; d < 7; d++) {
-        bool enabled  = (menuNav.tempDaysBitmap & (1 << d));
-        bool cursorOn = (menuNav.daySelectIndex == d);
-
-        if (cursorOn) {
-          tft.setTextColor(YELLOW);          // cursor highlight
-        } else {
-          tft.setTextColor(enabled ? GREEN   // enabled day
-                                  : RED);   // disabled day
-        }
-
-        tft.print(dayAbbr[d]);
-        if (d < 6) tft.print(" ");
-      }
+  canvas.setCursor(4, y + 2);
+  canvas.print("Days:");
 
-      // DONE slot at the end
-      tft.print(" ");
-      if (menuNav.daySelectIndex == 7) tft.setTextColor(YELLOW);
-      else tft.setTextColor(GREEN);
-      tft.print("DONE");
-
-      // restore a sane default for later prints
-      tft.setTextColor(WHITE);
-    } 
-    else {
-      // Normal compact view
-      tft.setTextColor(WHITE);
-      String daysStr = formatDaysCompact(menuNav.tempDaysBitmap);
-      tft.print(daysStr);
-    }
+  // Print days on second line
+  canvas.setCursor(4, y + 2 + lineHeight);
 
-  }
-  y += lineHeight * 2;
+  if (daysEditing) {
+    // Inline edit view: color-coded days + yellow cursor
+    const char* dayAbbr[7] = {"Su", "Mo", "Tu", "We", "Th", "Fr", "Sa"};
 
-  // Line 2: Time
-  if (fullRedraw || lastSelectedIndex == 2 || menuNav.selectedIndex == 2 ||
-      lastHour != tempDosingSchedule.hour || lastMinute != tempDosingSchedule.minute ||
-      lastInEditMode != menuNav.inEditMode || lastEditingHour != menuNav.editingHour) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    if (menuNav.selectedIndex == 2) {
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(WHITE);
-    } else {
-      tft.setTextColor(GREEN);
-    }
-    tft.setCursor(4, y + 2);
-    tft.print("Time: ");
-
-    // Show edit indicator with color (same font size)
-    if (menuNav.selectedIndex == 2 && menuNav.inEditMode) {
-      if (menuNav.editingHour) {
-        tft.setTextColor(YELLOW);
-        if (tempDosingSchedule.hour < 10) tft.print("0");
-        tft.print(tempDosingSchedule.hour);
-        tft.setTextColor(WHITE);
-        tft.print(":");
-        if (tempDosingSchedule.minute < 10) tft.print("0");
-        tft.print(tempDosingSchedule.minute);
+    for (int d = 0; d < 7; d++) {
+      bool enabled  = (menuNav.tempDaysBitmap & (1 << d));
+      bool cursorOn = (menuNav.daySelectIndex == d);
+
+      if (cursorOn) {
+        canvas.setTextColor(YELLOW);          // cursor highlight
       } else {
-        if (tempDosingSchedule.hour < 10) tft.print("0");
-        tft.print(tempDosingSchedule.hour);
-        tft.print(":");
-        tft.setTextColor(YELLOW);
-        if (tempDosingSchedule.minute < 10) tft.print("0");
-        tft.print(tempDosingSchedule.minute);
+        canvas.setTextColor(enabled ? GREEN   // enabled day
+                                    : RED);   // disabled day
       }
-    } else {
-      if (tempDosingSchedule.hour < 10) tft.print("0");
-      tft.print(tempDosingSchedule.hour);
-      tft.print(":");
-      if (tempDosingSchedule.minute < 10) tft.print("0");
-      tft.print(tempDosingSchedule.minute);
+
+      canvas.print(dayAbbr[d]);
+      if (d < 6) canvas.print(" ");
     }
-    lastHour = tempDosingSchedule.hour;
-    lastMinute = tempDosingSchedule.minute;
+
+    // DONE slot at the end
+    canvas.print(" ");
+    if (menuNav.daySelectIndex == 7) canvas.setTextColor(YELLOW);
+    else canvas.setTextColor(GREEN);
+    canvas.print("DONE");
   }
-  y += lineHeight;
+  else {
+    // Normal compact view
+    canvas.setTextColor(WHITE);
+    canvas.print(formatDaysCompact(menuNav.tempDaysBitmap));
+  }
+  y += lineHeight * 2;
 
-  // Line 3: Amount
-  if (fullRedraw || lastSelectedIndex == 3 || menuNav.selectedIndex == 3 ||
-      lastAmount != tempDosingSchedule.amountML || lastInEditMode != menuNav.inEditMode) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    if (menuNav.selectedIndex == 3) {
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(WHITE);
-    } else {
-      tft.setTextColor(GREEN);
-    }
-    tft.setCursor(4, y + 2);
-    tft.print("Amount: ");
+  // Line 2: Time, the edited half in yellow
+  bool timeEditing = (menuNav.selectedIndex == 2 && menuNav.inEditMode);
+  beginEditorRow(y, lineHeight, menuNav.selectedIndex == 2);
+  canvas.print(tempDosingSchedule.intervalMinutes > 0 ? "Start: " : "Time: ");
+  uint16_t textColor = menuNav.selectedIndex == 2 ? WHITE : GREEN;
+
+  if (timeEditing && menuNav.editingHour) canvas.setTextColor(YELLOW);
+  printTwoDigits(tempDosingSchedule.hour);
+  canvas.setTextColor(textColor);
+  canvas.print(":");
+  if (timeEditing && !menuNav.editingHour) canvas.setTextColor(YELLOW);
+  printTwoDigits(tempDosingSchedule.minute);
+  y += lineHeight;
 
-    // Show edit indicator with color (same font size)
-    if (menuNav.selectedIndex == 3 && menuNav.inEditMode) {
-      tft.setTextColor(YELLOW);
-    }
-    tft.print(tempDosingSchedule.amountML / 10.0, 1);  // Show decimal
-    tft.print(" mL");
-    lastAmount = tempDosingSchedule.amountML;
+  // Line 3: Every (interval; "Once" = daily at Time)
+  beginEditorRow(y, lineHeight, menuNav.selectedIndex == 3);
+  canvas.print("Every: ");
+  if (menuNav.selectedIndex == 3 && menuNav.inEditMode) {
+    canvas.setTextColor(YELLOW);
   }
-  y += lineHeight + 4;
-
-  // Line 4: Save
-  if (fullRedraw || lastSelectedIndex == 4 || menuNav.selectedIndex == 4) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    if (menuNav.selectedIndex == 4) {
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(WHITE);
-    } else {
-      tft.setTextColor(GREEN);
-    }
-    tft.setCursor(4, y + 2);
-    tft.print("[ Save ]");
+  uint16_t mins = tempDosingSchedule.intervalMinutes;
+  if (mins == 0) {
+    canvas.print("Once");
+  } else if (mins % 60 == 0) {
+    canvas.print(mins / 60);
+    canvas.print(" h");
+  } else {
+    canvas.print(mins);
+    canvas.print(" min");
   }
   y += lineHeight;
 
-  // Line 5: Cancel
-  if (fullRedraw || lastSelectedIndex == 5 || menuNav.selectedIndex == 5) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    if (menuNav.selectedIndex == 5) {
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(WHITE);
-    } else {
-      tft.setTextColor(GREEN);
-    }
-    tft.setCursor(4, y + 2);
-    tft.print("[ Cancel ]");
+  // Line 4: Amount
+  beginEditorRow(y, lineHeight, menuNav.selectedIndex == 4);
+  canvas.print("Amount: ");
+  if (menuNav.selectedIndex == 4 && menuNav.inEditMode) {
+    canvas.setTextColor(YELLOW);
   }
+  canvas.print(tempDosingSchedule.amountML / 10.0, 1);  // Show decimal
+  canvas.print(" mL");
+  y += lineHeight;
+
+  // Line 5: Save
+  beginEditorRow(y, lineHeight, menuNav.selectedIndex == 5);
+  canvas.print("[ Save ]");
+  y += lineHeight;
 
-  lastSelectedIndex = menuNav.selectedIndex;
-  lastInEditMode = menuNav.inEditMode;
-  lastEditingHour = menuNav.editingHour;
+  // Line 6: Cancel
+  beginEditorRow(y, lineHeight, menuNav.selectedIndex == 6);
+  canvas.print("[ Cancel ]");
 }
 
 void drawOutletEditorScreen() {
-  static int lastSelectedIndex = -1;
-  static uint8_t lastDaysBitmap = 0xFF;
-//  static uint8_t lastRelay = 0;
-  static uint8_t lastRelay = 1;
-  static uint8_t lastHourOn = 0, lastMinOn = 0, lastHourOff = 0, lastMinOff = 0;
-  static bool lastInterval = false;
-  static uint16_t lastIntervalMin = 0;
-  static bool lastInEditMode = false;
-  static bool lastEditingHour = false;
-  static bool lastIntervalIsHours = false;
-  static uint8_t lastIntervalValue = 0;
-
-  bool fullRedraw = (menuNav.lastDrawnIndex == -1);
-
-  if (fullRedraw) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-
-    tft.setTextColor(YELLOW);
-    tft.setCursor(2, 2);
-    tft.print(" ADD OUTLET SCHEDULE ");
-    tft.drawFastHLine(0, 10, 128, YELLOW);
-
-    lastSelectedIndex = -1;
-  }
+  canvas.setTextSize(1);
+
+  canvas.setTextColor(YELLOW);
+  canvas.setCursor(2, 2);
+  canvas.print(" ADD OUTLET SCHEDULE ");
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
 
   int y = 15;
   int lineHeight = 14;
 
   auto highlightLine = [&](int idx, bool editing=false){
     if (menuNav.selectedIndex == idx) {
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(editing ? YELLOW : WHITE);
+      canvas.fillRect(0, y, 128, lineHeight, BLUE);
+      canvas.setTextColor(editing ? YELLOW : WHITE);
     } else {
-      tft.fillRect(0, y, 128, lineHeight, BLACK);
-      tft.setTextColor(GREEN);
+      canvas.setTextColor(GREEN);
     }
   };
 
   // 0) Relay
-  if (fullRedraw || lastSelectedIndex==0 || menuNav.selectedIndex==0 || lastRelay!=tempOutletSchedule.relayNumber || lastInEditMode!=menuNav.inEditMode) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    highlightLine(0, menuNav.inEditMode);
-    tft.setCursor(4, y+2);
-    tft.print("Relay: ");
-    tft.print(tempOutletSchedule.relayNumber);
-  }
+  highlightLine(0, menuNav.inEditMode);
+  canvas.setCursor(4, y+2);
+  canvas.print("Relay: ");
+  canvas.print(tempOutletSchedule.relayNumber);
   y += lineHeight;
 
   // 1) Days (uses tempDaysBitmap like dosing)
-  if (fullRedraw || lastSelectedIndex==1 || menuNav.selectedIndex==1 || lastDaysBitmap!=menuNav.tempDaysBitmap) {
-    tft.fillRect(0, y, 128, lineHeight*2, BLACK);
+  bool daysEditing = (menuNav.selectedIndex==1 && menuNav.inEditMode);
+  if (!daysEditing && menuNav.selectedIndex==1) {
+    canvas.fillRect(0, y, 128, lineHeight, BLUE);
+    canvas.setTextColor(BLACK);
+  } else {
+    canvas.setTextColor(WHITE);
+  }
 
-    bool daysEditing = (menuNav.selectedIndex==1 && menuNav.inEditMode);
-    if (!daysEditing && menuNav.selectedIndex==1) {
-      tft.fillRect(0, y, 128, lineHeight, BLUE);
-      tft.setTextColor(BLACK);
-    } else {
-      tft.fillRect(0, y, 128, lineHeight, BLACK);
-      tft.setTextColor(WHITE);
-    }
+  canvas.setCursor(4, y+2);
+  canvas.print("Days:");
 
-    tft.setCursor(4, y+2);
-    tft.print("Days:");
-
-    // second line: print enabled day abbreviations
-  //   tft.setCursor(4, y+2+lineHeight);
-  //   const char* dayAbbr[7] = {"Su","Mo","Tu","We","Th","Fr","Sa"};
-  //   for (int d=0; d<7; d++) {
-  //     if (menuNav.tempDaysBitmap & (1<<d)) {
-  //       tft.setTextColor(GREEN);
-  //     } else {
-  //       tft.setTextColor(RED);
-  //     }
-  //     tft.print(dayAbbr[d]);
-  //     if (d<6) tft.print(" ");
-  //   }
-  // }
   // second line: print enabled day abbreviations + yellow cursor when editing
-  tft.setCursor(4, y + 2 + lineHeight);
+  canvas.setCursor(4, y + 2 + lineHeight);
   const char* dayAbbr[7] = {"Su","Mo","Tu","We","Th","Fr","Sa"};
 
-  if (menuNav.selectedIndex == 1 && menuNav.inEditMode) {
+  if (daysEditing) {
     // Inline edit view: color-coded days + yellow cursor + DONE
     for (int d = 0; d < 7; d++) {
       bool enabled  = (menuNav.tempDaysBitmap & (1 << d));
       bool cursorOn = (menuNav.daySelectIndex == d);
 
       if (cursorOn) {
-        tft.setTextColor(YELLOW);
+        canvas.setTextColor(YELLOW);
       } else {
-        tft.setTextColor(enabled ? GREEN : RED);
+        canvas.setTextColor(enabled ? GREEN : RED);
       }
 
-      tft.print(dayAbbr[d]);
-      if (d < 6) tft.print(" ");
+      canvas.print(dayAbbr[d]);
+      if (d < 6) canvas.print(" ");
     }
 
     // DONE slot at the end
-    tft.print(" ");
-    tft.setTextColor(menuNav.daySelectIndex == 7 ? YELLOW : GREEN);
-    tft.print("DONE");
-
-    tft.setTextColor(WHITE);
+    canvas.print(" ");
+    canvas.setTextColor(menuNav.daySelectIndex == 7 ? YELLOW : GREEN);
+    canvas.print("DONE");
   } else {
     // Normal compact view
     for (int d = 0; d < 7; d++) {
       bool enabled = (menuNav.tempDaysBitmap & (1 << d));
-      tft.setTextColor(enabled ? GREEN : RED);
-      tft.print(dayAbbr[d]);
-      if (d < 6) tft.print(" ");
+      canvas.setTextColor(enabled ? GREEN : RED);
+      canvas.print(dayAbbr[d]);
+      if (d < 6) canvas.print(" ");
     }
   }
-}
-  
   y += lineHeight*2;
 
   // 2) Interval row
-  if (fullRedraw || lastSelectedIndex==2 || menuNav.selectedIndex==2 ||
-      lastInterval!=tempOutletSchedule.isInterval ||
-      lastIntervalMin!=tempOutletSchedule.intervalMinutes ||
-      lastIntervalIsHours!=menuNav.outletIntervalIsHours ||
-      lastIntervalValue!=menuNav.outletIntervalValue ||
-      lastInEditMode!=menuNav.inEditMode ||
-      lastEditingHour!=menuNav.editingHour) {
-
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    highlightLine(2, menuNav.inEditMode);
-
-    tft.setCursor(4, y+2);
-    tft.print("Interval: ");
-
-    if (!tempOutletSchedule.isInterval) {
-      tft.setTextColor(RED);
-      tft.print("OFF");
+  highlightLine(2, menuNav.inEditMode);
+  canvas.setCursor(4, y+2);
+  canvas.print("Interval: ");
+  uint16_t shownIntervalMinutes = tempOutletSchedule.intervalMinutes;
+
+  if (!tempOutletSchedule.isInterval) {
+    canvas.setTextColor(RED);
+    canvas.print("OFF");
+  } else {
+    canvas.setTextColor(GREEN);
+    // show unit + value from nav temps while editing, else from stored minutes
+    bool showHours;
+    uint8_t showVal;
+    if (menuNav.selectedIndex==2 && menuNav.inEditMode) {
+      showHours = menuNav.outletIntervalIsHours;
+      showVal   = menuNav.outletIntervalValue;
+      shownIntervalMinutes = showHours ? showVal * 60 : showVal;
     } else {
-      tft.setTextColor(GREEN);
-      // show unit + value from nav temps while editing, else from stored minutes
-      bool showHours;
-      uint8_t showVal;
-      if (menuNav.selectedIndex==2 && menuNav.inEditMode) {
-        showHours = menuNav.outletIntervalIsHours;
-        showVal   = menuNav.outletIntervalValue;
-
-      } else {
-        showHours = (tempOutletSchedule.intervalMinutes >= 60);
-        showVal   = showHours ? (tempOutletSchedule.intervalMinutes/60) : tempOutletSchedule.intervalMinutes;
-      }
-      tft.print(showVal);
-      tft.print(showHours ? "h" : "m");
+      showHours = (tempOutletSchedule.intervalMinutes >= 60);
+      showVal   = showHours ? (tempOutletSchedule.intervalMinutes/60) : tempOutletSchedule.intervalMinutes;
     }
+    canvas.print(showVal);
+    canvas.print(showHours ? "h" : "m");
   }
   y += lineHeight;
 
   // 3) Time ON (inactive if interval)
-  if (fullRedraw || lastSelectedIndex==3 || menuNav.selectedIndex==3 ||
-      lastHourOn!=tempOutletSchedule.hourOn || lastMinOn!=tempOutletSchedule.minuteOn ||
-      lastInterval!=tempOutletSchedule.isInterval || lastInEditMode!=menuNav.inEditMode ||
-      lastEditingHour!=menuNav.editingHour) {
-
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-
-    if (tempOutletSchedule.isInterval) {
-      // greyed line
-      tft.setTextColor(DARKGREY);
-      tft.setCursor(4, y+2);
-      tft.print("Time ON: --:--");
-    } else {
-      highlightLine(3, menuNav.inEditMode);
-      tft.setCursor(4, y+2);
-      tft.print("Time ON: ");
-      if (menuNav.selectedIndex==3 && menuNav.inEditMode) tft.setTextColor(YELLOW);
-      if (tempOutletSchedule.hourOn<10) tft.print("0");
-      tft.print(tempOutletSchedule.hourOn);
-      tft.print(":");
-      if (tempOutletSchedule.minuteOn<10) tft.print("0");
-      tft.print(tempOutletSchedule.minuteOn);
-    }
+  if (tempOutletSchedule.isInterval) {
+    // greyed line: the fixed on/off split of each period
+    canvas.setTextColor(DARKGREY);
+    canvas.setCursor(4, y+2);
+    canvas.print("Time ON:  first ");
+    printHalfInterval(shownIntervalMinutes);
+  } else {
+    highlightLine(3, menuNav.inEditMode);
+    canvas.setCursor(4, y+2);
+    canvas.print("Time ON: ");
+    if (menuNav.selectedIndex==3 && menuNav.inEditMode) canvas.setTextColor(YELLOW);
+    printTwoDigits(tempOutletSchedule.hourOn);
+    canvas.print(":");
+    printTwoDigits(tempOutletSchedule.minuteOn);
   }
   y += lineHeight;
 
   // 4) Time OFF (inactive if interval)
-  if (fullRedraw || lastSelectedIndex==4 || menuNav.selectedIndex==4 ||
-      lastHourOff!=tempOutletSchedule.hourOff || lastMinOff!=tempOutletSchedule.minuteOff ||
-      lastInterval!=tempOutletSchedule.isInterval || lastInEditMode!=menuNav.inEditMode ||
-      lastEditingHour!=menuNav.editingHour) {
-
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-
-    if (tempOutletSchedule.isInterval) {
-      tft.setTextColor(DARKGREY);
-      tft.setCursor(4, y+2);
-      tft.print("Time OFF: --:--");
-    } else {
-      highlightLine(4, menuNav.inEditMode);
-      tft.setCursor(4, y+2);
-      tft.print("Time OFF:");
-      tft.setCursor(68, y+2);
-      if (menuNav.selectedIndex==4 && menuNav.inEditMode) tft.setTextColor(YELLOW);
-      if (tempOutletSchedule.hourOff<10) tft.print("0");
-      tft.print(tempOutletSchedule.hourOff);
-      tft.print(":");
-      if (tempOutletSchedule.minuteOff<10) tft.print("0");
-      tft.print(tempOutletSchedule.minuteOff);
-    }
+  if (tempOutletSchedule.isInterval) {
+    canvas.setTextColor(DARKGREY);
+    canvas.setCursor(4, y+2);
+    canvas.print("Time OFF: then ");
+    printHalfInterval(shownIntervalMinutes);
+  } else {
+    highlightLine(4, menuNav.inEditMode);
+    canvas.setCursor(4, y+2);
+    canvas.print("Time OFF:");
+    canvas.setCursor(68, y+2);
+    if (menuNav.selectedIndex==4 && menuNav.inEditMode) canvas.setTextColor(YELLOW);
+    printTwoDigits(tempOutletSchedule.hourOff);
+    canvas.print(":");
+    printTwoDigits(tempOutletSchedule.minuteOff);
   }
   y += lineHeight;
 
   // 5) Save
-  if (fullRedraw || lastSelectedIndex==5 || menuNav.selectedIndex==5) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    highlightLine(5);
-    tft.setCursor(4, y+2);
-    tft.print("SAVE");
-  }
+  highlightLine(5);
+  canvas.setCursor(4, y+2);
+  canvas.print("SAVE");
   y += lineHeight;
 
   // 6) Cancel
-  if (fullRedraw || lastSelectedIndex==6 || menuNav.selectedIndex==6) {
-    tft.fillRect(0, y, 128, lineHeight, BLACK);
-    highlightLine(6);
-    tft.setCursor(4, y+2);
-    tft.print("CANCEL");
-  }
-
-  lastSelectedIndex = menuNav.selectedIndex;
-  lastDaysBitmap = menuNav.tempDaysBitmap;
-  lastRelay = tempOutletSchedule.relayNumber;
-  lastHourOn = tempOutletSchedule.hourOn;
-  lastMinOn = tempOutletSchedule.minuteOn;
-  lastHourOff = tempOutletSchedule.hourOff;
-  lastMinOff = tempOutletSchedule.minuteOff;
-  lastInterval = tempOutletSchedule.isInterval;
-  lastIntervalMin = tempOutletSchedule.intervalMinutes;
-  lastInEditMode = menuNav.inEditMode;
-  lastEditingHour = menuNav.editingHour;
-  lastIntervalIsHours = menuNav.outletIntervalIsHours;
-  lastIntervalValue = menuNav.outletIntervalValue;
+  highlightLine(6);
+  canvas.setCursor(4, y+2);
+  canvas.print("CANCEL");
 }
 
 void drawTimeSelectionScreen() {
-  static uint8_t lastHour = 255;
-  static uint8_t lastMinute = 255;
-  static bool lastEditingHour = true;
-
-  bool fullRedraw = (menuNav.lastDrawnIndex == -1);
-
-  if (fullRedraw) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-
-    // Header
-    tft.setTextColor(YELLOW);
-    tft.setCursor(2, 2);
-    tft.print("SET TIME");
-    tft.drawFastHLine(0, 10, 128, YELLOW);
-
-    // Instructions
-    tft.setTextSize(1);
-    tft.setTextColor(CYAN);
-    int y = 90;
-    tft.setCursor(2, y);
-    tft.print("Rotate: Change");
-    y += 10;
-    tft.setCursor(2, y);
-    tft.print("Click: Next field");
-
-    lastHour = 255;  // Force redraw
-    lastMinute = 255;
-  }
-
-  // Only redraw time if changed
-  if (fullRedraw || lastHour != tempDosingSchedule.hour || lastEditingHour != menuNav.editingHour) {
-    int y = 45;
-    int xOffset = 20;
-
-    // Clear hour area
-    tft.fillRect(xOffset - 2, y - 2, 36, 26, BLACK);
-
-    // Hour
-    tft.setTextSize(3);
-    if (menuNav.editingHour) {
-      tft.fillRect(xOffset - 2, y - 2, 36, 26, BLUE);
-      tft.setTextColor(WHITE);
-    } else {
-      tft.setTextColor(GREEN);
-    }
-    tft.setCursor(xOffset, y);
-    if (tempDosingSchedule.hour < 10) tft.print("0");
-    tft.print(tempDosingSchedule.hour);
-
-    lastHour = tempDosingSchedule.hour;
-  }
-
-  // Colon (only on full redraw)
-  if (fullRedraw) {
-    int y = 45;
-    int xOffset = 20;
-    tft.setTextSize(3);
-    tft.setTextColor(CYAN);
-    tft.setCursor(xOffset + 38, y);
-    tft.print(":");
-  }
-
-  // Only redraw minute if changed
-  if (fullRedraw || lastMinute != tempDosingSchedule.minute || lastEditingHour != menuNav.editingHour) {
-    int y = 45;
-    int xOffset = 20;
-
-    // Clear minute area
-    tft.fillRect(xOffset + 52, y - 2, 36, 26, BLACK);
-
-    // Minute
-    tft.setTextSize(3);
-    if (!menuNav.editingHour) {
-      tft.fillRect(xOffset + 52, y - 2, 36, 26, BLUE);
-      tft.setTextColor(WHITE);
-    } else {
-      tft.setTextColor(GREEN);
-    }
-    tft.setCursor(xOffset + 54, y);
-    if (tempDosingSchedule.minute < 10) tft.print("0");
-    tft.print(tempDosingSchedule.minute);
-
-    lastMinute = tempDosingSchedule.minute;
+  canvas.setTextSize(1);
+
+  // Header
+  canvas.setTextColor(YELLOW);
+  canvas.setCursor(2, 2);
+  canvas.print("SET TIME");
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
+
+  // Instructions
+  canvas.setTextColor(CYAN);
+  canvas.setCursor(2, 90);
+  canvas.print("Rotate: Change");
+  canvas.setCursor(2, 100);
+  canvas.print("Click: Next field");
+
+  int y = 45;
+  int xOffset = 20;
+  canvas.setTextSize(3);
+
+  // Hour
+  if (menuNav.editingHour) {
+    canvas.fillRect(xOffset - 2, y - 2, 36, 26, BLUE);
+    canvas.setTextColor(WHITE);
+  } else {
+    canvas.setTextColor(GREEN);
   }
-
-  // Update editing status text
-  if (fullRedraw || lastEditingHour != menuNav.editingHour) {
-    int y = 110;
-    tft.setTextSize(1);
-    tft.fillRect(0, y, 128, 10, BLACK);  // Clear line
-    tft.setTextColor(CYAN);
-    tft.setCursor(2, y);
-    if (menuNav.editingHour) {
-      tft.print("Editing: Hour");
-    } else {
-      tft.print("Editing: Minute");
-    }
-    lastEditingHour = menuNav.editingHour;
+  canvas.setCursor(xOffset, y);
+  printTwoDigits(tempDosingSchedule.hour);
+
+  // Colon
+  canvas.setTextColor(CYAN);
+  canvas.setCursor(xOffset + 38, y);
+  canvas.print(":");
+
+  // Minute
+  if (!menuNav.editingHour) {
+    canvas.fillRect(xOffset + 52, y - 2, 36, 26, BLUE);
+    canvas.setTextColor(WHITE);
+  } else {
+    canvas.setTextColor(GREEN);
   }
+  canvas.setCursor(xOffset + 54, y);
+  printTwoDigits(tempDosingSchedule.minute);
+
+  // Editing status text
+  canvas.setTextSize(1);
+  canvas.setTextColor(CYAN);
+  canvas.setCursor(2, 110);
+  canvas.print(menuNav.editingHour ? "Editing: Hour" : "Editing: Minute");
 }
 
 
 void drawAmountSelectionScreen() {
-  static uint16_t lastAmount = 0xFFFF;
-
-  bool fullRedraw = (menuNav.lastDrawnIndex == -1);
-
-  if (fullRedraw) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-
-    // Header
-    tft.setTextColor(YELLOW);
-    tft.setCursor(2, 2);
-    tft.print("SET AMOUNT");
-    tft.drawFastHLine(0, 10, 128, YELLOW);
-
-    // Instructions
-    tft.setTextSize(1);
-    tft.setTextColor(CYAN);
-    int y = 100;
-    tft.setCursor(2, y);
-    tft.print("Rotate: Change (0.1mL)");
-    y += 10;
-    tft.setCursor(2, y);
-    tft.print("Click: Confirm");
-
-    lastAmount = 0xFFFF;  // Force redraw
-  }
-
-  // Only redraw amount if changed
-  if (fullRedraw || lastAmount != tempDosingSchedule.amountML) {
-    int y = 50;
-
-    // Clear amount area
-    tft.fillRect(20, y, 90, 26, BLACK);
-
-    // Amount display
-    tft.setTextSize(3);
-    tft.setTextColor(GREEN);
-    tft.setCursor(25, y);
-    tft.print(tempDosingSchedule.amountML / 10.0, 1);
-    tft.setTextSize(2);
-    tft.setCursor(75, y + 8);
-    tft.print(" mL");
-
-    lastAmount = tempDosingSchedule.amountML;
-  }
+  canvas.setTextSize(1);
+
+  // Header
+  canvas.setTextColor(YELLOW);
+  canvas.setCursor(2, 2);
+  canvas.print("SET AMOUNT");
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
+
+  // Instructions
+  canvas.setTextColor(CYAN);
+  canvas.setCursor(2, 100);
+  canvas.print("Rotate: Change (0.1mL)");
+  canvas.setCursor(2, 110);
+  canvas.print("Click: Confirm");
+
+  // Amount display
+  int y = 50;
+  canvas.setTextSize(3);
+  canvas.setTextColor(GREEN);
+  canvas.setCursor(25, y);
+  canvas.print(tempDosingSchedule.amountML / 10.0, 1);
+  canvas.setTextSize(2);
+  canvas.setCursor(75, y + 8);
+  canvas.print(" mL");
 }
 // outlet draw routines
+// Shared by OUTLET VIEW and OUTLET DELETE SELECT; only delete gets a return row
 void drawOutletScheduleListScreen() {
-  static int lastSelectedIndex = -1;
-  static int lastPage = -1;
-
-  // bool needsFullRedraw = (menuNav.needsFullRedraw || lastPage != menuNav.currentPage);
-
-  // if (needsFullRedraw) {
-  //   tft.fillScreen(BLACK);
-  //   tft.setTextSize(1);
-  //   lastSelectedIndex = -1;
-  //   lastPage = menuNav.currentPage;
-  //   menuNav.needsFullRedraw = false;
-  // }
-    // ✅ ALSO full redraw on fresh entry (drawMenu clears needsFullRedraw early)
-  bool needsFullRedraw = (menuNav.lastDrawnIndex == -1) || (lastPage != menuNav.currentPage);
-
-  if (needsFullRedraw) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-    lastSelectedIndex = -1;
-    lastPage = menuNav.currentPage;
-  }
+  bool viewOnly = (menuNav.currentMenu == MENU_OUTLET_VIEW);
+  drawListHeader(viewOnly ? "OUTLET SCHEDULES" : "DELETE OUTLET");
 
   // No schedules
   if (outletScheduleCount == 0) {
-    tft.setTextColor(CYAN);
-    tft.setCursor(4, 50);
-    tft.print("No schedules");
-    tft.setCursor(4, 62);
-    tft.print("Press to Return");
+    drawListEmpty();
     return;
   }
 
-  const int SCHEDULES_PER_PAGE = 6;
-  const int LINE_HEIGHT = 20;
-
-  // int startIdx = menuNav.currentPage * SCHEDULES_PER_PAGE;
-  // int endIdx   = min(startIdx + SCHEDULES_PER_PAGE, outletScheduleCount);
-  int startIdx = menuNav.currentPage * SCHEDULES_PER_PAGE;
-  if (startIdx >= outletScheduleCount) {
-    menuNav.currentPage = 0;
-    menuNav.selectedIndex = 0;
-    menuNav.needsFullRedraw = true;
-    return;  // next frame redraws page 0
-  }
-  int endIdx = min(startIdx + SCHEDULES_PER_PAGE, outletScheduleCount);
-
-  int y = 0;
-  int itemsOnPage = 0;
-
-  for (int i = startIdx; i < endIdx; i++) {
-    bool isSelected  = (i == menuNav.selectedIndex);
-    bool wasSelected = (i == lastSelectedIndex);
-
-    if (isSelected != wasSelected || needsFullRedraw || lastSelectedIndex == -1) {
-      OutletSchedule &sched = outletSchedules[i];
-
-      tft.setTextColor(GREEN);
-      tft.setTextSize(1);
-
-      // // LINE 1: "S1 Rly3 08:00-09:30"
-      // tft.setCursor(0, y);
-      // tft.print("S");
-      // tft.print(i + 1);
-      // tft.print(" Rly");
-      // tft.print(sched.relayNumber);
-      // tft.print(" ");
-
-      // if (sched.hourOn < 10) tft.print("0");
-      // tft.print(sched.hourOn);
-      // tft.print(":");
-      // if (sched.minuteOn < 10) tft.print("0");
-      // tft.print(sched.minuteOn);
-
-      // tft.print("-");
-
-      // if (sched.hourOff < 10) tft.print("0");
-      // tft.print(sched.hourOff);
-      // tft.print(":");
-      // if (sched.minuteOff < 10) tft.print("0");
-      // tft.print(sched.minuteOff);
-
-    // LINE 1: either time span or interval
-    tft.setCursor(0, y);
-    tft.print("S");
-    tft.print(i + 1);
-    tft.print(" Rly");
-    tft.print(sched.relayNumber);
-    tft.print(" ");
-
-    if (sched.isInterval) {
-      tft.print("Int ");
-      uint16_t mins = sched.intervalMinutes;
-
-      if (mins % 60 == 0) {
-        tft.print(mins / 60);
-        tft.print("h");
-      } else {
-        tft.print(mins);
-        tft.print("m");
-      }
-    } else {
-      if (sched.hourOn < 10) tft.print("0");
-      tft.print(sched.hourOn);
-      tft.print(":");
-      if (sched.minuteOn < 10) tft.print("0");
-      tft.print(sched.minuteOn);
-
-      tft.print("-");
-
-      if (sched.hourOff < 10) tft.print("0");
-      tft.print(sched.hourOff);
-      tft.print(":");
-      if (sched.minuteOff < 10) tft.print("0");
-      tft.print(sched.minuteOff);
-    }
-
-      // LINE 2: days
-      const char* dayAbbr[] = {"Su", "Mo", "Tu", "We", "Th", "Fr", "Sa"};
-      tft.setCursor(0, y + 9);
-
-      for (int d = 0; d < 7; d++) {
-        bool enabled = isDayEnabled(sched.daysOfWeek, d);
-        tft.setTextColor(enabled ? GREEN : RED);
-        tft.print(dayAbbr[d]);
-        if (d < 6) tft.print(" ");
-      }
-    }
-
-    y += LINE_HEIGHT;
-    itemsOnPage++;
-  }
-
-  // "Return to Menu" line at end (same pattern as dosing list)
-  int returnIndex = outletScheduleCount;
-  int returnPage = returnIndex / SCHEDULES_PER_PAGE;
-
-  if (menuNav.currentPage == returnPage && itemsOnPage < SCHEDULES_PER_PAGE) {
-    bool isSelected  = (menuNav.selectedIndex == returnIndex);
-    bool wasSelected = (lastSelectedIndex == returnIndex);
-
-    if (isSelected != wasSelected || needsFullRedraw || lastSelectedIndex == -1) {
-      tft.fillRect(0, y, 128, 10, isSelected ? BLUE : BLACK);
-      tft.setTextColor(isSelected ? WHITE : YELLOW);
-      tft.setTextSize(1);
-      tft.setCursor(0, y);
-      tft.print("Return to Menu");
-    }
+  if (viewOnly) {
+    outletList.draw(outletScheduleCount, menuNav.selectedIndex, drawOutletRow);
+    canvas.drawText(0, 119, "Press to Return", YELLOW, BLACK);
+  } else {
+    outletList.draw(outletScheduleCount + 1, menuNav.selectedIndex, drawOutletRow);
   }
-
-  lastSelectedIndex = menuNav.selectedIndex;
 }
 
 
 void drawMainMenu() {
-  // Draw status bar only on full redraw
-  if (menuNav.lastDrawnIndex == -1) {
-    drawStatusBar();
-    // No "MAIN MENU" text - cleaner look
-    // No yellow line - blank space separator
-    
-    // Draw IP address at bottom (y=118)
-    tft.setTextSize(1);
-    tft.setTextColor(YELLOW);
-    tft.setCursor(2, 118);
-    if (wifiConnected && currentData.ip.length() > 0) {
-      tft.print("IP: ");
-      tft.print(currentData.ip);
-    } else {
-      tft.print("IP: N/A");
-    }
+  drawStatusBar();
+  // No "MAIN MENU" text - cleaner look
+  // No yellow line - blank space separator
+
+  // Draw IP address at bottom (y=118)
+  canvas.setTextSize(1);
+  canvas.setTextColor(YELLOW);
+  canvas.setCursor(2, 118);
+  if (wifiConnected && currentData.ip.length() > 0) {
+    canvas.print("IP: ");
+    canvas.print(currentData.ip);
+  } else {
+    canvas.print("IP: N/A");
   }
 
   // Start menu items below status bar
@@ -1449,115 +890,215 @@ void drawMainMenu() {
     int itemIndex = i + menuNav.scrollOffset;
     int y = startY + (i * MENU_ITEM_HEIGHT);
 
-    // Only redraw if this item's selection state changed
     bool isSelected = (itemIndex == menuNav.selectedIndex);
-    bool wasSelected = (itemIndex == menuNav.lastDrawnIndex);
-
-    if (isSelected != wasSelected || menuNav.lastDrawnIndex == -1) {
-      // Clear the line
-      tft.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLACK);
-
-      if (isSelected) {
-        tft.setTextColor(WHITE);
-        // Draw arrow indicator
-        tft.setCursor(2, y);
-        tft.print(">");  // Arrow indicator
-        tft.setCursor(12, y);  // Text starts after arrow
-      } else {
-        tft.setTextColor(GREEN);
-        tft.setCursor(12, y);  // Text at same position (no arrow)
-      }
-
-      // Read string from PROGMEM
-      char buffer[50];
-      strcpy_P(buffer, (char*)pgm_read_ptr(&mainMenuItems[itemIndex]));
-      tft.print(buffer);
+    uint16_t color = isSelected ? WHITE : GREEN;
+    if (isSelected) {
+      canvas.drawText(2, y, ">", color, BLACK);  // Arrow indicator
     }
+
+    // Read string from PROGMEM, text at x=12 with or without the arrow
+    char buffer[50];
+    strcpy_P(buffer, (char*)pgm_read_ptr(&mainMenuItems[itemIndex]));
+    canvas.drawText(12, y, buffer, color, BLACK);
   }
 }
 
 // Draw dosing schedule menu
 
 void drawConfirmDialog(const char* title) {
-  static int lastConfirmIndex = -1;
-  
-  // Full redraw on first draw
-  if (menuNav.needsFullRedraw || lastConfirmIndex == -1) {
-    tft.fillScreen(BLACK);
-    tft.setTextSize(1);
-    tft.setCursor(2, 2);
-    tft.setTextColor(YELLOW);
-    tft.print(title);
-    tft.drawFastHLine(0, 10, 128, YELLOW);
-
-    tft.setCursor(2, 40);
-    tft.setTextColor(WHITE);
-    tft.print("Are you sure?");
-    
-    lastConfirmIndex = -1;  // Force redraw of all options
-    menuNav.needsFullRedraw = false;
-  }
+  canvas.setTextSize(1);
+  canvas.setCursor(2, 2);
+  canvas.setTextColor(YELLOW);
+  canvas.print(title);
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
+
+  canvas.setCursor(2, 40);
+  canvas.setTextColor(WHITE);
+  canvas.print("Are you sure?");
 
   int startY = 60;
 
   for (int i = 0; i < confirmYesNoMenuCount; i++) {
     int y = startY + (i * MENU_ITEM_HEIGHT);
 
-    bool isSelected = (i == menuNav.selectedIndex);
-    bool wasSelected = (i == lastConfirmIndex);
-
-    if (isSelected != wasSelected || lastConfirmIndex == -1) {
-      tft.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLACK);
-
-      if (isSelected) {
-        tft.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLUE);
-        tft.setTextColor(WHITE);
-      } else {
-        tft.setTextColor(GREEN);
-      }
-
-      tft.setCursor(2, y);
-      char buffer[10];
-      strcpy_P(buffer, (char*)pgm_read_ptr(&confirmYesNoMenu[i]));
-      tft.print(buffer);
+    if (i == menuNav.selectedIndex) {
+      canvas.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLUE);
+      canvas.setTextColor(WHITE);
+    } else {
+      canvas.setTextColor(GREEN);
     }
+
+    canvas.setCursor(2, y);
+    char buffer[10];
+    strcpy_P(buffer, (char*)pgm_read_ptr(&confirmYesNoMenu[i]));
+    canvas.print(buffer);
   }
-  
-  lastConfirmIndex = menuNav.selectedIndex;
 }
 
 
 void drawCalibrateMenu(uint8_t pumpNum) {
-  if (menuNav.lastDrawnIndex == -1) {
-    tft.setTextSize(1);
-    tft.setCursor(2, 2);
-    tft.setTextColor(YELLOW);
-    tft.print("CALIBRATE PUMP ");
-    tft.print(pumpNum);
-    tft.drawFastHLine(0, 10, 128, YELLOW);
+  canvas.setTextSize(1);
+  canvas.setCursor(2, 2);
+  canvas.setTextColor(YELLOW);
+  canvas.print("CALIBRATE PUMP ");
+  canvas.print(pumpNum);
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
+
+  // Current calibration
+  const PumpCalibration &cal = pumpCalibrations[pumpNum - 1];
+  char line[24];
+  if (cal.pointCount > 0) {
+    snprintf(line, sizeof(line), "%d pts, %.2fmL/s@%d%%", cal.pointCount, cal.mlPerSecond, cal.pwmSpeed);
+  } else if (cal.isCalibrated) {
+    snprintf(line, sizeof(line), "1 pt, %.2fmL/s@%d%%", cal.mlPerSecond, cal.pwmSpeed);
+  } else {
+    snprintf(line, sizeof(line), "Not calibrated");
   }
+  canvas.drawText(2, 18, line, CYAN, BLACK);
 
   int startY = 40;
 
   for (int i = 0; i < calibrateConfirmMenuCount; i++) {
     int y = startY + (i * MENU_ITEM_HEIGHT);
 
-    bool isSelected = (i == menuNav.selectedIndex);
-    bool wasSelected = (i == menuNav.lastDrawnIndex);
+    if (i == menuNav.selectedIndex) {
+      canvas.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLUE);
+      canvas.setTextColor(WHITE);
+    } else {
+      canvas.setTextColor(GREEN);
+    }
 
-    if (isSelected != wasSelected || menuNav.lastDrawnIndex == -1) {
-      tft.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLACK);
+    canvas.setCursor(2, y);
+    canvas.print(calibrateConfirmMenu[i]);
+  }
+}
 
-      if (isSelected) {
-        tft.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLUE);
-        tft.setTextColor(WHITE);
-      } else {
-        tft.setTextColor(GREEN);
+
+// Calibration wizard, one screen per step (state from Calibration.h)
+void drawCalibrationRunScreen() {
+  CalibrationStatus cal = getCalibrationStatus();
+  char line[24];
+
+  snprintf(line, sizeof(line), "CALIBRATE PUMP %d", menuNav.tempPumpNumber);
+  canvas.drawText(2, 2, line, YELLOW, BLACK);
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
+
+  if (cal.requestPending || cal.state == CAL_IDLE) {
+    canvas.drawText(2, 40, "Please wait...", WHITE, BLACK);
+    return;
+  }
+
+  if (cal.state == CAL_READY || cal.state == CAL_RUNNING || cal.state == CAL_MEASURE) {
+    snprintf(line, sizeof(line), "Point %d/%d at %d%%", cal.point + 1, CAL_POINT_COUNT, cal.duty);
+    canvas.drawText(2, 16, line, CYAN, BLACK);
+  }
+
+  switch (cal.state) {
+    case CAL_READY: {
+      canvas.drawText(2, 32, "Empty the cup and", WHITE, BLACK);
+      canvas.drawText(2, 42, "place it under the", WHITE, BLACK);
+      canvas.drawText(2, 52, "pump outlet.", WHITE, BLACK);
+
+      snprintf(line, sizeof(line), "Run %d s", CAL_RUN_MS / 1000);
+      const char* items[2] = { line, "Cancel" };
+      for (int i = 0; i < 2; i++) {
+        int y = 80 + (i * MENU_ITEM_HEIGHT);
+        bool isSelected = (i == menuNav.selectedIndex);
+        if (isSelected) canvas.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLUE);
+        canvas.drawText(2, y, items[i], isSelected ? WHITE : GREEN, isSelected ? BLUE : BLACK);
+      }
+      break;
+    }
+
+    case CAL_RUNNING: {
+      canvas.drawText(2, 36, "Running...", WHITE, BLACK);
+      unsigned long elapsed = min<unsigned long>(cal.elapsedMs, CAL_RUN_MS);
+      canvas.drawRect(4, 52, 120, 12, WHITE);
+      canvas.fillRect(6, 54, (int16_t)(116UL * elapsed / CAL_RUN_MS), 8, GREEN);
+      snprintf(line, sizeof(line), "%lu / %d s", elapsed / 1000, CAL_RUN_MS / 1000);
+      canvas.drawText(2, 70, line, WHITE, BLACK);
+      canvas.drawText(2, 110, "Click: Abort", CYAN, BLACK);
+      break;
+    }
+
+    case CAL_MEASURE:
+      canvas.drawText(2, 32, "Volume collected:", WHITE, BLACK);
+      canvas.setTextSize(2);
+      canvas.setTextColor(GREEN);
+      canvas.setCursor(20, 50);
+      canvas.print(cal.volume / 10.0, 1);
+      canvas.print(" mL");
+      canvas.setTextSize(1);
+      canvas.drawText(2, 100, "Rotate: Change 0.1mL", CYAN, BLACK);
+      canvas.drawText(2, 110, "Click: Confirm", CYAN, BLACK);
+      break;
+
+    case CAL_REVIEW:
+      canvas.drawText(2, 16, "Duty   Flow", CYAN, BLACK);
+      for (int i = 0; i < cal.result.pointCount; i++) {
+        snprintf(line, sizeof(line), "%3d%%   %.3f mL/s", cal.result.pointDuty[i], cal.result.pointFlow[i]);
+        canvas.drawText(2, 28 + (i * 10), line, WHITE, BLACK);
       }
+      canvas.drawText(2, 110, "Click: Continue", CYAN, BLACK);
+      break;
+
+    default:
+      canvas.drawText(2, 32, "No flow measured.", RED, BLACK);
+      canvas.drawText(2, 42, "Check the tubing", WHITE, BLACK);
+      canvas.drawText(2, 52, "and try again.", WHITE, BLACK);
+      canvas.drawText(2, 110, "Click: Back", CYAN, BLACK);
+      break;
+  }
+}
+
+// Replace cycle progress (state from ReplaceSolution.h)
+void drawReplaceStatusScreen() {
+  ReplaceStatus rep = getReplaceStatus();
+  bool active = rep.stage != REPLACE_IDLE && rep.stage != REPLACE_FAULT;
+  char line[40];   // Fits the pump line with any two %lu values
+
+  canvas.drawText(2, 2, "REPLACE SOLUTION", YELLOW, BLACK);
+  canvas.drawFastHLine(0, 10, 128, YELLOW);
 
-      tft.setCursor(2, y);
-      tft.print(calibrateConfirmMenu[i]);
+  if (rep.requestPending) {
+    canvas.drawText(2, 40, "Please wait...", WHITE, BLACK);
+    return;
+  }
+
+  // Stage list with the current one marked
+  static const ReplaceStage stages[] = { REPLACE_DRAIN, REPLACE_FILL, REPLACE_DOSE, REPLACE_SETTLE };
+  for (int i = 0; i < 4; i++) {
+    bool current = rep.stage == stages[i] || (rep.stage == REPLACE_FAULT && rep.faultStage == stages[i]);
+    uint16_t color = !current ? WHITE : (rep.stage == REPLACE_FAULT ? RED : GREEN);
+    snprintf(line, sizeof(line), "%c %s", current ? '>' : ' ', replaceStageName(stages[i]));
+    canvas.drawText(2, 16 + (i * 10), line, color, BLACK);
+  }
+
+  if (active) {
+    uint32_t elapsed = min<uint32_t>(rep.elapsedS, rep.limitS);
+    canvas.drawRect(4, 60, 120, 10, WHITE);
+    canvas.fillRect(6, 62, (int16_t)(116UL * elapsed / rep.limitS), 6, GREEN);
+    if (rep.stage == REPLACE_DOSE && rep.dosePump > 0) {
+      snprintf(line, sizeof(line), "Pump %d  %lu/%lu min", rep.dosePump,
+               (unsigned long)elapsed / 60, (unsigned long)rep.limitS / 60);
+    } else {
+      snprintf(line, sizeof(line), "%lu / %lu min", (unsigned long)elapsed / 60, (unsigned long)rep.limitS / 60);
     }
+    canvas.drawText(2, 74, line, WHITE, BLACK);
+  } else if (rep.stage == REPLACE_FAULT) {
+    canvas.drawText(2, 64, "Stage timed out.", RED, BLACK);
+    canvas.drawText(2, 74, "Relays are off.", WHITE, BLACK);
+  } else {
+    canvas.drawText(2, 64, "No cycle running", WHITE, BLACK);
+  }
+
+  const char* items[2] = { "Back", "Abort" };
+  int itemCount = active ? 2 : 1;
+  for (int i = 0; i < itemCount; i++) {
+    int y = 90 + (i * MENU_ITEM_HEIGHT);
+    bool isSelected = (i == menuNav.selectedIndex);
+    if (isSelected) canvas.fillRect(0, y - 1, 128, MENU_ITEM_HEIGHT, BLUE);
+    canvas.drawText(2, y, items[i], isSelected ? WHITE : (i == 1 ? RED : GREEN), isSelected ? BLUE : BLACK);
   }
 }
 
@@ -1569,12 +1110,16 @@ void initDisplay() {
     return;
   }
 
+  // Off-screen canvas in PSRAM, falls back to direct drawing
+  canvas.begin(&tft);
+
   // Clear the screen completely
-  tft.fillScreen(BLACK);
+  canvas.fillScreen(BLACK);
+  canvas.flush();
 
   // Set text properties
-  tft.setTextSize(1);
-  tft.setTextWrap(false);
+  canvas.setTextSize(1);
+  canvas.setTextWrap(false);
 
   // Mark as initialized
   initialized = true;
@@ -0,0 +1,313 @@
+/*
+ * DoseJournal.cpp
+ *
+ * Scheduled dose journal on LittleFS and the boot-time catch-up of missed
+ * fires.
+ */
+
+#include "DoseJournal.h"
+#include "Crc.h"
+#include "DosingQueue.h"
+#include "TimeService.h"
+#include <LittleFS.h>
+
+#define DOSE_JOURNAL_TMP "/dose_journal.tmp"
+#define DOSE_JOURNAL_COMPACT_SIZE 4096     // Rewrite the journal past this size
+#define DOSE_JOURNAL_OPEN_MAX (DOSING_PUMP_COUNT * (DOSE_QUEUE_LENGTH + 1))
+#define DOSE_CATCHUP_LATE_LIMIT_S 86400UL  // DOSE_CATCHUP_LATE never runs a fire older than this
+
+static_assert(sizeof(DoseJournalRecord) == 16, "DoseJournalRecord must stay 16 bytes on flash");
+
+// Doses queued or running, as of their latest record
+static DoseJournalRecord openDoses[DOSE_JOURNAL_OPEN_MAX];
+static uint8_t openCount = 0;
+
+// Latest fire time in the journal and the pumps dosed at it
+static uint32_t watermark = 0;
+static uint8_t watermarkPumps = 0;
+
+static size_t journalSize = 0;
+static bool journalReady = false;
+
+// ==================================================
+// RECORDS
+// ==================================================
+static uint16_t recordCRC(const DoseJournalRecord &rec) {
+  return crc16((const uint8_t*)&rec, offsetof(DoseJournalRecord, crc));
+}
+
+static uint8_t pumpBit(uint8_t pumpNumber) {
+  return (pumpNumber >= 1 && pumpNumber <= 8) ? (1 << (pumpNumber - 1)) : 0;
+}
+
+static int findOpenDose(uint8_t pump, uint32_t dueUnix) {
+  for (int i = 0; i < openCount; i++) {
+    if (openDoses[i].pump == pump && openDoses[i].dueUnix == dueUnix) return i;
+  }
+  return -1;
+}
+
+// Fold a record into the in-memory state
+static void applyRecord(const DoseJournalRecord &rec) {
+  if (rec.dueUnix > watermark) {
+    watermark = rec.dueUnix;
+    watermarkPumps = 0;
+  }
+  if (rec.dueUnix == watermark) watermarkPumps |= pumpBit(rec.pump);
+  if (rec.type == DOSE_JOURNAL_WATERMARK) return;
+
+  int slot = findOpenDose(rec.pump, rec.dueUnix);
+  if (rec.type == DOSE_JOURNAL_QUEUED || rec.type == DOSE_JOURNAL_STARTED) {
+    if (slot >= 0) {
+      openDoses[slot] = rec;
+    } else if (openCount < DOSE_JOURNAL_OPEN_MAX) {
+      openDoses[openCount++] = rec;
+    }
+  } else if (slot >= 0) {
+    // Closed; keep the rest in queue order
+    memmove(&openDoses[slot], &openDoses[slot + 1], (openCount - slot - 1) * sizeof(DoseJournalRecord));
+    openCount--;
+  }
+}
+
+// ==================================================
+// FILE
+// ==================================================
+// Returns false if the journal ends in a torn or corrupt record
+static bool replayJournal() {
+  File file = LittleFS.open(DOSE_JOURNAL_FILE, "r");
+  if (!file) return true;   // No journal yet
+
+  size_t fileSize = file.size();
+  DoseJournalRecord rec;
+  while (file.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+    if (rec.crc != recordCRC(rec)) break;
+    applyRecord(rec);
+    journalSize += sizeof(rec);
+  }
+  file.close();
+  return journalSize == fileSize;
+}
+
+// Rewrite the journal as the watermark plus the open doses
+static void compactJournal() {
+  File file = LittleFS.open(DOSE_JOURNAL_TMP, "w");
+  if (!file) {
+    Serial.println("[JOURNAL] Failed to open temp file for compaction");
+    return;
+  }
+
+  size_t written = 0;
+  for (uint8_t pump = 1; pump <= DOSING_PUMP_COUNT; pump++) {
+    if (!(watermarkPumps & pumpBit(pump))) continue;
+    DoseJournalRecord rec = {};
+    rec.type = DOSE_JOURNAL_WATERMARK;
+    rec.pump = pump;
+    rec.dueUnix = watermark;
+    rec.crc = recordCRC(rec);
+    written += file.write((const uint8_t*)&rec, sizeof(rec));
+  }
+  for (int i = 0; i < openCount; i++) {
+    written += file.write((const uint8_t*)&openDoses[i], sizeof(DoseJournalRecord));
+  }
+  file.close();
+
+  // LittleFS renames over an existing file atomically; the fallback leaves
+  // only the temp file, which initDoseJournal() picks up
+  if (!LittleFS.rename(DOSE_JOURNAL_TMP, DOSE_JOURNAL_FILE)) {
+    LittleFS.remove(DOSE_JOURNAL_FILE);
+    if (!LittleFS.rename(DOSE_JOURNAL_TMP, DOSE_JOURNAL_FILE)) {
+      Serial.println("[JOURNAL] Compaction failed");
+      return;
+    }
+  }
+  journalSize = written;
+}
+
+static void appendRecord(DoseJournalRecord &rec) {
+  DateTime now = timeNow();
+  rec.atUnix = now.isValid() ? now.unixtime() : 0;
+  rec.crc = recordCRC(rec);
+
+  File file = LittleFS.open(DOSE_JOURNAL_FILE, "a");
+  if (!file || file.write((const uint8_t*)&rec, sizeof(rec)) != sizeof(rec)) {
+    Serial.println("[JOURNAL] Failed to append dose record");
+  } else {
+    journalSize += sizeof(rec);
+  }
+  if (file) file.close();
+
+  applyRecord(rec);
+  if (journalSize > DOSE_JOURNAL_COMPACT_SIZE) compactJournal();
+}
+
+void journalDose(DoseJournalType type, const DoseRequest &dose) {
+  if (!journalReady || dose.source != DOSE_SOURCE_SCHEDULE) return;
+
+  DoseJournalRecord rec = {};
+  rec.type = type;
+  rec.pump = dose.pumpNumber;
+  rec.source = dose.source;
+  rec.scheduleIndex = dose.scheduleIndex;
+  rec.dueUnix = dose.dueUnix;
+  rec.amountML = dose.amountML;
+  appendRecord(rec);
+}
+
+// ==================================================
+// CATCH-UP
+// ==================================================
+static bool catchUpAllowed(uint32_t dueUnix, uint32_t nowUnix) {
+  uint32_t late = nowUnix - dueUnix;
+  switch (config.doseCatchUp) {
+    case DOSE_CATCHUP_LATE:   return late <= DOSE_CATCHUP_LATE_LIMIT_S;
+    case DOSE_CATCHUP_WINDOW: return late <= (uint32_t)config.doseCatchUpMinutes * 60;
+    default:                  return false;
+  }
+}
+
+static void printFireTime(uint32_t unixTime) {
+  char buf[24];   // Fits any DateTime field values, not just valid ones
+  DateTime t(unixTime);
+  snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d", t.year(), t.month(), t.day(), t.hour(), t.minute());
+  Serial.print(buf);
+}
+
+// Doses that were queued or running when the controller went down
+static void closeOpenDoses(bool clockValid, uint32_t nowUnix) {
+  DoseJournalRecord open[DOSE_JOURNAL_OPEN_MAX];
+  uint8_t count = openCount;
+  memcpy(open, openDoses, count * sizeof(DoseJournalRecord));
+
+  for (uint8_t i = 0; i < count; i++) {
+    DoseRequest dose;
+    dose.pumpNumber = open[i].pump;
+    dose.amountML = open[i].amountML;
+    dose.source = (DoseSource)open[i].source;
+    dose.scheduleIndex = open[i].scheduleIndex;
+    dose.dueUnix = open[i].dueUnix;
+
+    Serial.print("[DOSING] Pump ");
+    Serial.print(dose.pumpNumber);
+    Serial.print(" dose due ");
+    printFireTime(dose.dueUnix);
+
+    if (open[i].type == DOSE_JOURNAL_STARTED) {
+      // Unknown how much was pumped; dosing it again could overdose
+      Serial.println(" was interrupted by a reboot, not repeated");
+      journalDose(DOSE_JOURNAL_INTERRUPTED, dose);
+    } else if (clockValid && catchUpAllowed(dose.dueUnix, nowUnix)) {
+      Serial.println(" was still pending, queued again");
+      queueDose(dose);
+    } else {
+      Serial.println(" was still pending, skipped");
+      journalDose(DOSE_JOURNAL_SKIPPED, dose);
+    }
+  }
+}
+
+// The latest fire of each schedule between the journal's watermark and the
+// start of the current minute; DosingQueue handles the current minute on.
+// A fire at the watermark itself was handed out only for the pumps in
+// watermarkPumps: power can fail between two schedules due the same second.
+static void catchUpMissedFires(uint32_t nowUnix) {
+  uint32_t minuteStart = nowUnix - nowUnix % 60;
+  uint32_t since = watermark;
+  if (minuteStart > DOSE_CATCHUP_LATE_LIMIT_S && since < minuteStart - DOSE_CATCHUP_LATE_LIMIT_S) {
+    since = minuteStart - DOSE_CATCHUP_LATE_LIMIT_S;
+  }
+
+  for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
+    const DosingSchedule &sched = dosingSchedules[i];
+    uint32_t latest = 0;
+    uint16_t missed = 0;
+    uint32_t t = dosingScheduleNextFire(sched, since == watermark ? since - 1 : since);
+    if (t == watermark && (watermarkPumps & pumpBit(sched.pumpNumber))) {
+      t = dosingScheduleNextFire(sched, t);
+    }
+    for (; t != 0 && t < minuteStart; t = dosingScheduleNextFire(sched, t)) {
+      latest = t;
+      missed++;
+    }
+    if (missed == 0) continue;
+
+    DoseRequest dose;
+    dose.pumpNumber = sched.pumpNumber;
+    dose.amountML = sched.amountML;
+    dose.source = DOSE_SOURCE_SCHEDULE;
+    dose.scheduleIndex = (uint8_t)i;
+    dose.dueUnix = latest;
+
+    bool run = catchUpAllowed(latest, nowUnix);
+    Serial.print("[DOSING] Schedule ");
+    Serial.print(i + 1);
+    Serial.print(" missed ");
+    Serial.print(missed);
+    Serial.print(" fire(s) while off, latest ");
+    printFireTime(latest);
+    Serial.println(run ? ": dosing now" : ": skipped");
+
+    if (run) {
+      queueDose(dose);
+    } else {
+      journalDose(DOSE_JOURNAL_SKIPPED, dose);
+    }
+  }
+}
+
+void initDoseJournal() {
+  openCount = 0;
+  watermark = 0;
+  watermarkPumps = 0;
+  journalSize = 0;
+  journalReady = false;
+
+  // A compaction cut off between remove and rename leaves only the temp file
+  if (LittleFS.exists(DOSE_JOURNAL_TMP)) {
+    if (LittleFS.exists(DOSE_JOURNAL_FILE)) {
+      LittleFS.remove(DOSE_JOURNAL_TMP);
+    } else {
+      LittleFS.rename(DOSE_JOURNAL_TMP, DOSE_JOURNAL_FILE);
+    }
+  }
+
+  bool intact = replayJournal();
+  journalReady = true;
+  if (!intact) {
+    Serial.println("[JOURNAL] Dropped torn record at end of dose journal");
+    compactJournal();
+  }
+
+  Serial.print("[JOURNAL] ");
+  Serial.print(journalSize / sizeof(DoseJournalRecord));
+  Serial.print(" records, ");
+  Serial.print(openCount);
+  Serial.println(" open doses");
+
+  // A clock behind the journal was reset; nothing can be judged late
+  DateTime now = timeNow();
+  bool clockValid = now.isValid() && now.unixtime() >= watermark;
+  uint32_t nowUnix = now.unixtime();
+
+  closeOpenDoses(clockValid, nowUnix);
+  if (clockValid && watermark != 0) catchUpMissedFires(nowUnix);
+
+  seedDosingQueueHistory(watermark, watermarkPumps);
+}
+
+// ==================================================
+// CONFIG
+// ==================================================
+const char* doseCatchUpName(uint8_t policy) {
+  switch (policy) {
+    case DOSE_CATCHUP_SKIP: return "skip";
+    case DOSE_CATCHUP_LATE: return "late";
+    default:                return "window";
+  }
+}
+
+uint8_t doseCatchUpFromName(const char* name) {
+  if (name && strcmp(name, "skip") == 0) return DOSE_CATCHUP_SKIP;
+  if (name && strcmp(name, "late") == 0) return DOSE_CATCHUP_LATE;
+  return DOSE_CATCHUP_WINDOW;
+}
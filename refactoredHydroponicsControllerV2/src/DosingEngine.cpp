@@ -0,0 +1,339 @@
+/*
+ * DosingEngine.cpp
+ * 
+ * Per-pump dosing executors fed by the schedule queue.
+ */
+
+#include "DosingEngine.h"
+#include "DosingQueue.h"
+#include "DoseJournal.h"
+#include "Calibration.h"
+#include "DisplayQueue.h"
+#include "Hardware.h"
+#include "Tasks.h"
+#include "Telemetry.h"
+#include <esp_timer.h>
+
+#define PUMP_STOP_GRACE_MS 1000   // loop() stops the pump itself once the stop timer is this late
+
+enum PumpExecState : uint8_t {
+  PUMP_IDLE,
+  PUMP_RUNNING
+};
+
+struct PumpExecutor {
+  PumpExecState state = PUMP_IDLE;
+  DoseRequest active;
+  unsigned long startTime = 0;
+  unsigned long runDuration = 0;   // ms, for the loop() backstop
+
+  // Pump-off edge: the stop timer switches the pump off in the esp_timer
+  // task, so a stalled loop() cannot stretch a dose
+  esp_timer_handle_t stopTimer = nullptr;
+  bool timerArmed = false;
+  int64_t startMicros = 0;
+  int64_t plannedMicros = 0;
+  volatile int64_t stopMicros = 0;
+  volatile bool stopped = false;
+
+  // Last finished dose
+  int64_t lastPlannedMicros = 0;
+  int64_t lastActualMicros = 0;
+
+  // Ring of pending doses
+  DoseRequest pending[DOSE_QUEUE_LENGTH];
+  uint8_t head = 0;
+  uint8_t count = 0;
+};
+
+static PumpExecutor executors[DOSING_PUMP_COUNT];
+
+// Pending queues are filled from loop() and, for manual and top-up doses,
+// from other tasks
+static portMUX_TYPE doseMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================================================
+// DOSE REQUESTS
+// ==================================================
+bool queueDose(const DoseRequest &request) {
+  if (request.pumpNumber < 1 || request.pumpNumber > DOSING_PUMP_COUNT) return false;
+  if (request.amountML == 0) return false;
+
+  PumpExecutor &ex = executors[request.pumpNumber - 1];
+  bool coalesced = false;
+  DoseRequest carrier;
+
+  portENTER_CRITICAL(&doseMux);
+  if (ex.count < DOSE_QUEUE_LENGTH) {
+    ex.pending[(ex.head + ex.count) % DOSE_QUEUE_LENGTH] = request;
+    ex.count++;
+  } else {
+    DoseRequest &last = ex.pending[(ex.head + ex.count - 1) % DOSE_QUEUE_LENGTH];
+    uint32_t total = (uint32_t)last.amountML + request.amountML;
+    last.amountML = total > 0xFFFF ? 0xFFFF : (uint16_t)total;
+    carrier = last;
+    coalesced = true;
+  }
+  portEXIT_CRITICAL(&doseMux);
+
+  if (!coalesced) {
+    journalDose(DOSE_JOURNAL_QUEUED, request);
+    return true;
+  }
+
+  Serial.print("[DOSING] Queue full, merged dose into last pending on Pump ");
+  Serial.println(request.pumpNumber);
+  // Merges from manual or top-up requests come from other tasks and stay
+  // out of the journal
+  if (request.source == DOSE_SOURCE_SCHEDULE) {
+    journalDose(DOSE_JOURNAL_MERGED, request);
+    journalDose(DOSE_JOURNAL_QUEUED, carrier);
+  }
+  return true;
+}
+
+static bool takePendingDose(PumpExecutor &ex, DoseRequest &out) {
+  bool taken = false;
+  portENTER_CRITICAL(&doseMux);
+  if (ex.count > 0) {
+    out = ex.pending[ex.head];
+    ex.head = (ex.head + 1) % DOSE_QUEUE_LENGTH;
+    ex.count--;
+    taken = true;
+  }
+  portEXIT_CRITICAL(&doseMux);
+  return taken;
+}
+
+// ==================================================
+// EXECUTION
+// ==================================================
+// Queue every schedule that is due. Only the pump queues wait for a busy
+// pump, so a long dose on one pump never holds back another pump.
+void checkDosingSchedules(unsigned long currentTime) {
+  int index;
+  uint32_t due;
+  while ((index = takeDueDosingSchedule(currentTime, &due)) >= 0) {
+    const DosingSchedule &sched = dosingSchedules[index];
+    DoseRequest request;
+    request.pumpNumber = sched.pumpNumber;
+    request.amountML = sched.amountML;
+    request.source = DOSE_SOURCE_SCHEDULE;
+    request.scheduleIndex = (uint8_t)index;
+    request.dueUnix = due;
+    queueDose(request);
+  }
+}
+
+// esp_timer task: only the pump-off edge, loop() does the bookkeeping
+static void pumpStopCallback(void *arg) {
+  uint8_t i = (uint8_t)(uintptr_t)arg;
+  setPumpSpeed(i + 1, 0);
+  executors[i].stopMicros = esp_timer_get_time();
+  executors[i].stopped = true;
+}
+
+static void createStopTimer(uint8_t pump, PumpExecutor &ex) {
+  static const char *names[DOSING_PUMP_COUNT] = { "pump1_stop", "pump2_stop", "pump3_stop", "pump4_stop" };
+  esp_timer_create_args_t args = {};
+  args.callback = pumpStopCallback;
+  args.arg = (void*)(uintptr_t)(pump - 1);
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = names[pump - 1];
+  if (esp_timer_create(&args, &ex.stopTimer) != ESP_OK) {
+    ex.stopTimer = nullptr;
+    Serial.print("[DOSING] Failed to create stop timer for Pump ");
+    Serial.println(pump);
+  }
+}
+
+static void startDose(uint8_t pump, PumpExecutor &ex, const DoseRequest &dose, unsigned long currentTime) {
+  uint8_t duty;
+  float mlPerSecond;
+  if (!choosePumpDuty(pumpCalibrations[pump - 1], dose.amountML, duty, mlPerSecond)) {
+    Serial.print("[DOSING] Pump ");
+    Serial.print(pump);
+    Serial.println(" not calibrated, dose skipped");
+    displayNotify("Pump not calibrated", RED);
+    journalDose(DOSE_JOURNAL_SKIPPED, dose);
+    return;
+  }
+
+  // Calculate runtime based on calibration
+  float targetML = dose.amountML / 10.0; // Convert from tenths
+  int64_t runUs = (int64_t)((targetML / mlPerSecond) * 1000000.0f);
+  unsigned long runMs = (unsigned long)((runUs + 999) / 1000);
+
+  ex.state = PUMP_RUNNING;
+  ex.active = dose;
+  ex.startTime = currentTime;
+  ex.runDuration = runMs;
+  ex.plannedMicros = runUs;
+  ex.stopped = false;
+
+  if (!ex.stopTimer) createStopTimer(pump, ex);
+
+  journalDose(DOSE_JOURNAL_STARTED, dose);
+  setPumpSpeed(pump, duty);
+  ex.startMicros = esp_timer_get_time();
+  ex.timerArmed = ex.stopTimer && esp_timer_start_once(ex.stopTimer, (uint64_t)runUs) == ESP_OK;
+  if (!ex.timerArmed) {
+    Serial.print("[DOSING] Stop timer unavailable, Pump ");
+    Serial.print(pump);
+    Serial.println(" stopped from loop");
+  }
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+
+  char msg[DRAW_NOTIFY_TEXT_LEN + 1];
+  snprintf(msg, sizeof(msg), "Dosing P%d %.1fmL", pump, targetML);
+  displayNotify(msg, CYAN, (uint16_t)min<unsigned long>(runMs + 1000, 60000));
+
+  Serial.print("[DOSING] Starting Pump ");
+  Serial.print(pump);
+  Serial.print(" for ");
+  Serial.print(targetML, 1);
+  Serial.print(" mL at ");
+  Serial.print(duty);
+  Serial.print("% (");
+  Serial.print(runMs);
+  Serial.println(" ms)");
+}
+
+// Switch the pump off from loop() ahead of (or instead of) the stop timer
+static void stopPumpNow(uint8_t pump, PumpExecutor &ex) {
+  if (ex.timerArmed) esp_timer_stop(ex.stopTimer);
+  setPumpSpeed(pump, 0);
+  if (!ex.stopped) {
+    ex.stopMicros = esp_timer_get_time();
+    ex.stopped = true;
+  }
+}
+
+// Stop timer missing or late
+static void stopPumpFromLoop(uint8_t pump, PumpExecutor &ex) {
+  if (ex.timerArmed) {
+    Serial.print("[DOSING] Stop timer late on Pump ");
+    Serial.println(pump);
+  }
+  stopPumpNow(pump, ex);
+}
+
+static void finishDose(uint8_t pump, PumpExecutor &ex) {
+  journalDose(DOSE_JOURNAL_DONE, ex.active);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+
+  // Read by the web server task (lastDoseRunTime)
+  portENTER_CRITICAL(&doseMux);
+  ex.lastPlannedMicros = ex.plannedMicros;
+  ex.lastActualMicros = ex.stopMicros - ex.startMicros;
+  portEXIT_CRITICAL(&doseMux);
+  float plannedML = ex.active.amountML / 10.0;
+  float actualML = ex.plannedMicros > 0 ? plannedML * ex.lastActualMicros / ex.plannedMicros : plannedML;
+
+  Serial.print("[DOSING] Completed Pump ");
+  Serial.print(pump);
+  Serial.print(" - ");
+  Serial.print(actualML, 2);
+  Serial.print(" of ");
+  Serial.print(plannedML, 1);
+  Serial.print(" mL, ran ");
+  Serial.print(ex.lastActualMicros / 1000.0, 3);
+  Serial.print(" of ");
+  Serial.print(ex.plannedMicros / 1000.0, 3);
+  Serial.println(" ms");
+  telemetryRecordDose(pump, actualML);
+
+  ex.state = PUMP_IDLE;
+}
+
+uint8_t cancelDoses(uint8_t pumpNumber, DoseSource source) {
+  if (pumpNumber < 1 || pumpNumber > DOSING_PUMP_COUNT) return 0;
+  PumpExecutor &ex = executors[pumpNumber - 1];
+
+  // Compact the ring in place, keeping the other doses in order
+  DoseRequest dropped[DOSE_QUEUE_LENGTH];
+  uint8_t droppedCount = 0;
+  portENTER_CRITICAL(&doseMux);
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < ex.count; i++) {
+    const DoseRequest &dose = ex.pending[(ex.head + i) % DOSE_QUEUE_LENGTH];
+    if (dose.source == source) {
+      dropped[droppedCount++] = dose;
+    } else {
+      ex.pending[(ex.head + kept) % DOSE_QUEUE_LENGTH] = dose;
+      kept++;
+    }
+  }
+  ex.count = kept;
+  portEXIT_CRITICAL(&doseMux);
+
+  for (uint8_t i = 0; i < droppedCount; i++) journalDose(DOSE_JOURNAL_SKIPPED, dropped[i]);
+
+  uint8_t cancelled = droppedCount;
+  if (ex.state == PUMP_RUNNING && ex.active.source == source) {
+    stopPumpNow(pumpNumber, ex);
+    finishDose(pumpNumber, ex);
+    cancelled++;
+  }
+
+  if (cancelled > 0) {
+    Serial.print("[DOSING] Cancelled ");
+    Serial.print(cancelled);
+    Serial.print(" dose(s) on Pump ");
+    Serial.println(pumpNumber);
+    postDisplayEvent(DISPLAY_EVT_STATUS);
+  }
+  return cancelled;
+}
+
+void updateDosingExecution(unsigned long currentTime) {
+  for (uint8_t i = 0; i < DOSING_PUMP_COUNT; i++) {
+    PumpExecutor &ex = executors[i];
+    uint8_t pump = i + 1;
+
+    if (ex.state == PUMP_RUNNING) {
+      if (!ex.stopped) {
+        unsigned long limit = ex.runDuration + (ex.timerArmed ? PUMP_STOP_GRACE_MS : 0);
+        if ((unsigned long)(currentTime - ex.startTime) < limit) continue;
+        stopPumpFromLoop(pump, ex);
+      }
+      finishDose(pump, ex);
+    }
+
+    // The calibration wizard owns the pump; doses wait in its queue
+    if (isPumpCalibrating(pump)) continue;
+
+    DoseRequest next;
+    if (takePendingDose(ex, next)) startDose(pump, ex, next, currentTime);
+  }
+}
+
+// ==================================================
+// STATUS
+// ==================================================
+bool isPumpDosing(uint8_t pumpNumber) {
+  if (pumpNumber < 1 || pumpNumber > DOSING_PUMP_COUNT) return false;
+  return executors[pumpNumber - 1].state == PUMP_RUNNING;
+}
+
+bool isAnyPumpDosing() {
+  for (uint8_t i = 0; i < DOSING_PUMP_COUNT; i++) {
+    if (executors[i].state == PUMP_RUNNING) return true;
+  }
+  return false;
+}
+
+uint8_t pendingDoseCount(uint8_t pumpNumber) {
+  if (pumpNumber < 1 || pumpNumber > DOSING_PUMP_COUNT) return 0;
+  return executors[pumpNumber - 1].count;
+}
+
+bool lastDoseRunTime(uint8_t pumpNumber, int64_t &plannedUs, int64_t &actualUs) {
+  if (pumpNumber < 1 || pumpNumber > DOSING_PUMP_COUNT) return false;
+  const PumpExecutor &ex = executors[pumpNumber - 1];
+  portENTER_CRITICAL(&doseMux);
+  plannedUs = ex.lastPlannedMicros;
+  actualUs = ex.lastActualMicros;
+  portEXIT_CRITICAL(&doseMux);
+  return plannedUs != 0;
+}
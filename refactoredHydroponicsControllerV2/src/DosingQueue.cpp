@@ -0,0 +1,171 @@
+/*
+ * DosingQueue.cpp
+ * 
+ * Min-heap of dosing schedule fire times, clocked by millis() between RTC
+ * resyncs.
+ */
+
+#include "DosingQueue.h"
+#include "TimeService.h"
+#include <algorithm>
+
+#define DOSING_RESYNC_INTERVAL 60000   // Re-read the RTC this often to catch drift and jumps
+#define DOSING_CLOCK_JUMP_S 5          // Rebuild when the RTC moved further than this
+#define DOSING_LATE_LIMIT_S 600        // Fire times found this late (RTC was missing, loop stalled) are skipped
+
+struct DosingQueueEntry {
+  uint32_t due;      // Local unix time
+  uint8_t index;     // dosingSchedules[] slot
+};
+
+// std::*_heap build a max-heap; invert to keep the earliest fire on top
+static bool laterThan(const DosingQueueEntry &a, const DosingQueueEntry &b) {
+  return a.due > b.due;
+}
+
+static DosingQueueEntry heap[MAX_DOSING_SCHEDULES];
+static int heapSize = 0;
+static volatile bool queueDirty = true;
+
+// Unix time <-> millis() anchor, refreshed on every RTC read
+static uint32_t anchorUnix = 0;
+static unsigned long anchorMillis = 0;
+static unsigned long lastResync = 0;
+
+// Latest fire time handed out and the pumps dosed at it. A rebuild skips
+// those fires, so editing schedules in the same minute cannot dose twice.
+// Pumps rather than slots: deleting a schedule shifts the slots.
+static uint32_t lastFiredAt = 0;
+static uint8_t lastFiredPumps = 0;
+
+// ==================================================
+// FIRE TIMES
+// ==================================================
+uint32_t dosingScheduleNextFire(const DosingSchedule &sched, uint32_t afterUnix) {
+  if (!sched.enabled || sched.daysOfWeek == 0) return 0;
+  if (sched.isInterval && sched.intervalMinutes == 0) return 0;
+
+  DateTime after(afterUnix);
+  uint32_t midnight = DateTime(after.year(), after.month(), after.day()).unixtime();
+  uint8_t dayOfWeek = after.dayOfTheWeek();
+
+  // Today plus a full week covers every enabled day
+  for (uint8_t d = 0; d <= 7; d++) {
+    uint32_t dayStart = midnight + (uint32_t)d * 86400UL;
+    if (!isDayEnabled(sched.daysOfWeek, (dayOfWeek + d) % 7)) continue;
+
+    uint32_t anchor = dayStart + (uint32_t)sched.hour * 3600 + (uint32_t)sched.minute * 60;
+    if (sched.isInterval) {
+      // Fires are counted from the day's anchor, never from the last fire,
+      // so a late or missed dose does not shift the ones after it
+      uint32_t period = (uint32_t)sched.intervalMinutes * 60;
+      uint32_t k = afterUnix < anchor ? 0 : (afterUnix - anchor) / period + 1;
+      uint32_t t = anchor + k * period;
+      if (t < dayStart + 86400UL) return t;
+    } else if (anchor > afterUnix) {
+      return anchor;
+    }
+  }
+  return 0;
+}
+
+// ==================================================
+// QUEUE
+// ==================================================
+static void pushEntry(uint32_t due, uint8_t index) {
+  if (due == 0 || heapSize >= MAX_DOSING_SCHEDULES) return;
+  heap[heapSize].due = due;
+  heap[heapSize].index = index;
+  heapSize++;
+  std::push_heap(heap, heap + heapSize, laterThan);
+}
+
+static void popEntry() {
+  std::pop_heap(heap, heap + heapSize, laterThan);
+  heapSize--;
+}
+
+static uint8_t pumpBit(uint8_t pumpNumber) {
+  return (pumpNumber >= 1 && pumpNumber <= 8) ? (1 << (pumpNumber - 1)) : 0;
+}
+
+static void resync(unsigned long currentTime) {
+  DateTime now = timeNow();
+  lastResync = currentTime;
+  if (!now.isValid()) return;
+
+  uint32_t unixNow = now.unixtime();
+  if (anchorUnix != 0) {
+    long expected = (long)anchorUnix + (long)((currentTime - anchorMillis) / 1000);
+    if (labs((long)unixNow - expected) > DOSING_CLOCK_JUMP_S) queueDirty = true;
+  }
+  anchorUnix = unixNow;
+  anchorMillis = currentTime;
+}
+
+static void rebuild(unsigned long currentTime) {
+  queueDirty = false;
+  resync(currentTime);
+  heapSize = 0;
+  if (anchorUnix == 0) return;   // No valid RTC time yet
+
+  // Include the current minute so a boot or edit at hh:mm:20 still runs
+  // an hh:mm schedule
+  uint32_t after = anchorUnix - (anchorUnix % 60) - 1;
+
+  for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
+    const DosingSchedule &sched = dosingSchedules[i];
+    uint32_t due = dosingScheduleNextFire(sched, after);
+    bool fired = due != 0 && (due < lastFiredAt ||
+                              (due == lastFiredAt && (lastFiredPumps & pumpBit(sched.pumpNumber))));
+    if (fired) due = dosingScheduleNextFire(sched, lastFiredAt);
+    pushEntry(due, i);
+  }
+}
+
+// Unix time as seen through millis() since the last RTC read
+static uint32_t estimatedUnix(unsigned long currentTime) {
+  return anchorUnix + (uint32_t)((currentTime - anchorMillis) / 1000);
+}
+
+void invalidateDosingQueue() {
+  queueDirty = true;
+}
+
+void seedDosingQueueHistory(uint32_t firedAt, uint8_t pumps) {
+  lastFiredAt = firedAt;
+  lastFiredPumps = pumps;
+  queueDirty = true;
+}
+
+int takeDueDosingSchedule(unsigned long currentTime, uint32_t *dueUnix) {
+  if ((unsigned long)(currentTime - lastResync) >= DOSING_RESYNC_INTERVAL) resync(currentTime);
+  if (queueDirty) rebuild(currentTime);
+  if (heapSize == 0 || estimatedUnix(currentTime) < heap[0].due) return -1;
+
+  // Head looks due: confirm against the RTC before dosing
+  resync(currentTime);
+  if (queueDirty) {
+    rebuild(currentTime);
+    if (heapSize == 0) return -1;
+  }
+  if (anchorUnix < heap[0].due) return -1;
+
+  while (heapSize > 0 && heap[0].due <= anchorUnix) {
+    DosingQueueEntry entry = heap[0];
+    popEntry();
+    pushEntry(dosingScheduleNextFire(dosingSchedules[entry.index], entry.due), entry.index);
+
+    if (anchorUnix - entry.due > DOSING_LATE_LIMIT_S) {
+      Serial.print("[DOSING] Skipped late schedule ");
+      Serial.println(entry.index + 1);
+      continue;
+    }
+    if (entry.due != lastFiredAt) lastFiredPumps = 0;
+    lastFiredAt = entry.due;
+    lastFiredPumps |= pumpBit(dosingSchedules[entry.index].pumpNumber);
+    if (dueUnix) *dueUnix = entry.due;
+    return entry.index;
+  }
+  return -1;
+}
@@ -0,0 +1,302 @@
+/*
+ * FrameCanvas.cpp
+ *
+ * Implementation of the off-screen TFT canvas and tile-hash flush.
+ */
+
+#include "FrameCanvas.h"
+#include <esp_heap_caps.h>
+
+FrameCanvas canvas;
+
+#define TILE_BIT(tx, ty) (1ULL << ((ty) * CANVAS_TILES_X + (tx)))
+
+static inline uint16_t toPanelOrder(uint16_t color) {
+  return (color >> 8) | (color << 8);
+}
+
+FrameCanvas::FrameCanvas()
+  : Adafruit_GFX(CANVAS_WIDTH, CANVAS_HEIGHT),
+    buffer(nullptr),
+    stagingNext(0),
+    panel(nullptr),
+    owner(NULL),
+    touchedTiles(0),
+    validTiles(0),
+    flushPending(false) {
+  staging[0] = staging[1] = nullptr;
+  memset(tileHash, 0, sizeof(tileHash));
+  memset(&renderStats, 0, sizeof(renderStats));
+}
+
+bool FrameCanvas::begin(TFT_ILI9163C* tftPanel) {
+  panel = tftPanel;
+  if (buffer) return true;
+
+  const size_t bytes = CANVAS_WIDTH * CANVAS_HEIGHT * sizeof(uint16_t);
+  buffer = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!buffer) {
+    // No PSRAM: 32 KB of internal RAM still beats drawing unbuffered
+    buffer = (uint16_t*)heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+  }
+  if (!buffer) {
+    Serial.println("Canvas: no memory, drawing direct to TFT");
+    return false;
+  }
+
+  // Partial tile rows need a contiguous copy for DMA; without it flush()
+  // widens every run to the full row
+  const size_t stagingBytes = CANVAS_WIDTH * CANVAS_TILE * sizeof(uint16_t);
+  for (uint8_t i = 0; i < 2; i++) {
+    staging[i] = (uint16_t*)heap_caps_malloc(stagingBytes, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+  }
+  if (!staging[0] || !staging[1]) {
+    free(staging[0]);
+    free(staging[1]);
+    staging[0] = staging[1] = nullptr;
+  }
+
+  memset(buffer, 0, bytes);
+  invalidate();
+  return true;
+}
+
+// ==================================================
+// TILE TRACKING
+// ==================================================
+void FrameCanvas::markTouched(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+  for (int16_t ty = y0 / CANVAS_TILE; ty <= y1 / CANVAS_TILE; ty++) {
+    for (int16_t tx = x0 / CANVAS_TILE; tx <= x1 / CANVAS_TILE; tx++) {
+      touchedTiles |= TILE_BIT(tx, ty);
+    }
+  }
+}
+
+void FrameCanvas::invalidate() {
+  validTiles = 0;
+  touchedTiles = ~0ULL;
+}
+
+void FrameCanvas::resetStats() {
+  memset(&renderStats, 0, sizeof(renderStats));
+}
+
+// FNV-1a over the tile, two pixels per step
+uint32_t FrameCanvas::hashTile(uint8_t tx, uint8_t ty) const {
+  uint32_t h = 2166136261UL;
+  const uint16_t* row = &buffer[(ty * CANVAS_TILE) * CANVAS_WIDTH + tx * CANVAS_TILE];
+  for (uint8_t y = 0; y < CANVAS_TILE; y++) {
+    const uint32_t* p = (const uint32_t*)row;
+    for (uint8_t i = 0; i < CANVAS_TILE / 2; i++) {
+      h = (h ^ p[i]) * 16777619UL;
+    }
+    row += CANVAS_WIDTH;
+  }
+  return h;
+}
+
+// The buffer may still be on the wire from the previous flush
+void FrameCanvas::waitForPanel() {
+  if (flushPending) {
+    panel->waitAsync();
+    flushPending = false;
+  }
+}
+
+// ==================================================
+// DRAWING PRIMITIVES
+// ==================================================
+void FrameCanvas::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  if (!buffer) { if (panel) panel->drawPixel(x, y, color); return; }
+  if (x < 0 || y < 0 || x >= CANVAS_WIDTH || y >= CANVAS_HEIGHT) return;
+
+  waitForPanel();
+  buffer[y * CANVAS_WIDTH + x] = toPanelOrder(color);
+  touchedTiles |= TILE_BIT(x / CANVAS_TILE, y / CANVAS_TILE);
+}
+
+void FrameCanvas::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+void FrameCanvas::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void FrameCanvas::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+  if (!buffer) { if (panel) panel->fillRect(x, y, w, h, color); return; }
+
+  // Clip to the canvas
+  if (x < 0) { w += x; x = 0; }
+  if (y < 0) { h += y; y = 0; }
+  if (x + w > CANVAS_WIDTH) w = CANVAS_WIDTH - x;
+  if (y + h > CANVAS_HEIGHT) h = CANVAS_HEIGHT - y;
+  if (w <= 0 || h <= 0) return;
+
+  waitForPanel();
+  uint16_t c = toPanelOrder(color);
+  for (int16_t row = y; row < y + h; row++) {
+    uint16_t* p = &buffer[row * CANVAS_WIDTH + x];
+    for (int16_t i = 0; i < w; i++) p[i] = c;
+  }
+  markTouched(x, y, x + w - 1, y + h - 1);
+}
+
+void FrameCanvas::fillScreen(uint16_t color) {
+  fillRect(0, 0, CANVAS_WIDTH, CANVAS_HEIGHT, color);
+}
+
+// ==================================================
+// TEXT BLITTER
+// ==================================================
+// One scaled pixel row of a string. Each glyph row is a 6 bit mask (5 inked
+// columns + spacing); runs of equal bits are filled in one go. skip/width
+// clip the row to the visible part of the string box.
+void FrameCanvas::textRow(const char* text, uint8_t len, uint8_t row, uint8_t size,
+                          uint16_t fg, uint16_t bg, uint16_t* out, int16_t skip, int16_t width) {
+  int16_t px = -skip;  // Position of the current run relative to out[0]
+
+  for (uint8_t i = 0; i < len && px < width; i++) {
+    uint8_t bits = glyphRow(text[i], row) << 1;  // Bit 0 becomes the spacing column
+    uint8_t col = 0;
+    while (col < GLYPH_ADVANCE) {
+      bool on = bits & (0x20 >> col);
+      uint8_t run = 1;
+      while (col + run < GLYPH_ADVANCE && (bool)(bits & (0x20 >> (col + run))) == on) run++;
+
+      int16_t start = px;
+      int16_t end = px + run * size;
+      if (start < 0) start = 0;
+      if (end > width) end = width;
+      uint16_t c = on ? fg : bg;
+      for (int16_t p = start; p < end; p++) out[p] = c;
+
+      px += run * size;
+      col += run;
+    }
+  }
+}
+
+int16_t FrameCanvas::drawText(int16_t x, int16_t y, const char* text,
+                              uint16_t fg, uint16_t bg, uint8_t size) {
+  if (!text || size == 0) return 0;
+  uint8_t len = strlen(text);
+  int16_t w = len * GLYPH_ADVANCE * size;
+  int16_t h = GLYPH_HEIGHT * size;
+
+  // Clip the string box to the screen
+  int16_t skip = (x < 0) ? -x : 0;
+  int16_t x0 = x + skip;
+  int16_t visible = min<int16_t>(w - skip, CANVAS_WIDTH - x0);
+  if (len == 0 || visible <= 0 || y >= CANVAS_HEIGHT || y + h <= 0) return w;
+
+  if (!buffer) {
+    // Unbuffered: build each row and stream the box in one address window
+    if (!panel) return w;
+    int16_t y0 = max<int16_t>(y, 0);
+    int16_t y1 = min<int16_t>(y + h, CANVAS_HEIGHT) - 1;
+    uint16_t line[CANVAS_WIDTH];
+    panel->startPushData(x0, y0, x0 + visible - 1, y1);
+    for (int16_t py = y0; py <= y1; py++) {
+      textRow(text, len, (py - y) / size, size, fg, bg, line, skip, visible);
+      panel->pushColors(line, visible);
+    }
+    panel->endPushData();
+    return w;
+  }
+
+  waitForPanel();
+  uint16_t fgPanel = toPanelOrder(fg);
+  uint16_t bgPanel = toPanelOrder(bg);
+  int16_t y0 = max<int16_t>(y, 0);
+  int16_t y1 = min<int16_t>(y + h, CANVAS_HEIGHT) - 1;
+  for (int16_t py = y0; py <= y1; py++) {
+    textRow(text, len, (py - y) / size, size, fgPanel, bgPanel,
+            &buffer[py * CANVAS_WIDTH + x0], skip, visible);
+  }
+  markTouched(x0, y0, x0 + visible - 1, y1);
+  return w;
+}
+
+// ==================================================
+// FLUSH
+// ==================================================
+// Queue one run of changed tiles. pushRectAsync() waits for the previous
+// block before queuing, so the staging buffer being filled here is never
+// the one on the wire.
+bool FrameCanvas::sendRun(uint8_t ty, uint8_t tx0, uint8_t tiles) {
+  int16_t x = tx0 * CANVAS_TILE;
+  int16_t y = ty * CANVAS_TILE;
+  int16_t w = tiles * CANVAS_TILE;
+  const uint16_t* src = &buffer[y * CANVAS_WIDTH];
+
+  if (w < CANVAS_WIDTH) {
+    uint16_t* dst = staging[stagingNext];
+    stagingNext ^= 1;
+    for (uint8_t row = 0; row < CANVAS_TILE; row++) {
+      memcpy(&dst[row * w], &src[row * CANVAS_WIDTH + x], w * sizeof(uint16_t));
+    }
+    src = dst;
+  }
+
+  if (!panel->pushRectAsync(x, y, w, CANVAS_TILE, src)) return false;
+  flushPending = true;
+  renderStats.tilesSent += tiles;
+  renderStats.bytesSent += (uint32_t)w * CANVAS_TILE * sizeof(uint16_t);
+  return true;
+}
+
+void FrameCanvas::flush() {
+  if (!buffer || !panel) return;
+  if (owner && xTaskGetCurrentTaskHandle() != owner) {
+    Serial.println("[CANVAS] flush from non-owner task ignored");
+    return;
+  }
+
+  uint32_t startMicros = micros();
+  renderStats.tilesChecked = 0;
+  renderStats.tilesSent = 0;
+  renderStats.bytesSent = 0;
+
+  uint64_t unsent = 0;  // Tiles of runs the panel refused, retried next flush
+
+  for (uint8_t ty = 0; ty < CANVAS_TILES_Y; ty++) {
+    uint8_t changed = 0;  // Bit per tile column in this row
+
+    for (uint8_t tx = 0; tx < CANVAS_TILES_X; tx++) {
+      uint64_t bit = TILE_BIT(tx, ty);
+      if (!(touchedTiles & bit)) continue;
+
+      uint32_t h = hashTile(tx, ty);
+      renderStats.tilesChecked++;
+      if ((validTiles & bit) && tileHash[ty * CANVAS_TILES_X + tx] == h) continue;
+
+      tileHash[ty * CANVAS_TILES_X + tx] = h;
+      validTiles |= bit;
+      changed |= (1 << tx);
+    }
+
+    if (!changed) continue;
+    if (!staging[0]) changed = 0xFF;  // No staging RAM, send the whole row
+
+    uint8_t tx = 0;
+    while (tx < CANVAS_TILES_X) {
+      if (!(changed & (1 << tx))) { tx++; continue; }
+      uint8_t start = tx;
+      while (tx < CANVAS_TILES_X && (changed & (1 << tx))) tx++;
+      if (sendRun(ty, start, tx - start)) continue;
+
+      // The panel still shows the old content of these tiles
+      for (uint8_t t = start; t < tx; t++) unsent |= TILE_BIT(t, ty);
+    }
+  }
+
+  validTiles &= ~unsent;
+  touchedTiles = unsent;
+  renderStats.flushMicros = micros() - startMicros;
+  if (renderStats.tilesSent > 0) {
+    renderStats.frames++;
+    renderStats.totalTilesSent += renderStats.tilesSent;
+    renderStats.totalBytesSent += renderStats.bytesSent;
+  }
+}
@@ -27,169 +27,55 @@ const char* dayNamesShort[] = {
 // PROGMEM MENU STRINGS
 // ==================================================
 
+// Item strings and navigation targets are generated from the *_ITEMS
+// lists in MenuTable.h; counts are constexpr in Globals.h.
+
 // Main menu
-const char mainMenuItems_0[] PROGMEM = "Scheduling";
-const char mainMenuItems_1[] PROGMEM = "Manual Dosing";
-const char mainMenuItems_2[] PROGMEM = "Pump Calibration";
-const char mainMenuItems_3[] PROGMEM = "Top-up Solution";
-const char mainMenuItems_4[] PROGMEM = "Replace Solution";
-const char mainMenuItems_5[] PROGMEM = "Reset WiFi";
-const char mainMenuItems_6[] PROGMEM = "Factory Reset";
-const char* const mainMenuItems[] PROGMEM = {
-  mainMenuItems_0, mainMenuItems_1, mainMenuItems_2, mainMenuItems_3,
-  mainMenuItems_4, mainMenuItems_5, mainMenuItems_6
-};
-const int mainMenuCount = 7;
+const char* const mainMenuItems[] PROGMEM = { MAIN_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState mainMenuTargets[] = { MAIN_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Scheduling submenu
-const char schedulingMenu_0[] PROGMEM = "Dosing Schedule";
-const char schedulingMenu_1[] PROGMEM = "Outlet Schedule";
-const char schedulingMenu_2[] PROGMEM = "Back";
-const char* const schedulingMenuItems[] PROGMEM = {
-  schedulingMenu_0, schedulingMenu_1, schedulingMenu_2
-};
-const int schedulingMenuCount = 3;
+const char* const schedulingMenuItems[] PROGMEM = { SCHEDULING_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState schedulingMenuTargets[] = { SCHEDULING_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Dosing schedule submenu
-const char dosingScheduleMenu_0[] PROGMEM = "View Schedules";
-const char dosingScheduleMenu_1[] PROGMEM = "Add Schedule";
-const char dosingScheduleMenu_2[] PROGMEM = "Delete Schedule";
-const char dosingScheduleMenu_3[] PROGMEM = "Delete All";
-const char dosingScheduleMenu_4[] PROGMEM = "Back";
-const char* const dosingScheduleMenu[] PROGMEM = {
-  dosingScheduleMenu_0, dosingScheduleMenu_1, dosingScheduleMenu_2,
-  dosingScheduleMenu_3, dosingScheduleMenu_4
-};
-const int dosingScheduleMenuCount = 5;
+const char* const dosingScheduleMenu[] PROGMEM = { DOSING_SCHEDULE_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState dosingScheduleMenuTargets[] = { DOSING_SCHEDULE_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Dosing confirm menu
-const char dosingConfirmMenu_0[] PROGMEM = "Save to EEPROM";
-const char dosingConfirmMenu_1[] PROGMEM = "Cancel";
-const char* const dosingConfirmMenu[] PROGMEM = {
-  dosingConfirmMenu_0, dosingConfirmMenu_1
-};
-const int dosingConfirmMenuCount = 2;
+const char* const dosingConfirmMenu[] PROGMEM = { DOSING_CONFIRM_MENU_ITEMS(MENU_ITEM_LABEL) };
 
 // Yes/No confirm menu
-const char confirmYesNoMenu_0[] PROGMEM = "Yes";
-const char confirmYesNoMenu_1[] PROGMEM = "No";
-const char* const confirmYesNoMenu[] PROGMEM = {
-  confirmYesNoMenu_0, confirmYesNoMenu_1
-};
-const int confirmYesNoMenuCount = 2;
-
-// // Dosing add error: no days selected
-// const char dosingErrorNoDaysMenu_0[] PROGMEM = "OK";
-// const char* const dosingErrorNoDaysMenu[] PROGMEM = {
-//   dosingErrorNoDaysMenu_0
-// };
-// const int dosingErrorNoDaysMenuCount = 1;
-
-// // Dosing "no days selected" error menu
-// const char dosingErrorNoDays_0[] PROGMEM = "ERROR: SELECT DAYS";
-// const char dosingErrorNoDays_1[] PROGMEM = "Press to return";
-
-// const char* const dosingErrorNoDaysMenu[] PROGMEM = {
-//   dosingErrorNoDays_0,
-//   dosingErrorNoDays_1
-// };
-
-// const int dosingErrorNoDaysMenuCount = 2;
+const char* const confirmYesNoMenu[] PROGMEM = { CONFIRM_YES_NO_MENU_ITEMS(MENU_ITEM_LABEL) };
 
 // Manual dosing menu
-const char manualDosingMenu_0[] PROGMEM = "Select Pump";
-const char manualDosingMenu_1[] PROGMEM = "Set Amount (mL)";
-const char manualDosingMenu_2[] PROGMEM = "Start Dosing";
-const char manualDosingMenu_3[] PROGMEM = "Cancel";
-const char* const manualDosingMenu[] PROGMEM = {
-  manualDosingMenu_0, manualDosingMenu_1, manualDosingMenu_2, manualDosingMenu_3
-};
-const int manualDosingMenuCount = 4;
+const char* const manualDosingMenu[] PROGMEM = { MANUAL_DOSING_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState manualDosingMenuTargets[] = { MANUAL_DOSING_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Outlet Schedule Menu
-const char outletScheduleItem0[] PROGMEM = "View Schedules";
-const char outletScheduleItem1[] PROGMEM = "Add Schedule";
-const char outletScheduleItem2[] PROGMEM = "Delete Schedule";
-const char outletScheduleItem3[] PROGMEM = "Delete All";
-const char outletScheduleItem4[] PROGMEM = "Back";
-
-const char* const outletScheduleMenu[] PROGMEM = {
-  outletScheduleItem0,
-  outletScheduleItem1,
-  outletScheduleItem2,
-  outletScheduleItem3,
-  outletScheduleItem4
-};
-
-const int outletScheduleMenuCount = 5;
-
+const char* const outletScheduleMenu[] PROGMEM = { OUTLET_SCHEDULE_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState outletScheduleMenuTargets[] = { OUTLET_SCHEDULE_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Pump calibration submenu
-const char pumpCalibrationMenu_0[] PROGMEM = "Calibrate Pump 1";
-const char pumpCalibrationMenu_1[] PROGMEM = "Calibrate Pump 2";
-const char pumpCalibrationMenu_2[] PROGMEM = "Calibrate Pump 3";
-const char pumpCalibrationMenu_3[] PROGMEM = "Calibrate Pump 4";
-const char pumpCalibrationMenu_4[] PROGMEM = "Back";
-const char* const pumpCalibrationMenu[] PROGMEM = {
-  pumpCalibrationMenu_0, pumpCalibrationMenu_1, pumpCalibrationMenu_2,
-  pumpCalibrationMenu_3, pumpCalibrationMenu_4
-};
-const int pumpCalibrationMenuCount = 5;
+const char* const pumpCalibrationMenu[] PROGMEM = { PUMP_CALIBRATION_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState pumpCalibrationMenuTargets[] = { PUMP_CALIBRATION_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Calibration confirm menu
-const char calibrateConfirmMenu_0[] PROGMEM = "Start Calibration";
-const char calibrateConfirmMenu_1[] PROGMEM = "Cancel";
-const char* const calibrateConfirmMenu[] PROGMEM = {
-  calibrateConfirmMenu_0, calibrateConfirmMenu_1
-};
-const int calibrateConfirmMenuCount = 2;
+const char* const calibrateConfirmMenu[] PROGMEM = { CALIBRATE_CONFIRM_MENU_ITEMS(MENU_ITEM_LABEL) };
 
 // Calibration save menu
-const char calibrateSaveMenu_0[] PROGMEM = "Save to EEPROM";
-const char calibrateSaveMenu_1[] PROGMEM = "Cancel";
-const char* const calibrateSaveMenu[] PROGMEM = {
-  calibrateSaveMenu_0, calibrateSaveMenu_1
-};
-const int calibrateSaveMenuCount = 2;
+const char* const calibrateSaveMenu[] PROGMEM = { CALIBRATE_SAVE_MENU_ITEMS(MENU_ITEM_LABEL) };
 
 // Top-up menu
-const char topupMenu_0[] PROGMEM = "Set Pump Amounts";
-const char topupMenu_1[] PROGMEM = "Set Fill Relay";
-const char topupMenu_2[] PROGMEM = "Back";
-const char* const topupMenu[] PROGMEM = {
-  topupMenu_0, topupMenu_1, topupMenu_2
-};
-const int topupMenuCount = 3;
+const char* const topupMenu[] PROGMEM = { TOPUP_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState topupMenuTargets[] = { TOPUP_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Replace solution menu
-const char replaceMenu_0[] PROGMEM = "Set Pump Amounts";
-const char replaceMenu_1[] PROGMEM = "Set Drain Relay";
-const char replaceMenu_2[] PROGMEM = "Set Fill Relay";
-const char replaceMenu_3[] PROGMEM = "Set Schedule";
-const char replaceMenu_4[] PROGMEM = "Back";
-const char* const replaceMenu[] PROGMEM = {
-  replaceMenu_0, replaceMenu_1, replaceMenu_2, replaceMenu_3, replaceMenu_4
-};
-const int replaceMenuCount = 5;
+const char* const replaceMenu[] PROGMEM = { REPLACE_MENU_ITEMS(MENU_ITEM_LABEL) };
+const MenuState replaceMenuTargets[] = { REPLACE_MENU_ITEMS(MENU_ITEM_TARGET) };
 
 // Day selection menu
-const char daySelectMenu_0[] PROGMEM = "Sunday";
-const char daySelectMenu_1[] PROGMEM = "Monday";
-const char daySelectMenu_2[] PROGMEM = "Tuesday";
-const char daySelectMenu_3[] PROGMEM = "Wednesday";
-const char daySelectMenu_4[] PROGMEM = "Thursday";
-const char daySelectMenu_5[] PROGMEM = "Friday";
-const char daySelectMenu_6[] PROGMEM = "Saturday";
-const char daySelectMenu_7[] PROGMEM = "All Days";
-const char daySelectMenu_8[] PROGMEM = "Weekdays";
-const char daySelectMenu_9[] PROGMEM = "Weekends";
-const char daySelectMenu_10[] PROGMEM = "Done";
-const char* const daySelectMenuItems[] PROGMEM = {
-  daySelectMenu_0, daySelectMenu_1, daySelectMenu_2, daySelectMenu_3,
-  daySelectMenu_4, daySelectMenu_5, daySelectMenu_6, daySelectMenu_7,
-  daySelectMenu_8, daySelectMenu_9, daySelectMenu_10
-};
-const int daySelectMenuCount = 11;
+const char* const daySelectMenuItems[] PROGMEM = { DAY_SELECT_MENU_ITEMS(MENU_ITEM_LABEL) };
 
 // ==================================================
 // HARDWARE OBJECTS
@@ -211,6 +97,8 @@ Preferences preferences;
 TaskHandle_t DisplayTaskHandle = NULL;
 TaskHandle_t SensorTaskHandle = NULL;
 TaskHandle_t MQTTTaskHandle = NULL;
+TaskHandle_t TopUpTaskHandle = NULL;
+TaskHandle_t PersistTaskHandle = NULL;
 
 // ==================================================
 // STATE VARIABLES
@@ -276,7 +164,6 @@ unsigned long lastMqttPublish = 0;
 unsigned long lastDisplayUpdate = 0;
 unsigned long lastDailySyncCheck = 0;
 unsigned long lastNTPSync = 0;
-unsigned long lastLogWrite = 0;
 unsigned long lastWebUpdate = 0;
 unsigned long lastWifiReconnect = 0;
 unsigned long lastStatusBarUpdate = 0;
@@ -5,6 +5,8 @@
  */
 
 #include "Hardware.h"
+#include "Tasks.h"
+#include "TopUp.h"
 #include <ArduinoJson.h>
 
 // ==================================================
@@ -89,6 +91,7 @@ void updateEncoder() {
       hardware.encoderButton = true;
       encoderButtonPressed = true;
       lastButtonTime = currentTime;
+      postDisplayEvent(DISPLAY_EVT_BUTTON);
     }
   }
   // Detect long press
@@ -112,6 +115,7 @@ void updateEncoder() {
 // ==================================================
 // FLOAT SWITCHES UPDATE
 // ==================================================
+// Debounced LOW and FULL edges wake TopUpTask
 void updateFloatSwitches(unsigned long currentTime) {
   if ((unsigned long)(currentTime - lastFloatCheck) < FLOAT_CHECK_INTERVAL) return;
   lastFloatCheck = currentTime;
@@ -130,6 +134,7 @@ void updateFloatSwitches(unsigned long currentTime) {
       bool newFull = (fullReading == HIGH);
       if (newFull != hardware.floatFull) {
         hardware.floatFull = newFull;
+        postTopUpEvent(TOPUP_EVT_FLOAT);
       }
     }
   }
@@ -145,6 +150,7 @@ void updateFloatSwitches(unsigned long currentTime) {
       bool newLow = (lowReading == HIGH);
       if (newLow != hardware.floatLow) {
         hardware.floatLow = newLow;
+        postTopUpEvent(TOPUP_EVT_FLOAT);
       }
     }
   }
@@ -298,6 +304,7 @@ String getHardwareJSON() {
   doc["floatFull"] = hardware.floatFull;
   doc["floatLow"] = hardware.floatLow;
   doc["floatEmpty"] = hardware.floatEmpty;
+  doc["topUp"] = topUpStateName(getTopUpStatus().state);
 
   doc["relay1"] = hardware.relay1;
   doc["relay2"] = hardware.relay2;
@@ -0,0 +1,312 @@
+/*
+ * LogQuery.cpp
+ *
+ * Streaming range queries over the telemetry rings.
+ */
+
+#include "LogQuery.h"
+#include "Crc.h"
+
+enum LogQueryStage : uint8_t {
+  QUERY_HEADER,
+  QUERY_RECORDS,
+  QUERY_FOOTER,
+  QUERY_DONE
+};
+
+// ==================================================
+// PARAMETERS
+// ==================================================
+bool logQueryFormatFromName(const char *name, LogQueryFormat &format) {
+  if (strcmp(name, "csv") == 0)  { format = LOG_FORMAT_CSV;  return true; }
+  if (strcmp(name, "json") == 0) { format = LOG_FORMAT_JSON; return true; }
+  if (strcmp(name, "bin") == 0)  { format = LOG_FORMAT_BIN;  return true; }
+  return false;
+}
+
+const char* logQueryContentType(LogQueryFormat format) {
+  switch (format) {
+    case LOG_FORMAT_JSON: return "application/json";
+    case LOG_FORMAT_BIN:  return "application/octet-stream";
+    default:              return "text/csv";
+  }
+}
+
+bool logQueryParseNumber(const char *text, uint32_t &value) {
+  if (*text == '\0') return false;
+
+  uint32_t number = 0;
+  for (const char *p = text; *p; p++) {
+    if (*p < '0' || *p > '9') return false;
+    uint32_t digit = *p - '0';
+    if (number > (0xFFFFFFFFUL - digit) / 10) return false;
+    number = number * 10 + digit;
+  }
+  value = number;
+  return true;
+}
+
+bool logQueryParseTime(const char *text, uint32_t &unixTime) {
+  if (logQueryParseNumber(text, unixTime)) return true;
+
+  int y, mo, d, h = 0, mi = 0, s = 0;
+  int len = 0;
+  if (sscanf(text, "%d-%d-%d%n", &y, &mo, &d, &len) != 3) return false;
+  const char *rest = text + len;
+  if (*rest != '\0') {
+    if (*rest != ' ' && *rest != 'T') return false;
+    rest++;
+    if (sscanf(rest, "%d:%d:%d%n", &h, &mi, &s, &len) != 3 || rest[len] != '\0') return false;
+  }
+  DateTime at(y, mo, d, h, mi, s);
+  if (!at.isValid()) return false;
+  unixTime = at.unixtime();
+  return true;
+}
+
+// Coarsest rollup series whose bucket fits in step; raw below a minute
+static SensorLogSeries seriesForStep(uint32_t step) {
+  for (uint8_t s = SENSOR_SERIES_DAY; s >= SENSOR_SERIES_MINUTE; s--) {
+    if (step >= sensorLogBucketSeconds((SensorLogSeries)s)) return (SensorLogSeries)s;
+  }
+  return SENSOR_SERIES_RAW;
+}
+
+// ==================================================
+// STREAM
+// ==================================================
+LogQueryStream::LogQueryStream(const LogQuery &q)
+  : query(q), source(seriesForStep(q.step)), windowSeconds(0),
+    reader(sensorLogRing(source)), nextSeq(0), lastSeq(0),
+    stage(QUERY_HEADER), wroteRecord(false), outLen(0), outPos(0),
+    windows(), windowStart(0), flushChannel(SENSOR_CH_COUNT), pending(),
+    hasPending(false), windowOpen(false), ended(false) {
+  uint32_t bucket = sensorLogBucketSeconds(source);
+  if (bucket > 0) windowSeconds = query.step - query.step % bucket;
+
+  // A bucket that starts before from still overlaps the window
+  uint32_t seekFrom = query.from > bucket ? query.from - bucket : 0;
+  uint32_t firstSeq;
+  sensorLogRing(source).span(firstSeq, lastSeq);
+  nextSeq = sensorLogRing(source).seek(seekFrom);
+}
+
+size_t LogQueryStream::read(uint8_t *buffer, size_t maxLen) {
+  size_t len = 0;
+  while (len < maxLen) {
+    if (outPos < outLen) {
+      size_t n = min(outLen - outPos, maxLen - len);
+      memcpy(buffer + len, out + outPos, n);
+      outPos += n;
+      len += n;
+      continue;
+    }
+    if (!nextRecord()) break;
+  }
+  return len;
+}
+
+// Fill out with the next piece of the response
+bool LogQueryStream::nextRecord() {
+  outLen = 0;
+  outPos = 0;
+  switch (stage) {
+    case QUERY_HEADER:
+      emitHeader();
+      stage = QUERY_RECORDS;
+      return true;
+    case QUERY_RECORDS:
+      if (source == SENSOR_SERIES_RAW ? nextRaw() : nextRollup()) return true;
+      stage = QUERY_FOOTER;
+      return nextRecord();
+    case QUERY_FOOTER:
+      emitFooter();
+      stage = QUERY_DONE;
+      return outLen > 0;
+    default:
+      return false;
+  }
+}
+
+// Whether there is another sequence number to read. Picks up records
+// appended since the last look and skips any the writer has lapped.
+bool LogQueryStream::seqLeft() {
+  if (ended || nextSeq == 0) return false;
+  if (nextSeq > lastSeq) {
+    uint32_t firstSeq;
+    sensorLogRing(source).span(firstSeq, lastSeq);
+    if (nextSeq < firstSeq) nextSeq = firstSeq;
+  }
+  return nextSeq <= lastSeq;
+}
+
+bool LogQueryStream::nextRaw() {
+  SensorLogRecord rec;
+  while (seqLeft()) {
+    if (!reader.read(nextSeq++, &rec)) continue;
+    if (rec.head.unixTime > query.to) {
+      ended = true;
+      break;
+    }
+    if (rec.head.unixTime < query.from) continue;
+    if (query.channel != 0 && rec.channel != query.channel) continue;
+    emitRaw(rec);
+    return true;
+  }
+  return false;
+}
+
+bool LogQueryStream::nextRollup() {
+  uint32_t bucket = sensorLogBucketSeconds(source);
+  SensorRollupRecord rec;
+
+  while (true) {
+    if (flushChannel < SENSOR_CH_COUNT && flushWindow()) return true;
+    if (hasPending) {
+      addBucket(pending);
+      hasPending = false;
+    }
+
+    if (!seqLeft()) {
+      if (!windowOpen) return false;
+      windowOpen = false;
+      flushChannel = 0;
+      continue;
+    }
+    if (!reader.read(nextSeq++, &rec)) continue;
+    if (rec.head.unixTime > query.to) {
+      ended = true;
+      continue;
+    }
+    if (rec.head.unixTime + bucket <= query.from) continue;
+    if (query.channel != 0 && rec.channel != query.channel) continue;
+
+    uint32_t start = rec.head.unixTime - rec.head.unixTime % windowSeconds;
+    if (windowOpen && start != windowStart) {
+      // Emit the finished window first; this bucket opens the next one
+      pending = rec;
+      hasPending = true;
+      windowOpen = false;
+      flushChannel = 0;
+      continue;
+    }
+    addBucket(rec);
+  }
+}
+
+void LogQueryStream::addBucket(const SensorRollupRecord &rec) {
+  if (rec.channel == 0 || rec.channel > SENSOR_CH_COUNT || rec.count == 0) return;
+
+  windowStart = rec.head.unixTime - rec.head.unixTime % windowSeconds;
+  windowOpen = true;
+
+  Window &w = windows[rec.channel - 1];
+  if (w.count == 0) {
+    w.min = rec.min;
+    w.max = rec.max;
+  } else {
+    if (rec.min < w.min) w.min = rec.min;
+    if (rec.max > w.max) w.max = rec.max;
+  }
+  w.sum += rec.avg * rec.count;
+  w.count += rec.count;
+}
+
+// Emit the next channel of the closed window; false once all are out
+bool LogQueryStream::flushWindow() {
+  for (; flushChannel < SENSOR_CH_COUNT; flushChannel++) {
+    Window &w = windows[flushChannel];
+    if (w.count == 0) continue;
+
+    SensorRollupRecord rec = {};
+    rec.head.unixTime = windowStart;
+    rec.min = w.min;
+    rec.max = w.max;
+    rec.avg = w.sum / w.count;
+    rec.count = w.count;
+    rec.channel = flushChannel + 1;
+    w = Window();
+    flushChannel++;
+    emitRollup(rec);
+    return true;
+  }
+  return false;
+}
+
+// ==================================================
+// OUTPUT
+// ==================================================
+void LogQueryStream::emitText(const char *text) {
+  int len = snprintf((char*)out, sizeof(out), "%s", text);
+  outLen = len < 0 ? 0 : min((size_t)len, sizeof(out) - 1);
+}
+
+void LogQueryStream::emitHeader() {
+  if (query.format == LOG_FORMAT_BIN) {
+    LogExportHeader header = { LOG_EXPORT_MAGIC, LOG_EXPORT_VERSION,
+                               sensorLogRing(source).recordSize(), windowSeconds,
+                               query.from, query.to };
+    memcpy(out, &header, sizeof(header));
+    outLen = sizeof(header);
+  } else if (query.format == LOG_FORMAT_JSON) {
+    int len = snprintf((char*)out, sizeof(out),
+                       "{\"series\":\"%s\",\"step\":%lu,\"from\":%lu,\"to\":%lu,\"records\":[\n",
+                       sensorLogSeriesName(source), (unsigned long)windowSeconds,
+                       (unsigned long)query.from, (unsigned long)query.to);
+    outLen = len < 0 ? 0 : min((size_t)len, sizeof(out) - 1);
+  } else if (source == SENSOR_SERIES_RAW) {
+    emitText("time,channel,value\n");
+  } else {
+    emitText("time,channel,min,max,avg,count\n");
+  }
+}
+
+void LogQueryStream::emitFooter() {
+  if (query.format == LOG_FORMAT_JSON) emitText("\n]}\n");
+}
+
+void LogQueryStream::emitRaw(const SensorLogRecord &rec) {
+  char *text = (char*)out;
+  switch (query.format) {
+    case LOG_FORMAT_BIN:
+      memcpy(out, &rec, sizeof(rec));
+      outLen = sizeof(rec);
+      break;
+    case LOG_FORMAT_JSON:
+      outLen = 0;
+      if (wroteRecord) {
+        out[outLen++] = ',';
+        out[outLen++] = '\n';
+      }
+      outLen += sensorLogFormatJson(rec, text + outLen, sizeof(out) - outLen);
+      break;
+    default:
+      outLen = sensorLogFormatCsv(rec, text, sizeof(out));
+      break;
+  }
+  wroteRecord = true;
+}
+
+void LogQueryStream::emitRollup(SensorRollupRecord &rec) {
+  char *text = (char*)out;
+  switch (query.format) {
+    case LOG_FORMAT_BIN:
+      // Merged windows have no sequence number; the CRC still checks
+      rec.crc = crc16((const uint8_t*)&rec, offsetof(SensorRollupRecord, crc));
+      memcpy(out, &rec, sizeof(rec));
+      outLen = sizeof(rec);
+      break;
+    case LOG_FORMAT_JSON:
+      outLen = 0;
+      if (wroteRecord) {
+        out[outLen++] = ',';
+        out[outLen++] = '\n';
+      }
+      outLen += sensorRollupFormatJson(rec, text + outLen, sizeof(out) - outLen);
+      break;
+    default:
+      outLen = sensorRollupFormatCsv(rec, text, sizeof(out));
+      break;
+  }
+  wroteRecord = true;
+}
@@ -0,0 +1,131 @@
+/*
+ * OutletScheduler.cpp
+ * 
+ * Level-based relay control from the outlet schedules.
+ */
+
+#include "OutletScheduler.h"
+#include "Hardware.h"
+#include "Tasks.h"
+#include "TopUp.h"
+#include "ReplaceSolution.h"
+#include "TimeService.h"
+
+#define OUTLET_RELAY_COUNT 4
+#define OUTLET_CLOCK_JUMP_S 5   // RTC moved further than this from millis(): re-apply
+
+static bool relayOwned[OUTLET_RELAY_COUNT] = {false};      // Scheduler set this relay last pass
+static bool relayCommanded[OUTLET_RELAY_COUNT] = {false};  // State it was set to
+static volatile bool outletSchedulesDirty = true;          // Re-apply everything (boot, edits)
+static uint32_t lastEvalUnix = 0;
+static unsigned long lastEvalMillis = 0;
+
+// ==================================================
+// EVALUATION
+// ==================================================
+bool outletScheduleWantsOn(const OutletSchedule &sched, uint32_t secondOfDay, uint8_t dayOfWeek) {
+  if (!sched.enabled) return false;
+
+  if (sched.isInterval) {
+    if (sched.intervalMinutes == 0) return false;
+    if (!isDayEnabled(sched.daysOfWeek, dayOfWeek)) return false;
+    uint32_t period = (uint32_t)sched.intervalMinutes * 60;
+    return (secondOfDay % period) < period / 2;
+  }
+
+  uint32_t on = (uint32_t)sched.hourOn * 3600 + (uint32_t)sched.minuteOn * 60;
+  uint32_t off = (uint32_t)sched.hourOff * 3600 + (uint32_t)sched.minuteOff * 60;
+
+  if (on < off) {
+    return isDayEnabled(sched.daysOfWeek, dayOfWeek) && secondOfDay >= on && secondOfDay < off;
+  }
+  if (on > off) {
+    // Crosses midnight: the evening part is today's window, the morning
+    // part is the tail of yesterday's
+    uint8_t yesterday = (dayOfWeek + 6) % 7;
+    if (secondOfDay >= on) return isDayEnabled(sched.daysOfWeek, dayOfWeek);
+    if (secondOfDay < off) return isDayEnabled(sched.daysOfWeek, yesterday);
+    return false;
+  }
+  return false;   // ON == OFF: empty window
+}
+
+// ==================================================
+// SCHEDULER
+// ==================================================
+void invalidateOutletSchedules() {
+  outletSchedulesDirty = true;
+}
+
+void updateOutletSchedules(unsigned long currentTime) {
+  static unsigned long lastCheck = 0;
+  bool dirty = outletSchedulesDirty;
+  if (!dirty && (unsigned long)(currentTime - lastCheck) < OUTLET_CHECK_INTERVAL) return;
+  lastCheck = currentTime;
+
+  DateTime now = timeNow();
+  if (!now.isValid()) return;
+  uint32_t unixNow = now.unixtime();
+
+  // A clock jump (NTP sync, manual set) may skip an edge; re-apply
+  bool force = dirty;
+  if (lastEvalUnix != 0) {
+    long expected = (long)lastEvalUnix + (long)((currentTime - lastEvalMillis) / 1000);
+    if (labs((long)unixNow - expected) > OUTLET_CLOCK_JUMP_S) force = true;
+  }
+  lastEvalUnix = unixNow;
+  lastEvalMillis = currentTime;
+  outletSchedulesDirty = false;
+
+  uint32_t secondOfDay = (uint32_t)now.hour() * 3600 + (uint32_t)now.minute() * 60 + now.second();
+  uint8_t dayOfWeek = now.dayOfTheWeek();
+
+  bool scheduled[OUTLET_RELAY_COUNT] = {false};
+  bool wanted[OUTLET_RELAY_COUNT] = {false};
+  for (int i = 0; i < outletScheduleCount; i++) {
+    const OutletSchedule &sched = outletSchedules[i];
+    if (!sched.enabled || sched.relayNumber < 1 || sched.relayNumber > OUTLET_RELAY_COUNT) continue;
+    uint8_t r = sched.relayNumber - 1;
+    scheduled[r] = true;
+    if (outletScheduleWantsOn(sched, secondOfDay, dayOfWeek)) wanted[r] = true;
+  }
+
+  bool changed = false;
+  for (uint8_t r = 0; r < OUTLET_RELAY_COUNT; r++) {
+    if (topUpOwnsRelay(r + 1) || replaceOwnsRelay(r + 1)) {
+      // Fill relay belongs to TopUpTask while top-up is enabled, drain and
+      // fill relays to a running replace cycle
+      relayOwned[r] = false;
+      relayCommanded[r] = false;
+      continue;
+    }
+    if (!scheduled[r]) {
+      // Last schedule for this relay was deleted: leave it off, then hand
+      // it back to manual control
+      if (relayOwned[r]) {
+        if (relayCommanded[r]) {
+          setRelay(r + 1, false);
+          changed = true;
+        }
+        relayOwned[r] = false;
+        relayCommanded[r] = false;
+      }
+      continue;
+    }
+
+    // Only act on a change of the wanted state, so a manual override from
+    // the web UI holds until the schedule's next transition
+    if (!force && relayOwned[r] && wanted[r] == relayCommanded[r]) continue;
+
+    setRelay(r + 1, wanted[r]);
+    relayOwned[r] = true;
+    relayCommanded[r] = wanted[r];
+    changed = true;
+
+    Serial.print("[OUTLET] Relay ");
+    Serial.print(r + 1);
+    Serial.println(wanted[r] ? " ON" : " OFF");
+  }
+
+  if (changed) postDisplayEvent(DISPLAY_EVT_STATUS);
+}
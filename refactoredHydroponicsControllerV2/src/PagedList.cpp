@@ -0,0 +1,31 @@
+/*
+ * PagedList.cpp
+ *
+ * Implementation of the paged list widget.
+ */
+
+#include "PagedList.h"
+
+PagedList::PagedList(int16_t top, int16_t rowHeight, uint8_t visibleRows)
+  : top(top),
+    rowHeight(rowHeight),
+    visibleRows(visibleRows),
+    first(0) {
+}
+
+// ==================================================
+// DRAW
+// ==================================================
+void PagedList::draw(int itemCount, int selected, ListRowFn drawRow) {
+  if (selected < 0) selected = 0;
+  first = (selected / visibleRows) * visibleRows;
+
+  for (int s = 0; s < visibleRows; s++) {
+    int16_t y = top + s * rowHeight;
+    int index = first + s;
+
+    // Every row is rebuilt in the canvas; only changed tiles reach the panel
+    canvas.fillRect(0, y, CANVAS_WIDTH, rowHeight, BLACK);
+    if (index < itemCount) drawRow(index, y, index == selected);
+  }
+}
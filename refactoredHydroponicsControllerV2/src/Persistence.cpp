@@ -0,0 +1,174 @@
+/*
+ * Persistence.cpp
+ *
+ * Coalescing write-behind queue for NVS sections, drained by PersistTask.
+ */
+
+#include "Persistence.h"
+#include "DosingQueue.h"
+#include "OutletScheduler.h"
+#include "Storage.h"
+
+#define PERSIST_EVT_DIRTY (1UL << 0)
+#define PERSIST_EVT_FLUSH (1UL << 1)
+
+// Written by any task under persistMux
+static uint32_t dirtySections = 0;
+static unsigned long firstDirtyMs = 0;
+static unsigned long lastDirtyMs = 0;
+static bool flushRequested = false;
+static bool writing = false;
+static bool lastFlushOk = true;
+static PersistCallback callbacks[PERSIST_SECTION_COUNT] = {};
+
+static portMUX_TYPE persistMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================================================
+// REQUESTS
+// ==================================================
+static void wakePersistTask(uint32_t events) {
+  if (PersistTaskHandle == NULL) return;
+  xTaskNotify(PersistTaskHandle, events, eSetBits);
+}
+
+// Caller holds persistMux
+static void markDirtyLocked(uint32_t sections, PersistCallback done) {
+  unsigned long now = millis();
+  if (dirtySections == 0) firstDirtyMs = now;
+  lastDirtyMs = now;
+  dirtySections |= sections;
+
+  if (done == NULL) return;
+  for (uint8_t i = 0; i < PERSIST_SECTION_COUNT; i++) {
+    if (sections & (1UL << i)) callbacks[i] = done;
+  }
+}
+
+void persistSections(uint32_t sections, PersistCallback done) {
+  if (sections & PERSIST_SCHEDULES) {
+    invalidateOutletSchedules();
+    invalidateDosingQueue();
+  }
+
+  portENTER_CRITICAL(&persistMux);
+  markDirtyLocked(sections, done);
+  portEXIT_CRITICAL(&persistMux);
+  wakePersistTask(PERSIST_EVT_DIRTY);
+}
+
+void persistDosingSchedule(int index, PersistCallback done) {
+  if (index < 0 || index >= MAX_DOSING_SCHEDULES) return;
+  invalidateDosingQueue();
+
+  portENTER_CRITICAL(&persistMux);
+  markDirtyLocked(PERSIST_SCHEDULES, done);
+  portEXIT_CRITICAL(&persistMux);
+  wakePersistTask(PERSIST_EVT_DIRTY);
+}
+
+void persistOutletSchedule(int index, PersistCallback done) {
+  if (index < 0 || index >= MAX_OUTLET_SCHEDULES) return;
+  invalidateOutletSchedules();
+
+  portENTER_CRITICAL(&persistMux);
+  markDirtyLocked(PERSIST_SCHEDULES, done);
+  portEXIT_CRITICAL(&persistMux);
+  wakePersistTask(PERSIST_EVT_DIRTY);
+}
+
+// ==================================================
+// WRITES
+// ==================================================
+static bool writeSection(uint32_t section) {
+  switch (section) {
+    case PERSIST_SCHEDULES: return saveSchedulesToStorage();
+    case PERSIST_PUMP_CAL:  return savePumpCalibrationsToStorage();
+    case PERSIST_TOPUP:     return saveTopUpConfigToStorage();
+    case PERSIST_REPLACE:   return saveReplaceConfigToStorage();
+    default:                return true;
+  }
+}
+
+static void flushNow() {
+  portENTER_CRITICAL(&persistMux);
+  uint32_t sections = dirtySections;
+  PersistCallback done[PERSIST_SECTION_COUNT];
+  memcpy(done, callbacks, sizeof(done));
+  dirtySections = 0;
+  flushRequested = false;
+  memset(callbacks, 0, sizeof(callbacks));
+  writing = true;
+  portEXIT_CRITICAL(&persistMux);
+
+  bool allOk = true;
+
+  for (uint8_t i = 0; i < PERSIST_SECTION_COUNT; i++) {
+    uint32_t section = 1UL << i;
+    if (!(sections & section)) continue;
+
+    bool ok = writeSection(section);
+    if (!ok) allOk = false;
+    if (done[i] != NULL) done[i](section, ok);
+  }
+
+  portENTER_CRITICAL(&persistMux);
+  writing = false;
+  lastFlushOk = allOk;
+  portEXIT_CRITICAL(&persistMux);
+}
+
+TickType_t updatePersistence(unsigned long currentTime) {
+  portENTER_CRITICAL(&persistMux);
+  bool dirty = dirtySections != 0;
+  bool flush = flushRequested;
+  unsigned long quietFor = currentTime - lastDirtyMs;
+  unsigned long dirtyFor = currentTime - firstDirtyMs;
+  portEXIT_CRITICAL(&persistMux);
+
+  if (!dirty) {
+    // A flush with nothing pending is already done
+    if (flush) {
+      portENTER_CRITICAL(&persistMux);
+      flushRequested = false;
+      portEXIT_CRITICAL(&persistMux);
+    }
+    return portMAX_DELAY;
+  }
+
+  if (!flush && quietFor < PERSIST_DEBOUNCE_MS && dirtyFor < PERSIST_MAX_DELAY_MS) {
+    unsigned long debounceLeft = PERSIST_DEBOUNCE_MS - quietFor;
+    unsigned long maxLeft = PERSIST_MAX_DELAY_MS - dirtyFor;
+    return pdMS_TO_TICKS(min(debounceLeft, maxLeft));
+  }
+
+  flushNow();
+  // Edits made during the write start a new debounce
+  return 0;
+}
+
+bool flushPersistence() {
+  if (PersistTaskHandle == NULL) {
+    flushNow();
+    return lastFlushOk;
+  }
+
+  portENTER_CRITICAL(&persistMux);
+  flushRequested = true;
+  portEXIT_CRITICAL(&persistMux);
+  wakePersistTask(PERSIST_EVT_FLUSH);
+
+  unsigned long start = millis();
+  for (;;) {
+    portENTER_CRITICAL(&persistMux);
+    bool busy = flushRequested || writing;
+    bool ok = lastFlushOk;
+    portEXIT_CRITICAL(&persistMux);
+    if (!busy) return ok;
+
+    if ((unsigned long)(millis() - start) >= PERSIST_FLUSH_TIMEOUT_MS) {
+      Serial.println("[PERSIST] Flush timed out");
+      return false;
+    }
+    delay(10);
+  }
+}
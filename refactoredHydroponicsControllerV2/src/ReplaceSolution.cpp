@@ -0,0 +1,386 @@
+/*
+ * ReplaceSolution.cpp
+ *
+ * Checkpointed reservoir replace cycle, driven from loop().
+ */
+
+#include "ReplaceSolution.h"
+#include "DosingEngine.h"
+#include "DisplayQueue.h"
+#include "Hardware.h"
+#include "Storage.h"
+#include "Tasks.h"
+#include "TimeService.h"
+#include "TopUp.h"
+#include <ArduinoJson.h>
+
+enum ReplaceRequest : uint8_t {
+  REPLACE_REQ_NONE,
+  REPLACE_REQ_START,
+  REPLACE_REQ_ABORT
+};
+
+// Posted by the menu / web, taken by loop()
+static volatile ReplaceRequest pendingRequest = REPLACE_REQ_NONE;
+
+// Written by loop() under replaceMux; mirrored to NVS on every change
+static ReplaceProgress progress = {};
+static unsigned long stageStartMs = 0;    // millis() at stage entry, this boot
+static bool resumePending = false;
+
+static portMUX_TYPE replaceMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================================================
+// REQUESTS
+// ==================================================
+static void postRequest(ReplaceRequest request) {
+  portENTER_CRITICAL(&replaceMux);
+  pendingRequest = request;
+  portEXIT_CRITICAL(&replaceMux);
+}
+
+static ReplaceRequest takeRequest() {
+  portENTER_CRITICAL(&replaceMux);
+  ReplaceRequest request = pendingRequest;
+  pendingRequest = REPLACE_REQ_NONE;
+  portEXIT_CRITICAL(&replaceMux);
+  return request;
+}
+
+void requestReplaceStart() {
+  postRequest(REPLACE_REQ_START);
+}
+
+void requestReplaceAbort() {
+  postRequest(REPLACE_REQ_ABORT);
+}
+
+// ==================================================
+// STAGES
+// ==================================================
+static bool stageActive(uint8_t stage) {
+  return stage != REPLACE_IDLE && stage != REPLACE_FAULT;
+}
+
+static uint32_t stageLimit(uint8_t stage) {
+  switch (stage) {
+    case REPLACE_DRAIN:  return REPLACE_DRAIN_TIMEOUT_S;
+    case REPLACE_FILL:   return REPLACE_FILL_TIMEOUT_S;
+    case REPLACE_DOSE:   return REPLACE_DOSE_TIMEOUT_S;
+    case REPLACE_SETTLE: return REPLACE_SETTLE_S;
+    default:             return 0;
+  }
+}
+
+// Timed on millis(), so setting the clock mid-stage cannot fault or stretch it
+static uint32_t stageElapsed(unsigned long currentTime) {
+  return (currentTime - stageStartMs) / 1000;
+}
+
+// Time the stage had already run before a reboot, from the checkpoint.
+// Unknown (no RTC time then or now, or the clock went back) counts as 0.
+static uint32_t elapsedBeforeReboot(const DateTime &now) {
+  uint32_t start = progress.stageStartUnix;
+  if (!now.isValid() || start == 0 || now.unixtime() < start) return 0;
+  return min(now.unixtime() - start, stageLimit(progress.stage));
+}
+
+// Drive the relays for a stage; everything else is off
+static void applyRelays(uint8_t stage) {
+  bool drain = stage == REPLACE_DRAIN;
+  bool fill = stage == REPLACE_FILL;
+  if (replaceConfig.drainRelay != replaceConfig.fillRelay) {
+    setRelay(replaceConfig.drainRelay, drain);
+    setRelay(replaceConfig.fillRelay, fill);
+  } else {
+    setRelay(replaceConfig.drainRelay, drain || fill);
+  }
+}
+
+static void enterStage(ReplaceStage stage, const DateTime &now, unsigned long currentTime) {
+  bool wasActive = stageActive(progress.stage);
+
+  portENTER_CRITICAL(&replaceMux);
+  progress.stage = stage;
+  progress.stageStartUnix = now.isValid() ? now.unixtime() : 0;
+  stageStartMs = currentTime;
+  portEXIT_CRITICAL(&replaceMux);
+
+  applyRelays(stage);
+  saveReplaceProgressToStorage(progress);
+
+  Serial.print("[REPLACE] Stage: ");
+  Serial.println(replaceStageName(stage));
+
+  // Top-up stands down for the cycle and re-checks the level after it
+  if (wasActive != stageActive(stage)) postTopUpEvent(TOPUP_EVT_CONFIG);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+}
+
+static void startCycle(const DateTime &now, unsigned long currentTime) {
+  portENTER_CRITICAL(&replaceMux);
+  progress.faultStage = REPLACE_IDLE;
+  progress.dosePump = 0;
+  progress.doseQueued = false;
+  progress.startedUnix = now.isValid() ? now.unixtime() : 0;
+  portEXIT_CRITICAL(&replaceMux);
+
+  enterStage(REPLACE_DRAIN, now, currentTime);
+  displayNotify("Replace: draining", CYAN);
+}
+
+// Leaving the dose stage early (abort, fault): the cycle's dose must not
+// run on into whatever comes next
+static void cancelReplaceDose() {
+  if (progress.stage != REPLACE_DOSE || !progress.doseQueued) return;
+  cancelDoses(progress.dosePump, DOSE_SOURCE_REPLACE);
+  portENTER_CRITICAL(&replaceMux);
+  progress.doseQueued = false;
+  portEXIT_CRITICAL(&replaceMux);
+}
+
+static void faultCycle(const DateTime &now, unsigned long currentTime) {
+  ReplaceStage failed = (ReplaceStage)progress.stage;
+  cancelReplaceDose();
+  portENTER_CRITICAL(&replaceMux);
+  progress.faultStage = failed;
+  portEXIT_CRITICAL(&replaceMux);
+  enterStage(REPLACE_FAULT, now, currentTime);
+
+  Serial.print("[REPLACE] ");
+  Serial.print(replaceStageName(failed));
+  Serial.println(" timed out, cycle stopped");
+  displayNotify("REPLACE TIMEOUT", RED, 10000);
+}
+
+// Dose the pumps in order, each only after the previous one has finished,
+// so the checkpoint knows which doses are done
+static void updateDoseStage(const DateTime &now, unsigned long currentTime) {
+  if (progress.doseQueued) {
+    uint8_t pump = progress.dosePump;
+    if (pendingDoseCount(pump) > 0 || isPumpDosing(pump)) {
+      if (stageElapsed(currentTime) >= REPLACE_DOSE_TIMEOUT_S) faultCycle(now, currentTime);
+      return;
+    }
+  }
+
+  const uint16_t amounts[DOSING_PUMP_COUNT] = {
+    replaceConfig.pump1ML, replaceConfig.pump2ML, replaceConfig.pump3ML, replaceConfig.pump4ML
+  };
+  uint8_t next = progress.dosePump + 1;
+  while (next <= DOSING_PUMP_COUNT && amounts[next - 1] == 0) next++;
+
+  if (next > DOSING_PUMP_COUNT) {
+    enterStage(REPLACE_SETTLE, now, currentTime);
+    return;
+  }
+
+  // Checkpoint before queueing: a reboot from here on skips this dose
+  // rather than risk giving it twice
+  portENTER_CRITICAL(&replaceMux);
+  progress.dosePump = next;
+  progress.doseQueued = true;
+  progress.stageStartUnix = now.isValid() ? now.unixtime() : 0;
+  stageStartMs = currentTime;
+  portEXIT_CRITICAL(&replaceMux);
+  saveReplaceProgressToStorage(progress);
+
+  DoseRequest dose;
+  dose.pumpNumber = next;
+  dose.amountML = amounts[next - 1];
+  dose.source = DOSE_SOURCE_REPLACE;
+  dose.scheduleIndex = 0;
+  dose.dueUnix = 0;
+  queueDose(dose);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+}
+
+static void updateStage(const DateTime &now, unsigned long currentTime) {
+  uint32_t elapsed = stageElapsed(currentTime);
+
+  switch (progress.stage) {
+    case REPLACE_DRAIN:
+      if (hardware.floatEmpty) {
+        enterStage(REPLACE_FILL, now, currentTime);
+      } else if (elapsed >= REPLACE_DRAIN_TIMEOUT_S) {
+        faultCycle(now, currentTime);
+      }
+      break;
+
+    case REPLACE_FILL:
+      if (hardware.floatFull) {
+        enterStage(REPLACE_DOSE, now, currentTime);
+      } else if (elapsed >= REPLACE_FILL_TIMEOUT_S) {
+        faultCycle(now, currentTime);
+      }
+      break;
+
+    case REPLACE_DOSE:
+      updateDoseStage(now, currentTime);
+      break;
+
+    case REPLACE_SETTLE:
+      if (elapsed >= REPLACE_SETTLE_S) {
+        enterStage(REPLACE_IDLE, now, currentTime);
+        Serial.println("[REPLACE] Cycle complete");
+        displayNotify("Replace done", GREEN);
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+// Scheduled start: once per week at scheduleDay / scheduleHour. A faulted
+// cycle waits for a manual start.
+static bool scheduleDue(const DateTime &now) {
+  if (!replaceConfig.enabled || progress.stage != REPLACE_IDLE || !now.isValid()) return false;
+  if (now.dayOfTheWeek() != replaceConfig.scheduleDay || now.hour() != replaceConfig.scheduleHour) return false;
+  return now.unixtime() - progress.startedUnix >= 3600;
+}
+
+// Re-open the relay of the stage the reboot cut off; its time limit
+// carries on from the checkpoint
+static void resumeCycle(const DateTime &now, unsigned long currentTime) {
+  resumePending = false;
+  if (!stageActive(progress.stage)) return;
+
+  Serial.print("[REPLACE] Resuming cycle at stage: ");
+  Serial.println(replaceStageName((ReplaceStage)progress.stage));
+
+  if (progress.stage == REPLACE_DOSE && progress.doseQueued) {
+    Serial.print("[REPLACE] Pump ");
+    Serial.print(progress.dosePump);
+    Serial.println(" dose was interrupted by a reboot, not repeated");
+    portENTER_CRITICAL(&replaceMux);
+    progress.doseQueued = false;
+    portEXIT_CRITICAL(&replaceMux);
+    saveReplaceProgressToStorage(progress);
+  }
+
+  portENTER_CRITICAL(&replaceMux);
+  stageStartMs = currentTime - elapsedBeforeReboot(now) * 1000UL;
+  portEXIT_CRITICAL(&replaceMux);
+  applyRelays(progress.stage);
+  postTopUpEvent(TOPUP_EVT_CONFIG);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+  displayNotify("Replace resumed", CYAN);
+}
+
+// ==================================================
+// LOOP
+// ==================================================
+void initReplaceSolution() {
+  if (!loadReplaceProgressFromStorage(progress)) {
+    memset(&progress, 0, sizeof(progress));
+    return;
+  }
+  if (progress.stage > REPLACE_FAULT) progress.stage = REPLACE_IDLE;
+  resumePending = stageActive(progress.stage);
+
+  if (resumePending) {
+    Serial.print("[REPLACE] Interrupted during ");
+    Serial.print(replaceStageName((ReplaceStage)progress.stage));
+    Serial.println(", resuming shortly");
+  }
+}
+
+void updateReplaceSolution(unsigned long currentTime) {
+  static unsigned long lastCheck = 0;
+  ReplaceRequest request = takeRequest();
+  if (request == REPLACE_REQ_NONE && (unsigned long)(currentTime - lastCheck) < REPLACE_CHECK_INTERVAL) return;
+  lastCheck = currentTime;
+
+  if (currentTime < REPLACE_BOOT_SETTLE_MS) {
+    if (request != REPLACE_REQ_NONE) postRequest(request);   // Keep it for later
+    return;
+  }
+
+  DateTime now = timeNow();
+  if (resumePending) resumeCycle(now, currentTime);
+
+  switch (request) {
+    case REPLACE_REQ_START:
+      if (stageActive(progress.stage)) break;
+      Serial.println("[REPLACE] Cycle started");
+      startCycle(now, currentTime);
+      return;
+
+    case REPLACE_REQ_ABORT:
+      if (!stageActive(progress.stage)) break;
+      Serial.println("[REPLACE] Cycle aborted");
+      cancelReplaceDose();
+      enterStage(REPLACE_IDLE, now, currentTime);
+      displayNotify("Replace aborted", RED);
+      return;
+
+    default:
+      break;
+  }
+
+  if (scheduleDue(now)) {
+    Serial.println("[REPLACE] Scheduled cycle started");
+    startCycle(now, currentTime);
+    return;
+  }
+
+  updateStage(now, currentTime);
+}
+
+// ==================================================
+// STATUS
+// ==================================================
+ReplaceStatus getReplaceStatus() {
+  ReplaceStatus status;
+  unsigned long startMs;
+  portENTER_CRITICAL(&replaceMux);
+  status.stage = (ReplaceStage)progress.stage;
+  status.faultStage = (ReplaceStage)progress.faultStage;
+  status.dosePump = progress.dosePump;
+  status.requestPending = pendingRequest != REPLACE_REQ_NONE;
+  startMs = stageStartMs;
+  portEXIT_CRITICAL(&replaceMux);
+
+  status.limitS = stageLimit(status.stage);
+  status.elapsedS = stageActive(status.stage) ? (millis() - startMs) / 1000 : 0;
+  return status;
+}
+
+const char* replaceStageName(ReplaceStage stage) {
+  switch (stage) {
+    case REPLACE_DRAIN:  return "draining";
+    case REPLACE_FILL:   return "filling";
+    case REPLACE_DOSE:   return "dosing";
+    case REPLACE_SETTLE: return "settling";
+    case REPLACE_FAULT:  return "fault";
+    default:             return "idle";
+  }
+}
+
+String getReplaceJSON() {
+  ReplaceStatus status = getReplaceStatus();
+  StaticJsonDocument<256> doc;
+
+  doc["stage"] = replaceStageName(status.stage);
+  doc["elapsed"] = status.elapsedS;
+  doc["limit"] = status.limitS;
+  if (status.stage == REPLACE_DOSE) doc["pump"] = status.dosePump;
+  if (status.stage == REPLACE_FAULT) doc["failedStage"] = replaceStageName(status.faultStage);
+  doc["pending"] = status.requestPending;
+  doc["enabled"] = replaceConfig.enabled;
+  doc["scheduleDay"] = replaceConfig.scheduleDay;
+  doc["scheduleHour"] = replaceConfig.scheduleHour;
+
+  String output;
+  serializeJson(doc, output);
+  return output;
+}
+
+bool isReplaceActive() {
+  return stageActive(progress.stage) || resumePending;
+}
+
+bool replaceOwnsRelay(uint8_t relay) {
+  return isReplaceActive() && (relay == replaceConfig.drainRelay || relay == replaceConfig.fillRelay);
+}
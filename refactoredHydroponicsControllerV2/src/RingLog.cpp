@@ -0,0 +1,274 @@
+/*
+ * RingLog.cpp
+ *
+ * Segmented fixed-record ring on LittleFS.
+ */
+
+#include "RingLog.h"
+#include "Crc.h"
+
+#define RING_LOG_MAGIC   0x474C4752UL   // "RGLG"
+#define RING_LOG_VERSION 1
+
+struct RingLogMeta {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t recordSize;
+  uint16_t segments;
+  uint16_t perSegment;
+};
+
+// Guards lastSeq of every ring; held for a word copy only
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================================================
+// RECORDS
+// ==================================================
+static uint16_t recordCRC(const uint8_t *record, uint16_t size) {
+  return crc16(record, size - sizeof(uint16_t));
+}
+
+static void sealRecord(uint8_t *record, uint16_t size) {
+  uint16_t crc = recordCRC(record, size);
+  memcpy(record + size - sizeof(uint16_t), &crc, sizeof(crc));
+}
+
+static bool recordIntact(const uint8_t *record, uint16_t size) {
+  uint16_t crc;
+  memcpy(&crc, record + size - sizeof(uint16_t), sizeof(crc));
+  return crc == recordCRC(record, size);
+}
+
+static RingLogHead recordHead(const uint8_t *record) {
+  RingLogHead head;
+  memcpy(&head, record, sizeof(head));
+  return head;
+}
+
+static uint32_t recordSeq(const uint8_t *record) {
+  return recordHead(record).seq;
+}
+
+// ==================================================
+// RING LOG
+// ==================================================
+RingLog::RingLog(const char *dir, uint16_t recordSize, uint16_t segments)
+  : dirPath(dir), recSize(recordSize), segCount(segments),
+    perSegment(RING_LOG_SEGMENT_BYTES / recordSize), lastSeq(0), isReady(false), firstTimes() {}
+
+void RingLog::segmentPath(uint16_t segment, char *buf, size_t size) const {
+  snprintf(buf, size, "%s/%u.bin", dirPath, segment);
+}
+
+bool RingLog::checkMeta() {
+  char path[40];
+  snprintf(path, sizeof(path), "%s/meta.bin", dirPath);
+  File file = LittleFS.open(path, "r");
+  if (!file) return false;
+
+  RingLogMeta meta;
+  bool ok = file.read((uint8_t*)&meta, sizeof(meta)) == sizeof(meta) &&
+            meta.magic == RING_LOG_MAGIC && meta.version == RING_LOG_VERSION &&
+            meta.recordSize == recSize && meta.segments == segCount &&
+            meta.perSegment == perSegment;
+  file.close();
+  return ok;
+}
+
+void RingLog::writeMeta() {
+  char path[40];
+  snprintf(path, sizeof(path), "%s/meta.bin", dirPath);
+  RingLogMeta meta = { RING_LOG_MAGIC, RING_LOG_VERSION, recSize, segCount, perSegment };
+  File file = LittleFS.open(path, "w");
+  if (file) {
+    file.write((const uint8_t*)&meta, sizeof(meta));
+    file.close();
+  }
+}
+
+void RingLog::removeSegments() {
+  char path[40];
+  // Segments left over from a larger ring go too
+  for (uint16_t seg = 0; ; seg++) {
+    segmentPath(seg, path, sizeof(path));
+    if (!LittleFS.exists(path)) {
+      if (seg >= segCount) break;
+      continue;
+    }
+    LittleFS.remove(path);
+  }
+}
+
+// Highest valid sequence number on flash; fills firstTimes on the way
+uint32_t RingLog::scan() {
+  uint8_t record[RING_LOG_RECORD_MAX];
+  char path[40];
+  uint32_t newest = 0;
+
+  for (uint16_t seg = 0; seg < segCount; seg++) {
+    segmentPath(seg, path, sizeof(path));
+    firstTimes[seg] = 0;
+    File file = LittleFS.open(path, "r");
+    if (!file) continue;
+    for (uint16_t idx = 0; idx < perSegment; idx++) {
+      if (file.read(record, recSize) != recSize) break;
+      RingLogHead head = recordHead(record);
+      if (head.seq == 0 || !recordIntact(record, recSize)) continue;
+      if ((head.seq - 1) % capacity() != (uint32_t)seg * perSegment + idx) continue;
+      if (firstTimes[seg] == 0) firstTimes[seg] = head.unixTime;
+      if (head.seq > newest) newest = head.seq;
+    }
+    file.close();
+  }
+  return newest;
+}
+
+bool RingLog::begin() {
+  if (recSize > RING_LOG_RECORD_MAX || perSegment == 0 || segCount > RING_LOG_SEGMENTS_MAX) {
+    return false;
+  }
+
+  LittleFS.mkdir(dirPath);
+  uint32_t newest = 0;
+  if (checkMeta()) {
+    newest = scan();
+  } else {
+    removeSegments();
+    writeMeta();
+    memset(firstTimes, 0, sizeof(firstTimes));
+  }
+
+  portENTER_CRITICAL(&ringMux);
+  lastSeq = newest;
+  portEXIT_CRITICAL(&ringMux);
+  isReady = true;
+  return true;
+}
+
+// Open the segment with the write position at offset. Normally that is
+// the end of the file; after a torn write it may not be.
+File RingLog::openForWrite(uint16_t segment, uint32_t offset) {
+  char path[40];
+  segmentPath(segment, path, sizeof(path));
+  if (offset == 0) return LittleFS.open(path, "w");
+
+  File file = LittleFS.open(path, "a");
+  if (!file || file.size() == offset) return file;
+
+  size_t size = file.size();
+  file.close();
+  file = LittleFS.open(path, "r+");
+  if (!file) return file;
+  if (size > offset) {
+    file.seek(offset);
+  } else {
+    // Records missing before this one: pad with zeros, which never pass
+    // the CRC check
+    static const uint8_t zeros[RING_LOG_RECORD_MAX] = {};
+    file.seek(size);
+    while (size < offset) {
+      size_t n = min<size_t>(offset - size, sizeof(zeros));
+      file.write(zeros, n);
+      size += n;
+    }
+  }
+  return file;
+}
+
+bool RingLog::append(void *record) {
+  if (!isReady) return false;
+
+  uint8_t *bytes = (uint8_t*)record;
+  uint32_t seq = lastSeq + 1;
+  memcpy(bytes, &seq, sizeof(seq));
+  sealRecord(bytes, recSize);
+
+  uint32_t slot = (seq - 1) % capacity();
+  uint16_t segment = slot / perSegment;
+  File file = openForWrite(segment, (slot % perSegment) * recSize);
+  bool ok = file && file.write(bytes, recSize) == recSize;
+  if (file) file.close();
+  if (!ok) return false;
+
+  portENTER_CRITICAL(&ringMux);
+  lastSeq = seq;
+  if (slot % perSegment == 0 || firstTimes[segment] == 0) {
+    firstTimes[segment] = recordHead(bytes).unixTime;
+  }
+  portEXIT_CRITICAL(&ringMux);
+  return true;
+}
+
+void RingLog::clear() {
+  if (!isReady) return;
+  removeSegments();
+  portENTER_CRITICAL(&ringMux);
+  lastSeq = 0;
+  memset(firstTimes, 0, sizeof(firstTimes));
+  portEXIT_CRITICAL(&ringMux);
+}
+
+void RingLog::span(uint32_t &firstSeq, uint32_t &lastSeqOut) const {
+  portENTER_CRITICAL(&ringMux);
+  uint32_t newest = lastSeq;
+  portEXIT_CRITICAL(&ringMux);
+
+  lastSeqOut = newest;
+  if (newest == 0) {
+    firstSeq = 0;
+    return;
+  }
+  // The segment being written was truncated when the ring entered it, so
+  // the oldest record left is the first of the segment after it
+  uint32_t segmentStart = newest - (newest - 1) % perSegment;
+  uint32_t lapStart = (uint32_t)(segCount - 1) * perSegment;
+  firstSeq = segmentStart > lapStart ? segmentStart - lapStart : 1;
+}
+
+uint32_t RingLog::seek(uint32_t unixTime) const {
+  uint32_t firstSeq, newest;
+  span(firstSeq, newest);
+  if (newest == 0) return 0;
+
+  // Walk the segments oldest first; entries are only read under ringMux
+  // so a segment being entered is never seen half-updated
+  uint32_t found = firstSeq;
+  uint32_t start = firstSeq - (firstSeq - 1) % perSegment;
+  portENTER_CRITICAL(&ringMux);
+  for (; start <= newest; start += perSegment) {
+    uint32_t first = firstTimes[((start - 1) % capacity()) / perSegment];
+    if (first == 0) continue;
+    if (first > unixTime) break;
+    found = start;
+  }
+  portEXIT_CRITICAL(&ringMux);
+  return found > firstSeq ? found : firstSeq;
+}
+
+// ==================================================
+// READER
+// ==================================================
+bool RingLogReader::read(uint32_t seq, void *record) {
+  if (seq == 0 || !ring.isReady) return false;
+
+  uint32_t slot = (seq - 1) % ring.capacity();
+  int32_t segment = slot / ring.perSegment;
+  uint32_t offset = (slot % ring.perSegment) * ring.recSize;
+  uint8_t *bytes = (uint8_t*)record;
+
+  // A second try on a fresh handle picks up records appended since the
+  // segment was opened
+  for (uint8_t attempt = 0; attempt < 2; attempt++) {
+    if (segment != openSegment || attempt > 0) {
+      if (file) file.close();
+      char path[40];
+      ring.segmentPath(segment, path, sizeof(path));
+      file = LittleFS.open(path, "r");
+      openSegment = segment;
+    }
+    if (file && file.seek(offset) && file.read(bytes, ring.recSize) == ring.recSize) {
+      return recordSeq(bytes) == seq && recordIntact(bytes, ring.recSize);
+    }
+  }
+  return false;
+}
@@ -0,0 +1,202 @@
+/*
+ * SensorLog.cpp
+ *
+ * Telemetry rings on LittleFS and conversion of the older CSV log.
+ */
+
+#include "SensorLog.h"
+
+static_assert(sizeof(SensorLogRecord) == 16, "SensorLogRecord must not be padded");
+static_assert(sizeof(SensorRollupRecord) == 28, "SensorRollupRecord must not be padded");
+
+static RingLog rawLog(TELEMETRY_DIR "/raw", sizeof(SensorLogRecord), SENSOR_LOG_RAW_SEGMENTS);
+static RingLog minuteLog(TELEMETRY_DIR "/minute", sizeof(SensorRollupRecord), SENSOR_LOG_MINUTE_SEGMENTS);
+static RingLog hourLog(TELEMETRY_DIR "/hour", sizeof(SensorRollupRecord), SENSOR_LOG_HOUR_SEGMENTS);
+static RingLog dayLog(TELEMETRY_DIR "/day", sizeof(SensorRollupRecord), SENSOR_LOG_DAY_SEGMENTS);
+
+static RingLog* const rings[SENSOR_SERIES_COUNT] = { &rawLog, &minuteLog, &hourLog, &dayLog };
+
+static const char* const channelNames[SENSOR_CH_COUNT] = {
+  "rtc_temp",
+  "float_full", "float_low", "float_empty",
+  "relay1", "relay2", "relay3", "relay4",
+  "pump1", "pump2", "pump3", "pump4",
+  "touch1", "touch2", "touch3", "touch4",
+  "dose1", "dose2", "dose3", "dose4"
+};
+
+// ==================================================
+// IMPORT
+// ==================================================
+// Carry the samples of the CSV log over, then drop it
+static void importCsvLog() {
+  File csv = LittleFS.open(LOG_FILE, "r");
+  if (!csv) return;
+
+  char line[64];
+  size_t len = 0;
+  uint32_t imported = 0;
+  int c;
+  while ((c = csv.read()) >= 0) {
+    if (c != '\n') {
+      if (len < sizeof(line) - 1) line[len++] = (char)c;
+      continue;
+    }
+    line[len] = '\0';
+    len = 0;
+
+    int y, mo, d, h, mi, s;
+    float temp;
+    if (sscanf(line, "%d-%d-%d %d:%d:%d,%f", &y, &mo, &d, &h, &mi, &s, &temp) != 7) continue;
+    DateTime at(y, mo, d, h, mi, s);
+    if (!at.isValid()) continue;
+    if (!sensorLogAppend(SENSOR_CH_RTC_TEMP, temp, at.unixtime())) break;
+    imported++;
+  }
+  csv.close();
+
+  LittleFS.remove(LOG_FILE);
+  Serial.print("[LOG] Imported ");
+  Serial.print(imported);
+  Serial.println(" rows from the CSV log");
+}
+
+// ==================================================
+// LOG
+// ==================================================
+bool initSensorLog() {
+  if (!spiffsReady) return false;
+
+  LittleFS.mkdir(TELEMETRY_DIR);
+  bool ok = true;
+  for (uint8_t s = 0; s < SENSOR_SERIES_COUNT; s++) {
+    if (!rings[s]->begin()) {
+      Serial.print("[LOG] Failed to open the ");
+      Serial.print(sensorLogSeriesName((SensorLogSeries)s));
+      Serial.println(" telemetry log");
+      ok = false;
+    }
+  }
+  if (!rawLog.ready()) return false;
+
+  importCsvLog();
+  return ok;
+}
+
+bool sensorLogAppend(uint8_t channel, float value, uint32_t unixTime) {
+  SensorLogRecord rec = {};
+  rec.head.unixTime = unixTime;
+  rec.value = value;
+  rec.channel = channel;
+  if (rawLog.append(&rec)) return true;
+
+  Serial.println("[LOG] Failed to append sensor record");
+  return false;
+}
+
+bool sensorLogAppendRollup(SensorLogSeries series, SensorRollupRecord &rec) {
+  if (series == SENSOR_SERIES_RAW || series >= SENSOR_SERIES_COUNT) return false;
+  if (rings[series]->append(&rec)) return true;
+
+  Serial.print("[LOG] Failed to append ");
+  Serial.print(sensorLogSeriesName(series));
+  Serial.println(" rollup");
+  return false;
+}
+
+void clearSensorLog() {
+  for (uint8_t s = 0; s < SENSOR_SERIES_COUNT; s++) rings[s]->clear();
+}
+
+RingLog& sensorLogRing(SensorLogSeries series) {
+  return *rings[series < SENSOR_SERIES_COUNT ? series : SENSOR_SERIES_RAW];
+}
+
+const char* sensorLogSeriesName(SensorLogSeries series) {
+  switch (series) {
+    case SENSOR_SERIES_RAW:    return "raw";
+    case SENSOR_SERIES_MINUTE: return "minute";
+    case SENSOR_SERIES_HOUR:   return "hour";
+    case SENSOR_SERIES_DAY:    return "day";
+    default:                   return "unknown";
+  }
+}
+
+uint32_t sensorLogBucketSeconds(SensorLogSeries series) {
+  switch (series) {
+    case SENSOR_SERIES_MINUTE: return 60;
+    case SENSOR_SERIES_HOUR:   return 3600;
+    case SENSOR_SERIES_DAY:    return 86400;
+    default:                   return 0;
+  }
+}
+
+SensorLogSeries sensorLogSeriesFor(uint32_t spanSeconds, uint32_t maxPoints) {
+  for (uint8_t s = SENSOR_SERIES_MINUTE; s < SENSOR_SERIES_DAY; s++) {
+    uint32_t bucket = sensorLogBucketSeconds((SensorLogSeries)s);
+    if (spanSeconds / bucket < maxPoints) return (SensorLogSeries)s;
+  }
+  return SENSOR_SERIES_DAY;
+}
+
+// ==================================================
+// FORMATTING
+// ==================================================
+static size_t formatTime(uint32_t unixTime, char *buf, size_t size) {
+  DateTime at(unixTime);
+  int len = snprintf(buf, size, "%04d-%02d-%02d %02d:%02d:%02d",
+                     at.year(), at.month(), at.day(),
+                     at.hour(), at.minute(), at.second());
+  if (len < 0) return 0;
+  return (size_t)len < size ? (size_t)len : size - 1;
+}
+
+static size_t finishLine(size_t used, int len, size_t size) {
+  if (len < 0) return used;
+  used += len;
+  return used < size ? used : size - 1;
+}
+
+size_t sensorLogFormatCsv(const SensorLogRecord &rec, char *buf, size_t size) {
+  size_t used = formatTime(rec.head.unixTime, buf, size);
+  int len = snprintf(buf + used, size - used, ",%s,%.2f\n",
+                     sensorLogChannelName(rec.channel), rec.value);
+  return finishLine(used, len, size);
+}
+
+size_t sensorRollupFormatCsv(const SensorRollupRecord &rec, char *buf, size_t size) {
+  size_t used = formatTime(rec.head.unixTime, buf, size);
+  int len = snprintf(buf + used, size - used, ",%s,%.2f,%.2f,%.2f,%lu\n",
+                     sensorLogChannelName(rec.channel), rec.min, rec.max, rec.avg,
+                     (unsigned long)rec.count);
+  return finishLine(used, len, size);
+}
+
+size_t sensorLogFormatJson(const SensorLogRecord &rec, char *buf, size_t size) {
+  int len = snprintf(buf, size, "{\"t\":%lu,\"ch\":\"%s\",\"v\":%.2f}",
+                     (unsigned long)rec.head.unixTime, sensorLogChannelName(rec.channel), rec.value);
+  return finishLine(0, len, size);
+}
+
+size_t sensorRollupFormatJson(const SensorRollupRecord &rec, char *buf, size_t size) {
+  int len = snprintf(buf, size,
+                     "{\"t\":%lu,\"ch\":\"%s\",\"min\":%.2f,\"max\":%.2f,\"avg\":%.2f,\"n\":%lu}",
+                     (unsigned long)rec.head.unixTime, sensorLogChannelName(rec.channel),
+                     rec.min, rec.max, rec.avg, (unsigned long)rec.count);
+  return finishLine(0, len, size);
+}
+
+// ==================================================
+// CHANNELS
+// ==================================================
+const char* sensorLogChannelName(uint8_t channel) {
+  if (channel == 0 || channel > SENSOR_CH_COUNT) return "unknown";
+  return channelNames[channel - 1];
+}
+
+uint8_t sensorLogChannelFromName(const char *name) {
+  for (uint8_t ch = 1; ch <= SENSOR_CH_COUNT; ch++) {
+    if (strcmp(name, channelNames[ch - 1]) == 0) return ch;
+  }
+  return 0;
+}
@@ -1,7 +1,7 @@
 // SimpleWiFi.cpp
 // Simple WiFi management implementation
 
-#include "SimpleWiFi.h"
+#include "SimpleWifi.h"
 #include "Globals.h"
 #include <Preferences.h>
 #include <esp_task_wdt.h>
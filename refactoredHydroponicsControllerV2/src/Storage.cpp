@@ -5,6 +5,8 @@
  */
 
 #include "Storage.h"
+#include "DoseJournal.h"
+#include "Crc.h"
 
 // ==================================================
 // LITTLEFS INITIALIZATION
@@ -41,6 +43,8 @@ void setDefaultConfig() {
   config.mqttUseTLS = true;
   config.webUsername = WEB_USERNAME;
   config.webPassword = WEB_PASSWORD;
+  config.doseCatchUp = DOSE_CATCHUP_WINDOW;
+  config.doseCatchUpMinutes = 30;
 }
 
 bool loadConfigFromLittleFS() {
@@ -85,6 +89,8 @@ bool loadConfigFromLittleFS() {
 
   config.webUsername = doc["webUsername"] | WEB_USERNAME;
   config.webPassword = doc["webPassword"] | WEB_PASSWORD;
+  config.doseCatchUp = doseCatchUpFromName(doc["doseCatchUp"] | "window");
+  config.doseCatchUpMinutes = doc["doseCatchUpMinutes"] | 30;
 
   return true;
 }
@@ -108,6 +114,8 @@ bool saveConfigToLittleFS() {
   doc["mqttUseTLS"] = config.mqttUseTLS;
   doc["webUsername"] = config.webUsername;
   doc["webPassword"] = config.webPassword;
+  doc["doseCatchUp"] = doseCatchUpName(config.doseCatchUp);
+  doc["doseCatchUpMinutes"] = config.doseCatchUpMinutes;
 
   File file = LittleFS.open(CONFIG_FILE, "w");
   if (!file) {
@@ -126,11 +134,79 @@ bool saveConfigToLittleFS() {
 // ==================================================
 // PREFERENCES (EEPROM) STORAGE
 // ==================================================
-void loadSchedulesFromStorage() {
-  preferences.begin("schedules", true);
+// All schedules live in one "schedules"/"blob" entry: a header naming the
+// layout, then both arrays. Earlier firmware wrote one key per schedule
+// (dose_N / outlet_N); those are migrated on the first load.
+#define SCHEDULE_STORE_MAGIC   0x44484353UL   // "SCHD"
+#define SCHEDULE_STORE_VERSION 1
+
+struct ScheduleStoreBlob {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t crc;               // CRC-16 of everything after the header
+  uint8_t dosingSize;         // sizeof(DosingSchedule) when written
+  uint8_t outletSize;         // sizeof(OutletSchedule) when written
+  uint8_t dosingCount;
+  uint8_t outletCount;
+  DosingSchedule dosing[MAX_DOSING_SCHEDULES];
+  OutletSchedule outlet[MAX_OUTLET_SCHEDULES];
+};
+
+#define SCHEDULE_STORE_PAYLOAD offsetof(ScheduleStoreBlob, dosingSize)
+
+// Image of what is in flash; saves that match it are skipped
+static ScheduleStoreBlob storedSchedules;
+static bool storedSchedulesValid = false;
+
+static uint16_t scheduleBlobCRC(const ScheduleStoreBlob &blob) {
+  return crc16((const uint8_t*)&blob + SCHEDULE_STORE_PAYLOAD,
+               sizeof(ScheduleStoreBlob) - SCHEDULE_STORE_PAYLOAD);
+}
+
+static void buildScheduleBlob(ScheduleStoreBlob &blob) {
+  memset(&blob, 0, sizeof(blob));
+  blob.magic = SCHEDULE_STORE_MAGIC;
+  blob.version = SCHEDULE_STORE_VERSION;
+  blob.dosingSize = sizeof(DosingSchedule);
+  blob.outletSize = sizeof(OutletSchedule);
+  blob.dosingCount = dosingScheduleCount;
+  blob.outletCount = outletScheduleCount;
+  memcpy(blob.dosing, dosingSchedules, sizeof(blob.dosing));
+  memcpy(blob.outlet, outletSchedules, sizeof(blob.outlet));
+  blob.crc = scheduleBlobCRC(blob);
+}
+
+static bool scheduleBlobUsable(const ScheduleStoreBlob &blob) {
+  if (blob.magic != SCHEDULE_STORE_MAGIC) return false;
+  if (blob.version != SCHEDULE_STORE_VERSION ||
+      blob.dosingSize != sizeof(DosingSchedule) ||
+      blob.outletSize != sizeof(OutletSchedule)) {
+    Serial.println("[STORAGE] Schedule blob has an unknown layout");
+    return false;
+  }
+  if (blob.crc != scheduleBlobCRC(blob)) {
+    Serial.println("[STORAGE] Schedule blob CRC mismatch");
+    return false;
+  }
+  return blob.dosingCount <= MAX_DOSING_SCHEDULES && blob.outletCount <= MAX_OUTLET_SCHEDULES;
+}
+
+// storedSchedules must already hold a complete image with its CRC set
+static bool writeStoredSchedules() {
+  preferences.begin("schedules", false);
+  bool ok = preferences.putBytes("blob", &storedSchedules, sizeof(ScheduleStoreBlob)) == sizeof(ScheduleStoreBlob);
+  preferences.end();
+
+  storedSchedulesValid = ok;
+  if (!ok) Serial.println("[STORAGE] Schedule save failed");
+  return ok;
+}
 
-  dosingScheduleCount = preferences.getInt("dose_count", 0);
-  outletScheduleCount = preferences.getInt("outlet_count", 0);
+// Read the per-schedule keys of earlier firmware; the caller holds the
+// "schedules" namespace open
+static void loadLegacySchedules() {
+  dosingScheduleCount = constrain(preferences.getInt("dose_count", 0), 0, MAX_DOSING_SCHEDULES);
+  outletScheduleCount = constrain(preferences.getInt("outlet_count", 0), 0, MAX_OUTLET_SCHEDULES);
 
   for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
     String key = "dose_" + String(i);
@@ -147,29 +223,72 @@ void loadSchedulesFromStorage() {
       preferences.getBytes(key.c_str(), &outletSchedules[i], sizeof(OutletSchedule));
     }
   }
-
-  preferences.end();
 }
 
-void saveSchedulesToStorage() {
+// The blob is written before the old keys go, so a power cut part way
+// through just repeats the migration
+static void removeLegacySchedules() {
   preferences.begin("schedules", false);
+  preferences.remove("dose_count");
+  preferences.remove("outlet_count");
+  for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
+    preferences.remove(("dose_" + String(i)).c_str());
+  }
+  for (int i = 0; i < MAX_OUTLET_SCHEDULES; i++) {
+    preferences.remove(("outlet_" + String(i)).c_str());
+  }
+  preferences.end();
+}
 
-  preferences.putInt("dose_count", dosingScheduleCount);
-  preferences.putInt("outlet_count", outletScheduleCount);
+void loadSchedulesFromStorage() {
+  preferences.begin("schedules", true);
 
-  for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
-    String key = "dose_" + String(i);
-    preferences.putBytes(key.c_str(), &dosingSchedules[i], sizeof(DosingSchedule));
+  bool loaded = false;
+  bool legacy = false;
+  if (preferences.getBytesLength("blob") == sizeof(ScheduleStoreBlob)) {
+    preferences.getBytes("blob", &storedSchedules, sizeof(ScheduleStoreBlob));
+    loaded = scheduleBlobUsable(storedSchedules);
+  } else if (preferences.isKey("blob")) {
+    Serial.println("[STORAGE] Schedule blob has an unknown size");
   }
 
-  for (int i = 0; i < MAX_OUTLET_SCHEDULES; i++) {
-    String key = "outlet_" + String(i);
-    preferences.putBytes(key.c_str(), &outletSchedules[i], sizeof(OutletSchedule));
+  if (loaded) {
+    dosingScheduleCount = storedSchedules.dosingCount;
+    outletScheduleCount = storedSchedules.outletCount;
+    memcpy(dosingSchedules, storedSchedules.dosing, sizeof(storedSchedules.dosing));
+    memcpy(outletSchedules, storedSchedules.outlet, sizeof(storedSchedules.outlet));
+  } else if (preferences.isKey("dose_count") || preferences.isKey("outlet_count")) {
+    loadLegacySchedules();
+    legacy = true;
   }
 
   preferences.end();
+  storedSchedulesValid = loaded;
+
+  if (legacy) {
+    Serial.println("[STORAGE] Migrating schedules to a single blob");
+    buildScheduleBlob(storedSchedules);
+    if (writeStoredSchedules()) removeLegacySchedules();
+  }
+}
+
+bool saveSchedulesToStorage() {
+  static ScheduleStoreBlob blob;   // Too big for the caller's stack
+  buildScheduleBlob(blob);
+  if (storedSchedulesValid && memcmp(&blob, &storedSchedules, sizeof(blob)) == 0) return true;
+
+  storedSchedules = blob;
+  return writeStoredSchedules();
 }
 
+// Single-speed layout stored before the flow curve was added
+struct PumpCalibrationV1 {
+  uint8_t pwmSpeed;
+  uint16_t timeMs;
+  float mlPerSecond;
+  bool isCalibrated;
+};
+
 void loadPumpCalibrationsFromStorage() {
   preferences.begin("pumps", true);
 
@@ -178,21 +297,34 @@ void loadPumpCalibrationsFromStorage() {
     size_t len = preferences.getBytesLength(key.c_str());
     if (len == sizeof(PumpCalibration)) {
       preferences.getBytes(key.c_str(), &pumpCalibrations[i], sizeof(PumpCalibration));
+    } else if (len == sizeof(PumpCalibrationV1)) {
+      // Keep the old calibration as a curve-less one; rewritten on next save
+      PumpCalibrationV1 old;
+      preferences.getBytes(key.c_str(), &old, sizeof(old));
+      pumpCalibrations[i].pwmSpeed = old.pwmSpeed;
+      pumpCalibrations[i].timeMs = old.timeMs;
+      pumpCalibrations[i].mlPerSecond = old.mlPerSecond;
+      pumpCalibrations[i].isCalibrated = old.isCalibrated;
+      pumpCalibrations[i].pointCount = 0;
     }
   }
 
   preferences.end();
 }
 
-void savePumpCalibrationsToStorage() {
+bool savePumpCalibrationsToStorage() {
   preferences.begin("pumps", false);
 
+  bool ok = true;
   for (int i = 0; i < 4; i++) {
     String key = "cal_" + String(i);
-    preferences.putBytes(key.c_str(), &pumpCalibrations[i], sizeof(PumpCalibration));
+    if (preferences.putBytes(key.c_str(), &pumpCalibrations[i], sizeof(PumpCalibration)) != sizeof(PumpCalibration)) {
+      ok = false;
+    }
   }
 
   preferences.end();
+  return ok;
 }
 
 void loadTopUpConfigFromStorage() {
@@ -204,10 +336,11 @@ void loadTopUpConfigFromStorage() {
   preferences.end();
 }
 
-void saveTopUpConfigToStorage() {
+bool saveTopUpConfigToStorage() {
   preferences.begin("topup", false);
-  preferences.putBytes("config", &topUpConfig, sizeof(TopUpConfig));
+  bool ok = preferences.putBytes("config", &topUpConfig, sizeof(TopUpConfig)) == sizeof(TopUpConfig);
   preferences.end();
+  return ok;
 }
 
 void loadReplaceConfigFromStorage() {
@@ -219,41 +352,29 @@ void loadReplaceConfigFromStorage() {
   preferences.end();
 }
 
-void saveReplaceConfigToStorage() {
+bool saveReplaceConfigToStorage() {
   preferences.begin("replace", false);
-  preferences.putBytes("config", &replaceConfig, sizeof(ReplaceConfig));
+  bool ok = preferences.putBytes("config", &replaceConfig, sizeof(ReplaceConfig)) == sizeof(ReplaceConfig);
   preferences.end();
+  return ok;
 }
 
-// ==================================================
-// LOGGING
-// ==================================================
-void logSensorData() {
-  if (!spiffsReady) return;
-
-  DateTime now = rtc.now();
-  float temp = rtc.getTemperature();
-
-  File file = LittleFS.open(LOG_FILE, "a");
-  if (!file) {
-    return;
+// The replace checkpoint is written from loop() while PersistTask may be
+// using the shared preferences object, so it has a handle of its own
+bool loadReplaceProgressFromStorage(ReplaceProgress &progress) {
+  Preferences progressPrefs;
+  progressPrefs.begin("replace", true);
+  bool found = progressPrefs.getBytesLength("progress") == sizeof(ReplaceProgress);
+  if (found) {
+    progressPrefs.getBytes("progress", &progress, sizeof(ReplaceProgress));
   }
+  progressPrefs.end();
+  return found;
+}
 
-  char logEntry[100];
-  sprintf(logEntry, "%04d-%02d-%02d %02d:%02d:%02d,%.1f\n",
-          now.year(), now.month(), now.day(),
-          now.hour(), now.minute(), now.second(),
-          temp);
-
-  file.print(logEntry);
-  file.close();
-
-  // Keep log file manageable
-  File checkFile = LittleFS.open(LOG_FILE, "r");
-  if (checkFile && checkFile.size() > 50000) {
-    checkFile.close();
-    LittleFS.remove(LOG_FILE);
-  } else {
-    checkFile.close();
-  }
+void saveReplaceProgressToStorage(const ReplaceProgress &progress) {
+  Preferences progressPrefs;
+  progressPrefs.begin("replace", false);
+  progressPrefs.putBytes("progress", &progress, sizeof(ReplaceProgress));
+  progressPrefs.end();
 }
@@ -5,43 +5,93 @@
  */
 
 #include "Tasks.h"
+#include "Persistence.h"
+#include "TimeService.h"
+#include "TopUp.h"
 #include <esp_task_wdt.h>
+#include <freertos/timers.h>
 
 // Forward declarations for menu functions (implemented in MenuSystem)
 extern bool checkMenuTimeout(unsigned long currentTime);
 extern void handleMenuNavigation();
+extern void refreshLiveMenu(unsigned long currentTime);
+
+static TimerHandle_t displayClockTimer = NULL;
+
+// ==================================================
+// DISPLAY EVENTS
+// ==================================================
+// Events posted before the task exists are dropped; setup() draws the first
+// frame itself.
+void postDisplayEvent(uint32_t events) {
+  if (DisplayTaskHandle == NULL) return;
+  xTaskNotify(DisplayTaskHandle, events, eSetBits);
+}
+
+void IRAM_ATTR postDisplayEventFromISR(uint32_t events) {
+  if (DisplayTaskHandle == NULL) return;
+  BaseType_t woken = pdFALSE;
+  xTaskNotifyFromISR(DisplayTaskHandle, events, eSetBits, &woken);
+  if (woken) portYIELD_FROM_ISR();
+}
+
+static void displayClockTick(TimerHandle_t /*timer*/) {
+  postDisplayEvent(DISPLAY_EVT_CLOCK);
+}
 
 // ==================================================
 // DISPLAY TASK - Core 1
 // ==================================================
-// Handles menu rendering and display updates at 20 FPS
-void DisplayTask(void *parameter) {
-  TickType_t lastWakeTime = xTaskGetTickCount();
-  const TickType_t frequency = pdMS_TO_TICKS(50); // 50ms = 20 FPS
+// Sole owner of the canvas and the TFT, and sole caller of the menu input
+// and render functions. Other tasks reach the screen through DisplayQueue.
+// Blocks until an event arrives, so an idle screen costs one wake-up per
+// second.
+void DisplayTask(void * /*parameter*/) {
+  canvas.setOwner(xTaskGetCurrentTaskHandle());
 
   for(;;) {
-    // Feed watchdog at start of loop
+    uint32_t events = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
+
+    // Feed watchdog after each wake-up
     esp_task_wdt_reset();
-    
+
+    // Drain queued draw commands from other tasks
+    if (events & DISPLAY_EVT_COMMAND) {
+      DrawCommand cmd;
+      while (popDrawCommand(cmd)) {
+        applyDrawCommand(cmd);
+      }
+    }
+
     // Check menu timeout FIRST before handling navigation
-    checkMenuTimeout(millis());
+    if (events & DISPLAY_EVT_CLOCK) {
+      unsigned long currentTime = millis();
+      refreshLiveMenu(currentTime);
+      checkMenuTimeout(currentTime);
+      expireNotification(currentTime);
+    }
 
     // Handle menu navigation
-    handleMenuNavigation();
+    if (events & (DISPLAY_EVT_ENCODER | DISPLAY_EVT_BUTTON)) {
+      handleMenuNavigation();
+    }
 
-    // Draw menu
+    // Draw menu (returns at once unless something set needsRedraw)
     drawMenu();
 
-    // Maintain consistent timing
-    vTaskDelayUntil(&lastWakeTime, frequency);
+    // Clock and connection indicators on the main screen
+    if (events & (DISPLAY_EVT_CLOCK | DISPLAY_EVT_STATUS)) {
+      updateStatusBar();
+    }
   }
 }
 
 // ==================================================
 // SENSOR TASK - Core 1
 // ==================================================
-// Handles float switches and touch sensors at 10 Hz
-void SensorTask(void *parameter) {
+// Handles float switches and touch sensors at 10 Hz, and owns the RTC
+void SensorTask(void * /*parameter*/) {
   TickType_t lastWakeTime = xTaskGetTickCount();
   const TickType_t frequency = pdMS_TO_TICKS(100); // 100ms
 
@@ -57,11 +107,48 @@ void SensorTask(void *parameter) {
     // Update touch sensors
     updateTouchSensors(currentTime);
 
+    // Refresh the cached RTC time / temperature
+    updateTimeService(currentTime);
+
     // Maintain consistent timing
     vTaskDelayUntil(&lastWakeTime, frequency);
   }
 }
 
+// ==================================================
+// TOP-UP TASK - Core 1
+// ==================================================
+// Sleeps until a float switch edge or config change, or until the fill
+// failsafe is due while the fill relay is open
+void TopUpTask(void * /*parameter*/) {
+  TickType_t wait = portMAX_DELAY;
+
+  for(;;) {
+    uint32_t events = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &events, wait);
+
+    esp_task_wdt_reset();
+    wait = updateTopUp(millis());
+  }
+}
+
+// ==================================================
+// PERSIST TASK - Core 1
+// ==================================================
+// Sleeps until a section is marked dirty, then writes it once the edits
+// have settled
+void PersistTask(void * /*parameter*/) {
+  TickType_t wait = portMAX_DELAY;
+
+  for(;;) {
+    uint32_t events = 0;
+    xTaskNotifyWait(0, UINT32_MAX, &events, wait);
+
+    esp_task_wdt_reset();
+    wait = updatePersistence(millis());
+  }
+}
+
 // ==================================================
 // TASK INITIALIZATION
 // ==================================================
@@ -69,11 +156,11 @@ void startTasks() {
   // Feed watchdog before creating tasks
   esp_task_wdt_reset();
 
-  // Display task - handles menu rendering (Core 1, high priority)
+  // Display task - handles menu input and rendering (Core 1, high priority)
   xTaskCreatePinnedToCore(
     DisplayTask,
     "DisplayTask",
-    4096,
+    8192,       // Menu selections run here now
     NULL,
     2,
     &DisplayTaskHandle,
@@ -91,5 +178,34 @@ void startTasks() {
     CORE_1
   );
 
+  // Top-up task - fill relay and top-up nutrients (Core 1, medium priority)
+  xTaskCreatePinnedToCore(
+    TopUpTask,
+    "TopUpTask",
+    3072,
+    NULL,
+    1,
+    &TopUpTaskHandle,
+    CORE_1
+  );
+
+  // Persist task - write-behind NVS saves (Core 1, low priority)
+  xTaskCreatePinnedToCore(
+    PersistTask,
+    "PersistTask",
+    4096,
+    NULL,
+    1,
+    &PersistTaskHandle,
+    CORE_1
+  );
+
+  // One-second tick for the status bar clock and the menu timeout
+  displayClockTimer = xTimerCreate("DisplayClock", pdMS_TO_TICKS(1000), pdTRUE,
+                                   NULL, displayClockTick);
+  if (displayClockTimer == NULL || xTimerStart(displayClockTimer, 0) != pdPASS) {
+    Serial.println("✗ Display clock timer failed");
+  }
+
   Serial.println("✓ FreeRTOS tasks started");
 }
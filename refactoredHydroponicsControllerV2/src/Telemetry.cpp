@@ -0,0 +1,224 @@
+/*
+ * Telemetry.cpp
+ *
+ * Change-only sampling and minute / hour / day rollups.
+ */
+
+#include "Telemetry.h"
+#include "SensorLog.h"
+#include "TimeService.h"
+#include "DosingEngine.h"
+
+#define TELEMETRY_TIERS (SENSOR_SERIES_COUNT - 1)   // Rollup series, finest first
+
+struct Accumulator {
+  float min;
+  float max;
+  float sum;
+  uint32_t count;
+};
+
+struct ChannelRollup {
+  Accumulator acc;
+  float lastValue;         // Value of the last single-valued rollup written
+  uint32_t lastWritten;    // Bucket of the last rollup written
+  bool lastConstant;       // The last rollup written held one value
+  bool written;
+};
+
+struct Tier {
+  uint32_t bucketStart;    // 0 until the first sample
+  ChannelRollup channels[SENSOR_CH_COUNT];
+};
+
+static Tier tiers[TELEMETRY_TIERS];
+
+// Last raw value per sampled channel
+static float lastRaw[SENSOR_CH_SAMPLED];
+static bool rawValid = false;
+static uint32_t lastKeyframe = 0;
+static unsigned long lastSample = 0;
+
+// Posted by the web, taken by loop()
+static volatile bool clearPending = false;
+static portMUX_TYPE telemetryMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================================================
+// ROLLUPS
+// ==================================================
+static SensorLogSeries tierSeries(uint8_t tier) {
+  return (SensorLogSeries)(SENSOR_SERIES_MINUTE + tier);
+}
+
+static void accumulate(Accumulator &acc, float min, float max, float sum, uint32_t count) {
+  if (acc.count == 0) {
+    acc.min = min;
+    acc.max = max;
+  } else {
+    if (min < acc.min) acc.min = min;
+    if (max > acc.max) acc.max = max;
+  }
+  acc.sum += sum;
+  acc.count += count;
+}
+
+static bool isDoseChannel(uint8_t channel) {
+  return channel > SENSOR_CH_SAMPLED;
+}
+
+static void writeRollup(uint8_t tier, uint8_t channel, ChannelRollup &ch, uint32_t bucketStart) {
+  uint32_t bucket = sensorLogBucketSeconds(tierSeries(tier));
+  bool constant = ch.acc.min == ch.acc.max;
+
+  if (!isDoseChannel(channel) && constant && ch.written && ch.lastConstant &&
+      ch.lastValue == ch.acc.min &&
+      bucketStart - ch.lastWritten < bucket * TELEMETRY_ROLLUP_KEYFRAME) {
+    return;
+  }
+
+  SensorRollupRecord rec = {};
+  rec.head.unixTime = bucketStart;
+  rec.min = ch.acc.min;
+  rec.max = ch.acc.max;
+  rec.avg = ch.acc.sum / ch.acc.count;
+  rec.count = ch.acc.count;
+  rec.channel = channel;
+  if (!sensorLogAppendRollup(tierSeries(tier), rec)) return;
+
+  ch.written = true;
+  ch.lastWritten = bucketStart;
+  ch.lastConstant = constant;
+  ch.lastValue = ch.acc.min;
+}
+
+// Write the tier's open bucket and fold it into the next coarser tier
+static void closeBucket(uint8_t tier) {
+  Tier &t = tiers[tier];
+  for (uint8_t i = 0; i < SENSOR_CH_COUNT; i++) {
+    ChannelRollup &ch = t.channels[i];
+    if (ch.acc.count == 0) continue;
+
+    writeRollup(tier, i + 1, ch, t.bucketStart);
+    if (tier + 1 < TELEMETRY_TIERS) {
+      accumulate(tiers[tier + 1].channels[i].acc, ch.acc.min, ch.acc.max, ch.acc.sum, ch.acc.count);
+    }
+    ch.acc = Accumulator();
+  }
+}
+
+// Close every bucket that unixTime has left, finest first so each one is
+// folded into its parent before the parent closes
+static void advanceBuckets(uint32_t unixTime) {
+  for (uint8_t tier = 0; tier < TELEMETRY_TIERS; tier++) {
+    uint32_t bucket = sensorLogBucketSeconds(tierSeries(tier));
+    uint32_t start = unixTime - unixTime % bucket;
+    Tier &t = tiers[tier];
+    if (t.bucketStart == start) continue;
+    if (t.bucketStart != 0) closeBucket(tier);
+    t.bucketStart = start;
+  }
+}
+
+static void addSample(uint8_t channel, float value) {
+  accumulate(tiers[0].channels[channel - 1].acc, value, value, value, 1);
+}
+
+// ==================================================
+// SAMPLING
+// ==================================================
+static float sampleChannel(uint8_t channel) {
+  switch (channel) {
+    case SENSOR_CH_RTC_TEMP:    return rtcTemperature();
+    case SENSOR_CH_FLOAT_FULL:  return hardware.floatFull;
+    case SENSOR_CH_FLOAT_LOW:   return hardware.floatLow;
+    case SENSOR_CH_FLOAT_EMPTY: return hardware.floatEmpty;
+    case SENSOR_CH_RELAY1:      return hardware.relay1;
+    case SENSOR_CH_RELAY2:      return hardware.relay2;
+    case SENSOR_CH_RELAY3:      return hardware.relay3;
+    case SENSOR_CH_RELAY4:      return hardware.relay4;
+    case SENSOR_CH_PUMP1:       return hardware.pump1Speed;
+    case SENSOR_CH_PUMP2:       return hardware.pump2Speed;
+    case SENSOR_CH_PUMP3:       return hardware.pump3Speed;
+    case SENSOR_CH_PUMP4:       return hardware.pump4Speed;
+    case SENSOR_CH_TOUCH1:      return hardware.touch1;
+    case SENSOR_CH_TOUCH2:      return hardware.touch2;
+    case SENSOR_CH_TOUCH3:      return hardware.touch3;
+    case SENSOR_CH_TOUCH4:      return hardware.touch4;
+    default:                    return 0;
+  }
+}
+
+static bool recording(uint32_t &unixTime) {
+  if (!config.enableLogging || !spiffsReady) return false;
+  DateTime now = timeNow();
+  if (!now.isValid()) return false;
+  unixTime = now.unixtime();
+  return true;
+}
+
+// ==================================================
+// CLEAR
+// ==================================================
+void requestTelemetryClear() {
+  portENTER_CRITICAL(&telemetryMux);
+  clearPending = true;
+  portEXIT_CRITICAL(&telemetryMux);
+}
+
+static bool takeClearRequest() {
+  portENTER_CRITICAL(&telemetryMux);
+  bool pending = clearPending;
+  clearPending = false;
+  portEXIT_CRITICAL(&telemetryMux);
+  return pending;
+}
+
+// Drop every series along with the open buckets and the last values they
+// were compared against, so recording starts over with a keyframe
+static void clearTelemetry() {
+  clearSensorLog();
+  for (uint8_t tier = 0; tier < TELEMETRY_TIERS; tier++) tiers[tier] = Tier();
+  rawValid = false;
+  lastKeyframe = 0;
+  Serial.println("[LOG] Telemetry cleared");
+}
+
+void updateTelemetry(unsigned long currentTime) {
+  if (takeClearRequest()) clearTelemetry();
+
+  if ((unsigned long)(currentTime - lastSample) < TELEMETRY_SAMPLE_MS) return;
+  lastSample = currentTime;
+
+  uint32_t now;
+  if (!recording(now)) {
+    // Start with a keyframe when recording resumes
+    rawValid = false;
+    return;
+  }
+
+  advanceBuckets(now);
+
+  bool keyframe = !rawValid || now - lastKeyframe >= TELEMETRY_KEYFRAME_S;
+  if (keyframe) lastKeyframe = now;
+
+  for (uint8_t ch = 1; ch <= SENSOR_CH_SAMPLED; ch++) {
+    float value = sampleChannel(ch);
+    addSample(ch, value);
+    if (keyframe || value != lastRaw[ch - 1]) {
+      sensorLogAppend(ch, value, now);
+      lastRaw[ch - 1] = value;
+    }
+  }
+  rawValid = true;
+}
+
+void telemetryRecordDose(uint8_t pumpNumber, float ml) {
+  if (pumpNumber < 1 || pumpNumber > DOSING_PUMP_COUNT) return;
+  uint32_t now;
+  if (!recording(now)) return;
+
+  uint8_t channel = SENSOR_CH_DOSE1 + pumpNumber - 1;
+  advanceBuckets(now);
+  addSample(channel, ml);
+  sensorLogAppend(channel, ml, now);
+}
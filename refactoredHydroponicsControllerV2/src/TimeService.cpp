@@ -0,0 +1,158 @@
+/*
+ * TimeService.cpp
+ *
+ * DS3231 read-through cache with esp_timer interpolation.
+ */
+
+#include "TimeService.h"
+#include <esp_timer.h>
+
+struct TimeSnapshot {
+  uint32_t unixTime;   // RTC second...
+  int64_t baseUs;      // ...that began at this esp_timer time
+  float temperature;
+  bool valid;
+};
+
+// Readers and writers (SensorTask refresh, setRtcTime) copy the snapshot
+// under timeMux; a copy is a few words, so the critical section stays
+// shorter than any I2C transfer
+static TimeSnapshot current = {};
+static portMUX_TYPE timeMux = portMUX_INITIALIZER_UNLOCKED;
+static bool setPending = false;
+static DateTime pendingTime;
+
+static unsigned long lastRefresh = 0;
+static unsigned long lastTempRead = 0;
+
+// ==================================================
+// SNAPSHOT
+// ==================================================
+static TimeSnapshot readSnapshot() {
+  portENTER_CRITICAL(&timeMux);
+  TimeSnapshot snap = current;
+  portEXIT_CRITICAL(&timeMux);
+  return snap;
+}
+
+// Caller holds timeMux
+static void publishLocked(const TimeSnapshot &snap) {
+  current = snap;
+}
+
+static int64_t elapsedUs(const TimeSnapshot &snap, int64_t nowUs) {
+  return nowUs > snap.baseUs ? nowUs - snap.baseUs : 0;
+}
+
+// ==================================================
+// SERVICE
+// ==================================================
+void initTimeService() {
+  TimeSnapshot snap = {};
+  DateTime first = rtc.now();
+
+  if (first.isValid()) {
+    // Wait for the seconds to tick so baseUs marks the start of a second
+    DateTime now = first;
+    unsigned long start = millis();
+    while (now.unixtime() == first.unixtime() && (unsigned long)(millis() - start) < TIME_EDGE_WAIT_MS) {
+      delay(5);
+      now = rtc.now();
+    }
+    snap.unixTime = now.unixtime();
+    snap.baseUs = esp_timer_get_time();
+    snap.valid = now.isValid();
+  } else {
+    Serial.println("[TIME] RTC time invalid");
+  }
+  snap.temperature = rtc.getTemperature();
+
+  portENTER_CRITICAL(&timeMux);
+  publishLocked(snap);
+  portEXIT_CRITICAL(&timeMux);
+
+  lastRefresh = millis();
+  lastTempRead = lastRefresh;
+}
+
+void setRtcTime(const DateTime &time) {
+  int64_t nowUs = esp_timer_get_time();
+
+  // Edit in place: a copy taken outside the lock could undo a newer
+  // temperature reading
+  portENTER_CRITICAL(&timeMux);
+  pendingTime = time;
+  setPending = true;
+  current.unixTime = time.unixtime();
+  current.baseUs = nowUs;
+  current.valid = time.isValid();
+  portEXIT_CRITICAL(&timeMux);
+}
+
+void updateTimeService(unsigned long currentTime) {
+  portENTER_CRITICAL(&timeMux);
+  bool applySet = setPending;
+  DateTime setTime = pendingTime;
+  portEXIT_CRITICAL(&timeMux);
+
+  if (applySet) {
+    // The snapshot already serves the new time; only the chip is behind
+    rtc.adjust(setTime);
+    portENTER_CRITICAL(&timeMux);
+    if (pendingTime.unixtime() == setTime.unixtime()) setPending = false;
+    portEXIT_CRITICAL(&timeMux);
+    lastRefresh = currentTime;
+    return;
+  }
+
+  if ((unsigned long)(currentTime - lastRefresh) < TIME_REFRESH_INTERVAL_MS) return;
+  lastRefresh = currentTime;
+
+  DateTime rtcNow = rtc.now();
+  int64_t nowUs = esp_timer_get_time();
+  TimeSnapshot snap = readSnapshot();
+  bool changed = false;
+
+  if (rtcNow.isValid()) {
+    uint32_t predicted = snap.unixTime + (uint32_t)(elapsedUs(snap, nowUs) / 1000000);
+    if (!snap.valid || rtcNow.unixtime() != predicted) {
+      // esp_timer drifted past a second boundary, or the RTC was set
+      // behind our back: move the phase as little as will agree with it
+      snap.unixTime = rtcNow.unixtime();
+      snap.baseUs = rtcNow.unixtime() > predicted ? nowUs : nowUs - 999999;
+      snap.valid = true;
+      changed = true;
+    }
+  }
+
+  if ((unsigned long)(currentTime - lastTempRead) >= TIME_TEMP_INTERVAL_MS) {
+    lastTempRead = currentTime;
+    snap.temperature = rtc.getTemperature();
+    changed = true;
+  }
+
+  if (!changed) return;
+  portENTER_CRITICAL(&timeMux);
+  // A set that arrived during the read wins over what the chip said
+  if (!setPending) publishLocked(snap);
+  portEXIT_CRITICAL(&timeMux);
+}
+
+// ==================================================
+// READERS
+// ==================================================
+DateTime timeNow() {
+  TimeSnapshot snap = readSnapshot();
+  if (!snap.valid) return DateTime((uint32_t)0xFFFFFFFF);   // Year 2106: isValid() is false
+  return DateTime(snap.unixTime + (uint32_t)(elapsedUs(snap, esp_timer_get_time()) / 1000000));
+}
+
+uint64_t timeNowMs() {
+  TimeSnapshot snap = readSnapshot();
+  if (!snap.valid) return 0;
+  return (uint64_t)snap.unixTime * 1000 + elapsedUs(snap, esp_timer_get_time()) / 1000;
+}
+
+float rtcTemperature() {
+  return readSnapshot().temperature;
+}
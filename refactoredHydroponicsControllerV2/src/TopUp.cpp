@@ -0,0 +1,162 @@
+/*
+ * TopUp.cpp
+ *
+ * Float-switch driven top-up cycle, run by TopUpTask.
+ */
+
+#include "TopUp.h"
+#include "DosingEngine.h"
+#include "DisplayQueue.h"
+#include "Hardware.h"
+#include "ReplaceSolution.h"
+#include "Tasks.h"
+
+// Written by TopUpTask under topUpMux
+static TopUpState topUpState = TOPUP_IDLE;
+static uint8_t fillRelay = 0;
+static unsigned long fillStartMs = 0;
+static unsigned long lastFillMs = 0;
+static uint16_t fillCycles = 0;
+
+static portMUX_TYPE topUpMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ==================================================
+// TOP-UP EVENTS
+// ==================================================
+void postTopUpEvent(uint32_t events) {
+  if (TopUpTaskHandle == NULL) return;
+  xTaskNotify(TopUpTaskHandle, events, eSetBits);
+}
+
+// ==================================================
+// CYCLE
+// ==================================================
+static void setState(TopUpState state) {
+  portENTER_CRITICAL(&topUpMux);
+  topUpState = state;
+  portEXIT_CRITICAL(&topUpMux);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
+}
+
+static void startFill(unsigned long currentTime) {
+  fillRelay = topUpConfig.fillPumpRelay;
+  fillStartMs = currentTime;
+  setRelay(fillRelay, true);
+  setState(TOPUP_FILLING);
+
+  Serial.print("[TOPUP] LOW tripped, filling on relay ");
+  Serial.println(fillRelay);
+}
+
+static void stopFill() {
+  setRelay(fillRelay, false);
+}
+
+// Nutrients for one LOW-to-FULL fill; pumps set to 0 are skipped
+static void queueTopUpDoses() {
+  const uint16_t amounts[DOSING_PUMP_COUNT] = {
+    topUpConfig.pump1ML, topUpConfig.pump2ML, topUpConfig.pump3ML, topUpConfig.pump4ML
+  };
+
+  for (uint8_t i = 0; i < DOSING_PUMP_COUNT; i++) {
+    if (amounts[i] == 0) continue;
+    DoseRequest dose;
+    dose.pumpNumber = i + 1;
+    dose.amountML = amounts[i];
+    dose.source = DOSE_SOURCE_TOPUP;
+    dose.scheduleIndex = 0;
+    dose.dueUnix = 0;
+    queueDose(dose);
+  }
+}
+
+static void finishFill(unsigned long currentTime) {
+  stopFill();
+  unsigned long elapsed = currentTime - fillStartMs;
+  portENTER_CRITICAL(&topUpMux);
+  lastFillMs = elapsed;
+  fillCycles++;
+  portEXIT_CRITICAL(&topUpMux);
+  setState(TOPUP_IDLE);
+
+  Serial.print("[TOPUP] FULL after ");
+  Serial.print(elapsed / 1000);
+  Serial.println(" s, dosing nutrients");
+  queueTopUpDoses();
+  displayNotify("Top-up done", GREEN);
+}
+
+TickType_t updateTopUp(unsigned long currentTime) {
+  bool low = hardware.floatLow;
+  bool full = hardware.floatFull;
+
+  switch (topUpState) {
+    case TOPUP_IDLE:
+      if (!topUpConfig.enabled || isReplaceActive() || !low) break;
+      if (full) {
+        // Both switches tripped: a float is stuck, filling could overflow
+        Serial.println("[TOPUP] LOW and FULL both tripped, not filling");
+        break;
+      }
+      startFill(currentTime);
+      break;
+
+    case TOPUP_FILLING:
+      if (full) {
+        finishFill(currentTime);
+      } else if (!topUpConfig.enabled || isReplaceActive() || topUpConfig.fillPumpRelay != fillRelay) {
+        stopFill();
+        setState(TOPUP_IDLE);
+        Serial.println("[TOPUP] Fill stopped by config change or replace cycle");
+        // A new relay takes over on the next pass
+        if (topUpConfig.enabled) return 0;
+      } else if ((unsigned long)(currentTime - fillStartMs) >= TOPUP_MAX_FILL_MS) {
+        // Nutrients are not dosed: the volume added is unknown
+        stopFill();
+        setState(TOPUP_FAULT);
+        Serial.println("[TOPUP] FULL not reached in time, fill relay locked off");
+        displayNotify("TOP-UP TIMEOUT", RED, 10000);
+      }
+      break;
+
+    case TOPUP_FAULT:
+      if (full) {
+        Serial.println("[TOPUP] FULL tripped, fault cleared");
+        setState(TOPUP_IDLE);
+      }
+      break;
+  }
+
+  if (topUpState != TOPUP_FILLING) return portMAX_DELAY;
+  unsigned long elapsed = millis() - fillStartMs;
+  unsigned long remaining = elapsed < TOPUP_MAX_FILL_MS ? TOPUP_MAX_FILL_MS - elapsed : 0;
+  return pdMS_TO_TICKS(remaining);
+}
+
+// ==================================================
+// STATUS
+// ==================================================
+TopUpStatus getTopUpStatus() {
+  TopUpStatus status;
+  portENTER_CRITICAL(&topUpMux);
+  status.state = topUpState;
+  status.relay = fillRelay;
+  status.lastFillMs = lastFillMs;
+  status.cycles = fillCycles;
+  portEXIT_CRITICAL(&topUpMux);
+
+  status.elapsedMs = status.state == TOPUP_FILLING ? (unsigned long)(millis() - fillStartMs) : 0;
+  return status;
+}
+
+const char* topUpStateName(TopUpState state) {
+  switch (state) {
+    case TOPUP_FILLING: return "filling";
+    case TOPUP_FAULT:   return "fault";
+    default:            return "idle";
+  }
+}
+
+bool topUpOwnsRelay(uint8_t relay) {
+  return topUpConfig.enabled && topUpConfig.fillPumpRelay == relay;
+}
@@ -7,6 +7,15 @@
 #include "WebServer.h"
 #include "Storage.h"
 #include "Hardware.h"
+#include "DisplayQueue.h"
+#include "DoseJournal.h"
+#include "DosingEngine.h"
+#include "Persistence.h"
+#include "ReplaceSolution.h"
+#include "SensorLog.h"
+#include "Telemetry.h"
+#include "LogQuery.h"
+#include "TimeService.h"
 
 // Forward declarations for functions from main.cpp
 void connectMQTT();
@@ -39,14 +48,14 @@ void notifyWebClients() {
 }
 
 void updateSensorData() {
-  DateTime now = rtc.now();
+  DateTime now = timeNow();
   char timeStr[30];
   sprintf(timeStr, "%04d-%02d-%02d %02d:%02d:%02d",
           now.year(), now.month(), now.day(),
           now.hour(), now.minute(), now.second());
 
   currentData.timestamp = String(timeStr);
-  currentData.temperature = rtc.getTemperature();
+  currentData.temperature = rtcTemperature();
   currentData.wifiStatus = wifiConnected;
   currentData.mqttStatus = mqttConnected;
   currentData.spiffsUsed = LittleFS.usedBytes() / 1024;
@@ -55,7 +64,7 @@ void updateSensorData() {
 }
 
 String getSensorDataJSON() {
-  StaticJsonDocument<512> doc;
+  StaticJsonDocument<1024> doc;
 
   doc["timestamp"] = currentData.timestamp;
   doc["temperature"] = currentData.temperature;
@@ -67,6 +76,20 @@ String getSensorDataJSON() {
   doc["uptime"] = millis() / 1000;
   doc["ntpSynced"] = ntpSynced;
 
+  // Dosing pumps; the last dose's planned vs measured run time shows how
+  // closely the stop timer hit its target
+  JsonArray pumps = doc.createNestedArray("pumps");
+  for (uint8_t pump = 1; pump <= DOSING_PUMP_COUNT; pump++) {
+    JsonObject p = pumps.createNestedObject();
+    p["dosing"] = isPumpDosing(pump);
+    p["pending"] = pendingDoseCount(pump);
+    int64_t plannedUs, actualUs;
+    if (lastDoseRunTime(pump, plannedUs, actualUs)) {
+      p["lastPlannedMs"] = plannedUs / 1000.0;
+      p["lastActualMs"] = actualUs / 1000.0;
+    }
+  }
+
   String output;
   serializeJson(doc, output);
   return output;
@@ -87,6 +110,8 @@ String getConfigJSON() {
   doc["publishInterval"] = config.publishInterval;
   doc["enableLogging"] = config.enableLogging;
   doc["webUsername"] = config.webUsername;
+  doc["doseCatchUp"] = doseCatchUpName(config.doseCatchUp);
+  doc["doseCatchUpMinutes"] = config.doseCatchUpMinutes;
 
   String output;
   serializeJson(doc, output);
@@ -114,6 +139,8 @@ bool updateConfigFromJSON(String json) {
   if (doc.containsKey("enableLogging")) config.enableLogging = doc["enableLogging"];
   if (doc.containsKey("webUsername")) config.webUsername = doc["webUsername"].as<String>();
   if (doc.containsKey("webPassword")) config.webPassword = doc["webPassword"].as<String>();
+  if (doc.containsKey("doseCatchUp")) config.doseCatchUp = doseCatchUpFromName(doc["doseCatchUp"]);
+  if (doc.containsKey("doseCatchUpMinutes")) config.doseCatchUpMinutes = doc["doseCatchUpMinutes"];
 
   bool saved = saveConfigToLittleFS();
 
@@ -129,6 +156,83 @@ bool updateConfigFromJSON(String json) {
   return saved;
 }
 
+// ==================================================
+// LOG EXPORT
+// ==================================================
+// Parse the /api/logs query string. Sends a 400 and returns false on a
+// bad parameter.
+static bool parseLogQuery(AsyncWebServerRequest *request, LogQuery &query) {
+  query.from = 0;
+  query.to = 0xFFFFFFFF;
+  query.channel = 0;
+  query.step = 0;
+  query.format = LOG_FORMAT_CSV;
+
+  const char *error = NULL;
+  if (request->hasParam("from") &&
+      !logQueryParseTime(request->getParam("from")->value().c_str(), query.from)) {
+    error = "Invalid from";
+  }
+  if (request->hasParam("to") &&
+      !logQueryParseTime(request->getParam("to")->value().c_str(), query.to)) {
+    error = "Invalid to";
+  }
+  if (request->hasParam("channel")) {
+    String channel = request->getParam("channel")->value();
+    query.channel = sensorLogChannelFromName(channel.c_str());
+    if (query.channel == 0) {
+      uint32_t number;
+      if (logQueryParseNumber(channel.c_str(), number) && number >= 1 && number <= SENSOR_CH_COUNT) {
+        query.channel = number;
+      } else {
+        error = "Invalid channel";
+      }
+    }
+  }
+  if (request->hasParam("step") &&
+      !logQueryParseNumber(request->getParam("step")->value().c_str(), query.step)) {
+    error = "Invalid step";
+  }
+  if (request->hasParam("format") &&
+      !logQueryFormatFromName(request->getParam("format")->value().c_str(), query.format)) {
+    error = "Invalid format";
+  }
+  if (!error && query.from > query.to) error = "from is after to";
+
+  if (error) {
+    char body[80];
+    snprintf(body, sizeof(body), "{\"success\":false,\"message\":\"%s\"}", error);
+    request->send(400, "application/json", body);
+    return false;
+  }
+  return true;
+}
+
+// Stream the records of the query a chunk at a time; the stream holds
+// one formatted record and one window of rollups, whatever the range
+static void sendLogQuery(AsyncWebServerRequest *request) {
+  LogQuery query;
+  if (!parseLogQuery(request, query)) return;
+
+  std::shared_ptr<LogQueryStream> stream = std::make_shared<LogQueryStream>(query);
+  if (!stream->hasRecords()) {
+    request->send(404, "text/plain", "No log file found");
+    return;
+  }
+
+  AsyncWebServerResponse *response = request->beginChunkedResponse(logQueryContentType(query.format),
+    [stream](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+      return stream->read(buffer, maxLen);
+    });
+
+  static const char *const extensions[] = { "csv", "json", "bin" };
+  char disposition[64];
+  snprintf(disposition, sizeof(disposition), "attachment; filename=\"sensor_log_%s.%s\"",
+           sensorLogSeriesName(stream->series()), extensions[query.format]);
+  response->addHeader("Content-Disposition", disposition);
+  request->send(response);
+}
+
 void setupWebServer() {
   // WebSocket handler
   ws.onEvent(onWebSocketEvent);
@@ -167,6 +271,7 @@ void setupWebServer() {
     if (index + len == total) {
       // Last chunk - process the data
       if (updateConfigFromJSON(body)) {
+        displayNotify("Config saved (web)", GREEN);
         request->send(200, "application/json", "{\"success\":true,\"message\":\"Configuration saved\"}");
       } else {
         request->send(400, "application/json", "{\"success\":false,\"message\":\"Failed to save configuration\"}");
@@ -174,16 +279,12 @@ void setupWebServer() {
     }
   });
 
-  // API: Download logs
+  // API: Query logs (?from=&to=&channel=&step=&format=csv|json|bin)
   server.on("/api/logs", HTTP_GET, [](AsyncWebServerRequest *request) {
     if (!authenticate(request)) {
       return request->requestAuthentication();
     }
-    if (LittleFS.exists(LOG_FILE)) {
-      request->send(LittleFS, LOG_FILE, "text/csv", true);
-    } else {
-      request->send(404, "text/plain", "No log file found");
-    }
+    sendLogQuery(request);
   });
 
   // API: Clear logs
@@ -191,9 +292,16 @@ void setupWebServer() {
     if (!authenticate(request)) {
       return request->requestAuthentication();
     }
-    if (LittleFS.exists(LOG_FILE)) {
-      LittleFS.remove(LOG_FILE);
-      request->send(200, "application/json", "{\"success\":true,\"message\":\"Logs cleared\"}");
+    bool any = false;
+    for (uint8_t s = 0; s < SENSOR_SERIES_COUNT; s++) {
+      uint32_t firstSeq, lastSeq;
+      sensorLogRing((SensorLogSeries)s).span(firstSeq, lastSeq);
+      if (lastSeq != 0) any = true;
+    }
+    if (any) {
+      // The rings are appended to by loop(), so it does the clearing
+      requestTelemetryClear();
+      request->send(200, "application/json", "{\"success\":true,\"message\":\"Clearing logs\"}");
     } else {
       request->send(404, "application/json", "{\"success\":false,\"message\":\"No log file found\"}");
     }
@@ -205,6 +313,7 @@ void setupWebServer() {
       return request->requestAuthentication();
     }
     request->send(200, "application/json", "{\"success\":true,\"message\":\"Rebooting...\"}");
+    flushPersistence();
     delay(1000);
     ESP.restart();
   });
@@ -217,6 +326,7 @@ void setupWebServer() {
     if (wifiConnected) {
       resetNTPSync();
       startNTPSync();
+      displayNotify("NTP sync (web)", CYAN);
       request->send(200, "application/json", "{\"success\":true,\"message\":\"NTP sync initiated\"}");
     } else {
       request->send(400, "application/json", "{\"success\":false,\"message\":\"WiFi not connected\"}");
@@ -231,6 +341,37 @@ void setupWebServer() {
     request->send(200, "application/json", getHardwareJSON());
   });
 
+  // API: Replace solution progress
+  server.on("/api/replace", HTTP_GET, [](AsyncWebServerRequest *request) {
+    if (!authenticate(request)) {
+      return request->requestAuthentication();
+    }
+    request->send(200, "application/json", getReplaceJSON());
+  });
+
+  // API: Start or abort a replace cycle
+  server.on("/api/replace", HTTP_POST, [](AsyncWebServerRequest *request) {
+    if (!authenticate(request)) {
+      return request->requestAuthentication();
+    }
+
+    if (request->hasParam("action", true)) {
+      String action = request->getParam("action", true)->value();
+      if (action == "start") {
+        requestReplaceStart();
+        displayNotify("Replace start (web)", CYAN);
+        request->send(200, "application/json", "{\"success\":true}");
+      } else if (action == "abort") {
+        requestReplaceAbort();
+        request->send(200, "application/json", "{\"success\":true}");
+      } else {
+        request->send(400, "application/json", "{\"success\":false,\"message\":\"Invalid action\"}");
+      }
+    } else {
+      request->send(400, "application/json", "{\"success\":false,\"message\":\"Missing parameters\"}");
+    }
+  });
+
   // API: Control relay
   server.on("/api/relay", HTTP_POST, [](AsyncWebServerRequest *request) {
     if (!authenticate(request)) {
@@ -244,6 +385,9 @@ void setupWebServer() {
 
       if (relay >= 1 && relay <= 4) {
         setRelay(relay, state);
+        char msg[DRAW_NOTIFY_TEXT_LEN + 1];
+        snprintf(msg, sizeof(msg), "Relay %d %s (web)", relay, state ? "ON" : "OFF");
+        displayNotify(msg, CYAN);
         request->send(200, "application/json", "{\"success\":true}");
       } else {
         request->send(400, "application/json", "{\"success\":false,\"message\":\"Invalid relay number\"}");
@@ -342,6 +486,7 @@ server.on("/api/wifi", HTTP_POST, [](AsyncWebServerRequest *request) {
                         : "";
 
     if (saveWiFiCredentials(ssid.c_str(), password.c_str())) {
+        displayNotify("WiFi saved, reboot", YELLOW, 5000);
         request->send(200, "application/json",
                       "{\"success\":true,\"message\":\"WiFi credentials saved. Rebooting...\"}");
         // optional: schedule a reboot (see Fix D)
@@ -71,9 +71,20 @@
 #include "DisplayUI.h"
 #include "WebPages.h"
 #include "WebServer.h"
-#include "SimpleWiFi.h"
+#include "SimpleWifi.h"
 #include "Tasks.h"
 #include "MenuRegistry.h"
+#include "OutletScheduler.h"
+#include "DosingQueue.h"
+#include "DosingEngine.h"
+#include "DoseJournal.h"
+#include "Calibration.h"
+#include "TopUp.h"
+#include "ReplaceSolution.h"
+#include "TimeService.h"
+#include "Persistence.h"
+#include "SensorLog.h"
+#include "Telemetry.h"
 #include <Arduino.h>
 #include <esp_task_wdt.h>
 #include <WiFi.h>
@@ -127,6 +138,7 @@ void IRAM_ATTR encoderISR() {
       encoderPosition--;
       pulseCounter = 0;
       lastEncoderTime = currentTime;
+      postDisplayEventFromISR(DISPLAY_EVT_ENCODER);
     }
   }
   else if (sum == 0b1110 || sum == 0b0111 || sum == 0b0001 || sum == 0b1000) {
@@ -135,6 +147,7 @@ void IRAM_ATTR encoderISR() {
       encoderPosition++;
       pulseCounter = 0;
       lastEncoderTime = currentTime;
+      postDisplayEventFromISR(DISPLAY_EVT_ENCODER);
     }
   }
 
@@ -151,13 +164,13 @@ void setDefaultConfig();
 bool loadConfigFromLittleFS();
 bool saveConfigToLittleFS();
 void loadSchedulesFromStorage();
-void saveSchedulesToStorage();
+bool saveSchedulesToStorage();
 void loadPumpCalibrationsFromStorage();
-void savePumpCalibrationsToStorage();
+bool savePumpCalibrationsToStorage();
 void loadTopUpConfigFromStorage();
-void saveTopUpConfigToStorage();
+bool saveTopUpConfigToStorage();
 void loadReplaceConfigFromStorage();
-void saveReplaceConfigToStorage();
+bool saveReplaceConfigToStorage();
 
 // --- WEB SERVER / JSON ---
 void setupWebServer();
@@ -196,11 +209,6 @@ bool getFloatSwitch(uint8_t level);
 void setLED(uint8_t led, bool state);
 void setWS2812B(uint8_t r, uint8_t g, uint8_t b);
 
-// --- SCHEDULE EXECUTION ---
-void checkDosingSchedules(unsigned long currentTime);
-void startDosing(uint8_t scheduleIndex, unsigned long currentTime);
-void updateDosingExecution(unsigned long currentTime);
-
 // --- MENU SYSTEM ---
 void handleMenuNavigation();
 void drawMenu();
@@ -234,11 +242,10 @@ void updateStatusBar();
 void SensorTask(void *parameter);
 
 // --- MISC ---
-void logSensorData();
 
 // Check if schedule should run today based on day bitmap
 bool isScheduleActiveToday(uint8_t daysBitmap) {
-  DateTime now = rtc.now();
+  DateTime now = timeNow();
   uint8_t todayIndex = now.dayOfTheWeek(); // 0=Sun, 1=Mon, etc.
   return isDayEnabled(daysBitmap, todayIndex);
 }
@@ -263,6 +270,7 @@ void initMenuSystem() {
     pumpCalibrations[i].pwmSpeed = 50;
     pumpCalibrations[i].timeMs = 1000;
     pumpCalibrations[i].mlPerSecond = 1.0;
+    pumpCalibrations[i].pointCount = 0;
   }
 
   // Initialize configs
@@ -271,6 +279,7 @@ void initMenuSystem() {
   topUpConfig.pump3ML = 0;
   topUpConfig.pump4ML = 0;
   topUpConfig.fillPumpRelay = 1;
+  topUpConfig.enabled = false;
 
   replaceConfig.pump1ML = 0;
   replaceConfig.pump2ML = 0;
@@ -278,6 +287,9 @@ void initMenuSystem() {
   replaceConfig.pump4ML = 0;
   replaceConfig.drainRelay = 1;
   replaceConfig.fillRelay = 2;
+  replaceConfig.scheduleDay = 0;
+  replaceConfig.scheduleHour = 10;
+  replaceConfig.enabled = false;
 
   // Load from storage
   loadSchedulesFromStorage();
@@ -306,8 +318,6 @@ void resetToMainScreen() {
   menuNav.editingHour = true;
   menuNav.daySelectIndex = 0;
   menuNav.needsRedraw = true;
-  menuNav.needsFullRedraw = true;
-  menuNav.lastDrawnIndex = -1;
   menuNav.tempIndex = -1;
 
   noInterrupts();
@@ -323,8 +333,6 @@ void navigateToMenu(MenuState menu, int selectedIndex = 0) {
   menuNav.selectedIndex = selectedIndex;
   menuNav.scrollOffset = 0;
   menuNav.needsRedraw = true;
-  menuNav.needsFullRedraw = true;
-  menuNav.lastDrawnIndex = -1;
   menuNav.lastActivity = millis();
   
   // RESET ENCODER ATOMICALLY - prevents encoder position carryover between menus
@@ -391,9 +399,6 @@ static void defaultMenuNav(const MenuDef& m) {
 }
 
 
-// Legacy selection switch (we'll keep it for menus not migrated)
-static void handleMenuSelectionLegacy();
-
 // New master navigation dispatcher
 void handleMenuNavigation() {
   // Preserve your activity + redraw trigger
@@ -413,7 +418,7 @@ void handleMenuNavigation() {
     hardware.encoderButton = false;
     menuNav.lastActivity = millis();
     handleMenuSelection();
-    menuNav.needsFullRedraw = true;
+    menuNav.needsRedraw = true;
   }
 }
 
@@ -433,10 +438,10 @@ void handleMainMenu() {
   // Handle scrolling
   if (menuNav.selectedIndex < menuNav.scrollOffset) {
     menuNav.scrollOffset = menuNav.selectedIndex;
-    menuNav.needsFullRedraw = true;
+    menuNav.needsRedraw = true;
   } else if (menuNav.selectedIndex >= menuNav.scrollOffset + MENU_ITEMS_PER_PAGE) {
     menuNav.scrollOffset = menuNav.selectedIndex - MENU_ITEMS_PER_PAGE + 1;
-    menuNav.needsFullRedraw = true;
+    menuNav.needsRedraw = true;
   }
 }
 
@@ -454,35 +459,25 @@ void handleDosingScheduleMenu() {
   //menuNav.selectedIndex = hardware.encoderPosition;
 }
 
-// Dosing View Menu Handler (page-based navigation)
+// Dosing View Menu Handler (paged list, see PagedList)
 void handleDosingViewMenu() {
-  // Calculate total pages (6 schedules per page, max 4 pages)
-  const int SCHEDULES_PER_PAGE = 6;
-  int totalPages = (dosingScheduleCount + SCHEDULES_PER_PAGE - 1) / SCHEDULES_PER_PAGE;
-  if (totalPages > 4) totalPages = 4;  // Limit to 4 pages max
-  if (totalPages == 0) totalPages = 1;  // At least 1 page (for "no schedules" message)
-  
-  const int maxPage = totalPages - 1;
-  
-  // Clamp page to valid range
-  noInterrupts();
-  if (encoderPosition < 0) encoderPosition = 0;
-  if (encoderPosition > maxPage) encoderPosition = maxPage;
-  menuNav.currentPage = encoderPosition;
-  menuNav.selectedIndex = menuNav.currentPage;  // keep selection in sync
-  interrupts();
-  
-  // Trigger full redraw if page changed
-  static int lastPage = -1;
-  if (lastPage != menuNav.currentPage) {
-    menuNav.needsFullRedraw = true;
-    lastPage = menuNav.currentPage;
-  }
+  clampEncoderPosition(0, max(0, dosingScheduleCount - 1));
 }
 
 // Dosing Add Menu Handler (unified editor with inline editing)
+// Interval choices for the dosing editor; 0 = once a day at the set time
+static const uint16_t DOSING_INTERVAL_STEPS[] = { 0, 15, 30, 45, 60, 90, 120, 180, 240, 360, 480, 720 };
+static const int DOSING_INTERVAL_STEP_COUNT = sizeof(DOSING_INTERVAL_STEPS) / sizeof(DOSING_INTERVAL_STEPS[0]);
+
+static int dosingIntervalStep(uint16_t minutes) {
+  for (int i = DOSING_INTERVAL_STEP_COUNT - 1; i > 0; i--) {
+    if (minutes >= DOSING_INTERVAL_STEPS[i]) return i;
+  }
+  return 0;
+}
+
 void handleDosingAddMenu() {
-  const int maxIndex = 5;  // 0-5: Pump, Days, Time, Amount, Save, Cancel
+  const int maxIndex = 6;  // 0-6: Pump, Days, Time, Every, Amount, Save, Cancel
 
   // ---- Normal navigation mode ----
   if (!menuNav.inEditMode) {
@@ -527,7 +522,14 @@ void handleDosingAddMenu() {
         tempDosingSchedule.minute = (uint8_t)m;
       }
     }
-    else if (menuNav.selectedIndex == 3) {  // Amount field
+    else if (menuNav.selectedIndex == 3) {  // Interval field
+      int step = dosingIntervalStep(tempDosingSchedule.intervalMinutes) + delta;
+      while (step < 0) step += DOSING_INTERVAL_STEP_COUNT;
+      while (step >= DOSING_INTERVAL_STEP_COUNT) step -= DOSING_INTERVAL_STEP_COUNT;
+      tempDosingSchedule.intervalMinutes = DOSING_INTERVAL_STEPS[step];
+      tempDosingSchedule.isInterval = tempDosingSchedule.intervalMinutes > 0;
+    }
+    else if (menuNav.selectedIndex == 4) {  // Amount field
     int newAmt = (int)tempDosingSchedule.amountML + (delta * 1); // tenths
 
     if (newAmt < 0) newAmt = 5000;
@@ -636,7 +638,7 @@ void handleOutletAddMenu() {
   }
 }
 
-// Dosing Delete Menu Handler (page-based with item selection)
+// Dosing Delete Menu Handler (paged list with item selection)
 void handleDosingDeleteMenu() {
   if (dosingScheduleCount == 0) {
     // No schedules to delete - just stay at position 0
@@ -650,18 +652,6 @@ void handleDosingDeleteMenu() {
   // Index dosingScheduleCount = "Return to Menu"
   const int maxIndex = dosingScheduleCount;  // Include return option
   clampEncoderPosition(0, maxIndex);
-  
-  // Calculate which page the selected item is on
-  const int SCHEDULES_PER_PAGE = 6;
-  int newPage = menuNav.selectedIndex / SCHEDULES_PER_PAGE;
-  
-  // Trigger full redraw if page changed
-  static int lastPage = -1;
-  if (lastPage != newPage) {
-    menuNav.currentPage = newPage;
-    menuNav.needsFullRedraw = true;
-    lastPage = newPage;
-  }
 }
 
 // Day Selection Menu Handler
@@ -689,27 +679,7 @@ void handleOutletScheduleMenu() {
 }
 
 void handleOutletViewMenu() {
-  const int SCHEDULES_PER_PAGE = 6;
-  int totalPages = (outletScheduleCount + SCHEDULES_PER_PAGE - 1) / SCHEDULES_PER_PAGE;
-  if (totalPages > 4) totalPages = 4;
-  if (totalPages == 0) totalPages = 1;
-
-  const int maxPage = totalPages - 1;
-
-  noInterrupts();
-  if (encoderPosition < 0) encoderPosition = 0;
-  if (encoderPosition > maxPage) encoderPosition = maxPage;
-
-  menuNav.currentPage = encoderPosition;
-  menuNav.selectedIndex = menuNav.currentPage;   // ✅ CRITICAL parity line
-
-  interrupts();
-
-  static int lastPage = -1;
-  if (lastPage != menuNav.currentPage) {
-    menuNav.needsFullRedraw = true;
-    lastPage = menuNav.currentPage;
-  }
+  clampEncoderPosition(0, max(0, outletScheduleCount - 1));
 }
 // Outlet Delete Menu Handler (page-based with item selection)
 // void handleOutletDeleteMenu() {
@@ -734,9 +704,7 @@ void handleOutletViewMenu() {
 
 //   if (newPage != menuNav.currentPage) {
 //     menuNav.currentPage     = newPage;
-//     menuNav.needsFullRedraw = true;
 //     menuNav.needsRedraw     = true;
-//     menuNav.lastDrawnIndex  = -1;
 //   } else {
 //     menuNav.needsRedraw = true;
 //   }
@@ -752,7 +720,6 @@ void handleOutletDeleteMenu() {
     menuNav.selectedIndex  = 0;
     menuNav.currentPage    = 0;
     menuNav.needsRedraw    = true;
-    menuNav.needsFullRedraw= true;
     return;
   }
 
@@ -761,18 +728,7 @@ void handleOutletDeleteMenu() {
   const int maxIndex = outletScheduleCount;
 
   clampEncoderPosition(0, maxIndex);   // updates encoderPosition and selectedIndex
-
-  const int SCHEDULES_PER_PAGE = 6;    // must match drawOutletScheduleListScreen()
-  int newPage = menuNav.selectedIndex / SCHEDULES_PER_PAGE;
-
-  if (newPage != menuNav.currentPage) {
-    menuNav.currentPage     = newPage;
-    menuNav.needsFullRedraw = true;
-    menuNav.needsRedraw     = true;
-    menuNav.lastDrawnIndex  = -1;
-  } else {
-    menuNav.needsRedraw = true;
-  }
+  menuNav.needsRedraw = true;          // PagedList sends only the rows that changed
 }
 
 // Pump Calibration Menu Handler
@@ -789,16 +745,33 @@ void handleCalibrateMenu() {
   //menuNav.selectedIndex = hardware.encoderPosition;
 }
 
+// Calibration run screen: Run/Cancel while ready, volume entry after a run
+void handleCalibrationRunMenu() {
+  CalibrationState state = getCalibrationStatus().state;
+
+  if (state == CAL_MEASURE) {
+    // Use menuNav.editValue as "last encoder position"
+    int delta = encoderPosition - menuNav.editValue;
+    if (delta != 0) {
+      adjustCalibrationVolume(delta);
+      menuNav.needsRedraw = true;
+    }
+  } else {
+    clampEncoderPosition(0, state == CAL_READY ? 1 : 0);
+  }
+  menuNav.editValue = encoderPosition;
+}
+
 // Top-Up Menu Handler
 void handleTopUpMenu() {
-  const int maxIndex = topupMenuCount - 1;  // 0-2
+  const int maxIndex = topupMenuCount - 1;  // 0-3
   clampEncoderPosition(0, maxIndex);
   //menuNav.selectedIndex = hardware.encoderPosition;
 }
 
 // Replace Solution Menu Handler
 void handleReplaceSolutionMenu() {
-  const int maxIndex = replaceMenuCount - 1;  // 0-4
+  const int maxIndex = replaceMenuCount - 1;  // 0-7
   clampEncoderPosition(0, maxIndex);
   //menuNav.selectedIndex = hardware.encoderPosition;
 }
@@ -810,41 +783,54 @@ void handleConfirmMenu() {
   //menuNav.selectedIndex = hardware.encoderPosition;
 }
 
-void selectMainMenu() {
-  switch (menuNav.selectedIndex) {
-    case 0: navigateToMenu(MENU_SCHEDULING); break;
-    case 1: navigateToMenu(MENU_MANUAL_DOSING); break;
-    case 2: navigateToMenu(MENU_PUMP_CALIBRATION); break;
-    case 3: navigateToMenu(MENU_TOPUP_SOLUTION); break;
-    case 4: navigateToMenu(MENU_REPLACE_SOLUTION); break;
-    case 5: navigateToMenu(MENU_RESET_WIFI_CONFIRM); break;
-    case 6: navigateToMenu(MENU_FACTORY_RESET_CONFIRM); break;
+// Menu edits are saved behind the UI's back (PersistTask); only a failed
+// write is worth telling the user about
+static void onMenuSaved(uint32_t section, bool ok) {
+  if (ok) return;
+  Serial.print("[PERSIST] Save failed, section 0x");
+  Serial.println(section, HEX);
+  displayNotify("SAVE FAILED", RED, 5000);
+}
+
+// Table dispatch for navigation menus: item i opens targets[i]
+static void selectMenuTarget(const MenuDef& m) {
+  int i = menuNav.selectedIndex;
+  if (i < 0 || i >= m.itemCount) return;
+  if (m.targets[i] != MENU_NONE) navigateToMenu(m.targets[i]);
+}
+
+void selectDosingScheduleMenu() {
+  if (menuNav.selectedIndex == 1) {   // Add Schedule: seed the editor
+    tempDosingSchedule.pumpNumber = 1;
+    tempDosingSchedule.hour = 8;
+    tempDosingSchedule.minute = 0;
+    tempDosingSchedule.amountML = 10;
+    tempDosingSchedule.isInterval = false;
+    tempDosingSchedule.intervalMinutes = 0;
+    menuNav.tempDaysBitmap = 0;
   }
+  selectMenuTarget(MENUS[MENU_DOSING_SCHEDULE]);
 }
 
-void selectSchedulingMenu() {
-  switch (menuNav.selectedIndex) {
-    case 0: navigateToMenu(MENU_DOSING_SCHEDULE); break;
-    case 1: navigateToMenu(MENU_OUTLET_SCHEDULE); break;
-    case 2: navigateToMenu(MENU_MAIN); break;
+void selectTopUpMenu() {
+  if (menuNav.selectedIndex == 2) {   // Auto Top-up: toggle
+    topUpConfig.enabled = !topUpConfig.enabled;
+    persistSections(PERSIST_TOPUP, onMenuSaved);
+    postTopUpEvent(TOPUP_EVT_CONFIG);
+    displayNotify(topUpConfig.enabled ? "Auto top-up ON" : "Auto top-up OFF", GREEN);
+    return;
   }
+  selectMenuTarget(MENUS[MENU_TOPUP_SOLUTION]);
 }
 
-void selectDosingScheduleMenu() {
-  switch (menuNav.selectedIndex) {
-    case 0: navigateToMenu(MENU_DOSING_VIEW); break;
-    case 1:
-      tempDosingSchedule.pumpNumber = 1;
-      tempDosingSchedule.hour = 8;
-      tempDosingSchedule.minute = 0;
-      tempDosingSchedule.amountML = 10;
-      menuNav.tempDaysBitmap = 0;
-      navigateToMenu(MENU_DOSING_ADD, 0);
-      break;
-    case 2: navigateToMenu(MENU_DOSING_DELETE); break;
-    case 3: navigateToMenu(MENU_DOSING_DELETE_ALL); break;
-    case 4: navigateToMenu(MENU_SCHEDULING); break;
+void selectReplaceMenu() {
+  if (menuNav.selectedIndex == 4) {   // Auto Replace: toggle
+    replaceConfig.enabled = !replaceConfig.enabled;
+    persistSections(PERSIST_REPLACE, onMenuSaved);
+    displayNotify(replaceConfig.enabled ? "Auto replace ON" : "Auto replace OFF", GREEN);
+    return;
   }
+  selectMenuTarget(MENUS[MENU_REPLACE_SOLUTION]);
 }
 
 void selectDosingViewMenu() {
@@ -858,10 +844,6 @@ void selectDosingViewMenu() {
 //   navigateToMenu(MENU_DOSING_ADD, 1);  // 1 = Days row in unified editor
 // }
 
-// For now these just fall through to legacy flows later,
-// but we register them as selectFns to prove the pattern.
-void selectManualDosingMenu()        { /* keep legacy for now */ }
-
 void selectOutletViewMenu() {
   navigateToMenu(MENU_OUTLET_SCHEDULE);
 }
@@ -880,31 +862,6 @@ void selectOutletAddSelectDaysMenu() {
   }
 }
 
-void selectOutletScheduleMenu() {
-  switch (menuNav.selectedIndex) {
-    case 0: // View Schedules
-      navigateToMenu(MENU_OUTLET_VIEW, 0);
-      break;
-
-    case 1: // Add Schedule
-      navigateToMenu(MENU_OUTLET_ADD, 0);
-      break;
-
-    case 2: // Delete Schedule
-      // Go directly to the delete list menu
-      navigateToMenu(MENU_OUTLET_DELETE_SELECT, 0);
-      break;
-
-    case 3: // Delete All
-      navigateToMenu(MENU_OUTLET_DELETE_ALL, 0);
-      break;
-
-    case 4: // Back
-      navigateToMenu(MENU_SCHEDULING);
-      break;
-  }
-}
-
 void selectOutletAddMenu() {
   switch(menuNav.selectedIndex) {
 
@@ -1053,7 +1010,7 @@ void selectOutletAddMenu() {
 
       outletSchedules[outletScheduleCount++] = tempOutletSchedule;
 
-      saveSchedulesToStorage();
+      persistOutletSchedule(outletScheduleCount - 1, onMenuSaved);
     //  saveOutletSchedulesToFile();   // single truth for outlet
       showSplash("SAVED!");
 
@@ -1102,7 +1059,7 @@ void selectOutletAddConfirmMenu() {
         case 0:
             // Save outlet schedule to storage
             outletSchedules[outletScheduleCount++] = tempOutletSchedule;
-            saveSchedulesToStorage();
+            persistOutletSchedule(outletScheduleCount - 1, onMenuSaved);
 //            saveOutletSchedulesToFile();
             navigateToMenu(MENU_OUTLET_SCHEDULE);
             break;
@@ -1142,7 +1099,7 @@ void selectOutletDeleteConfirmMenu() {
     }
 
     outletScheduleCount--;
-    saveSchedulesToStorage();    
+    persistSections(PERSIST_SCHEDULES, onMenuSaved);
 //    saveOutletSchedulesToFile();
   }
 
@@ -1160,7 +1117,7 @@ void selectOutletDeleteAllConfirmMenu() {
     switch (menuNav.selectedIndex) {
         case 0:
             outletScheduleCount = 0;
-            saveSchedulesToStorage();
+            persistSections(PERSIST_SCHEDULES, onMenuSaved);
             navigateToMenu(MENU_OUTLET_SCHEDULE);
             break;
         case 1:
@@ -1169,486 +1126,398 @@ void selectOutletDeleteAllConfirmMenu() {
     }
 }
 
-void selectPumpCalibrationMenu()     { /* keep legacy for now */ }
-void selectTopUpMenu()              { /* keep legacy for now */ }
-void selectReplaceMenu()            { /* keep legacy for now */ }
-
-void handleMenuSelection() {
-  const MenuDef& m = MENUS[menuNav.currentMenu];
-  if (m.selectFn) m.selectFn();
-  else handleMenuSelectionLegacy();
-}
-static void handleMenuSelectionLegacy() {
-  switch (menuNav.currentMenu) {
-    case MENU_MAIN:
-      switch (menuNav.selectedIndex) {
-        case 0: navigateToMenu(MENU_SCHEDULING); break;
-        case 1: navigateToMenu(MENU_MANUAL_DOSING); break;
-        case 2: navigateToMenu(MENU_PUMP_CALIBRATION); break;
-        case 3: navigateToMenu(MENU_TOPUP_SOLUTION); break;
-        case 4: navigateToMenu(MENU_REPLACE_SOLUTION); break;
-        case 5: navigateToMenu(MENU_RESET_WIFI_CONFIRM); break;
-        case 6: navigateToMenu(MENU_FACTORY_RESET_CONFIRM); break;
-      }
-      break;
+// DOSING DELETE ALL - Yes/No dialog
+void selectDosingDeleteAllMenu() {
+  if (menuNav.selectedIndex == 0) { // Yes
+    // Delete all dosing schedules
+    for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
+      dosingSchedules[i].enabled = false;
+    }
+    dosingScheduleCount = 0;
+    persistSections(PERSIST_SCHEDULES, onMenuSaved);
+  }
+  navigateToMenu(MENU_DOSING_SCHEDULE);
+}
 
-    case MENU_SCHEDULING:
-      switch (menuNav.selectedIndex) {
-        case 0: navigateToMenu(MENU_DOSING_SCHEDULE); break;
-        case 1: navigateToMenu(MENU_OUTLET_SCHEDULE); break;
-        case 2: navigateToMenu(MENU_MAIN); break;
-      }
-      break;
+// DOSING DELETE - Select schedule to delete
+void selectDosingDeleteMenu() {
+  if (dosingScheduleCount == 0) {
+    // No schedules, go back
+    navigateToMenu(MENU_DOSING_SCHEDULE);
+  } else if (menuNav.selectedIndex == dosingScheduleCount) {
+    // Selected "Return to Menu" option
+    navigateToMenu(MENU_DOSING_SCHEDULE);
+  } else {
+    // Store selected schedule index for deletion
+    menuNav.tempPumpNumber = menuNav.selectedIndex;
+    // Open confirmation dialog for selected schedule
+    navigateToMenu(MENU_DOSING_DELETE_CONFIRM, 1);  // Start at "No" (safer default)
+  }
+}
 
-    case MENU_DOSING_SCHEDULE:
-      switch (menuNav.selectedIndex) {
-        case 0: navigateToMenu(MENU_DOSING_VIEW); break;
-        case 1:
-          tempDosingSchedule.pumpNumber = 1;
-          tempDosingSchedule.hour = 8;
-          tempDosingSchedule.minute = 0;
-          tempDosingSchedule.amountML = 10;
-          menuNav.tempDaysBitmap = 0;
-          navigateToMenu(MENU_DOSING_ADD, 0);
-          break;
-        case 2: navigateToMenu(MENU_DOSING_DELETE); break;
-        case 3: navigateToMenu(MENU_DOSING_DELETE_ALL); break;
-        case 4: navigateToMenu(MENU_SCHEDULING); break;
-      }
-      break;
+// DOSING DELETE CONFIRM - Yes/No dialog
+void selectDosingDeleteConfirmMenu() {
+  if (menuNav.selectedIndex == 0) { // Yes - Delete
+    int deleteIdx = menuNav.tempPumpNumber;  // We'll store the selected schedule index here
 
-    // DOSING VIEW - View saved schedules (button goes back)
-    case MENU_DOSING_VIEW:
-      // Button press goes back to menu
-      navigateToMenu(MENU_DOSING_SCHEDULE);
-      break;
+    // Shift all schedules after this one down
+    for (int i = deleteIdx; i < dosingScheduleCount - 1; i++) {
+      dosingSchedules[i] = dosingSchedules[i + 1];
+    }
 
-    case MENU_OUTLET_VIEW:
-      // Button press exits back to Outlet Schedule menu
-      navigateToMenu(MENU_OUTLET_SCHEDULE);
-      break;
+    // Clear the last schedule
+    dosingSchedules[dosingScheduleCount - 1].enabled = false;
+    dosingScheduleCount--;
+
+    // Save to storage
+    persistSections(PERSIST_SCHEDULES, onMenuSaved);
+
+    // Show success message
+    canvas.fillScreen(BLACK);
+    canvas.setTextSize(1);
+    canvas.setCursor(20, 50);
+    canvas.setTextColor(GREEN);
+    canvas.print("DELETED!");
+    canvas.flush();
+    delay(1000);
+
+    navigateToMenu(MENU_DOSING_SCHEDULE);
+  } else { // No - Cancel
+    navigateToMenu(MENU_DOSING_DELETE, menuNav.tempPumpNumber);  // Return to delete list at same position
+  }
+}
 
-    case MENU_DOSING_DELETE_ALL:
-      if (menuNav.selectedIndex == 0) { // Yes
-        // Delete all dosing schedules
-        for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
-          dosingSchedules[i].enabled = false;
-        }
-        dosingScheduleCount = 0;
-        saveSchedulesToStorage();
-      }
-      navigateToMenu(MENU_DOSING_SCHEDULE);
-      break;
+// DOSING ADD - Unified Editor
+void selectDosingAddMenu() {
+  switch (menuNav.selectedIndex) {
+    case 0: // Pump (inline edit)
+      if (!menuNav.inEditMode) {
+        // ENTER edit
+        menuNav.inEditMode = true;
 
-    // DOSING DELETE - Select schedule to delete
-    case MENU_DOSING_DELETE:
-      if (dosingScheduleCount == 0) {
-        // No schedules, go back
-        navigateToMenu(MENU_DOSING_SCHEDULE);
-      } else if (menuNav.selectedIndex == dosingScheduleCount) {
-        // Selected "Return to Menu" option
-        navigateToMenu(MENU_DOSING_SCHEDULE);
+        noInterrupts();
+        encoderPosition = 0;
+        interrupts();
+        menuNav.editValue = 0;
       } else {
-        // Store selected schedule index for deletion
-        menuNav.tempPumpNumber = menuNav.selectedIndex;
-        // Open confirmation dialog for selected schedule
-        navigateToMenu(MENU_DOSING_DELETE_CONFIRM, 1);  // Start at "No" (safer default)
-      }
-      break;
+        // EXIT edit (confirm)
+        menuNav.inEditMode = false;
 
-    // DOSING DELETE CONFIRM - Yes/No dialog
-    case MENU_DOSING_DELETE_CONFIRM:
-      if (menuNav.selectedIndex == 0) { // Yes - Delete
-        int deleteIdx = menuNav.tempPumpNumber;  // We'll store the selected schedule index here
-        
-        // Shift all schedules after this one down
-        for (int i = deleteIdx; i < dosingScheduleCount - 1; i++) {
-          dosingSchedules[i] = dosingSchedules[i + 1];
-        }
-        
-        // Clear the last schedule
-        dosingSchedules[dosingScheduleCount - 1].enabled = false;
-        dosingScheduleCount--;
-        
-        // Save to storage
-        saveSchedulesToStorage();
-        
-        // Show success message
-        tft.fillScreen(BLACK);
-        tft.setTextSize(1);
-        tft.setCursor(20, 50);
-        tft.setTextColor(GREEN);
-        tft.print("DELETED!");
-        delay(1000);
-        
-        navigateToMenu(MENU_DOSING_SCHEDULE);
-      } else { // No - Cancel
-        navigateToMenu(MENU_DOSING_DELETE, menuNav.tempPumpNumber);  // Return to delete list at same position
+        noInterrupts();
+        encoderPosition = menuNav.selectedIndex; // restore highlight
+        interrupts();
+        menuNav.editValue = 0;
       }
-      break;
-
-    // DOSING ADD - Unified Editor
-    case MENU_DOSING_ADD:
-      switch (menuNav.selectedIndex) {
-        case 0: // Pump (inline edit)
-          if (!menuNav.inEditMode) {
-            // ENTER edit
-            menuNav.inEditMode = true;
-
-            noInterrupts();
-            encoderPosition = 0;
-            interrupts();
-            menuNav.editValue = 0;
-          } else {
-            // EXIT edit (confirm)
-            menuNav.inEditMode = false;
-
-            noInterrupts();
-            encoderPosition = menuNav.selectedIndex; // restore highlight
-            interrupts();
-            menuNav.editValue = 0;
-          }
 
-          menuNav.needsRedraw = true;
-          break;
-
-        case 1: // Days (inline edit Option A)
-          if (!menuNav.inEditMode) {
-            // ENTER days edit
-            menuNav.inEditMode = true;
-            menuNav.daySelectIndex = 0; // start at Sunday (change to 1 if you want Monday)
-
-            noInterrupts();
-            encoderPosition = 0;
-            interrupts();
-            menuNav.editValue = 0;
-          } 
-          else {
-            // Already editing days
-            if (menuNav.daySelectIndex == 7) {
-              // DONE -> EXIT edit
-              menuNav.inEditMode = false;
-
-              noInterrupts();
-              encoderPosition = menuNav.selectedIndex; // restore highlight to Days row
-              interrupts();
-              menuNav.editValue = 0;
-            } 
-            else {
-              // TOGGLE current day bit
-              uint8_t bit = (1 << menuNav.daySelectIndex);
-              menuNav.tempDaysBitmap ^= bit;
-              tempDosingSchedule.daysOfWeek = menuNav.tempDaysBitmap; // keep schedule synced
-            }
-          }
+      menuNav.needsRedraw = true;
+      break;
 
-          menuNav.needsRedraw = true;
-          break;
-
-        case 2: // Time - toggle editing hour/minute, or increment
-          // First click: start editing hour
-          // Second click: switch to minute
-          // Third click: done editing
-          if (!menuNav.inEditMode) {
-            menuNav.inEditMode = true;
-            menuNav.editingHour = true;
-          } else if (menuNav.editingHour) {
-            menuNav.editingHour = false;  // Switch to minute
-          } else {
-            menuNav.inEditMode = false;  // Done editing
-            menuNav.editingHour = true;  // Reset for next time
-          }
-          menuNav.needsRedraw = true;
-          break;
-        case 3: // Amount - toggle editing or increment
-          menuNav.inEditMode = !menuNav.inEditMode;
-          menuNav.needsRedraw = true;
-          break;
-        // case 4: // Save
-        //   {
-        //       // Validate
-        //       if (menuNav.tempDaysBitmap == 0) {
-        //           // Show error
-        //           tft.fillScreen(BLACK);
-        //           tft.setTextColor(RED);
-        //           tft.setTextSize(1);
-        //           tft.setCursor(10, 50);
-        //           tft.print("ERROR:SELECT DAYS!");
-        //           delay(2000);
-        //           menuNav.needsFullRedraw = true;
-        //           break;
-        //       }
-
-        //       if (dosingScheduleCount >= MAX_DOSING_SCHEDULES) {
-        //           // Array full error
-        //           tft.fillScreen(BLACK);
-        //           tft.setTextColor(RED);
-        //           tft.setTextSize(1);
-        //           tft.setCursor(10, 50);
-        //           tft.print("ERROR: LIST FULL!");
-        //           delay(2000);
-        //           menuNav.needsFullRedraw = true;
-        //           break;
-        //       }
-
-        //       // Save to array
-        //       tempDosingSchedule.daysOfWeek = menuNav.tempDaysBitmap;
-        //       tempDosingSchedule.enabled = true;
-        //       tempDosingSchedule.isInterval = false;
-        //       tempDosingSchedule.intervalMinutes = 0;
-
-        //       dosingSchedules[dosingScheduleCount] = tempDosingSchedule;
-        //       dosingScheduleCount++;
-
-        //       // Save to EEPROM (NOT JSON)
-        //       saveSchedulesToStorage();
-
-        //       // Show success
-        //       tft.fillScreen(BLACK);
-        //       tft.setTextSize(2);
-        //       tft.setCursor(20, 50);
-        //       tft.setTextColor(GREEN);
-        //       tft.print("SAVED!");
-        //       delay(1500);
-
-        //       menuNav.inEditMode = false;
-        //       navigateToMenu(MENU_DOSING_SCHEDULE);
-        //   }
-        //   break;  
-        case 4: // Save
-        {
-            // Validate
-            // if (menuNav.tempDaysBitmap == 0) {
-            //     // ✅ Go to a dedicated error screen that can be dismissed with a press
-            //     menuNav.inEditMode = false;
-            //     navigateToMenu(MENU_DOSING_ERROR_NO_DAYS);
-            //     break;
-            // }
-
-            if (menuNav.tempDaysBitmap == 0) {
-                showSplash("SELECT DAYS!");
-                break;
-            }
-
-            if (dosingScheduleCount >= MAX_DOSING_SCHEDULES) {
-                // Array full error (still uses a blocking splash)
-                tft.fillScreen(BLACK);
-                tft.setTextColor(RED);
-                tft.setTextSize(1);
-                tft.setCursor(10, 50);
-                tft.print("ERROR: LIST FULL!");
-                delay(2000);
-                menuNav.needsFullRedraw = true;
-                break;
-            }
-
-            // Normal save path...
-            tempDosingSchedule.daysOfWeek   = menuNav.tempDaysBitmap;
-            tempDosingSchedule.enabled      = true;
-            tempDosingSchedule.isInterval   = false;
-            tempDosingSchedule.intervalMinutes = 0;
-
-            dosingSchedules[dosingScheduleCount] = tempDosingSchedule;
-            dosingScheduleCount++;
-
-            saveSchedulesToStorage();
-
-            tft.fillScreen(BLACK);
-            tft.setTextSize(2);
-            tft.setCursor(20, 50);
-            tft.setTextColor(GREEN);
-            tft.print("SAVED!");
-            delay(1500);
-
-            menuNav.inEditMode = false;
-            navigateToMenu(MENU_DOSING_SCHEDULE);
-        }
-        break;
+    case 1: // Days (inline edit Option A)
+      if (!menuNav.inEditMode) {
+        // ENTER days edit
+        menuNav.inEditMode = true;
+        menuNav.daySelectIndex = 0; // start at Sunday (change to 1 if you want Monday)
 
-        case 5: // Cancel
-          menuNav.inEditMode = false;  // Exit edit mode
-          navigateToMenu(MENU_DOSING_SCHEDULE);
-          break;
+        noInterrupts();
+        encoderPosition = 0;
+        interrupts();
+        menuNav.editValue = 0;
       }
-      break;
-
-    // DOSING ADD - Day Selection
-    case MENU_DOSING_ADD_SELECT_DAYS:
-      {
-        int idx = menuNav.daySelectIndex;
+      else {
+        // Already editing days
+        if (menuNav.daySelectIndex == 7) {
+          // DONE -> EXIT edit
+          menuNav.inEditMode = false;
 
-        if (idx >= 0 && idx < 7) {
-          // Toggle day 0-6
-          toggleDay(menuNav.tempDaysBitmap, idx);
-          menuNav.needsRedraw = true;
-          // Don't set needsFullRedraw - partial update is enough
+          noInterrupts();
+          encoderPosition = menuNav.selectedIndex; // restore highlight to Days row
+          interrupts();
+          menuNav.editValue = 0;
         }
-        else if (idx == 7) {
-          // Done - return to unified editor on Days line
-          navigateToMenu(MENU_DOSING_ADD, 1);  // Line 1 = Days
+        else {
+          // TOGGLE current day bit
+          uint8_t bit = (1 << menuNav.daySelectIndex);
+          menuNav.tempDaysBitmap ^= bit;
+          tempDosingSchedule.daysOfWeek = menuNav.tempDaysBitmap; // keep schedule synced
         }
       }
+
+      menuNav.needsRedraw = true;
       break;
 
-    // DOSING ADD - Time Selection
-    case MENU_DOSING_ADD_SET_TIME:
-      // Toggle between editing hour and minute
-      if (menuNav.editingHour) {
+    case 2: // Time - toggle editing hour/minute, or increment
+      // First click: start editing hour
+      // Second click: switch to minute
+      // Third click: done editing
+      if (!menuNav.inEditMode) {
+        menuNav.inEditMode = true;
+        menuNav.editingHour = true;
+      } else if (menuNav.editingHour) {
         menuNav.editingHour = false;  // Switch to minute
-        menuNav.needsRedraw = true;
-        // Partial redraw - no flicker
       } else {
-        // Done with time, return to unified editor on Time line
+        menuNav.inEditMode = false;  // Done editing
         menuNav.editingHour = true;  // Reset for next time
-        navigateToMenu(MENU_DOSING_ADD, 2);  // Line 2 = Time
       }
+      menuNav.needsRedraw = true;
       break;
 
-    // DOSING ADD - Amount Selection
-    case MENU_DOSING_ADD_SET_AMOUNT:
-      // Done - return to unified editor on Amount line
-      navigateToMenu(MENU_DOSING_ADD, 3);  // Line 3 = Amount
+    case 3: // Every - toggle editing the interval
+      menuNav.inEditMode = !menuNav.inEditMode;
+      menuNav.editValue = encoderPosition;
+      menuNav.needsRedraw = true;
       break;
 
-    // MANUAL DOSING MENU
-    case MENU_MANUAL_DOSING:
-      switch (menuNav.selectedIndex) {
-        case 0: navigateToMenu(MENU_MANUAL_SELECT_PUMP); break;
-        case 1: navigateToMenu(MENU_MANUAL_SET_AMOUNT); break;
-          menuNav.needsFullRedraw = true;
-          break;
-        case 2: // Start Dosing
-          break;
-        case 3: // Cancel
-          menuNav.currentMenu = MENU_MAIN;
-          menuNav.selectedIndex = 0;
-          menuNav.scrollOffset = 0;
-          menuNav.needsFullRedraw = true;
-          break;
-      }
+    case 4: // Amount - toggle editing or increment
+      menuNav.inEditMode = !menuNav.inEditMode;
+      menuNav.needsRedraw = true;
       break;
 
-    // OUTLET SCHEDULE MENU
-    case MENU_OUTLET_SCHEDULE:
-      switch (menuNav.selectedIndex) {
-      //  case 0: navigateToMenu(MENU_OUTLET_VIEW);         break;
-        case 0: navigateToMenu(MENU_OUTLET_ADD);          break;
-        case 1: navigateToMenu(MENU_OUTLET_DELETE_SELECT);break;  // <-- FIXED
-        case 2: navigateToMenu(MENU_OUTLET_DELETE_ALL);   break;
-        case 3: navigateToMenu(MENU_SCHEDULING);          break;
-      }
-    break;
+    case 5: // Save
+    {
+        if (menuNav.tempDaysBitmap == 0) {
+            showSplash("SELECT DAYS!");
+            break;
+        }
 
-    case MENU_OUTLET_DELETE_ALL:
-      if (menuNav.selectedIndex == 0) { // Yes
-        // Clear all outlet schedules
-        for (int i = 0; i < MAX_OUTLET_SCHEDULES; i++) {
-          outletSchedules[i].enabled = false;
+        if (dosingScheduleCount >= MAX_DOSING_SCHEDULES) {
+            // Array full error (still uses a blocking splash)
+            canvas.fillScreen(BLACK);
+            canvas.setTextColor(RED);
+            canvas.setTextSize(1);
+            canvas.setCursor(10, 50);
+            canvas.print("ERROR: LIST FULL!");
+            canvas.flush();
+            delay(2000);
+            menuNav.needsRedraw = true;
+            break;
         }
-        // ✅ IMPORTANT: count must go to zero
-        outletScheduleCount = 0;
-        // Keep Preferences in sync (since boot still loads prefs)
-        saveSchedulesToStorage();
-      }
-      navigateToMenu(MENU_OUTLET_SCHEDULE);
-      break;
 
-    // PUMP CALIBRATION MENU
-    case MENU_PUMP_CALIBRATION:
-      menuNav.tempPumpNumber = menuNav.selectedIndex + 1; // Store pump number
-      switch (menuNav.selectedIndex) {
-        case 0: navigateToMenu(MENU_CALIBRATE_P1); break;
-        case 1: navigateToMenu(MENU_CALIBRATE_P2); break;
-        case 2: navigateToMenu(MENU_CALIBRATE_P3); break;
-          menuNav.tempPumpNumber = 3;
-          navigateToMenu(MENU_CALIBRATE_P3);
-          break;
-        case 3:
-          menuNav.tempPumpNumber = 4;
-          navigateToMenu(MENU_CALIBRATE_P4);
-          break;
-        case 4: navigateToMenu(MENU_MAIN); break; // Back
-      }
-      break;
+        // Normal save path...
+        tempDosingSchedule.daysOfWeek   = menuNav.tempDaysBitmap;
+        tempDosingSchedule.enabled      = true;
+        tempDosingSchedule.isInterval   = tempDosingSchedule.intervalMinutes > 0;
 
-    // Handle all calibration menus (P1-P4) similarly
-    case MENU_CALIBRATE_P1:
-    case MENU_CALIBRATE_P2:
-    case MENU_CALIBRATE_P3:
-    case MENU_CALIBRATE_P4:
-      if (menuNav.selectedIndex == 0) { // Start Calibration
-        menuNav.isCalibrating = true;
-        // TODO: Start calibration wizard
-      } else { // Cancel
-        navigateToMenu(MENU_PUMP_CALIBRATION);
-      }
-      break;
+        dosingSchedules[dosingScheduleCount] = tempDosingSchedule;
+        dosingScheduleCount++;
 
-    // TOP-UP SOLUTION MENU
-    case MENU_TOPUP_SOLUTION:
-      switch (menuNav.selectedIndex) {
-        case 0: navigateToMenu(MENU_TOPUP_SET_AMOUNTS); break;
-        case 1: navigateToMenu(MENU_TOPUP_SET_PUMP_PIN); break;
-        case 2: navigateToMenu(MENU_MAIN); break; // Back
-      }
-      break;
+        persistDosingSchedule(dosingScheduleCount - 1, onMenuSaved);
 
-    // REPLACE SOLUTION MENU
-    case MENU_REPLACE_SOLUTION:
-      switch (menuNav.selectedIndex) {
-        case 0: navigateToMenu(MENU_REPLACE_SET_AMOUNTS); break;
-        case 1: navigateToMenu(MENU_REPLACE_SET_DRAIN); break;
-        case 2: navigateToMenu(MENU_REPLACE_SET_FILL); break;
-        case 3: navigateToMenu(MENU_REPLACE_SET_SCHEDULE); break;
-        case 4: navigateToMenu(MENU_MAIN); break; // Back
-      }
-      break;
+        canvas.fillScreen(BLACK);
+        canvas.setTextSize(2);
+        canvas.setCursor(20, 50);
+        canvas.setTextColor(GREEN);
+        canvas.print("SAVED!");
+        canvas.flush();
+        delay(1500);
 
-    // RESET WIFI CONFIRM
-    case MENU_RESET_WIFI_CONFIRM:
-    if (menuNav.selectedIndex == 0) { // Yes
-        // Clear WiFi credentials from EEPROM
-        Preferences wifiPrefs;
-        wifiPrefs.begin("wifi", false);
-        wifiPrefs.clear();
-        wifiPrefs.end();
-        delay(1000);
-        ESP.restart();
-    } else { // No
-        navigateToMenu(MENU_MAIN);
-        menuNav.needsFullRedraw = true;
-      }
+        menuNav.inEditMode = false;
+        navigateToMenu(MENU_DOSING_SCHEDULE);
+    }
+    break;
+
+    case 6: // Cancel
+      menuNav.inEditMode = false;  // Exit edit mode
+      navigateToMenu(MENU_DOSING_SCHEDULE);
       break;
+  }
+}
+
+// DOSING ADD - Day Selection
+void selectDosingAddSelectDaysMenu() {
+  int idx = menuNav.daySelectIndex;
+
+  if (idx >= 0 && idx < 7) {
+    // Toggle day 0-6
+    toggleDay(menuNav.tempDaysBitmap, idx);
+    menuNav.needsRedraw = true;
+  }
+  else if (idx == 7) {
+    // Done - return to unified editor on Days line
+    navigateToMenu(MENU_DOSING_ADD, 1);  // Line 1 = Days
+  }
+}
+
+// DOSING ADD - Time Selection
+void selectDosingAddSetTimeMenu() {
+  // Toggle between editing hour and minute
+  if (menuNav.editingHour) {
+    menuNav.editingHour = false;  // Switch to minute
+    menuNav.needsRedraw = true;
+  } else {
+    // Done with time, return to unified editor on Time line
+    menuNav.editingHour = true;  // Reset for next time
+    navigateToMenu(MENU_DOSING_ADD, 2);  // Line 2 = Time
+  }
+}
+
+// DOSING ADD - Amount Selection
+void selectDosingAddSetAmountMenu() {
+  // Done - return to unified editor on Amount line
+  navigateToMenu(MENU_DOSING_ADD, 3);  // Line 3 = Amount
+}
+
+// PUMP CALIBRATION MENU
+void selectPumpCalibrationMenu() {
+  menuNav.tempPumpNumber = menuNav.selectedIndex + 1; // Store pump number
+  selectMenuTarget(MENUS[MENU_PUMP_CALIBRATION]);
+}
 
-    // FACTORY RESET CONFIRM
-    case MENU_FACTORY_RESET_CONFIRM:
-      if (menuNav.selectedIndex == 0) { // Yes
-        preferences.begin("schedules", false);
-        preferences.clear();
-        preferences.end();
-        preferences.begin("pumps", false);
-        preferences.clear();
-        preferences.end();
-        preferences.begin("topup", false);
-        preferences.clear();
-        preferences.end();
-        preferences.begin("replace", false);
-        preferences.clear();
-        preferences.end();
-        preferences.begin("config", false);
-        preferences.clear();
-        preferences.end();
-        //wm.resetSettings();
-        delay(1000);
-        ESP.restart();
-      } else { // No
-        navigateToMenu(MENU_MAIN);
+// Calibration screens per pump, indexed by pump - 1
+static const MenuState calibrateMenus[] = {
+  MENU_CALIBRATE_P1, MENU_CALIBRATE_P2, MENU_CALIBRATE_P3, MENU_CALIBRATE_P4 };
+static const MenuState calibrateRunMenus[] = {
+  MENU_CALIBRATE_P1_START, MENU_CALIBRATE_P2_START, MENU_CALIBRATE_P3_START, MENU_CALIBRATE_P4_START };
+static const MenuState calibrateSaveMenus[] = {
+  MENU_CALIBRATE_P1_CONFIRM, MENU_CALIBRATE_P2_CONFIRM, MENU_CALIBRATE_P3_CONFIRM, MENU_CALIBRATE_P4_CONFIRM };
+
+static uint8_t calibrationPumpIndex() {
+  return constrain(menuNav.tempPumpNumber, 1, 4) - 1;
+}
+
+// Calibration menus (P1-P4)
+void selectCalibrateMenu() {
+  if (menuNav.selectedIndex == 0) { // Start Calibration
+    requestPumpCalibration(menuNav.tempPumpNumber);
+    navigateToMenu(calibrateRunMenus[calibrationPumpIndex()]);
+    menuNav.editValue = 0;
+  } else { // Cancel
+    navigateToMenu(MENU_PUMP_CALIBRATION);
+  }
+}
+
+// CALIBRATION RUN - one press per step; the wizard itself runs in loop()
+void selectCalibrationRunMenu() {
+  CalibrationStatus cal = getCalibrationStatus();
+  if (cal.requestPending) return;
+
+  switch (cal.state) {
+    case CAL_READY:
+      if (menuNav.selectedIndex == 0) {   // Run
+        requestCalibrationStep();
+        break;
       }
+      requestCalibrationCancel();
+      navigateToMenu(calibrateMenus[calibrationPumpIndex()]);
+      return;
+    case CAL_RUNNING:                     // Press aborts the run
+      requestCalibrationCancel();
+      displayNotify("Calibration aborted", RED);
+      navigateToMenu(calibrateMenus[calibrationPumpIndex()]);
+      return;
+    case CAL_MEASURE:                     // Volume entered
+      requestCalibrationStep();
       break;
-    default:
-      // no-op
-      break;
+    case CAL_REVIEW:
+      navigateToMenu(calibrateSaveMenus[calibrationPumpIndex()]);
+      return;
+    default:                              // Failed
+      requestCalibrationCancel();
+      navigateToMenu(calibrateMenus[calibrationPumpIndex()]);
+      return;
+  }
+
+  // Same screen, next step: start again from the first item
+  navigateToMenu(menuNav.currentMenu);
+  menuNav.editValue = 0;
+}
+
+// CALIBRATION SAVE
+void selectCalibrationSaveMenu() {
+  if (menuNav.selectedIndex == 0) { // Save to EEPROM
+    requestCalibrationSave();
+    displayNotify("Calibration saved", GREEN);
+  } else { // Cancel
+    requestCalibrationCancel();
+    displayNotify("Calibration discarded");
   }
+  navigateToMenu(MENU_PUMP_CALIBRATION);
+}
+
+// Screens that show live progress repaint every second and do not time out
+void refreshLiveMenu(unsigned long currentTime) {
+  if (isPumpCalibrationActive()) {
+    menuNav.lastActivity = currentTime;
+    menuNav.needsRedraw = true;
+  } else if (menuNav.currentMenu == MENU_REPLACE_STATUS) {
+    // Progress screen stays up while a cycle runs
+    if (isReplaceActive()) menuNav.lastActivity = currentTime;
+    menuNav.needsRedraw = true;
+  }
+}
+
+// REPLACE CONFIRM
+void selectReplaceConfirmMenu() {
+  if (menuNav.selectedIndex == 0) { // Yes
+    requestReplaceStart();
+    navigateToMenu(MENU_REPLACE_STATUS);
+  } else { // No
+    navigateToMenu(MENU_REPLACE_SOLUTION);
+  }
+}
+
+// REPLACE STATUS: Back, or Abort while a cycle runs
+void handleReplaceStatusMenu() {
+  clampEncoderPosition(0, isReplaceActive() ? 1 : 0);
+}
+
+void selectReplaceStatusMenu() {
+  if (menuNav.selectedIndex == 1 && isReplaceActive()) {
+    requestReplaceAbort();
+    return;
+  }
+  navigateToMenu(MENU_REPLACE_SOLUTION);
+}
+
+// RESET WIFI CONFIRM
+void selectResetWifiConfirmMenu() {
+  if (menuNav.selectedIndex == 0) { // Yes
+    // Clear WiFi credentials from EEPROM
+    Preferences wifiPrefs;
+    wifiPrefs.begin("wifi", false);
+    wifiPrefs.clear();
+    wifiPrefs.end();
+    flushPersistence();
+    delay(1000);
+    ESP.restart();
+  } else { // No
+    navigateToMenu(MENU_MAIN);
+  }
+}
+
+// FACTORY RESET CONFIRM
+void selectFactoryResetConfirmMenu() {
+  if (menuNav.selectedIndex == 0) { // Yes
+    // Land pending saves first so none is written after the wipe
+    flushPersistence();
+    preferences.begin("schedules", false);
+    preferences.clear();
+    preferences.end();
+    preferences.begin("pumps", false);
+    preferences.clear();
+    preferences.end();
+    preferences.begin("topup", false);
+    preferences.clear();
+    preferences.end();
+    preferences.begin("replace", false);
+    preferences.clear();
+    preferences.end();
+    preferences.begin("config", false);
+    preferences.clear();
+    preferences.end();
+    //wm.resetSettings();
+    delay(1000);
+    ESP.restart();
+  } else { // No
+    navigateToMenu(MENU_MAIN);
+  }
+}
+
+// Button press: one table lookup decides what happens
+void handleMenuSelection() {
+  const MenuDef& m = MENUS[menuNav.currentMenu];
+  if (m.selectFn) m.selectFn();
+  else if (m.targets) selectMenuTarget(m);
+  else navigateToMenu(m.backMenu);
 }
 
 // ============================================
@@ -1688,6 +1557,9 @@ void setup() {
   SPI.begin(TFT_SCK, -1, TFT_MOSI, TFT_CS);
   tft.begin();
   tft.setRotation(1);
+  if (!tft.beginAsync(TFT_SCK, TFT_MOSI)) {
+    Serial.println("      TFT DMA unavailable, using blocking SPI");
+  }
   initDisplay();
 
   // DEBUG: Relay 2 - Display initialized
@@ -1722,6 +1594,7 @@ void setup() {
     if (rtc.lostPower()) {
     }
   }
+  initTimeService();
 
   // Load configuration from LittleFS
   if (!loadConfigFromLittleFS()) {
@@ -1792,11 +1665,17 @@ void setup() {
 
   // Initialize menu system
   initMenuSystem();
+
+  // Replay the dose journal now that schedules and RTC are up
+  initDoseJournal();
+  // Pick up a replace cycle cut off by the reboot (resumed from loop)
+  initReplaceSolution();
+  // Find the write position of the sensor ring log
+  initSensorLog();
   menuNav.lastActivity = millis();
-  menuNav.needsFullRedraw = true;
   menuNav.needsRedraw = true;
 
-  // Draw initial menu immediately
+  // Draw initial menu immediately; DisplayTask takes over once started
   drawMenu();
   
   // DEBUG: Relay 1 turns ON when menu is drawn
@@ -1806,6 +1685,7 @@ void setup() {
   
   // Feed watchdog before creating tasks
   esp_task_wdt_reset();
+  startTasks();
 
   // DEBUG: Relay 2 turns ON when all tasks are created
   setRelay(2, true);
@@ -1816,150 +1696,30 @@ void setup() {
   Serial.println("Entering main loop...\n");
 }
 
-// ============================================
-// MAIN LOOP
-// ============================================
-// ============================================
-// DOSING SCHEDULE EXECUTION ENGINE
-// ============================================
-
-// Dosing execution state machine
-enum DosingState {
-  DOSING_IDLE,
-  DOSING_RUNNING,
-  DOSING_COMPLETE
-};
-
-struct DosingExecution {
-  DosingState state = DOSING_IDLE;
-  uint8_t activePump = 0;
-  unsigned long startTime = 0;
-  unsigned long runDuration = 0;
-  uint16_t targetML = 0;
-  uint8_t scheduleIndex = 0;
-};
-
-DosingExecution activeDosing;
-
-// Track last execution time for each schedule (prevent duplicate runs)
-unsigned long lastDosingExecution[MAX_DOSING_SCHEDULES] = {0};
-const unsigned long DOSING_COOLDOWN = 60000; // 1 minute cooldown
-
-// Check schedules (call every 1 second from loop)
-void checkDosingSchedules(unsigned long currentTime) {
-  // Don't check while dosing is running
-  if (activeDosing.state == DOSING_RUNNING) return;
-  
-  // Check every second
-  static unsigned long lastCheck = 0;
-  if (currentTime - lastCheck < 1000) return;
-  lastCheck = currentTime;
-  
-  // Get current time from RTC
-  DateTime now = rtc.now();
-  
-  // Check each enabled schedule
-  for (int i = 0; i < MAX_DOSING_SCHEDULES; i++) {
-    DosingSchedule &sched = dosingSchedules[i];
-    
-    // Skip if disabled
-    if (!sched.enabled) continue;
-    
-    // Skip if not today
-    if (!isScheduleActiveToday(sched.daysOfWeek)) continue;
-    
-    // Skip if not current time (hour:minute match)
-    if (sched.hour != now.hour() || sched.minute != now.minute()) continue;
-    
-    // Skip if recently executed (within cooldown)
-    if ((currentTime - lastDosingExecution[i]) < DOSING_COOLDOWN) continue;
-    
-    // MATCH! Start dosing
-    startDosing(i, currentTime);
-    break; // Only execute one schedule at a time
-  }
-}
-
-// Start dosing operation
-void startDosing(uint8_t scheduleIndex, unsigned long currentTime) {
-  DosingSchedule &sched = dosingSchedules[scheduleIndex];
-  PumpCalibration &cal = pumpCalibrations[sched.pumpNumber - 1];
-  
-  // Calculate runtime based on calibration
-  float mlPerSec = cal.mlPerSecond;
-  float targetML = sched.amountML / 10.0; // Convert from tenths
-  unsigned long runMs = (unsigned long)((targetML / mlPerSec) * 1000);
-  
-  // Start pump
-  activeDosing.state = DOSING_RUNNING;
-  activeDosing.activePump = sched.pumpNumber;
-  activeDosing.startTime = currentTime;
-  activeDosing.runDuration = runMs;
-  activeDosing.scheduleIndex = scheduleIndex;
-  activeDosing.targetML = sched.amountML;
-  
-  setPumpSpeed(sched.pumpNumber, cal.pwmSpeed);
-  
-  // Mark as executed
-  lastDosingExecution[scheduleIndex] = currentTime;
-  
-  // Optional: Log to serial for debugging
-  Serial.print("[DOSING] Starting Pump ");
-  Serial.print(sched.pumpNumber);
-  Serial.print(" for ");
-  Serial.print(targetML, 1);
-  Serial.print(" mL (");
-  Serial.print(runMs);
-  Serial.println(" ms)");
-}
-
-// Update dosing state machine (call every loop iteration)
-void updateDosingExecution(unsigned long currentTime) {
-  if (activeDosing.state != DOSING_RUNNING) return;
-  
-  // Check if duration complete
-  if ((currentTime - activeDosing.startTime) >= activeDosing.runDuration) {
-    // Stop pump
-    setPumpSpeed(activeDosing.activePump, 0);
-    
-    // Log completion
-    Serial.print("[DOSING] Completed Pump ");
-    Serial.print(activeDosing.activePump);
-    Serial.print(" - ");
-    Serial.print(activeDosing.targetML / 10.0, 1);
-    Serial.println(" mL dispensed");
-    
-    // Reset state
-    activeDosing.state = DOSING_COMPLETE;
-    activeDosing.activePump = 0;
-    
-    // Transition to IDLE after short delay
-    delay(100); // Brief pause before next schedule can run
-    activeDosing.state = DOSING_IDLE;
-  }
-}
-
 // ============================================
 // MAIN LOOP (Runs on Core 0)
 // ============================================
 // Core 0: WiFi, MQTT, Encoder ISR, Networking
-// Core 1: Display rendering, Float switches, Touch sensors
+// Core 1: Display rendering (event driven), Float switches, Touch sensors
 void loop() {
   esp_task_wdt_reset();
   
   if (pendingRestart && millis() > restartAt) {
+    flushPersistence();
     ESP.restart();
   }
 
   unsigned long currentTime = millis();
 
-  checkMenuTimeout(currentTime);
-
   // Handle WiFi state and reconnection
   handleWiFi();
   // Check and execute dosing schedules
   checkDosingSchedules(currentTime);
   updateDosingExecution(currentTime);
+  updatePumpCalibration(currentTime);
+  updateReplaceSolution(currentTime);
+  // Drive relays from the outlet schedules
+  updateOutletSchedules(currentTime);
   
   // Heartbeat LED
   if ((unsigned long)(currentTime - lastHeartbeat) >= HEARTBEAT_INTERVAL) {
@@ -1968,17 +1728,9 @@ void loop() {
     digitalWrite(LED_BUILTIN, ledState);
   }
 
-  // Update encoder
+  // Poll the encoder button (posts DISPLAY_EVT_BUTTON). Menu navigation,
+  // drawing and the status bar all run in DisplayTask.
   updateEncoder();
-  // Handle menu navigation and redraw
-  handleMenuNavigation();
-  drawMenu();
-
-  // DEBUG: Removed LED 2/3 pin state display - was interfering with menu
-  // LED debugging confirmed encoder IS working
-
-  // Update status bar
-  updateStatusBar();
 
   // Handle WiFi state changes
   handleWiFiState(currentTime);
@@ -1994,13 +1746,8 @@ void loop() {
   // Check for daily NTP sync at midnight (and once on boot if connected)
   checkDailySync(currentTime);
 
-  // Write sensor log to LittleFS
-  if (config.enableLogging && spiffsReady) {
-    if ((unsigned long)(currentTime - lastLogWrite) >= LOG_WRITE_INTERVAL) {
-      lastLogWrite = currentTime;
-      logSensorData();
-    }
-  }
+  // Sample telemetry and roll it up to LittleFS
+  updateTelemetry(currentTime);
 
   // Update sensor data for web interface
   if ((unsigned long)(currentTime - lastWebUpdate) >= WEB_UPDATE_INTERVAL) {
@@ -2135,7 +1882,8 @@ void updateNTPSync() {
                        timeinfo.tm_min,
                        timeinfo.tm_sec);
 
-      rtc.adjust(newTime);
+      setRtcTime(newTime);
+      invalidateDosingQueue();
       lastNTPSyncTime = newTime;
       lastNTPSync = millis();
       ntpSynced = true;
@@ -2194,7 +1942,7 @@ void checkDailySync(unsigned long currentTime) {
   if ((unsigned long)(currentTime - lastDailySyncCheck) < DAILY_SYNC_CHECK_INTERVAL) return;
 
   lastDailySyncCheck = currentTime;
-  DateTime now = rtc.now();
+  DateTime now = timeNow();
 
   // Trigger at midnight (00:00)
   if (now.hour() == 0 && now.minute() == 0) {
@@ -2304,6 +2052,7 @@ void connectMQTT() {
     connected = mqtt.connect(clientId.c_str());
   }
   
+  postDisplayEvent(DISPLAY_EVT_STATUS);
   if (connected) {
     mqttConnected = true;
     
@@ -2376,6 +2125,7 @@ void mqttCallback(char* topic, byte* payload, unsigned int length) {
       testLedState = false;
     } else {
     }
+    postDisplayEvent(DISPLAY_EVT_STATUS);
   } else {
   }
 }
@@ -2386,8 +2136,8 @@ void publishSensorData(unsigned long currentTime) {
 
   lastMqttPublish = currentTime;
 
-  DateTime now = rtc.now();
-  float temp = rtc.getTemperature();
+  DateTime now = timeNow();
+  float temp = rtcTemperature();
 
   char timeStr[30];
   sprintf(timeStr, "%04d-%02d-%02d %02d:%02d:%02d",
@@ -2416,12 +2166,14 @@ void updateWifiStatus(const char* status) {
   // DISABLED - Menu system status bar shows WiFi connection status
   // Store status for internal state only
   strcpy(lastWifiStatus, status);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
 }
 
 void updateMqttStatus(const char* status) {
   // DISABLED - Menu system status bar shows MQTT connection status
   // Store status for internal state only
   strcpy(lastMqttStatus, status);
+  postDisplayEvent(DISPLAY_EVT_STATUS);
 }
 
 void updateNtpStatus(const char* status) {
@@ -2436,4 +2188,5 @@ void updateNtpStatus(const char* status) {
   } else {
     strcpy(lastNtpStatus, status);
   }
+  postDisplayEvent(DISPLAY_EVT_STATUS);
 }
\ No newline at end of file
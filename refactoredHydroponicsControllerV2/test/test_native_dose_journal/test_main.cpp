@@ -0,0 +1,216 @@
+/*
+ * test_main.cpp
+ *
+ * Dose journal on the simulated LittleFS: closing a dose that a reboot cut
+ * off mid-run, and the boot catch-up of fires missed while powered off.
+ * Run with `pio test -e native`.
+ */
+
+#include <unity.h>
+#include "DoseJournal.h"
+#include "Crc.h"
+#include "Sim.h"
+#include "TimeService.h"
+#include <LittleFS.h>
+
+#define MAX_RECORDS 64
+
+// 2025-06-01 is a Sunday
+static uint32_t at(uint8_t day, uint8_t hour, uint8_t minute) {
+  return DateTime(2025, 6, day, hour, minute, 0).unixtime();
+}
+
+static DosingSchedule schedule(uint8_t pump, uint8_t hour, uint8_t minute, uint16_t every) {
+  DosingSchedule sched = {};
+  sched.pumpNumber = pump;
+  sched.daysOfWeek = 0x7F;
+  sched.hour = hour;
+  sched.minute = minute;
+  sched.amountML = 50;
+  sched.isInterval = every > 0;
+  sched.intervalMinutes = every;
+  sched.enabled = true;
+  return sched;
+}
+
+static DoseJournalRecord record(DoseJournalType type, uint8_t pump, uint32_t dueUnix) {
+  DoseJournalRecord rec = {};
+  rec.type = type;
+  rec.pump = pump;
+  rec.source = DOSE_SOURCE_SCHEDULE;
+  rec.dueUnix = dueUnix;
+  rec.atUnix = dueUnix;
+  rec.amountML = 50;
+  rec.crc = crc16((const uint8_t*)&rec, offsetof(DoseJournalRecord, crc));
+  return rec;
+}
+
+// Journal as left by the previous boot; tornBytes of a further record model
+// a write cut off by the power loss
+static void writeJournal(const DoseJournalRecord *records, int count, size_t tornBytes = 0) {
+  File file = LittleFS.open(DOSE_JOURNAL_FILE, "w");
+  TEST_ASSERT_TRUE((bool)file);
+  for (int i = 0; i < count; i++) file.write((const uint8_t*)&records[i], sizeof(DoseJournalRecord));
+  if (tornBytes > 0) {
+    DoseJournalRecord torn = record(DOSE_JOURNAL_DONE, records[count - 1].pump, records[count - 1].dueUnix);
+    file.write((const uint8_t*)&torn, tornBytes);
+  }
+  file.close();
+}
+
+static int readJournal(DoseJournalRecord *out) {
+  File file = LittleFS.open(DOSE_JOURNAL_FILE, "r");
+  TEST_ASSERT_TRUE((bool)file);
+  TEST_ASSERT_EQUAL_UINT32(0, file.size() % sizeof(DoseJournalRecord));
+  int count = 0;
+  while (count < MAX_RECORDS && file.read((uint8_t*)&out[count], sizeof(DoseJournalRecord)) == sizeof(DoseJournalRecord)) {
+    count++;
+  }
+  file.close();
+  return count;
+}
+
+static int countRecords(const DoseJournalRecord *records, int count, DoseJournalType type, uint8_t pump) {
+  int found = 0;
+  for (int i = 0; i < count; i++) {
+    if (records[i].type == type && records[i].pump == pump) found++;
+  }
+  return found;
+}
+
+static void boot(uint32_t nowUnix) {
+  setRtcTime(DateTime(nowUnix));
+  initDoseJournal();
+}
+
+void setUp() {
+  TEST_ASSERT_TRUE(LittleFS.begin(true));
+  LittleFS.format();
+  memset(dosingSchedules, 0, sizeof(DosingSchedule) * MAX_DOSING_SCHEDULES);
+  dosingScheduleCount = 0;
+  config.doseCatchUp = DOSE_CATCHUP_LATE;
+}
+
+void tearDown() {}
+
+// ==================================================
+// INTERRUPTED DOSES
+// ==================================================
+void test_torn_started_dose_is_closed_not_repeated() {
+  dosingSchedules[0] = schedule(1, 8, 0, 0);
+  dosingScheduleCount = 1;
+  DoseJournalRecord previous[] = {
+    record(DOSE_JOURNAL_QUEUED, 1, at(2, 8, 0)),
+    record(DOSE_JOURNAL_STARTED, 1, at(2, 8, 0)),
+  };
+  writeJournal(previous, 2, 7);
+  uint8_t pendingBefore = pendingDoseCount(1);
+
+  boot(at(2, 8, 10));
+
+  DoseJournalRecord records[MAX_RECORDS];
+  int count = readJournal(records);
+  // The torn tail was dropped by compaction, which keeps only the latest
+  // record of each open dose
+  TEST_ASSERT_EQUAL_INT(1, countRecords(records, count, DOSE_JOURNAL_STARTED, 1));
+  TEST_ASSERT_EQUAL_INT(0, countRecords(records, count, DOSE_JOURNAL_QUEUED, 1));
+  TEST_ASSERT_EQUAL_INT(1, countRecords(records, count, DOSE_JOURNAL_INTERRUPTED, 1));
+  TEST_ASSERT_EQUAL_UINT8(DOSE_JOURNAL_INTERRUPTED, records[count - 1].type);
+  TEST_ASSERT_EQUAL_UINT32(at(2, 8, 0), records[count - 1].dueUnix);
+  TEST_ASSERT_EQUAL_UINT8(pendingBefore, pendingDoseCount(1));
+}
+
+void test_pending_dose_is_queued_again() {
+  dosingSchedules[0] = schedule(2, 8, 0, 0);
+  dosingScheduleCount = 1;
+  DoseJournalRecord previous[] = {
+    record(DOSE_JOURNAL_QUEUED, 2, at(2, 8, 0)),
+  };
+  writeJournal(previous, 1);
+  uint8_t pendingBefore = pendingDoseCount(2);
+
+  boot(at(2, 8, 10));
+
+  TEST_ASSERT_EQUAL_UINT8(pendingBefore + 1, pendingDoseCount(2));
+}
+
+// ==================================================
+// CATCH-UP
+// ==================================================
+void test_boot_catches_up_latest_missed_fire_only() {
+  dosingSchedules[0] = schedule(3, 0, 0, 60);
+  dosingScheduleCount = 1;
+  DoseJournalRecord previous[] = {
+    record(DOSE_JOURNAL_QUEUED, 3, at(2, 8, 0)),
+    record(DOSE_JOURNAL_STARTED, 3, at(2, 8, 0)),
+    record(DOSE_JOURNAL_DONE, 3, at(2, 8, 0)),
+  };
+  writeJournal(previous, 3);
+  uint8_t pendingBefore = pendingDoseCount(3);
+
+  // 09:00, 10:00 and 11:00 were missed
+  boot(at(2, 11, 30));
+
+  DoseJournalRecord records[MAX_RECORDS];
+  int count = readJournal(records);
+  TEST_ASSERT_EQUAL_UINT8(DOSE_JOURNAL_QUEUED, records[count - 1].type);
+  TEST_ASSERT_EQUAL_UINT32(at(2, 11, 0), records[count - 1].dueUnix);
+  TEST_ASSERT_EQUAL_INT(2, countRecords(records, count, DOSE_JOURNAL_QUEUED, 3));
+  TEST_ASSERT_EQUAL_UINT8(pendingBefore + 1, pendingDoseCount(3));
+}
+
+void test_skip_policy_records_missed_fire() {
+  config.doseCatchUp = DOSE_CATCHUP_SKIP;
+  dosingSchedules[0] = schedule(4, 8, 0, 0);
+  dosingScheduleCount = 1;
+  DoseJournalRecord previous[] = {
+    record(DOSE_JOURNAL_DONE, 4, at(2, 8, 0)),
+  };
+  writeJournal(previous, 1);
+  uint8_t pendingBefore = pendingDoseCount(4);
+
+  boot(at(3, 9, 0));
+
+  DoseJournalRecord records[MAX_RECORDS];
+  int count = readJournal(records);
+  TEST_ASSERT_EQUAL_UINT8(DOSE_JOURNAL_SKIPPED, records[count - 1].type);
+  TEST_ASSERT_EQUAL_UINT32(at(3, 8, 0), records[count - 1].dueUnix);
+  TEST_ASSERT_EQUAL_UINT8(pendingBefore, pendingDoseCount(4));
+}
+
+void test_fire_at_watermark_runs_for_unrecorded_pump() {
+  // Both due 08:00; power failed after pump 1 was journaled
+  dosingSchedules[0] = schedule(1, 8, 0, 0);
+  dosingSchedules[1] = schedule(2, 8, 0, 0);
+  dosingScheduleCount = 2;
+  DoseJournalRecord previous[] = {
+    record(DOSE_JOURNAL_QUEUED, 1, at(4, 8, 0)),
+    record(DOSE_JOURNAL_STARTED, 1, at(4, 8, 0)),
+    record(DOSE_JOURNAL_DONE, 1, at(4, 8, 0)),
+  };
+  writeJournal(previous, 3);
+  uint8_t pending1 = pendingDoseCount(1);
+  uint8_t pending2 = pendingDoseCount(2);
+
+  boot(at(4, 8, 30));
+
+  DoseJournalRecord records[MAX_RECORDS];
+  int count = readJournal(records);
+  TEST_ASSERT_EQUAL_INT(1, countRecords(records, count, DOSE_JOURNAL_QUEUED, 1));
+  TEST_ASSERT_EQUAL_INT(1, countRecords(records, count, DOSE_JOURNAL_QUEUED, 2));
+  TEST_ASSERT_EQUAL_UINT32(at(4, 8, 0), records[count - 1].dueUnix);
+  TEST_ASSERT_EQUAL_UINT8(pending1, pendingDoseCount(1));
+  TEST_ASSERT_EQUAL_UINT8(pending2 + 1, pendingDoseCount(2));
+}
+
+int main() {
+  Sim::setDataDir("test_data_dose_journal");
+
+  UNITY_BEGIN();
+  RUN_TEST(test_torn_started_dose_is_closed_not_repeated);
+  RUN_TEST(test_pending_dose_is_queued_again);
+  RUN_TEST(test_boot_catches_up_latest_missed_fire_only);
+  RUN_TEST(test_skip_policy_records_missed_fire);
+  RUN_TEST(test_fire_at_watermark_runs_for_unrecorded_pump);
+  return UNITY_END();
+}
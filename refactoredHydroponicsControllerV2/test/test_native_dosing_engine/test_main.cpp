@@ -0,0 +1,87 @@
+/*
+ * test_main.cpp
+ *
+ * DosingEngine cancellation: dropping one source's doses from a pump queue
+ * and stopping its running dose, leaving other doses queued in order. Run
+ * with `pio test -e native`.
+ */
+
+#include <unity.h>
+#include "DosingEngine.h"
+#include "Hardware.h"
+#include "Sim.h"
+
+static DoseRequest dose(uint8_t pump, uint16_t amountML, DoseSource source) {
+  DoseRequest request = {};
+  request.pumpNumber = pump;
+  request.amountML = amountML;
+  request.source = source;
+  return request;
+}
+
+void setUp() {
+  // Single-speed calibration: 1 mL/s at 50 %
+  for (int i = 0; i < DOSING_PUMP_COUNT; i++) {
+    pumpCalibrations[i] = {};
+    pumpCalibrations[i].pwmSpeed = 50;
+    pumpCalibrations[i].mlPerSecond = 1.0f;
+    pumpCalibrations[i].isCalibrated = true;
+  }
+}
+
+void tearDown() {}
+
+// ==================================================
+// TESTS
+// ==================================================
+void test_cancel_drops_pending_doses_of_source() {
+  TEST_ASSERT_TRUE(queueDose(dose(2, 100, DOSE_SOURCE_REPLACE)));
+  TEST_ASSERT_TRUE(queueDose(dose(2, 20, DOSE_SOURCE_MANUAL)));
+  TEST_ASSERT_TRUE(queueDose(dose(2, 100, DOSE_SOURCE_REPLACE)));
+  TEST_ASSERT_TRUE(queueDose(dose(2, 30, DOSE_SOURCE_MANUAL)));
+
+  TEST_ASSERT_EQUAL_UINT8(2, cancelDoses(2, DOSE_SOURCE_REPLACE));
+  TEST_ASSERT_EQUAL_UINT8(2, pendingDoseCount(2));
+  TEST_ASSERT_EQUAL_UINT8(0, cancelDoses(2, DOSE_SOURCE_REPLACE));
+  TEST_ASSERT_EQUAL_UINT8(2, cancelDoses(2, DOSE_SOURCE_MANUAL));
+  TEST_ASSERT_EQUAL_UINT8(0, pendingDoseCount(2));
+}
+
+void test_cancel_stops_running_dose_of_source() {
+  TEST_ASSERT_TRUE(queueDose(dose(1, 100, DOSE_SOURCE_REPLACE)));
+  TEST_ASSERT_TRUE(queueDose(dose(1, 20, DOSE_SOURCE_MANUAL)));
+  updateDosingExecution(millis());
+  TEST_ASSERT_TRUE(isPumpDosing(1));
+  TEST_ASSERT_EQUAL_UINT8(50, getPumpSpeed(1));
+
+  TEST_ASSERT_EQUAL_UINT8(1, cancelDoses(1, DOSE_SOURCE_REPLACE));
+  TEST_ASSERT_FALSE(isPumpDosing(1));
+  TEST_ASSERT_EQUAL_UINT8(0, getPumpSpeed(1));
+  TEST_ASSERT_EQUAL_UINT8(1, pendingDoseCount(1));
+
+  // The manual dose is next
+  updateDosingExecution(millis());
+  TEST_ASSERT_TRUE(isPumpDosing(1));
+  TEST_ASSERT_EQUAL_UINT8(1, cancelDoses(1, DOSE_SOURCE_MANUAL));
+}
+
+void test_cancel_leaves_other_sources_running() {
+  TEST_ASSERT_TRUE(queueDose(dose(3, 100, DOSE_SOURCE_MANUAL)));
+  updateDosingExecution(millis());
+  TEST_ASSERT_TRUE(isPumpDosing(3));
+
+  TEST_ASSERT_EQUAL_UINT8(0, cancelDoses(3, DOSE_SOURCE_REPLACE));
+  TEST_ASSERT_TRUE(isPumpDosing(3));
+  TEST_ASSERT_EQUAL_UINT8(1, cancelDoses(3, DOSE_SOURCE_MANUAL));
+  TEST_ASSERT_FALSE(isPumpDosing(3));
+}
+
+int main() {
+  Sim::setDataDir("test_data_dosing_engine");
+
+  UNITY_BEGIN();
+  RUN_TEST(test_cancel_drops_pending_doses_of_source);
+  RUN_TEST(test_cancel_stops_running_dose_of_source);
+  RUN_TEST(test_cancel_leaves_other_sources_running);
+  return UNITY_END();
+}
@@ -0,0 +1,107 @@
+/*
+ * test_main.cpp
+ *
+ * dosingScheduleNextFire(): daily and interval schedules and the wrap to
+ * the next enabled day. Run with `pio test -e native`.
+ */
+
+#include <unity.h>
+#include "DosingQueue.h"
+
+// 2025-06-01 is a Sunday
+static uint32_t at(uint8_t day, uint8_t hour, uint8_t minute) {
+  return DateTime(2025, 6, day, hour, minute, 0).unixtime();
+}
+
+static DosingSchedule schedule(uint8_t days, uint8_t hour, uint8_t minute, uint16_t every) {
+  DosingSchedule sched = {};
+  sched.pumpNumber = 1;
+  sched.daysOfWeek = days;
+  sched.hour = hour;
+  sched.minute = minute;
+  sched.amountML = 100;
+  sched.isInterval = every > 0;
+  sched.intervalMinutes = every;
+  sched.enabled = true;
+  return sched;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ==================================================
+// DAILY
+// ==================================================
+void test_daily_fires_later_today() {
+  DosingSchedule sched = schedule(0x7F, 8, 0, 0);
+  TEST_ASSERT_EQUAL_UINT32(at(1, 8, 0), dosingScheduleNextFire(sched, at(1, 7, 0)));
+}
+
+void test_daily_fire_time_is_exclusive() {
+  DosingSchedule sched = schedule(0x7F, 8, 0, 0);
+  TEST_ASSERT_EQUAL_UINT32(at(2, 8, 0), dosingScheduleNextFire(sched, at(1, 8, 0)));
+}
+
+void test_disabled_or_no_days_never_fires() {
+  DosingSchedule sched = schedule(0, 8, 0, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, dosingScheduleNextFire(sched, at(1, 7, 0)));
+
+  sched = schedule(0x7F, 8, 0, 0);
+  sched.enabled = false;
+  TEST_ASSERT_EQUAL_UINT32(0, dosingScheduleNextFire(sched, at(1, 7, 0)));
+}
+
+// ==================================================
+// INTERVAL
+// ==================================================
+void test_interval_counts_from_the_anchor() {
+  DosingSchedule sched = schedule(0x7F, 6, 0, 90);
+  TEST_ASSERT_EQUAL_UINT32(at(1, 6, 0), dosingScheduleNextFire(sched, at(1, 5, 0)));
+  TEST_ASSERT_EQUAL_UINT32(at(1, 7, 30), dosingScheduleNextFire(sched, at(1, 7, 0)));
+  TEST_ASSERT_EQUAL_UINT32(at(1, 9, 0), dosingScheduleNextFire(sched, at(1, 7, 30)));
+}
+
+void test_interval_stops_at_midnight() {
+  // 06:00 + k * 90 min: the last fire of the day is 22:30
+  DosingSchedule sched = schedule(0x7F, 6, 0, 90);
+  TEST_ASSERT_EQUAL_UINT32(at(1, 22, 30), dosingScheduleNextFire(sched, at(1, 22, 0)));
+  TEST_ASSERT_EQUAL_UINT32(at(2, 6, 0), dosingScheduleNextFire(sched, at(1, 22, 30)));
+}
+
+void test_interval_with_zero_minutes_never_fires() {
+  DosingSchedule sched = schedule(0x7F, 6, 0, 0);
+  sched.isInterval = true;
+  TEST_ASSERT_EQUAL_UINT32(0, dosingScheduleNextFire(sched, at(1, 5, 0)));
+}
+
+// ==================================================
+// DAY WRAP
+// ==================================================
+void test_skips_to_next_enabled_day() {
+  DosingSchedule sched = schedule(1 << 6, 8, 0, 0);   // Saturday
+  TEST_ASSERT_EQUAL_UINT32(at(7, 8, 0), dosingScheduleNextFire(sched, at(1, 9, 0)));
+}
+
+void test_wraps_a_full_week() {
+  DosingSchedule sched = schedule(1 << 0, 8, 0, 0);   // Sunday only
+  TEST_ASSERT_EQUAL_UINT32(at(8, 8, 0), dosingScheduleNextFire(sched, at(1, 9, 0)));
+}
+
+void test_interval_wraps_to_next_enabled_day() {
+  DosingSchedule sched = schedule((1 << 0) | (1 << 3), 0, 0, 720);   // Sun, Wed
+  TEST_ASSERT_EQUAL_UINT32(at(4, 0, 0), dosingScheduleNextFire(sched, at(1, 12, 0)));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_daily_fires_later_today);
+  RUN_TEST(test_daily_fire_time_is_exclusive);
+  RUN_TEST(test_disabled_or_no_days_never_fires);
+  RUN_TEST(test_interval_counts_from_the_anchor);
+  RUN_TEST(test_interval_stops_at_midnight);
+  RUN_TEST(test_interval_with_zero_minutes_never_fires);
+  RUN_TEST(test_skips_to_next_enabled_day);
+  RUN_TEST(test_wraps_a_full_week);
+  RUN_TEST(test_interval_wraps_to_next_enabled_day);
+  return UNITY_END();
+}
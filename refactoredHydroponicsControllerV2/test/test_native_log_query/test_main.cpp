@@ -0,0 +1,137 @@
+/*
+ * test_main.cpp
+ *
+ * /api/logs query parameters: time parsing and which series a step reads.
+ * Run with `pio test -e native`.
+ */
+
+#include <unity.h>
+#include "LogQuery.h"
+#include "Sim.h"
+
+static LogQuery query(uint32_t step) {
+  LogQuery q = {};
+  q.from = 0;
+  q.to = UINT32_MAX;
+  q.step = step;
+  q.format = LOG_FORMAT_CSV;
+  return q;
+}
+
+void setUp() {}
+void tearDown() {}
+
+// ==================================================
+// TIME PARSING
+// ==================================================
+void test_parse_unix_seconds() {
+  uint32_t t = 0;
+  TEST_ASSERT_TRUE(logQueryParseTime("1748764800", t));
+  TEST_ASSERT_EQUAL_UINT32(1748764800UL, t);
+}
+
+void test_parse_date() {
+  uint32_t t = 0;
+  TEST_ASSERT_TRUE(logQueryParseTime("2025-06-01", t));
+  TEST_ASSERT_EQUAL_UINT32(DateTime(2025, 6, 1).unixtime(), t);
+}
+
+void test_parse_date_time() {
+  uint32_t t = 0;
+  TEST_ASSERT_TRUE(logQueryParseTime("2025-06-01 07:30:15", t));
+  TEST_ASSERT_EQUAL_UINT32(DateTime(2025, 6, 1, 7, 30, 15).unixtime(), t);
+  TEST_ASSERT_TRUE(logQueryParseTime("2025-06-01T07:30:15", t));
+  TEST_ASSERT_EQUAL_UINT32(DateTime(2025, 6, 1, 7, 30, 15).unixtime(), t);
+}
+
+void test_parse_rejects_garbage() {
+  uint32_t t = 42;
+  TEST_ASSERT_FALSE(logQueryParseTime("", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("yesterday", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("12abc", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("2025-06", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("2025-06-01 07:30", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("2025-13-01", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("2025-06-01x", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("2025-06-01 07:30:15z", t));
+  TEST_ASSERT_FALSE(logQueryParseTime("4294967296", t));
+  TEST_ASSERT_EQUAL_UINT32(42, t);
+}
+
+void test_parse_numbers() {
+  uint32_t n = 7;
+  TEST_ASSERT_TRUE(logQueryParseNumber("0", n));
+  TEST_ASSERT_EQUAL_UINT32(0, n);
+  TEST_ASSERT_TRUE(logQueryParseNumber("4294967295", n));
+  TEST_ASSERT_EQUAL_UINT32(4294967295UL, n);
+  TEST_ASSERT_FALSE(logQueryParseNumber("", n));
+  TEST_ASSERT_FALSE(logQueryParseNumber("-60", n));
+  TEST_ASSERT_FALSE(logQueryParseNumber("60s", n));
+  TEST_ASSERT_FALSE(logQueryParseNumber("4294967296", n));
+  TEST_ASSERT_EQUAL_UINT32(4294967295UL, n);
+}
+
+void test_format_names() {
+  LogQueryFormat format;
+  TEST_ASSERT_TRUE(logQueryFormatFromName("json", format));
+  TEST_ASSERT_EQUAL(LOG_FORMAT_JSON, format);
+  TEST_ASSERT_TRUE(logQueryFormatFromName("bin", format));
+  TEST_ASSERT_EQUAL(LOG_FORMAT_BIN, format);
+  TEST_ASSERT_FALSE(logQueryFormatFromName("xml", format));
+}
+
+// ==================================================
+// STEP AND SERIES
+// ==================================================
+void test_short_steps_read_raw_records() {
+  LogQueryStream raw(query(0));
+  TEST_ASSERT_EQUAL(SENSOR_SERIES_RAW, raw.series());
+  TEST_ASSERT_EQUAL_UINT32(0, raw.step());
+
+  LogQueryStream under(query(59));
+  TEST_ASSERT_EQUAL(SENSOR_SERIES_RAW, under.series());
+}
+
+void test_step_picks_coarsest_fitting_series() {
+  LogQueryStream minute(query(60));
+  TEST_ASSERT_EQUAL(SENSOR_SERIES_MINUTE, minute.series());
+
+  LogQueryStream belowHour(query(3599));
+  TEST_ASSERT_EQUAL(SENSOR_SERIES_MINUTE, belowHour.series());
+
+  LogQueryStream hour(query(3600));
+  TEST_ASSERT_EQUAL(SENSOR_SERIES_HOUR, hour.series());
+
+  LogQueryStream day(query(7 * 86400));
+  TEST_ASSERT_EQUAL(SENSOR_SERIES_DAY, day.series());
+}
+
+void test_step_rounds_down_to_whole_buckets() {
+  LogQueryStream minute(query(150));
+  TEST_ASSERT_EQUAL_UINT32(120, minute.step());
+
+  LogQueryStream hour(query(5400));
+  TEST_ASSERT_EQUAL_UINT32(3600, hour.step());
+
+  LogQueryStream day(query(100000));
+  TEST_ASSERT_EQUAL_UINT32(86400, day.step());
+}
+
+int main() {
+  Sim::setDataDir("test_data_log_query");
+  LittleFS.begin(true);
+  LittleFS.format();
+  initSensorLog();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_parse_unix_seconds);
+  RUN_TEST(test_parse_date);
+  RUN_TEST(test_parse_date_time);
+  RUN_TEST(test_parse_rejects_garbage);
+  RUN_TEST(test_parse_numbers);
+  RUN_TEST(test_format_names);
+  RUN_TEST(test_short_steps_read_raw_records);
+  RUN_TEST(test_step_picks_coarsest_fitting_series);
+  RUN_TEST(test_step_rounds_down_to_whole_buckets);
+  return UNITY_END();
+}
@@ -0,0 +1,181 @@
+/*
+ * test_main.cpp
+ *
+ * RingLog on the simulated LittleFS: wraparound, the oldest readable
+ * record, and recovering the write position after a reboot. Run with
+ * `pio test -e native`.
+ */
+
+#include <unity.h>
+#include "RingLog.h"
+#include "Sim.h"
+
+#define TEST_RING_DIR      "/test_ring"
+#define TEST_RING_SEGMENTS 4
+
+struct TestRecord {
+  RingLogHead head;
+  uint32_t value;
+  uint16_t reserved;
+  uint16_t crc;
+};
+
+// 4096 / 16 = 256 records per segment
+#define PER_SEGMENT (RING_LOG_SEGMENT_BYTES / sizeof(TestRecord))
+#define CAPACITY    (PER_SEGMENT * TEST_RING_SEGMENTS)
+
+static void appendRecords(RingLog &ring, uint32_t count, uint32_t firstValue) {
+  for (uint32_t i = 0; i < count; i++) {
+    TestRecord rec = {};
+    rec.head.unixTime = 1000000 + (firstValue + i) * 60;
+    rec.value = firstValue + i;
+    TEST_ASSERT_TRUE(ring.append(&rec));
+  }
+}
+
+void setUp() {
+  TEST_ASSERT_TRUE(LittleFS.begin(true));
+  LittleFS.format();
+}
+
+void tearDown() {}
+
+// ==================================================
+// TESTS
+// ==================================================
+void test_empty_ring() {
+  RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+  TEST_ASSERT_TRUE(ring.begin());
+
+  uint32_t first, last;
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(0, first);
+  TEST_ASSERT_EQUAL_UINT32(0, last);
+  TEST_ASSERT_EQUAL_UINT32(0, ring.seek(0));
+}
+
+void test_reads_back_in_order() {
+  RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+  TEST_ASSERT_TRUE(ring.begin());
+  appendRecords(ring, 10, 1);
+
+  uint32_t first, last;
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(1, first);
+  TEST_ASSERT_EQUAL_UINT32(10, last);
+
+  RingLogReader reader(ring);
+  TestRecord rec;
+  for (uint32_t seq = first; seq <= last; seq++) {
+    TEST_ASSERT_TRUE(reader.read(seq, &rec));
+    TEST_ASSERT_EQUAL_UINT32(seq, rec.value);
+  }
+  TEST_ASSERT_FALSE(reader.read(11, &rec));
+}
+
+void test_wraparound_drops_oldest_segment() {
+  RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+  TEST_ASSERT_TRUE(ring.begin());
+  TEST_ASSERT_EQUAL_UINT32(CAPACITY, ring.capacity());
+
+  // Half a segment into the second lap
+  const uint32_t total = CAPACITY + PER_SEGMENT + PER_SEGMENT / 2;
+  appendRecords(ring, total, 1);
+
+  uint32_t first, last;
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(total, last);
+  TEST_ASSERT_EQUAL_UINT32(2 * PER_SEGMENT + 1, first);
+  TEST_ASSERT_TRUE(last - first + 1 <= CAPACITY);
+  TEST_ASSERT_TRUE(last - first + 1 >= CAPACITY - PER_SEGMENT);
+
+  RingLogReader reader(ring);
+  TestRecord rec;
+  TEST_ASSERT_FALSE(reader.read(first - 1, &rec));
+  TEST_ASSERT_TRUE(reader.read(first, &rec));
+  TEST_ASSERT_EQUAL_UINT32(first, rec.value);
+  TEST_ASSERT_TRUE(reader.read(last, &rec));
+  TEST_ASSERT_EQUAL_UINT32(last, rec.value);
+}
+
+void test_seek_lands_on_segment_start() {
+  RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+  TEST_ASSERT_TRUE(ring.begin());
+  appendRecords(ring, 3 * PER_SEGMENT, 1);
+
+  // Record n was stamped 1000000 + n * 60
+  uint32_t seq = ring.seek(1000000 + (PER_SEGMENT + 10) * 60);
+  TEST_ASSERT_EQUAL_UINT32(PER_SEGMENT + 1, seq);
+  TEST_ASSERT_EQUAL_UINT32(1, ring.seek(0));
+}
+
+void test_reboot_recovers_write_position() {
+  const uint32_t total = CAPACITY + 100;
+  {
+    RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+    TEST_ASSERT_TRUE(ring.begin());
+    appendRecords(ring, total, 1);
+  }
+
+  RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+  TEST_ASSERT_TRUE(ring.begin());
+  uint32_t first, last;
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(total, last);
+
+  // Appends continue the sequence and overwrite the oldest record
+  appendRecords(ring, 1, total + 1);
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(total + 1, last);
+
+  RingLogReader reader(ring);
+  TestRecord rec;
+  TEST_ASSERT_TRUE(reader.read(total + 1, &rec));
+  TEST_ASSERT_EQUAL_UINT32(total + 1, rec.value);
+  TEST_ASSERT_TRUE(reader.read(total, &rec));
+  TEST_ASSERT_EQUAL_UINT32(total, rec.value);
+}
+
+void test_reboot_with_other_layout_starts_over() {
+  {
+    RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+    TEST_ASSERT_TRUE(ring.begin());
+    appendRecords(ring, 10, 1);
+  }
+
+  RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS + 1);
+  TEST_ASSERT_TRUE(ring.begin());
+  uint32_t first, last;
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(0, last);
+}
+
+void test_clear_empties_the_ring() {
+  RingLog ring(TEST_RING_DIR, sizeof(TestRecord), TEST_RING_SEGMENTS);
+  TEST_ASSERT_TRUE(ring.begin());
+  appendRecords(ring, 10, 1);
+  ring.clear();
+
+  uint32_t first, last;
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(0, last);
+
+  appendRecords(ring, 1, 1);
+  ring.span(first, last);
+  TEST_ASSERT_EQUAL_UINT32(1, first);
+  TEST_ASSERT_EQUAL_UINT32(1, last);
+}
+
+int main() {
+  Sim::setDataDir("test_data_ring_log");
+
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_ring);
+  RUN_TEST(test_reads_back_in_order);
+  RUN_TEST(test_wraparound_drops_oldest_segment);
+  RUN_TEST(test_seek_lands_on_segment_start);
+  RUN_TEST(test_reboot_recovers_write_position);
+  RUN_TEST(test_reboot_with_other_layout_starts_over);
+  RUN_TEST(test_clear_empties_the_ring);
+  return UNITY_END();
+}
@@ -0,0 +1,118 @@
+/*
+ * test_main.cpp
+ *
+ * Schedule storage on the simulated NVS: the blob round trip, rejecting a
+ * blob whose CRC does not match, and migrating the per-schedule keys of
+ * earlier firmware. Run with `pio test -e native`.
+ */
+
+#include <unity.h>
+#include "Storage.h"
+#include "Sim.h"
+
+static DosingSchedule dosing(uint8_t pump, uint8_t hour) {
+  DosingSchedule sched = {};
+  sched.pumpNumber = pump;
+  sched.daysOfWeek = 0x7F;
+  sched.hour = hour;
+  sched.amountML = 25;
+  sched.enabled = true;
+  return sched;
+}
+
+static void clearSchedulesInRam() {
+  memset(dosingSchedules, 0, sizeof(DosingSchedule) * MAX_DOSING_SCHEDULES);
+  memset(outletSchedules, 0, sizeof(OutletSchedule) * MAX_OUTLET_SCHEDULES);
+  dosingScheduleCount = 0;
+  outletScheduleCount = 0;
+}
+
+void setUp() {
+  preferences.begin("schedules", false);
+  preferences.clear();
+  preferences.end();
+  clearSchedulesInRam();
+}
+
+void tearDown() {}
+
+// ==================================================
+// TESTS
+// ==================================================
+void test_blob_round_trip() {
+  dosingSchedules[0] = dosing(1, 8);
+  dosingSchedules[1] = dosing(3, 20);
+  dosingScheduleCount = 2;
+  outletSchedules[0].relayNumber = 2;
+  outletScheduleCount = 1;
+  TEST_ASSERT_TRUE(saveSchedulesToStorage());
+
+  clearSchedulesInRam();
+  loadSchedulesFromStorage();
+  TEST_ASSERT_EQUAL_INT(2, dosingScheduleCount);
+  TEST_ASSERT_EQUAL_INT(1, outletScheduleCount);
+  TEST_ASSERT_EQUAL_UINT8(3, dosingSchedules[1].pumpNumber);
+  TEST_ASSERT_EQUAL_UINT8(20, dosingSchedules[1].hour);
+  TEST_ASSERT_EQUAL_UINT8(2, outletSchedules[0].relayNumber);
+}
+
+void test_corrupt_blob_is_rejected() {
+  dosingSchedules[0] = dosing(1, 8);
+  dosingScheduleCount = 1;
+  TEST_ASSERT_TRUE(saveSchedulesToStorage());
+
+  // Flip one bit of the last byte, inside the CRC-covered payload
+  preferences.begin("schedules", false);
+  size_t len = preferences.getBytesLength("blob");
+  TEST_ASSERT_TRUE(len > 0);
+  uint8_t *blob = (uint8_t*)malloc(len);
+  preferences.getBytes("blob", blob, len);
+  blob[len - 1] ^= 0x01;
+  preferences.putBytes("blob", blob, len);
+  preferences.end();
+  free(blob);
+
+  clearSchedulesInRam();
+  loadSchedulesFromStorage();
+  TEST_ASSERT_EQUAL_INT(0, dosingScheduleCount);
+}
+
+void test_legacy_keys_are_migrated() {
+  DosingSchedule first = dosing(2, 6);
+  DosingSchedule second = dosing(4, 18);
+  preferences.begin("schedules", false);
+  preferences.putInt("dose_count", 2);
+  preferences.putInt("outlet_count", 0);
+  preferences.putBytes("dose_0", &first, sizeof(first));
+  preferences.putBytes("dose_1", &second, sizeof(second));
+  preferences.end();
+
+  loadSchedulesFromStorage();
+  TEST_ASSERT_EQUAL_INT(2, dosingScheduleCount);
+  TEST_ASSERT_EQUAL_UINT8(2, dosingSchedules[0].pumpNumber);
+  TEST_ASSERT_EQUAL_UINT8(18, dosingSchedules[1].hour);
+
+  // The blob replaced the old keys
+  preferences.begin("schedules", true);
+  TEST_ASSERT_TRUE(preferences.isKey("blob"));
+  TEST_ASSERT_FALSE(preferences.isKey("dose_count"));
+  TEST_ASSERT_FALSE(preferences.isKey("dose_0"));
+  TEST_ASSERT_FALSE(preferences.isKey("dose_1"));
+  preferences.end();
+
+  // And loads on its own
+  clearSchedulesInRam();
+  loadSchedulesFromStorage();
+  TEST_ASSERT_EQUAL_INT(2, dosingScheduleCount);
+  TEST_ASSERT_EQUAL_UINT8(4, dosingSchedules[1].pumpNumber);
+}
+
+int main() {
+  Sim::setDataDir("test_data_schedule_store");
+
+  UNITY_BEGIN();
+  RUN_TEST(test_blob_round_trip);
+  RUN_TEST(test_corrupt_blob_is_rejected);
+  RUN_TEST(test_legacy_keys_are_migrated);
+  return UNITY_END();
+}
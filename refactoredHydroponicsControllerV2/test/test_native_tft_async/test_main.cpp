@@ -0,0 +1,88 @@
+/*
+ * test_main.cpp
+ *
+ * TFT_ILI9163C::beginAsync() against the simulated IDF SPI master: when
+ * the bus or the device cannot be set up, the Arduino SPI host is begun
+ * again and the blocking path still reaches the wire. Run with
+ * `pio test -e native`.
+ *
+ * The real ESP32 driver is compiled into this test under another class
+ * name, since the firmware build links the simulated panel as
+ * TFT_ILI9163C.
+ */
+
+#include <unity.h>
+#include "Sim.h"
+
+#define ESP32 1
+#define TFT_ILI9163C DriverUnderTest
+#include "../../lib/TFT_ILI9163C/TFT_ILI9163C.cpp"
+#undef TFT_ILI9163C
+
+#define TEST_CS   40
+#define TEST_DC   38
+#define TEST_RST  39
+#define TEST_MOSI 35
+#define TEST_SCK  36
+
+static uint16_t block[16 * 16];
+
+void setUp() {
+  Sim::setSpiMasterFailure(false, false);
+  SPI.begin(TEST_SCK, -1, TEST_MOSI, TEST_CS);
+}
+
+void tearDown() {}
+
+// ==================================================
+// TESTS
+// ==================================================
+void test_bus_init_failure_keeps_arduino_spi() {
+  DriverUnderTest tft(TEST_CS, TEST_DC, TEST_RST);
+  Sim::setSpiMasterFailure(true, false);
+  uint32_t lost = Sim::spiBytesLost();
+
+  TEST_ASSERT_FALSE(tft.beginAsync(TEST_SCK, TEST_MOSI));
+  TEST_ASSERT_FALSE(tft.isAsync());
+  TEST_ASSERT_TRUE(Sim::spiBegun());
+  TEST_ASSERT_FALSE(Sim::spiBusHeld());
+
+  tft.fillRect(0, 0, 16, 16, 0xF800);
+  TEST_ASSERT_TRUE(tft.pushRectAsync(0, 0, 16, 16, block));
+  TEST_ASSERT_EQUAL_UINT32(lost, Sim::spiBytesLost());
+}
+
+void test_add_device_failure_frees_the_bus() {
+  DriverUnderTest tft(TEST_CS, TEST_DC, TEST_RST);
+  Sim::setSpiMasterFailure(false, true);
+  uint32_t lost = Sim::spiBytesLost();
+
+  TEST_ASSERT_FALSE(tft.beginAsync(TEST_SCK, TEST_MOSI));
+  TEST_ASSERT_FALSE(tft.isAsync());
+  TEST_ASSERT_TRUE(Sim::spiBegun());
+  TEST_ASSERT_FALSE(Sim::spiBusHeld());
+
+  tft.fillRect(0, 0, 16, 16, 0x07E0);
+  TEST_ASSERT_TRUE(tft.pushRectAsync(0, 0, 16, 16, block));
+  TEST_ASSERT_EQUAL_UINT32(lost, Sim::spiBytesLost());
+}
+
+void test_success_hands_the_host_over() {
+  DriverUnderTest tft(TEST_CS, TEST_DC, TEST_RST);
+
+  TEST_ASSERT_TRUE(tft.beginAsync(TEST_SCK, TEST_MOSI));
+  TEST_ASSERT_TRUE(tft.isAsync());
+  TEST_ASSERT_FALSE(Sim::spiBegun());
+  TEST_ASSERT_TRUE(Sim::spiBusHeld());
+
+  TEST_ASSERT_TRUE(tft.pushRectAsync(0, 0, 16, 16, block));
+  TEST_ASSERT_TRUE(tft.waitAsync());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bus_init_failure_keeps_arduino_spi);
+  RUN_TEST(test_add_device_failure_frees_the_bus);
+  RUN_TEST(test_success_hands_the_host_over);
+  return UNITY_END();
+}